@@ -57,6 +57,30 @@ class BigInt {
         return false; // 绝对值相等
     }
 
+    /**
+     * @brief 绝对值相减（要求|minuend| >= |subtrahend|），结果非负
+     */
+    static BigInt sub_abs(const BigInt& minuend, const BigInt& subtrahend) {
+        BigInt res;
+        res.digits_.clear();
+        int32_t borrow = 0; // 借位
+        for (size_t i = 0; i < minuend.digits_.size(); ++i) {
+            // 取当前位（减数不足补0）, 有符号运算避免借位时下溢
+            int32_t a = minuend.digits_[i];
+            const int32_t b = (i < subtrahend.digits_.size()) ? subtrahend.digits_[i] : 0;
+            // 处理借位：当前位不够减，向前借1（变成10+当前位）
+            a -= borrow;
+            borrow = 0;
+            if (a < b) {
+                a += 10;
+                borrow = 1;
+            }
+            res.digits_.push_back(static_cast<uint8_t>(a - b));
+        }
+        res.trim_leading_zeros();
+        return res;
+    }
+
     /**
      * @brief 核心辅助：计算 (dividend / divisor) 的商和余数（无符号，仅处理正整数）
      * @param dividend 被除数（非负）
@@ -301,9 +325,10 @@ public:
         // 情况2：异号（一正一负）→ 绝对值相减，符号取绝对值大的
         else {
             if (abs_less(other)) { // this绝对值 < other绝对值 → 结果符号=other符号
-                res = other - *this;
+                res = sub_abs(other, *this);
+                res.is_negative_ = other.is_negative_;
             } else { // this绝对值 >= other绝对值 → 结果符号=this符号
-                res = *this - other;
+                res = sub_abs(*this, other);
                 res.is_negative_ = is_negative_;
             }
         }
@@ -318,44 +343,13 @@ public:
     }
 
     // ========================= 核心运算：减法 =========================
+    // a - b 即 a + (-b), 符号由加法统一处理
     BigInt operator-(const BigInt& other) const {
-        // 特殊情况：减自己 → 0
-        if (*this == other) {
-            return BigInt(0);
+        BigInt negated = other;
+        if (!(negated.digits_.size() == 1 && negated.digits_[0] == 0)) {
+            negated.is_negative_ = !negated.is_negative_;
         }
-
-        BigInt res;
-        res.digits_.clear();
-        res.is_negative_ = false;
-
-        // 确定被减数和减数（确保被减数绝对值 >= 减数绝对值）
-        const BigInt* minuend = this;  // 被减数
-        const BigInt* subtrahend = &other; // 减数
-        if (abs_less(other)) {
-            minuend = &other;
-            subtrahend = this;
-            res.is_negative_ = true; // 结果为负
-        }
-
-        // 绝对值相减（大减小）
-        uint32_t borrow = 0; // 借位
-        for (size_t i = 0; i < minuend->digits_.size(); ++i) {
-            // 取当前位（减数不足补0）
-            uint32_t a = minuend->digits_[i];
-            uint32_t b = (i < subtrahend->digits_.size()) ? subtrahend->digits_[i] : 0;
-            // 处理借位：当前位不够减，向前借1（变成10+当前位）
-            a -= borrow;
-            borrow = 0;
-            if (a < b) {
-                a += 10;
-                borrow = 1;
-            }
-            uint32_t diff = a - b;
-            res.digits_.push_back(static_cast<uint8_t>(diff));
-        }
-
-        res.trim_leading_zeros();
-        return res;
+        return *this + negated;
     }
 
     BigInt& operator-=(const BigInt& other) {
@@ -369,10 +363,9 @@ public:
             return BigInt(0);
         }
 
-        BigInt res;
+        // 传入绝对值计算, 再设置符号
+        BigInt res = karatsuba_mul(this->abs(), other.abs());
         res.is_negative_ = is_negative_ ^ other.is_negative_;
-        // 传入绝对值计算
-        res = karatsuba_mul(this->abs(), other.abs());
         res.trim_leading_zeros();
         return res;
     }
@@ -493,6 +486,35 @@ public:
         return result;
     }
 
+    // 由有符号64位整数构造(含INT64_MIN)
+    static BigInt from_int64(const int64_t val) {
+        const bool negative = val < 0;
+        const auto magnitude = negative
+            ? 0ULL - static_cast<unsigned long long>(val)
+            : static_cast<unsigned long long>(val);
+        BigInt res(static_cast<size_t>(magnitude));
+        res.is_negative_ = negative and magnitude != 0;
+        return res;
+    }
+
+    // 在int64范围内时写入out并返回true, 否则返回false(不抛异常)
+    [[nodiscard]] bool to_int64(int64_t& out) const {
+        // 不超过19位的十进制数必然小于ULLONG_MAX, 累加不会溢出
+        if (digits_.empty() or digits_.size() > 19) return false;
+        unsigned long long magnitude = 0;
+        for (auto it = digits_.rbegin(); it != digits_.rend(); ++it) {
+            magnitude = magnitude * 10 + *it;
+        }
+        const unsigned long long limit = is_negative_
+            ? 9223372036854775808ULL
+            : 9223372036854775807ULL;
+        if (magnitude > limit) return false;
+        out = is_negative_
+            ? static_cast<int64_t>(0ULL - magnitude)
+            : static_cast<int64_t>(magnitude);
+        return true;
+    }
+
     [[nodiscard]] unsigned long long to_unsigned_long_long() const {
         // 检查是否为负数
         if (is_negative_) {
@@ -61,6 +61,35 @@ public:
         normalize();
     }
 
+    // 由int64尾数和十进制指数构造：在机器整数上去掉末尾零，不经过BigInt除法
+    static Decimal from_int64(int64_t mantissa, int exponent) {
+        Decimal res;
+        if (mantissa == 0) return res;
+        while (mantissa % 10 == 0) {
+            mantissa /= 10;
+            exponent += 1;
+        }
+        res.mantissa_ = BigInt::from_int64(mantissa);
+        res.exponent_ = exponent;
+        return res;
+    }
+
+    // 由尾数和十进制指数构造：末尾零在十进制串上去掉，避免逐次BigInt取模
+    static Decimal from_parts(const BigInt& mantissa, int exponent) {
+        Decimal res;
+        if (mantissa == BigInt(0)) return res;
+        std::string digits = mantissa.to_string();
+        const size_t kept = digits.find_last_not_of('0') + 1;
+        exponent += static_cast<int>(digits.size() - kept);
+        digits.resize(kept);
+        res.mantissa_ = BigInt(digits);
+        res.exponent_ = exponent;
+        return res;
+    }
+
+    [[nodiscard]] const BigInt& mantissa() const { return mantissa_; }
+    [[nodiscard]] int exponent() const { return exponent_; }
+
     // 修复：整数构造函数（原逻辑没问题，但补充注释）
     template <typename T, typename = std::enable_if_t<std::is_integral_v<T>>>
     explicit Decimal(T val) : mantissa_(BigInt(static_cast<size_t>(std::abs(val)))), exponent_(0) {
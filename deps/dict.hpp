@@ -1,5 +1,6 @@
 #pragma once
 #include "bigint.hpp"
+#include <algorithm>
 #include <vector>
 #include <memory>
 #include <sstream>
@@ -29,15 +30,21 @@ public:
     std::vector<std::shared_ptr<Node>> buckets_;  // 桶数组（链表头指针）
     size_t elem_count_ = 0;                       // 元素总数
     const float load_factor_ = 0.7f;              // 负载因子（const 不可修改）
+    size_t version_ = 0;                          // 结构修改计数(增删键/扩容), 供迭代器检测并发修改
 
     /**
      * @brief 从 BigInt 键生成桶索引（基于 BigInt 的字符串哈希）
      * 保证相同 BigInt 键始终映射到相同索引
      */
     [[nodiscard]] size_t getBucketIndex(const BigInt& key) const {
+        return getBucketIndex(key, buckets_.size());
+    }
+
+    // 按指定桶数计算索引(扩容时须使用新桶数)
+    [[nodiscard]] static size_t getBucketIndex(const BigInt& key, const size_t bucket_count) {
         std::string key_str = key.to_string();
         size_t hash = std::hash<std::string>()(key_str);
-        return hash & (buckets_.size() - 1);  // 位运算取模，要求桶大小为 2 的幂
+        return hash & (bucket_count - 1);  // 位运算取模，要求桶大小为 2 的幂
     }
 
     /**
@@ -54,7 +61,7 @@ public:
             while (current != nullptr) {
                 std::shared_ptr<Node> next_node = current->next;
                 // 基于当前节点的 BigInt 键重新计算新索引
-                size_t new_idx = getBucketIndex(current->key);
+                size_t new_idx = getBucketIndex(current->key, new_size);
                 // 头插法插入新桶
                 current->next = new_buckets[new_idx];
                 new_buckets[new_idx] = current;
@@ -63,6 +70,17 @@ public:
         }
 
         buckets_.swap(new_buckets);
+        ++version_;
+    }
+
+    /**
+     * @brief 预留容量：保证插入 n 个元素前不再扩容
+     */
+    void reserve(const size_t n) {
+        if (buckets_.empty()) buckets_.resize(16, nullptr);
+        while (static_cast<float>(n) >= buckets_.size() * load_factor_) {
+            resize();
+        }
     }
 
     // ========================= 构造与析构 =========================
@@ -91,17 +109,11 @@ public:
     // 深拷贝构造：逐节点拷贝键值对
     Dict(const Dict& other)
         : load_factor_(other.load_factor_) {  // const 成员只能初始化，不能赋值
-        auto all_kv = other.to_vector();
-        size_t init_size = 16;
-        while (init_size < (all_kv.size() / load_factor_)) {
-            init_size *= 2;
-        }
-        buckets_.resize(init_size, nullptr);
-
-        for (const auto& [key, val] : all_kv) {
+        buckets_.resize(16, nullptr);
+        reserve(other.elem_count_);
+        other.for_each([this](const BigInt& key, const VT& val) {
             insert(key, val);
-        }
-        elem_count_ = other.elem_count_;
+        });
     }
 
     // 移动构造：转移资源所有权
@@ -122,17 +134,12 @@ public:
         elem_count_ = 0;
 
         // 重新初始化桶并插入数据
-        auto all_kv = other.to_vector();
-        size_t init_size = 16;
-        while (init_size < (all_kv.size() / load_factor_)) {
-            init_size *= 2;
-        }
-        buckets_.resize(init_size, nullptr);
-
-        for (const auto& [key, val] : all_kv) {
+        buckets_.resize(16, nullptr);
+        reserve(other.elem_count_);
+        other.for_each([this](const BigInt& key, const VT& val) {
             insert(key, val);
-        }
-        elem_count_ = all_kv.size();
+        });
+        ++version_;
 
         return *this;
     }
@@ -152,6 +159,8 @@ public:
         // 置空原对象
         other.elem_count_ = 0;
         other.buckets_.clear();
+        ++version_;
+        ++other.version_;
 
         return *this;
     }
@@ -194,10 +203,42 @@ public:
         new_node->next = buckets_[bucket_idx];
         buckets_[bucket_idx] = new_node;
         elem_count_++;
+        ++version_;
 
         return old_val;
     }
 
+    /**
+     * @brief 删除 BigInt 键对应的节点
+     * @return 是否找到并删除
+     */
+    bool erase(const BigInt& key) {
+        if (buckets_.empty()) {
+            return false;
+        }
+
+        std::shared_ptr<Node>* link = &buckets_[getBucketIndex(key)];
+        while (*link != nullptr) {
+            if ((*link)->key == key) {
+                *link = (*link)->next;
+                elem_count_--;
+                ++version_;
+                return true;
+            }
+            link = &(*link)->next;
+        }
+        return false;
+    }
+
+    /**
+     * @brief 清空所有元素，保留桶数组
+     */
+    void clear() {
+        std::fill(buckets_.begin(), buckets_.end(), nullptr);
+        elem_count_ = 0;
+        ++version_;
+    }
+
     /**
      * @brief 查找 BigInt 键对应的节点
      * @return 找到返回节点指针，否则返回 nullptr
@@ -251,6 +292,40 @@ public:
         return ss.str();
     }
 
+    /**
+     * @brief 按桶顺序遍历所有键值对（不复制）
+     */
+    template <typename F>
+    void for_each(F&& f) const {
+        for (const auto& bucket_head : buckets_) {
+            for (auto current = bucket_head; current != nullptr; current = current->next) {
+                f(current->key, current->value);
+            }
+        }
+    }
+
+    /**
+     * @brief 原地游标：返回第 bucket 个桶中第 pos 个节点(不存在时顺延到后续桶)并前移游标，遍历结束返回 nullptr
+     * 顺序与 for_each 一致；调用方通过 version() 确认两次调用之间没有结构修改
+     */
+    const Node* cursor_next(size_t& bucket, size_t& pos) const {
+        for (; bucket < buckets_.size(); ++bucket, pos = 0) {
+            const Node* current = buckets_[bucket].get();
+            for (size_t k = 0; current != nullptr and k < pos; ++k) {
+                current = current->next.get();
+            }
+            if (current != nullptr) {
+                ++pos;
+                return current;
+            }
+        }
+        return nullptr;
+    }
+
+    [[nodiscard]] size_t version() const {
+        return version_;
+    }
+
     /**
      * @brief 转换为 BigInt 键值对 vector
      */
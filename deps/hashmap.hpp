@@ -10,6 +10,7 @@
 #include <iostream>
 #include <vector>
 #include <string>
+#include <string_view>
 #include <memory>
 #include <sstream>
 #include <utility>
@@ -17,7 +18,7 @@
 namespace dep {
 
 // 字符串哈希函数（FNV-1a算法）
-inline size_t hash_string(const std::string& key) {
+inline size_t hash_string(const std::string_view key) {
     constexpr size_t FNV_OFFSET = 14695981039346656037ULL;
     constexpr size_t FNV_PRIME = 1099511628211ULL;
     size_t hash = FNV_OFFSET;
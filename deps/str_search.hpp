@@ -0,0 +1,262 @@
+/**
+ * @file str_search.hpp
+ * @brief 子串查找（SIMD首尾字节过滤 + Two-Way回退）
+ *
+ * @author azhz1107cat
+ * @date 2026-10-18
+ */
+
+#pragma once
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace dep {
+
+namespace detail {
+
+// Two-Way算法的临界分解, 返回临界位置并写出周期
+inline size_t critical_factorization(std::string_view needle, size_t& period) {
+    const auto n = reinterpret_cast<const unsigned char*>(needle.data());
+    const size_t len = needle.size();
+
+    // 正序字典序的最大后缀
+    size_t max_suffix = SIZE_MAX, j = 0, k = 1, p = 1;
+    while (j + k < len) {
+        const auto a = n[j + k];
+        const auto b = n[max_suffix + k];
+        if (a < b) {
+            j += k; k = 1; p = j - max_suffix;
+        } else if (a == b) {
+            if (k != p) ++k;
+            else { j += p; k = 1; }
+        } else {
+            max_suffix = j++; k = p = 1;
+        }
+    }
+    period = p;
+
+    // 逆序字典序的最大后缀
+    size_t max_suffix_rev = SIZE_MAX;
+    j = 0; k = p = 1;
+    while (j + k < len) {
+        const auto a = n[j + k];
+        const auto b = n[max_suffix_rev + k];
+        if (b < a) {
+            j += k; k = 1; p = j - max_suffix_rev;
+        } else if (a == b) {
+            if (k != p) ++k;
+            else { j += p; k = 1; }
+        } else {
+            max_suffix_rev = j++; k = p = 1;
+        }
+    }
+
+    if (max_suffix_rev + 1 < max_suffix + 1) return max_suffix + 1;
+    period = p;
+    return max_suffix_rev + 1;
+}
+
+// Two-Way子串查找: 最坏线性时间, 常数额外空间
+inline size_t two_way_find(std::string_view hay, std::string_view needle, size_t from) {
+    const auto h = reinterpret_cast<const unsigned char*>(hay.data());
+    const auto n = reinterpret_cast<const unsigned char*>(needle.data());
+    const size_t hay_len = hay.size();
+    const size_t len = needle.size();
+    if (len > hay_len or from > hay_len - len) return std::string_view::npos;
+
+    size_t period;
+    const size_t suffix = critical_factorization(needle, period);
+
+    size_t j = from;
+    if (std::memcmp(n, n + period, suffix) == 0) {
+        // 周期性模式串, 记住已匹配的前缀长度
+        size_t memory = 0;
+        while (j <= hay_len - len) {
+            size_t i = suffix > memory ? suffix : memory;
+            while (i < len and n[i] == h[i + j]) ++i;
+            if (len <= i) {
+                i = suffix - 1;
+                while (memory < i + 1 and n[i] == h[i + j]) --i;
+                if (i + 1 < memory + 1) return j;
+                j += period;
+                memory = len - period;
+            } else {
+                j += i - suffix + 1;
+                memory = 0;
+            }
+        }
+    } else {
+        period = (suffix > len - suffix ? suffix : len - suffix) + 1;
+        while (j <= hay_len - len) {
+            size_t i = suffix;
+            while (i < len and n[i] == h[i + j]) ++i;
+            if (len <= i) {
+                i = suffix - 1;
+                while (i != SIZE_MAX and n[i] == h[i + j]) --i;
+                if (i == SIZE_MAX) return j;
+                j += period;
+            } else {
+                j += i - suffix + 1;
+            }
+        }
+    }
+    return std::string_view::npos;
+}
+
+}  // namespace detail
+
+// 在hay中从from开始查找needle, 未找到返回npos
+// 先用SIMD比较模式串首尾字节批量筛选候选位置; 候选验证失败过多时
+// (病态输入) 转入Two-Way, 保证最坏情况仍为线性
+inline size_t str_find(std::string_view hay, std::string_view needle, size_t from = 0) {
+    const size_t hay_len = hay.size();
+    const size_t len = needle.size();
+    if (len == 0) return from <= hay_len ? from : std::string_view::npos;
+    if (len > hay_len or from > hay_len - len) return std::string_view::npos;
+
+    if (len == 1) {
+        const void* p = std::memchr(hay.data() + from, needle[0], hay_len - from);
+        return p == nullptr ? std::string_view::npos
+                            : static_cast<const char*>(p) - hay.data();
+    }
+
+    size_t i = from;
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#if defined(__AVX2__)
+    constexpr size_t width = 32;
+    const __m256i first = _mm256_set1_epi8(needle[0]);
+    const __m256i last = _mm256_set1_epi8(needle[len - 1]);
+#else
+    constexpr size_t width = 16;
+    const __m128i first = _mm_set1_epi8(needle[0]);
+    const __m128i last = _mm_set1_epi8(needle[len - 1]);
+#endif
+    size_t fails = 0;
+    for (; i + len - 1 + width <= hay_len; i += width) {
+#if defined(__AVX2__)
+        const auto block_first = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(hay.data() + i));
+        const auto block_last = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(hay.data() + i + len - 1));
+        auto mask = static_cast<unsigned>(_mm256_movemask_epi8(_mm256_and_si256(
+            _mm256_cmpeq_epi8(first, block_first), _mm256_cmpeq_epi8(last, block_last)
+        )));
+#else
+        const auto block_first = _mm_loadu_si128(reinterpret_cast<const __m128i*>(hay.data() + i));
+        const auto block_last = _mm_loadu_si128(reinterpret_cast<const __m128i*>(hay.data() + i + len - 1));
+        auto mask = static_cast<unsigned>(_mm_movemask_epi8(_mm_and_si128(
+            _mm_cmpeq_epi8(first, block_first), _mm_cmpeq_epi8(last, block_last)
+        )));
+#endif
+        while (mask != 0) {
+            const size_t pos = i + __builtin_ctz(mask);
+            if (std::memcmp(hay.data() + pos + 1, needle.data() + 1, len - 2) == 0) return pos;
+            mask &= mask - 1;
+            ++fails;
+        }
+        // 验证开销超过扫描量的常数倍, 说明输入病态
+        if (fails > 64 and fails * len > 8 * (i - from + width)) {
+            return detail::two_way_find(hay, needle, i + width);
+        }
+    }
+#endif
+
+    return detail::two_way_find(hay, needle, i);
+}
+
+// 查找hay中第一个等于a、b、c之一的字节, 未找到返回npos
+// 每次用SIMD比较一整块, 适合在长文本中定位分隔符这类少数特殊字节
+inline size_t find_any_of3(std::string_view hay, const char a, const char b, const char c) {
+    const size_t hay_len = hay.size();
+    size_t i = 0;
+
+#if defined(__AVX2__)
+    const __m256i va = _mm256_set1_epi8(a);
+    const __m256i vb = _mm256_set1_epi8(b);
+    const __m256i vc = _mm256_set1_epi8(c);
+    for (; i + 32 <= hay_len; i += 32) {
+        const auto block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(hay.data() + i));
+        const auto mask = static_cast<unsigned>(_mm256_movemask_epi8(_mm256_or_si256(
+            _mm256_or_si256(_mm256_cmpeq_epi8(va, block), _mm256_cmpeq_epi8(vb, block)),
+            _mm256_cmpeq_epi8(vc, block)
+        )));
+        if (mask != 0) return i + __builtin_ctz(mask);
+    }
+#elif defined(__SSE2__)
+    const __m128i va = _mm_set1_epi8(a);
+    const __m128i vb = _mm_set1_epi8(b);
+    const __m128i vc = _mm_set1_epi8(c);
+    for (; i + 16 <= hay_len; i += 16) {
+        const auto block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(hay.data() + i));
+        const auto mask = static_cast<unsigned>(_mm_movemask_epi8(_mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi8(va, block), _mm_cmpeq_epi8(vb, block)),
+            _mm_cmpeq_epi8(vc, block)
+        )));
+        if (mask != 0) return i + __builtin_ctz(mask);
+    }
+#endif
+
+    for (; i < hay_len; ++i) {
+        const char ch = hay[i];
+        if (ch == a or ch == b or ch == c) return i;
+    }
+    return std::string_view::npos;
+}
+
+// 查找hay中第一个等于a、b之一或小于0x20(控制字符)的字节, 未找到返回npos
+// 用于JSON字符串扫描: 控制字节以无符号最小值判断(min(x, 0x1F) == x即x <= 0x1F)
+inline size_t find_any_of2_or_ctrl(std::string_view hay, const char a, const char b) {
+    const size_t hay_len = hay.size();
+    size_t i = 0;
+
+#if defined(__AVX2__)
+    const __m256i va = _mm256_set1_epi8(a);
+    const __m256i vb = _mm256_set1_epi8(b);
+    const __m256i vctrl = _mm256_set1_epi8(0x1F);
+    for (; i + 32 <= hay_len; i += 32) {
+        const auto block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(hay.data() + i));
+        const auto mask = static_cast<unsigned>(_mm256_movemask_epi8(_mm256_or_si256(
+            _mm256_or_si256(_mm256_cmpeq_epi8(va, block), _mm256_cmpeq_epi8(vb, block)),
+            _mm256_cmpeq_epi8(_mm256_min_epu8(block, vctrl), block)
+        )));
+        if (mask != 0) return i + __builtin_ctz(mask);
+    }
+#elif defined(__SSE2__)
+    const __m128i va = _mm_set1_epi8(a);
+    const __m128i vb = _mm_set1_epi8(b);
+    const __m128i vctrl = _mm_set1_epi8(0x1F);
+    for (; i + 16 <= hay_len; i += 16) {
+        const auto block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(hay.data() + i));
+        const auto mask = static_cast<unsigned>(_mm_movemask_epi8(_mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi8(va, block), _mm_cmpeq_epi8(vb, block)),
+            _mm_cmpeq_epi8(_mm_min_epu8(block, vctrl), block)
+        )));
+        if (mask != 0) return i + __builtin_ctz(mask);
+    }
+#endif
+
+    for (; i < hay_len; ++i) {
+        const char ch = hay[i];
+        if (ch == a or ch == b or static_cast<unsigned char>(ch) < 0x20) return i;
+    }
+    return std::string_view::npos;
+}
+
+// 统计needle在hay中不重叠出现的次数
+inline size_t str_count(std::string_view hay, std::string_view needle) {
+    if (needle.empty()) return hay.size() + 1;
+    size_t count = 0;
+    for (size_t pos = str_find(hay, needle); pos != std::string_view::npos;
+         pos = str_find(hay, needle, pos + needle.size())) {
+        ++count;
+    }
+    return count;
+}
+
+}  // namespace dep
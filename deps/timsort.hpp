@@ -0,0 +1,146 @@
+/**
+ * @file timsort.hpp
+ * @brief 稳定排序（Timsort: 自然run识别 + 二分插入补齐minrun + 栈式归并）
+ *
+ * 比较器可能抛异常(如通过VM调用__lt__), 此时序列内容未定义, 调用方应在副本上排序
+ *
+ * @author azhz1107cat
+ * @date 2026-10-18
+ */
+
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace dep {
+
+namespace detail {
+
+// 长度小于该值的序列直接二分插入排序
+constexpr size_t timsort_min_merge = 32;
+
+// 计算minrun: 使 n/minrun 接近且不大于2的幂
+inline size_t timsort_min_run(size_t n) {
+    size_t r = 0;
+    while (n >= timsort_min_merge) {
+        r |= n & 1;
+        n >>= 1;
+    }
+    return n + r;
+}
+
+// 对[lo, hi)做二分插入排序, 其中[lo, start)已有序
+template <typename T, typename Less>
+void binary_insertion_sort(std::vector<T>& a, size_t lo, size_t hi, size_t start, Less& less) {
+    if (start == lo) ++start;
+    for (; start < hi; ++start) {
+        T pivot = std::move(a[start]);
+        size_t left = lo, right = start;
+        // 找到第一个大于pivot的位置, 相等元素插在其后以保持稳定
+        while (left < right) {
+            const size_t mid = left + (right - left) / 2;
+            if (less(pivot, a[mid])) right = mid;
+            else left = mid + 1;
+        }
+        for (size_t k = start; k > left; --k) a[k] = std::move(a[k - 1]);
+        a[left] = std::move(pivot);
+    }
+}
+
+// 从lo开始识别run并返回其长度; 严格降序的run原地反转为升序
+template <typename T, typename Less>
+size_t count_run_and_make_ascending(std::vector<T>& a, size_t lo, size_t hi, Less& less) {
+    size_t run_hi = lo + 1;
+    if (run_hi == hi) return 1;
+    if (less(a[run_hi], a[lo])) {
+        ++run_hi;
+        while (run_hi < hi and less(a[run_hi], a[run_hi - 1])) ++run_hi;
+        std::reverse(a.begin() + static_cast<std::ptrdiff_t>(lo), a.begin() + static_cast<std::ptrdiff_t>(run_hi));
+    } else {
+        ++run_hi;
+        while (run_hi < hi and !less(a[run_hi], a[run_hi - 1])) ++run_hi;
+    }
+    return run_hi - lo;
+}
+
+// 合并相邻有序段[lo, mid)与[mid, hi), 只复制左段到缓冲区
+template <typename T, typename Less>
+void merge_runs(std::vector<T>& a, size_t lo, size_t mid, size_t hi, std::vector<T>& buf, Less& less) {
+    // 跳过左段中已经就位的前缀, 以及右段中已经就位的后缀
+    while (lo < mid and !less(a[mid], a[lo])) ++lo;
+    while (mid < hi and !less(a[hi - 1], a[mid - 1])) --hi;
+    if (lo == mid or mid == hi) return;
+
+    buf.clear();
+    for (size_t k = lo; k < mid; ++k) buf.push_back(std::move(a[k]));
+
+    size_t i = 0, j = mid, dest = lo;
+    const size_t left_len = buf.size();
+    while (i < left_len and j < hi) {
+        if (less(a[j], buf[i])) a[dest++] = std::move(a[j++]);
+        else a[dest++] = std::move(buf[i++]);
+    }
+    while (i < left_len) a[dest++] = std::move(buf[i++]);
+}
+
+} // namespace detail
+
+// 稳定排序: less(a, b) 为 true 表示 a 应排在 b 之前
+template <typename T, typename Less>
+void timsort(std::vector<T>& a, Less less) {
+    const size_t n = a.size();
+    if (n < 2) return;
+    if (n < detail::timsort_min_merge) {
+        const size_t run = detail::count_run_and_make_ascending(a, 0, n, less);
+        detail::binary_insertion_sort(a, 0, n, run, less);
+        return;
+    }
+
+    const size_t min_run = detail::timsort_min_run(n);
+    std::vector<std::pair<size_t, size_t>> runs; // (起点, 长度)
+    std::vector<T> buf;
+
+    auto merge_at = [&](const size_t i) {
+        auto& [base1, len1] = runs[i];
+        const auto [base2, len2] = runs[i + 1];
+        detail::merge_runs(a, base1, base2, base2 + len2, buf, less);
+        len1 += len2;
+        runs.erase(runs.begin() + static_cast<std::ptrdiff_t>(i) + 1);
+    };
+
+    // 维持栈不变式: len[i-2] > len[i-1] + len[i] 且 len[i-1] > len[i]
+    auto merge_collapse = [&] {
+        while (runs.size() > 1) {
+            size_t n_top = runs.size() - 2;
+            if ((n_top > 0 and runs[n_top - 1].second <= runs[n_top].second + runs[n_top + 1].second)
+                or (n_top > 1 and runs[n_top - 2].second <= runs[n_top - 1].second + runs[n_top].second)) {
+                if (runs[n_top - 1].second < runs[n_top + 1].second) --n_top;
+            } else if (runs[n_top].second > runs[n_top + 1].second) {
+                break;
+            }
+            merge_at(n_top);
+        }
+    };
+
+    size_t lo = 0;
+    while (lo < n) {
+        size_t run_len = detail::count_run_and_make_ascending(a, lo, n, less);
+        if (run_len < min_run) {
+            const size_t forced = std::min(min_run, n - lo);
+            detail::binary_insertion_sort(a, lo, lo + forced, lo + run_len, less);
+            run_len = forced;
+        }
+        runs.emplace_back(lo, run_len);
+        merge_collapse();
+        lo += run_len;
+    }
+    while (runs.size() > 1) {
+        size_t n_top = runs.size() - 2;
+        if (n_top > 0 and runs[n_top - 1].second < runs[n_top + 1].second) --n_top;
+        merge_at(n_top);
+    }
+}
+
+} // namespace dep
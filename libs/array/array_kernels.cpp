@@ -0,0 +1,545 @@
+#include "include/array_kernels.hpp"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+// x86上同一份循环模板编译两次: 默认目标(x86-64基线即SSE2)与AVX2+FMA, 运行时按CPU选择;
+// 浮点求和/点积/最值的归约顺序不能由编译器改写, 用内建函数手写256位版本
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define KIZ_ARRAY_X86 1
+#include <immintrin.h>
+#define KIZ_TARGET_AVX2 __attribute__((target("avx2,fma")))
+#endif
+
+#if defined(__GNUC__)
+#define KIZ_ALWAYS_INLINE inline __attribute__((always_inline))
+#else
+#define KIZ_ALWAYS_INLINE inline
+#endif
+
+namespace array_lib::kernels {
+
+bool has_avx2() {
+#ifdef KIZ_ARRAY_X86
+    static const bool supported = __builtin_cpu_supports("avx2") and __builtin_cpu_supports("fma");
+    return supported;
+#else
+    return false;
+#endif
+}
+
+// -------------------------- 逐元素运算 --------------------------
+// 整数运算经无符号类型进行, 溢出时回绕而不是未定义行为
+template <typename T>
+KIZ_ALWAYS_INLINE T wrap(const std::make_unsigned_t<T> v) { return static_cast<T>(v); }
+
+struct Add {
+    template <typename T> KIZ_ALWAYS_INLINE T operator()(const T x, const T y) const {
+        if constexpr (std::is_integral_v<T>) {
+            using U = std::make_unsigned_t<T>;
+            return wrap<T>(static_cast<U>(static_cast<U>(x) + static_cast<U>(y)));
+        } else {
+            return x + y;
+        }
+    }
+};
+
+struct Sub {
+    template <typename T> KIZ_ALWAYS_INLINE T operator()(const T x, const T y) const {
+        if constexpr (std::is_integral_v<T>) {
+            using U = std::make_unsigned_t<T>;
+            return wrap<T>(static_cast<U>(static_cast<U>(x) - static_cast<U>(y)));
+        } else {
+            return x - y;
+        }
+    }
+};
+
+struct Mul {
+    template <typename T> KIZ_ALWAYS_INLINE T operator()(const T x, const T y) const {
+        if constexpr (std::is_integral_v<T>) {
+            using U = std::make_unsigned_t<T>;
+            return wrap<T>(static_cast<U>(static_cast<U>(x) * static_cast<U>(y)));
+        } else {
+            return x * y;
+        }
+    }
+};
+
+struct Div {
+    KIZ_ALWAYS_INLINE double operator()(const double x, const double y) const { return x / y; }
+};
+
+// 取模结果与除数同号(与Int.__mod__一致)
+struct Mod {
+    template <typename T> KIZ_ALWAYS_INLINE T operator()(const T x, const T y) const {
+        if constexpr (std::is_floating_point_v<T>) {
+            T r = std::fmod(x, y);
+            if (r != 0 and (r < 0) != (y < 0)) r += y;
+            return r;
+        } else if constexpr (std::is_signed_v<T>) {
+            if (y == -1) return 0;  // 避免 INT64_MIN % -1 溢出
+            T r = x % y;
+            if (r != 0 and (r < 0) != (y < 0)) r += y;
+            return r;
+        } else {
+            return static_cast<T>(x % y);
+        }
+    }
+};
+
+// 整数幂按平方求幂并回绕, 指数非负由调用方保证
+struct Pow {
+    template <typename T> KIZ_ALWAYS_INLINE T operator()(const T x, const T y) const {
+        if constexpr (std::is_floating_point_v<T>) {
+            return std::pow(x, y);
+        } else {
+            using U = std::make_unsigned_t<T>;
+            U base = static_cast<U>(x);
+            U res = 1;
+            for (auto e = static_cast<uint64_t>(y); e != 0; e >>= 1) {
+                if (e & 1) res = static_cast<U>(res * base);
+                base = static_cast<U>(base * base);
+            }
+            return wrap<T>(res);
+        }
+    }
+};
+
+// 三种广播方式各写一个循环, 保证最内层循环没有分支, 可以向量化
+template <typename T, typename R, typename F>
+KIZ_ALWAYS_INLINE void map2(const T* __restrict a, const size_t a_step, const T* __restrict b, const size_t b_step,
+                            R* __restrict out, const size_t n, F f) {
+    if (a_step != 0 and b_step != 0) {
+        for (size_t i = 0; i < n; ++i) out[i] = static_cast<R>(f(a[i], b[i]));
+    } else if (a_step != 0) {
+        const T y = *b;
+        for (size_t i = 0; i < n; ++i) out[i] = static_cast<R>(f(a[i], y));
+    } else if (b_step != 0) {
+        const T x = *a;
+        for (size_t i = 0; i < n; ++i) out[i] = static_cast<R>(f(x, b[i]));
+    } else {
+        std::fill_n(out, n, static_cast<R>(f(*a, *b)));
+    }
+}
+
+template <typename T>
+KIZ_ALWAYS_INLINE void binary_impl(const BinOp op, const T* a, const size_t a_step, const T* b, const size_t b_step,
+                                   T* out, const size_t n) {
+    switch (op) {
+    case BinOp::Add: map2(a, a_step, b, b_step, out, n, Add{}); return;
+    case BinOp::Sub: map2(a, a_step, b, b_step, out, n, Sub{}); return;
+    case BinOp::Mul: map2(a, a_step, b, b_step, out, n, Mul{}); return;
+    case BinOp::Div:
+        if constexpr (std::is_floating_point_v<T>) map2(a, a_step, b, b_step, out, n, Div{});
+        return;
+    case BinOp::Mod: map2(a, a_step, b, b_step, out, n, Mod{}); return;
+    case BinOp::Pow: map2(a, a_step, b, b_step, out, n, Pow{}); return;
+    }
+}
+
+template <typename T>
+KIZ_ALWAYS_INLINE void compare_impl(const CmpOp op, const T* a, const size_t a_step, const T* b, const size_t b_step,
+                                    uint8_t* out, const size_t n) {
+    switch (op) {
+    case CmpOp::Eq: map2(a, a_step, b, b_step, out, n, [](const T x, const T y) { return x == y; }); return;
+    case CmpOp::Ne: map2(a, a_step, b, b_step, out, n, [](const T x, const T y) { return x != y; }); return;
+    case CmpOp::Lt: map2(a, a_step, b, b_step, out, n, [](const T x, const T y) { return x < y; }); return;
+    case CmpOp::Le: map2(a, a_step, b, b_step, out, n, [](const T x, const T y) { return x <= y; }); return;
+    case CmpOp::Gt: map2(a, a_step, b, b_step, out, n, [](const T x, const T y) { return x > y; }); return;
+    case CmpOp::Ge: map2(a, a_step, b, b_step, out, n, [](const T x, const T y) { return x >= y; }); return;
+    }
+}
+
+#ifdef KIZ_ARRAY_X86
+template <typename T>
+KIZ_TARGET_AVX2 void binary_avx2(const BinOp op, const T* a, const size_t a_step, const T* b, const size_t b_step,
+                                 T* out, const size_t n) {
+    binary_impl(op, a, a_step, b, b_step, out, n);
+}
+
+template <typename T>
+KIZ_TARGET_AVX2 void compare_avx2(const CmpOp op, const T* a, const size_t a_step, const T* b, const size_t b_step,
+                                  uint8_t* out, const size_t n) {
+    compare_impl(op, a, a_step, b, b_step, out, n);
+}
+#endif
+
+template <typename T>
+static void binary_dispatch(const BinOp op, const T* a, const size_t a_step, const T* b, const size_t b_step,
+                            T* out, const size_t n) {
+#ifdef KIZ_ARRAY_X86
+    if (has_avx2()) return binary_avx2(op, a, a_step, b, b_step, out, n);
+#endif
+    binary_impl(op, a, a_step, b, b_step, out, n);
+}
+
+template <typename T>
+static void compare_dispatch(const CmpOp op, const T* a, const size_t a_step, const T* b, const size_t b_step,
+                             uint8_t* out, const size_t n) {
+#ifdef KIZ_ARRAY_X86
+    if (has_avx2()) return compare_avx2(op, a, a_step, b, b_step, out, n);
+#endif
+    compare_impl(op, a, a_step, b, b_step, out, n);
+}
+
+void binary(const BinOp op, const int64_t* a, const size_t a_step, const int64_t* b, const size_t b_step,
+            int64_t* out, const size_t n) {
+    binary_dispatch(op, a, a_step, b, b_step, out, n);
+}
+
+void binary(const BinOp op, const double* a, const size_t a_step, const double* b, const size_t b_step,
+            double* out, const size_t n) {
+    binary_dispatch(op, a, a_step, b, b_step, out, n);
+}
+
+void binary(const BinOp op, const uint8_t* a, const size_t a_step, const uint8_t* b, const size_t b_step,
+            uint8_t* out, const size_t n) {
+    binary_dispatch(op, a, a_step, b, b_step, out, n);
+}
+
+void compare(const CmpOp op, const int64_t* a, const size_t a_step, const int64_t* b, const size_t b_step,
+             uint8_t* out, const size_t n) {
+    compare_dispatch(op, a, a_step, b, b_step, out, n);
+}
+
+void compare(const CmpOp op, const double* a, const size_t a_step, const double* b, const size_t b_step,
+             uint8_t* out, const size_t n) {
+    compare_dispatch(op, a, a_step, b, b_step, out, n);
+}
+
+void compare(const CmpOp op, const uint8_t* a, const size_t a_step, const uint8_t* b, const size_t b_step,
+             uint8_t* out, const size_t n) {
+    compare_dispatch(op, a, a_step, b, b_step, out, n);
+}
+
+// -------------------------- 归约 --------------------------
+// 基线版本用多个独立累加器, 编译器可将其打包为SSE2指令
+
+static double sum_base(const double* a, const size_t n) {
+    double s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        s0 += a[i];
+        s1 += a[i + 1];
+        s2 += a[i + 2];
+        s3 += a[i + 3];
+    }
+    double s = (s0 + s1) + (s2 + s3);
+    for (; i < n; ++i) s += a[i];
+    return s;
+}
+
+static double dot_base(const double* a, const double* b, const size_t n) {
+    double s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        s0 += a[i] * b[i];
+        s1 += a[i + 1] * b[i + 1];
+        s2 += a[i + 2] * b[i + 2];
+        s3 += a[i + 3] * b[i + 3];
+    }
+    double s = (s0 + s1) + (s2 + s3);
+    for (; i < n; ++i) s += a[i] * b[i];
+    return s;
+}
+
+static double extreme_base(const double* a, const size_t n, const bool want_max) {
+    double m = a[0];
+    for (size_t i = 0; i < n; ++i) {
+        const double x = a[i];
+        if (std::isnan(x)) return x;
+        m = want_max ? (x > m ? x : m) : (x < m ? x : m);
+    }
+    return m;
+}
+
+#ifdef KIZ_ARRAY_X86
+KIZ_TARGET_AVX2 static double hsum(const __m256d v) {
+    const __m128d lo = _mm256_castpd256_pd128(v);
+    const __m128d hi = _mm256_extractf128_pd(v, 1);
+    const __m128d s = _mm_add_pd(lo, hi);
+    return _mm_cvtsd_f64(_mm_add_sd(s, _mm_unpackhi_pd(s, s)));
+}
+
+// 4个256位累加器, 每轮处理16个元素, 隐藏加法延迟
+KIZ_TARGET_AVX2 static double sum_avx2(const double* a, const size_t n) {
+    __m256d s0 = _mm256_setzero_pd(), s1 = _mm256_setzero_pd();
+    __m256d s2 = _mm256_setzero_pd(), s3 = _mm256_setzero_pd();
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        s0 = _mm256_add_pd(s0, _mm256_loadu_pd(a + i));
+        s1 = _mm256_add_pd(s1, _mm256_loadu_pd(a + i + 4));
+        s2 = _mm256_add_pd(s2, _mm256_loadu_pd(a + i + 8));
+        s3 = _mm256_add_pd(s3, _mm256_loadu_pd(a + i + 12));
+    }
+    __m256d s = _mm256_add_pd(_mm256_add_pd(s0, s1), _mm256_add_pd(s2, s3));
+    for (; i + 4 <= n; i += 4) s = _mm256_add_pd(s, _mm256_loadu_pd(a + i));
+    double res = hsum(s);
+    for (; i < n; ++i) res += a[i];
+    return res;
+}
+
+KIZ_TARGET_AVX2 static double dot_avx2(const double* a, const double* b, const size_t n) {
+    __m256d s0 = _mm256_setzero_pd(), s1 = _mm256_setzero_pd();
+    __m256d s2 = _mm256_setzero_pd(), s3 = _mm256_setzero_pd();
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        s0 = _mm256_fmadd_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i), s0);
+        s1 = _mm256_fmadd_pd(_mm256_loadu_pd(a + i + 4), _mm256_loadu_pd(b + i + 4), s1);
+        s2 = _mm256_fmadd_pd(_mm256_loadu_pd(a + i + 8), _mm256_loadu_pd(b + i + 8), s2);
+        s3 = _mm256_fmadd_pd(_mm256_loadu_pd(a + i + 12), _mm256_loadu_pd(b + i + 12), s3);
+    }
+    __m256d s = _mm256_add_pd(_mm256_add_pd(s0, s1), _mm256_add_pd(s2, s3));
+    for (; i + 4 <= n; i += 4) s = _mm256_fmadd_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i), s);
+    double res = hsum(s);
+    for (; i < n; ++i) res += a[i] * b[i];
+    return res;
+}
+
+// vmaxpd/vminpd遇到nan时结果取决于操作数顺序, 因此另行累计无序比较的掩码
+KIZ_TARGET_AVX2 static double extreme_avx2(const double* a, const size_t n, const bool want_max) {
+    size_t i = 0;
+    double res = a[0];
+    if (n >= 4) {
+        __m256d m = _mm256_loadu_pd(a);
+        __m256d nan = _mm256_cmp_pd(m, m, _CMP_UNORD_Q);
+        for (i = 4; i + 4 <= n; i += 4) {
+            const __m256d x = _mm256_loadu_pd(a + i);
+            m = want_max ? _mm256_max_pd(m, x) : _mm256_min_pd(m, x);
+            nan = _mm256_or_pd(nan, _mm256_cmp_pd(x, x, _CMP_UNORD_Q));
+        }
+        if (_mm256_movemask_pd(nan) != 0) return std::numeric_limits<double>::quiet_NaN();
+        alignas(32) double lanes[4];
+        _mm256_store_pd(lanes, m);
+        res = lanes[0];
+        for (const double lane : lanes) res = want_max ? std::max(res, lane) : std::min(res, lane);
+    }
+    for (; i < n; ++i) {
+        if (std::isnan(a[i])) return a[i];
+        res = want_max ? std::max(res, a[i]) : std::min(res, a[i]);
+    }
+    return res;
+}
+#endif
+
+double sum(const double* a, const size_t n) {
+#ifdef KIZ_ARRAY_X86
+    if (has_avx2()) return sum_avx2(a, n);
+#endif
+    return sum_base(a, n);
+}
+
+double dot(const double* a, const double* b, const size_t n) {
+#ifdef KIZ_ARRAY_X86
+    if (has_avx2()) return dot_avx2(a, b, n);
+#endif
+    return dot_base(a, b, n);
+}
+
+double extreme(const double* a, const size_t n, const bool want_max) {
+#ifdef KIZ_ARRAY_X86
+    if (has_avx2()) return extreme_avx2(a, n, want_max);
+#endif
+    return extreme_base(a, n, want_max);
+}
+
+// 每个值拆成低32位(无符号)与高32位(有符号)分别累加, 两个累加都不会溢出且都可以向量化
+template <typename T>
+KIZ_ALWAYS_INLINE void sum_i64_impl(const T* a, const size_t n, int64_t& high, uint64_t& low) {
+    high = 0;
+    low = 0;
+    for (size_t i = 0; i < n; ++i) {
+        low += static_cast<uint32_t>(a[i]);
+        high += a[i] >> 32;
+    }
+}
+
+template <typename T>
+KIZ_ALWAYS_INLINE T extreme_int_impl(const T* a, const size_t n, const bool want_max) {
+    T m = a[0];
+    if (want_max) for (size_t i = 0; i < n; ++i) m = a[i] > m ? a[i] : m;
+    else for (size_t i = 0; i < n; ++i) m = a[i] < m ? a[i] : m;
+    return m;
+}
+
+KIZ_ALWAYS_INLINE uint64_t sum_u8_impl(const uint8_t* a, const size_t n) {
+    uint64_t s = 0;
+    for (size_t i = 0; i < n; ++i) s += a[i];
+    return s;
+}
+
+KIZ_ALWAYS_INLINE size_t count_nonzero_impl(const uint8_t* a, const size_t n) {
+    size_t c = 0;
+    for (size_t i = 0; i < n; ++i) c += a[i] != 0;
+    return c;
+}
+
+#ifdef KIZ_ARRAY_X86
+KIZ_TARGET_AVX2 static void sum_i64_avx2(const int64_t* a, const size_t n, int64_t& high, uint64_t& low) {
+    sum_i64_impl(a, n, high, low);
+}
+template <typename T>
+KIZ_TARGET_AVX2 T extreme_int_avx2(const T* a, const size_t n, const bool want_max) {
+    return extreme_int_impl(a, n, want_max);
+}
+KIZ_TARGET_AVX2 static uint64_t sum_u8_avx2(const uint8_t* a, const size_t n) { return sum_u8_impl(a, n); }
+KIZ_TARGET_AVX2 static size_t count_nonzero_avx2(const uint8_t* a, const size_t n) { return count_nonzero_impl(a, n); }
+#endif
+
+void sum(const int64_t* a, const size_t n, int64_t& high, uint64_t& low) {
+#ifdef KIZ_ARRAY_X86
+    if (has_avx2()) return sum_i64_avx2(a, n, high, low);
+#endif
+    sum_i64_impl(a, n, high, low);
+}
+
+uint64_t sum(const uint8_t* a, const size_t n) {
+#ifdef KIZ_ARRAY_X86
+    if (has_avx2()) return sum_u8_avx2(a, n);
+#endif
+    return sum_u8_impl(a, n);
+}
+
+int64_t extreme(const int64_t* a, const size_t n, const bool want_max) {
+#ifdef KIZ_ARRAY_X86
+    if (has_avx2()) return extreme_int_avx2(a, n, want_max);
+#endif
+    return extreme_int_impl(a, n, want_max);
+}
+
+uint8_t extreme(const uint8_t* a, const size_t n, const bool want_max) {
+#ifdef KIZ_ARRAY_X86
+    if (has_avx2()) return extreme_int_avx2(a, n, want_max);
+#endif
+    return extreme_int_impl(a, n, want_max);
+}
+
+size_t count_nonzero(const uint8_t* a, const size_t n) {
+#ifdef KIZ_ARRAY_X86
+    if (has_avx2()) return count_nonzero_avx2(a, n);
+#endif
+    return count_nonzero_impl(a, n);
+}
+
+// -------------------------- 排序 --------------------------
+// 元素少时直接比较排序, 否则把键映射为保序的无符号整数后做LSD基数排序
+constexpr size_t radix_threshold = 256;
+
+static uint64_t key_of(const int64_t v) {
+    return static_cast<uint64_t>(v) ^ (uint64_t{1} << 63);
+}
+
+static int64_t i64_of(const uint64_t k) {
+    return static_cast<int64_t>(k ^ (uint64_t{1} << 63));
+}
+
+// 负数按位取反, 非负数置符号位; nan统一映射为最大键
+static uint64_t key_of(const double v) {
+    if (std::isnan(v)) return UINT64_MAX;
+    const auto bits = std::bit_cast<uint64_t>(v);
+    return (bits >> 63) ? ~bits : bits | (uint64_t{1} << 63);
+}
+
+static double f64_of(const uint64_t k) {
+    return std::bit_cast<double>((k >> 63) ? k ^ (uint64_t{1} << 63) : ~k);
+}
+
+// 每趟8位, 8趟的直方图一次统计完; 某一趟所有键的该字节都相同时跳过; idx非空时同步移动下标(稳定)
+static void radix_sort(std::vector<uint64_t>& keys, std::vector<int64_t>* idx) {
+    const size_t n = keys.size();
+    std::vector<size_t> counts(8 * 256, 0);
+    for (const uint64_t k : keys) {
+        for (size_t p = 0; p < 8; ++p) ++counts[p * 256 + ((k >> (8 * p)) & 0xff)];
+    }
+
+    std::vector<uint64_t> tmp_keys(n);
+    std::vector<int64_t> tmp_idx(idx != nullptr ? n : 0);
+    for (size_t p = 0; p < 8; ++p) {
+        size_t* count = &counts[p * 256];
+        const unsigned shift = 8 * p;
+        if (count[(keys[0] >> shift) & 0xff] == n) continue;
+
+        size_t offset = 0;
+        for (size_t d = 0; d < 256; ++d) {
+            const size_t c = count[d];
+            count[d] = offset;
+            offset += c;
+        }
+        for (size_t i = 0; i < n; ++i) {
+            const size_t pos = count[(keys[i] >> shift) & 0xff]++;
+            tmp_keys[pos] = keys[i];
+            if (idx != nullptr) tmp_idx[pos] = (*idx)[i];
+        }
+        keys.swap(tmp_keys);
+        if (idx != nullptr) idx->swap(tmp_idx);
+    }
+}
+
+template <typename T>
+static void sort_by_key(T* a, const size_t n, T (*from_key)(uint64_t)) {
+    std::vector<uint64_t> keys(n);
+    for (size_t i = 0; i < n; ++i) keys[i] = key_of(a[i]);
+    if (n < radix_threshold) std::sort(keys.begin(), keys.end());
+    else radix_sort(keys, nullptr);
+    for (size_t i = 0; i < n; ++i) a[i] = from_key(keys[i]);
+}
+
+template <typename T>
+static void argsort_by_key(const T* a, const size_t n, int64_t* out) {
+    std::vector<uint64_t> keys(n);
+    for (size_t i = 0; i < n; ++i) keys[i] = key_of(a[i]);
+    std::vector<int64_t> idx(n);
+    for (size_t i = 0; i < n; ++i) idx[i] = static_cast<int64_t>(i);
+    if (n < radix_threshold) {
+        std::stable_sort(idx.begin(), idx.end(), [&](const int64_t x, const int64_t y) { return keys[x] < keys[y]; });
+    } else {
+        radix_sort(keys, &idx);
+    }
+    std::copy(idx.begin(), idx.end(), out);
+}
+
+void sort(int64_t* a, const size_t n) {
+    if (n < radix_threshold) std::sort(a, a + n);
+    else sort_by_key(a, n, i64_of);
+}
+
+void sort(double* a, const size_t n) {
+    sort_by_key(a, n, f64_of);
+}
+
+// u8只有256种取值, 直接计数
+void sort(uint8_t* a, const size_t n) {
+    size_t count[256] = {};
+    for (size_t i = 0; i < n; ++i) ++count[a[i]];
+    size_t pos = 0;
+    for (size_t v = 0; v < 256; ++v) {
+        std::fill_n(a + pos, count[v], static_cast<uint8_t>(v));
+        pos += count[v];
+    }
+}
+
+void argsort(const int64_t* a, const size_t n, int64_t* out) {
+    argsort_by_key(a, n, out);
+}
+
+void argsort(const double* a, const size_t n, int64_t* out) {
+    argsort_by_key(a, n, out);
+}
+
+void argsort(const uint8_t* a, const size_t n, int64_t* out) {
+    size_t offset[256] = {};
+    for (size_t i = 0; i < n; ++i) ++offset[a[i]];
+    size_t total = 0;
+    for (size_t& c : offset) {
+        const size_t v = c;
+        c = total;
+        total += v;
+    }
+    for (size_t i = 0; i < n; ++i) out[offset[a[i]]++] = static_cast<int64_t>(i);
+}
+
+}
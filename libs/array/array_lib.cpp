@@ -0,0 +1,1125 @@
+#include "include/array_lib.hpp"
+#include "include/array_kernels.hpp"
+#include <cstring>
+#include <fstream>
+#include <new>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "builtins/include/builtin_functions.hpp"
+#include "builtins/include/builtin_methods.hpp"
+
+namespace array_lib {
+
+using kernels::BinOp;
+using kernels::CmpOp;
+
+constexpr std::align_val_t buffer_align{64};
+
+// -------------------------- Buffer / Array --------------------------
+Buffer::Buffer(const size_t bytes)
+    : data_(static_cast<char*>(::operator new(bytes == 0 ? 1 : bytes, buffer_align))), bytes_(bytes), mapped_(false) {}
+
+Buffer::Buffer(char* mapped, const size_t bytes) : data_(mapped), bytes_(bytes), mapped_(true) {}
+
+Buffer::~Buffer() {
+#ifndef _WIN32
+    if (mapped_) {
+        munmap(data_, bytes_);
+        return;
+    }
+#endif
+    ::operator delete(data_, buffer_align);
+}
+
+Array::Array(const DType dtype, const size_t length)
+    : dtype(dtype), buffer(std::make_shared<Buffer>(length * elem_size(dtype))), length(length) {
+    attrs.insert("__parent__", based_array);
+}
+
+Array::Array(const DType dtype, std::shared_ptr<Buffer> buffer, const size_t offset, const size_t length)
+    : dtype(dtype), buffer(std::move(buffer)), offset(offset), length(length) {
+    attrs.insert("__parent__", based_array);
+}
+
+size_t elem_size(const DType dtype) {
+    switch (dtype) {
+    case DType::U8: return 1;
+    case DType::I64: return 8;
+    case DType::F64: return 8;
+    }
+    return 1;
+}
+
+const char* dtype_name(const DType dtype) {
+    switch (dtype) {
+    case DType::U8: return "u8";
+    case DType::I64: return "i64";
+    case DType::F64: return "f64";
+    }
+    return "?";
+}
+
+static void write_elem(const Array* arr, const size_t i, std::string& out) {
+    switch (arr->dtype) {
+    case DType::U8: out += std::to_string(arr->data<uint8_t>()[i]); return;
+    case DType::I64: out += std::to_string(arr->data<int64_t>()[i]); return;
+    case DType::F64: out += model::Float::to_string(arr->data<double>()[i]); return;
+    }
+}
+
+// 元素过多时只显示首尾各3个
+std::string Array::debug_string() const {
+    constexpr size_t edge = 3;
+    std::string out = "array([";
+    for (size_t i = 0; i < length; ++i) {
+        if (i != 0) out += ", ";
+        if (length > 1000 and i == edge) {
+            out += "..., ";
+            i = length - edge;
+        }
+        write_elem(this, i, out);
+    }
+    out += "], dtype=";
+    out += dtype_name(dtype);
+    out += ')';
+    return out;
+}
+
+// -------------------------- 参数与类型转换 --------------------------
+static Array* self_array(model::Object* self, const std::string& method) {
+    const auto arr = dynamic_cast<Array*>(self);
+    if (arr == nullptr) throw NativeFuncError("TypeError", "Array." + method + " must be called by Array object");
+    return arr;
+}
+
+static bool is_nil(const model::Object* obj) {
+    return obj->get_type() == model::Object::ObjectType::OT_Nil;
+}
+
+static model::Object* opt_arg(const model::List* args, const size_t pos) {
+    return args->val.size() > pos and !is_nil(args->val[pos]) ? args->val[pos] : nullptr;
+}
+
+bool parse_dtype(const model::Object* obj, DType& out) {
+    const auto name = dynamic_cast<const model::String*>(obj);
+    if (name == nullptr) return false;
+    const auto view = name->view();
+    if (view == "u8") out = DType::U8;
+    else if (view == "i64") out = DType::I64;
+    else if (view == "f64") out = DType::F64;
+    else return false;
+    return true;
+}
+
+// 省略或为Nil时返回false
+static bool dtype_arg(const model::List* args, const size_t pos, const std::string& func, DType& out) {
+    const auto obj = opt_arg(args, pos);
+    if (obj == nullptr) return false;
+    if (!parse_dtype(obj, out)) {
+        throw NativeFuncError("TypeError", func + "() dtype must be \"u8\", \"i64\" or \"f64\"");
+    }
+    return true;
+}
+
+static int64_t int64_of(const model::Object* obj, const std::string& func) {
+    const auto n = dynamic_cast<const model::Int*>(obj);
+    if (n == nullptr) throw NativeFuncError("TypeError", func + "() need an Int argument");
+    int64_t v;
+    if (!n->val.to_int64(v)) throw NativeFuncError("OverflowError", "Int too large to convert to i64");
+    return v;
+}
+
+static size_t size_arg(const model::List* args, const size_t pos, const std::string& func) {
+    if (args->val.size() <= pos) throw NativeFuncError("TypeError", func + "() missing size argument");
+    const int64_t n = int64_of(args->val[pos], func);
+    if (n < 0) throw NativeFuncError("ValueError", func + "() size must be non-negative");
+    return static_cast<size_t>(n);
+}
+
+static bool is_float_like(const model::Object* obj) {
+    const auto type = obj->get_type();
+    return type == model::Object::ObjectType::OT_Float or type == model::Object::ObjectType::OT_Decimal;
+}
+
+// 标量按目标类型存储: Int超出范围时报错, 浮点写入整数数组时向零取整
+template <typename T>
+T scalar_as(const model::Object* obj) {
+    if (const auto b = dynamic_cast<const model::Bool*>(obj)) return static_cast<T>(b->val);
+    if constexpr (std::is_floating_point_v<T>) {
+        double v;
+        if (!model::as_double(obj, v)) throw NativeFuncError("TypeError", "Array element must be Int, Decimal or Float");
+        return v;
+    } else {
+        int64_t v;
+        if (const auto n = dynamic_cast<const model::Int*>(obj)) {
+            if (!n->val.to_int64(v)) throw NativeFuncError("OverflowError", "Int " + n->val.to_string() + " out of bounds for i64");
+        } else {
+            double d;
+            if (!model::as_double(obj, d)) throw NativeFuncError("TypeError", "Array element must be Int, Decimal or Float");
+            if (!(d > -9.2233720368547758e18 and d < 9.2233720368547758e18)) {
+                throw NativeFuncError("ValueError", "cannot convert " + model::Float::to_string(d) + " to integer");
+            }
+            v = static_cast<int64_t>(d);
+        }
+        if constexpr (std::is_same_v<T, uint8_t>) {
+            if (v < 0 or v > 255) throw NativeFuncError("OverflowError", "Int " + std::to_string(v) + " out of bounds for u8");
+        }
+        return static_cast<T>(v);
+    }
+}
+
+template uint8_t scalar_as<uint8_t>(const model::Object*);
+template int64_t scalar_as<int64_t>(const model::Object*);
+template double scalar_as<double>(const model::Object*);
+
+static model::Object* box(const Array* arr, const size_t i) {
+    switch (arr->dtype) {
+    case DType::U8: return model::create_int(dep::BigInt::from_int64(arr->data<uint8_t>()[i]));
+    case DType::I64: return model::create_int(dep::BigInt::from_int64(arr->data<int64_t>()[i]));
+    case DType::F64: return model::create_float(arr->data<double>()[i]);
+    }
+    return model::load_nil();
+}
+
+// 类型间转换: 向上提升不会失败; astype降级时整数回绕, 浮点转整数向零取整(nan/inf报错)
+template <typename D, typename S>
+static void convert(const S* src, D* dst, const size_t n) {
+    if constexpr (std::is_floating_point_v<S> and !std::is_floating_point_v<D>) {
+        for (size_t i = 0; i < n; ++i) {
+            if (!(src[i] > -9.2233720368547758e18 and src[i] < 9.2233720368547758e18)) {
+                throw NativeFuncError("ValueError", "cannot convert " + model::Float::to_string(src[i]) + " to integer");
+            }
+            dst[i] = static_cast<D>(static_cast<int64_t>(src[i]));
+        }
+    } else {
+        for (size_t i = 0; i < n; ++i) dst[i] = static_cast<D>(src[i]);
+    }
+}
+
+template <typename D>
+static void convert_from(const Array* src, D* dst) {
+    switch (src->dtype) {
+    case DType::U8: convert(src->data<uint8_t>(), dst, src->length); return;
+    case DType::I64: convert(src->data<int64_t>(), dst, src->length); return;
+    case DType::F64: convert(src->data<double>(), dst, src->length); return;
+    }
+}
+
+// 先转换到新Buffer再包装为Array: 转换出错时不留下半成品对象
+// (Array析构会释放__parent__的引用, 不能直接delete临时的Array)
+static Elements convert_elements(const Array* src, const DType dtype) {
+    Elements out{dtype, std::make_shared<Buffer>(src->length * elem_size(dtype)), src->length};
+    if (src->dtype == dtype) {
+        std::memcpy(out.data<char>(), src->data<char>(), src->length * elem_size(dtype));
+        return out;
+    }
+    switch (dtype) {
+    case DType::U8: convert_from(src, out.data<uint8_t>()); break;
+    case DType::I64: convert_from(src, out.data<int64_t>()); break;
+    case DType::F64: convert_from(src, out.data<double>()); break;
+    }
+    return out;
+}
+
+Array* to_array(Elements elems) {
+    return new Array(elems.dtype, std::move(elems.buffer), 0, elems.length);
+}
+
+Array* astype_copy(const Array* src, const DType dtype) {
+    return to_array(convert_elements(src, dtype));
+}
+
+// -------------------------- 运算的操作数 --------------------------
+// Array或标量; 标量按弱类型参与提升: Int不改变数组类型, Float/Decimal使结果为f64
+struct Operand {
+    const Array* arr = nullptr;
+    const model::Object* scalar = nullptr;
+    DType dtype = DType::I64;
+};
+
+static bool operand_of(const model::Object* obj, Operand& out) {
+    if (const auto arr = dynamic_cast<const Array*>(obj)) {
+        out.arr = arr;
+        out.dtype = arr->dtype;
+        return true;
+    }
+    const auto type = obj->get_type();
+    if (type == model::Object::ObjectType::OT_Int or type == model::Object::ObjectType::OT_Bool) {
+        out.scalar = obj;
+        out.dtype = DType::U8;
+        return true;
+    }
+    if (is_float_like(obj)) {
+        out.scalar = obj;
+        out.dtype = DType::F64;
+        return true;
+    }
+    return false;
+}
+
+static Operand operand_arg(const model::List* args, const std::string& method) {
+    Operand op;
+    if (args->val.empty() or !operand_of(args->val[0], op)) {
+        throw NativeFuncError("TypeError", "Array." + method + " operand must be Array, Int, Decimal or Float");
+    }
+    return op;
+}
+
+// 结果类型与各操作数的步长(0为广播)
+struct Plan {
+    DType dtype;
+    size_t n;
+    size_t a_step;
+    size_t b_step;
+};
+
+static Plan plan_of(const Operand& a, const Operand& b) {
+    Plan plan{std::max(a.dtype, b.dtype), 0, 1, 1};
+    // 标量Int不提升数组类型
+    if (a.arr != nullptr and b.arr == nullptr and b.dtype != DType::F64) plan.dtype = a.dtype;
+    if (b.arr != nullptr and a.arr == nullptr and a.dtype != DType::F64) plan.dtype = b.dtype;
+
+    const size_t la = a.arr ? a.arr->length : 1;
+    const size_t lb = b.arr ? b.arr->length : 1;
+    if (a.arr == nullptr) plan.a_step = 0;
+    if (b.arr == nullptr) plan.b_step = 0;
+    if (la == lb) {
+        plan.n = la;
+    } else if (lb == 1) {
+        plan.n = la;
+        plan.b_step = 0;
+    } else if (la == 1) {
+        plan.n = lb;
+        plan.a_step = 0;
+    } else {
+        throw NativeFuncError("ValueError", "operands could not be broadcast together with lengths "
+            + std::to_string(la) + " and " + std::to_string(lb));
+    }
+    if (a.arr == nullptr) plan.a_step = 0;
+    if (b.arr == nullptr) plan.b_step = 0;
+    return plan;
+}
+
+// 取操作数按类型T的数据: 同类型数组直接返回其内存, 否则转换到tmp
+template <typename T>
+static const T* operand_data(const Operand& op, std::vector<T>& tmp) {
+    if (op.arr == nullptr) {
+        tmp.assign(1, scalar_as<T>(op.scalar));
+        return tmp.data();
+    }
+    if constexpr (std::is_same_v<T, uint8_t>) {
+        if (op.arr->dtype == DType::U8) return op.arr->data<uint8_t>();
+    } else if constexpr (std::is_same_v<T, int64_t>) {
+        if (op.arr->dtype == DType::I64) return op.arr->data<int64_t>();
+    } else {
+        if (op.arr->dtype == DType::F64) return op.arr->data<double>();
+    }
+    tmp.resize(op.arr->length);
+    convert_from(op.arr, tmp.data());
+    return tmp.data();
+}
+
+template <typename T>
+static Array* run_binary(const BinOp op, const Operand& a, const Operand& b, const Plan& plan) {
+    std::vector<T> ta, tb;
+    const T* pa = operand_data(a, ta);
+    const T* pb = operand_data(b, tb);
+    if constexpr (std::is_integral_v<T>) {
+        const size_t nb = plan.b_step != 0 ? plan.n : 1;
+        if (op == BinOp::Mod and std::find(pb, pb + nb, T{0}) != pb + nb) {
+            throw NativeFuncError("ZeroDivisionError", "integer modulo by zero");
+        }
+        if constexpr (std::is_signed_v<T>) {
+            if (op == BinOp::Pow and std::any_of(pb, pb + nb, [](const T e) { return e < 0; })) {
+                throw NativeFuncError("ValueError", "integers to negative integer powers are not allowed");
+            }
+        }
+    }
+    const auto out = new Array(plan.dtype, plan.n);
+    kernels::binary(op, pa, plan.a_step, pb, plan.b_step, out->data<T>(), plan.n);
+    return out;
+}
+
+static model::Object* binary_op(model::Object* self, const model::List* args, const BinOp op, const std::string& method) {
+    Operand a;
+    operand_of(self_array(self, method), a);
+    const Operand b = operand_arg(args, method);
+    Plan plan = plan_of(a, b);
+    // 除法总是得到f64
+    if (op == BinOp::Div) plan.dtype = DType::F64;
+
+    switch (plan.dtype) {
+    case DType::U8: return run_binary<uint8_t>(op, a, b, plan);
+    case DType::I64: return run_binary<int64_t>(op, a, b, plan);
+    case DType::F64: return run_binary<double>(op, a, b, plan);
+    }
+    return model::load_nil();
+}
+
+template <typename T>
+static Array* run_compare(const CmpOp op, const Operand& a, const Operand& b, const Plan& plan) {
+    std::vector<T> ta, tb;
+    const T* pa = operand_data(a, ta);
+    const T* pb = operand_data(b, tb);
+    const auto out = new Array(DType::U8, plan.n);
+    kernels::compare(op, pa, plan.a_step, pb, plan.b_step, out->data<uint8_t>(), plan.n);
+    return out;
+}
+
+static model::Object* compare_op(model::Object* self, const model::List* args, const CmpOp op, const std::string& method) {
+    Operand a;
+    operand_of(self_array(self, method), a);
+    Operand b;
+    if (args->val.empty() or !operand_of(args->val[0], b)) {
+        // 与非数值比较: 相等判断直接得出结果, 大小比较报错
+        if (op == CmpOp::Eq) return model::load_bool(false);
+        if (op == CmpOp::Ne) return model::load_bool(true);
+        throw NativeFuncError("TypeError", "Array." + method + " operand must be Array, Int, Decimal or Float");
+    }
+    const Plan plan = plan_of(a, b);
+    switch (plan.dtype) {
+    case DType::U8: return run_compare<uint8_t>(op, a, b, plan);
+    case DType::I64: return run_compare<int64_t>(op, a, b, plan);
+    case DType::F64: return run_compare<double>(op, a, b, plan);
+    }
+    return model::load_nil();
+}
+
+// -------------------------- 模块 --------------------------
+void register_array_type() {
+    static bool registered = false;
+    if (registered) return;
+    registered = true;
+
+    based_array->attrs.insert("__parent__", model::based_obj);
+    based_array->attrs.insert("__add__", new model::NativeFunction(array_add));
+    based_array->attrs.insert("__sub__", new model::NativeFunction(array_sub));
+    based_array->attrs.insert("__mul__", new model::NativeFunction(array_mul));
+    based_array->attrs.insert("__div__", new model::NativeFunction(array_div));
+    based_array->attrs.insert("__mod__", new model::NativeFunction(array_mod));
+    based_array->attrs.insert("__pow__", new model::NativeFunction(array_pow));
+    based_array->attrs.insert("__neg__", new model::NativeFunction(array_neg));
+    based_array->attrs.insert("__eq__", new model::NativeFunction(array_eq));
+    based_array->attrs.insert("__lt__", new model::NativeFunction(array_lt));
+    based_array->attrs.insert("__gt__", new model::NativeFunction(array_gt));
+    based_array->attrs.insert("__bool__", new model::NativeFunction(array_bool));
+    based_array->attrs.insert("__getitem__", new model::NativeFunction(array_getitem));
+    based_array->attrs.insert("__setitem__", new model::NativeFunction(array_setitem));
+    based_array->attrs.insert("__next__", new model::NativeFunction(array_next));
+    based_array->attrs.insert("__str__", new model::NativeFunction(array_str));
+    based_array->attrs.insert("eq", new model::NativeFunction(array_eq));
+    based_array->attrs.insert("ne", new model::NativeFunction(array_ne));
+    based_array->attrs.insert("lt", new model::NativeFunction(array_lt));
+    based_array->attrs.insert("le", new model::NativeFunction(array_le));
+    based_array->attrs.insert("gt", new model::NativeFunction(array_gt));
+    based_array->attrs.insert("ge", new model::NativeFunction(array_ge));
+    based_array->attrs.insert("len", new model::NativeFunction(array_len));
+    based_array->attrs.insert("dtype", new model::NativeFunction(array_dtype));
+    based_array->attrs.insert("sum", new model::NativeFunction(array_sum));
+    based_array->attrs.insert("min", new model::NativeFunction(array_min));
+    based_array->attrs.insert("max", new model::NativeFunction(array_max));
+    based_array->attrs.insert("mean", new model::NativeFunction(array_mean));
+    based_array->attrs.insert("dot", new model::NativeFunction(array_dot));
+    based_array->attrs.insert("any", new model::NativeFunction(array_any));
+    based_array->attrs.insert("all", new model::NativeFunction(array_all));
+    based_array->attrs.insert("sort", new model::NativeFunction(array_sort));
+    based_array->attrs.insert("argsort", new model::NativeFunction(array_argsort));
+    based_array->attrs.insert("astype", new model::NativeFunction(array_astype));
+    based_array->attrs.insert("copy", new model::NativeFunction(array_copy));
+    based_array->attrs.insert("to_list", new model::NativeFunction(array_to_list));
+    based_array->attrs.insert("tobytes", new model::NativeFunction(array_tobytes));
+    based_array->attrs.insert("tofile", new model::NativeFunction(array_tofile));
+}
+
+model::Object* init_module(model::Object* self, const model::List* args) {
+    auto mod = new model::Module("array");
+    register_array_type();
+
+    mod->attrs.insert("Array", based_array);
+    mod->attrs.insert("array", new model::NativeFunction(array));
+    mod->attrs.insert("zeros", new model::NativeFunction(zeros));
+    mod->attrs.insert("full", new model::NativeFunction(full));
+    mod->attrs.insert("arange", new model::NativeFunction(arange));
+    mod->attrs.insert("frombytes", new model::NativeFunction(frombytes));
+    mod->attrs.insert("fromfile", new model::NativeFunction(fromfile));
+
+    return mod;
+}
+
+// -------------------------- 构造 --------------------------
+// 未指定dtype时: 元素全为Int(或Bool)则为i64, 含Float/Decimal则为f64
+static DType infer_dtype(const std::vector<model::Object*>& elems) {
+    DType dtype = DType::I64;
+    for (const auto elem : elems) {
+        if (is_float_like(elem)) dtype = DType::F64;
+        else if (elem->get_type() != model::Object::ObjectType::OT_Int and elem->get_type() != model::Object::ObjectType::OT_Bool) {
+            throw NativeFuncError("TypeError", "Array element must be Int, Decimal or Float, not " + elem->debug_string());
+        }
+    }
+    return dtype;
+}
+
+template <typename T>
+static void store_all(const std::vector<model::Object*>& elems, T* dst) {
+    for (size_t i = 0; i < elems.size(); ++i) dst[i] = scalar_as<T>(elems[i]);
+}
+
+static Elements from_objects(const std::vector<model::Object*>& objs, const bool has_dtype, DType dtype) {
+    if (!has_dtype) dtype = infer_dtype(objs);
+    Elements out{dtype, std::make_shared<Buffer>(objs.size() * elem_size(dtype)), objs.size()};
+    switch (dtype) {
+    case DType::U8: store_all(objs, out.data<uint8_t>()); break;
+    case DType::I64: store_all(objs, out.data<int64_t>()); break;
+    case DType::F64: store_all(objs, out.data<double>()); break;
+    }
+    return out;
+}
+
+static Elements from_ints(const std::vector<int64_t>& ints, const DType dtype) {
+    Elements out{dtype, std::make_shared<Buffer>(ints.size() * elem_size(dtype)), ints.size()};
+    switch (dtype) {
+    case DType::I64:
+        std::memcpy(out.data<int64_t>(), ints.data(), ints.size() * sizeof(int64_t));
+        break;
+    case DType::F64:
+        convert(ints.data(), out.data<double>(), ints.size());
+        break;
+    case DType::U8:
+        for (size_t i = 0; i < ints.size(); ++i) {
+            if (ints[i] < 0 or ints[i] > 255) {
+                throw NativeFuncError("OverflowError", "Int " + std::to_string(ints[i]) + " out of bounds for u8");
+            }
+            out.data<uint8_t>()[i] = static_cast<uint8_t>(ints[i]);
+        }
+        break;
+    }
+    return out;
+}
+
+// src为Array、List或任意可迭代对象; 拆箱的Int/Dec列表直接读取底层数组
+Elements to_elements(model::Object* src, const bool has_dtype, const DType dtype) {
+    if (const auto src_arr = dynamic_cast<Array*>(src)) {
+        return convert_elements(src_arr, has_dtype ? dtype : src_arr->dtype);
+    }
+
+    if (const auto list = dynamic_cast<model::List*>(src)) {
+        if (list->strategy() == model::List::Strategy::Int) return from_ints(list->ints(), has_dtype ? dtype : DType::I64);
+        if (list->strategy() == model::List::Strategy::Decimal and (!has_dtype or dtype == DType::F64)) {
+            const auto& decimals = list->decimals();
+            Elements out{DType::F64, std::make_shared<Buffer>(decimals.size() * sizeof(double)), decimals.size()};
+            for (size_t i = 0; i < decimals.size(); ++i) out.data<double>()[i] = model::decimal_to_double(decimals[i]);
+            return out;
+        }
+        if (list->strategy() == model::List::Strategy::Generic) return from_objects(list->val, has_dtype, dtype);
+    }
+
+    std::vector<model::Object*> objs;
+    const auto it = model::make_iterator(src);
+    while (const auto elem = model::iterator_step(it)) objs.push_back(elem);
+    return from_objects(objs, has_dtype, dtype);
+}
+
+// array.array(src, dtype=Nil)
+model::Object* array(model::Object* self, const model::List* args) {
+    if (args->val.empty()) throw NativeFuncError("TypeError", "array() need 1 arg");
+    DType dtype;
+    const bool has_dtype = dtype_arg(args, 1, "array", dtype);
+    return to_array(to_elements(args->val[0], has_dtype, dtype));
+}
+
+// array.zeros(n, dtype="f64")
+model::Object* zeros(model::Object* self, const model::List* args) {
+    const size_t n = size_arg(args, 0, "zeros");
+    DType dtype = DType::F64;
+    dtype_arg(args, 1, "zeros", dtype);
+    const auto out = new Array(dtype, n);
+    std::memset(out->data<char>(), 0, n * elem_size(dtype));
+    return out;
+}
+
+template <typename T>
+static Array* filled(const DType dtype, const size_t n, const model::Object* value) {
+    const T v = scalar_as<T>(value);
+    const auto out = new Array(dtype, n);
+    std::fill_n(out->data<T>(), n, v);
+    return out;
+}
+
+// array.full(n, value, dtype=Nil): 未指定dtype时由value决定
+model::Object* full(model::Object* self, const model::List* args) {
+    const size_t n = size_arg(args, 0, "full");
+    if (args->val.size() < 2) throw NativeFuncError("TypeError", "full() need 2 args");
+    const auto value = args->val[1];
+    DType dtype;
+    if (!dtype_arg(args, 2, "full", dtype)) dtype = infer_dtype({value});
+    switch (dtype) {
+    case DType::U8: return filled<uint8_t>(dtype, n, value);
+    case DType::I64: return filled<int64_t>(dtype, n, value);
+    case DType::F64: return filled<double>(dtype, n, value);
+    }
+    return model::load_nil();
+}
+
+// array.arange(stop) / array.arange(start, stop, step=1, dtype=Nil)
+model::Object* arange(model::Object* self, const model::List* args) {
+    if (args->val.empty()) throw NativeFuncError("TypeError", "arange() need at least 1 arg");
+    model::Object* start_obj = args->val[0];
+    model::Object* stop_obj = opt_arg(args, 1);
+    const auto step_obj = opt_arg(args, 2);
+    if (stop_obj == nullptr) {
+        stop_obj = start_obj;
+        start_obj = nullptr;
+    }
+    DType dtype;
+    if (!dtype_arg(args, 3, "arange", dtype)) {
+        const bool any_float = is_float_like(stop_obj) or (start_obj and is_float_like(start_obj))
+            or (step_obj and is_float_like(step_obj));
+        dtype = any_float ? DType::F64 : DType::I64;
+    }
+
+    if (dtype == DType::F64) {
+        const double start = start_obj ? scalar_as<double>(start_obj) : 0;
+        const double stop = scalar_as<double>(stop_obj);
+        const double step = step_obj ? scalar_as<double>(step_obj) : 1;
+        if (step == 0 or std::isnan(step)) throw NativeFuncError("ValueError", "arange() step cannot be zero");
+        const double count = std::ceil((stop - start) / step);
+        if (count > 1e12) throw NativeFuncError("ValueError", "arange() result is too large");
+        const size_t n = count > 0 ? static_cast<size_t>(count) : 0;
+        const auto out = new Array(DType::F64, n);
+        for (size_t i = 0; i < n; ++i) out->data<double>()[i] = start + static_cast<double>(i) * step;
+        return out;
+    }
+
+    const int64_t start = start_obj ? int64_of(start_obj, "arange") : 0;
+    const int64_t stop = int64_of(stop_obj, "arange");
+    const int64_t step = step_obj ? int64_of(step_obj, "arange") : 1;
+    if (step == 0) throw NativeFuncError("ValueError", "arange() step cannot be zero");
+    const __int128 span = static_cast<__int128>(stop) - start;
+    const __int128 count = step > 0 ? (span + step - 1) / step : (span + step + 1) / step;
+    const size_t n = count > 0 ? static_cast<size_t>(count) : 0;
+    std::vector<int64_t> values(n);
+    for (size_t i = 0; i < n; ++i) values[i] = start + static_cast<int64_t>(i) * step;
+    return to_array(from_ints(values, dtype));
+}
+
+static void check_byte_size(const size_t bytes, const DType dtype, const std::string& func) {
+    if (bytes % elem_size(dtype) != 0) {
+        throw NativeFuncError("ValueError", func + "() size " + std::to_string(bytes)
+            + " is not a multiple of the " + dtype_name(dtype) + " element size");
+    }
+}
+
+// array.frombytes(s, dtype="u8"): 按本机字节序解释Str的字节
+model::Object* frombytes(model::Object* self, const model::List* args) {
+    const auto src = args->val.empty() ? nullptr : dynamic_cast<model::String*>(args->val[0]);
+    if (src == nullptr) throw NativeFuncError("TypeError", "frombytes() need a Str argument");
+    DType dtype = DType::U8;
+    dtype_arg(args, 1, "frombytes", dtype);
+    const auto bytes = src->view();
+    check_byte_size(bytes.size(), dtype, "frombytes");
+    const auto out = new Array(dtype, bytes.size() / elem_size(dtype));
+    std::memcpy(out->data<char>(), bytes.data(), bytes.size());
+    return out;
+}
+
+// array.fromfile(path, dtype="u8"): POSIX下私有映射文件, 元素直接位于映射内存中, 不复制;
+// 写入数组只修改本进程的副本
+model::Object* fromfile(model::Object* self, const model::List* args) {
+    const auto path_obj = args->val.empty() ? nullptr : dynamic_cast<model::String*>(args->val[0]);
+    if (path_obj == nullptr) throw NativeFuncError("TypeError", "fromfile() need a Str path");
+    const std::string path = path_obj->val();
+    DType dtype = DType::U8;
+    dtype_arg(args, 1, "fromfile", dtype);
+
+#ifndef _WIN32
+    const int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) throw NativeFuncError("PathError", "Failed to open file: " + path);
+    struct stat st{};
+    if (fstat(fd, &st) != 0) {
+        close(fd);
+        throw NativeFuncError("PathError", "Failed to stat file: " + path);
+    }
+    const auto bytes = static_cast<size_t>(st.st_size);
+    if (bytes % elem_size(dtype) != 0) close(fd);
+    check_byte_size(bytes, dtype, "fromfile");
+    if (bytes == 0) {
+        close(fd);
+        return new Array(dtype, 0);
+    }
+    void* mapped = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapped == MAP_FAILED) throw NativeFuncError("PathError", "Failed to map file: " + path);
+    return new Array(dtype, std::make_shared<Buffer>(static_cast<char*>(mapped), bytes), 0, bytes / elem_size(dtype));
+#else
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file.is_open()) throw NativeFuncError("PathError", "Failed to open file: " + path);
+    const auto bytes = static_cast<size_t>(file.tellg());
+    check_byte_size(bytes, dtype, "fromfile");
+    file.seekg(0);
+    const auto out = new Array(dtype, bytes / elem_size(dtype));
+    file.read(out->data<char>(), static_cast<std::streamsize>(bytes));
+    return out;
+#endif
+}
+
+// -------------------------- 运算 --------------------------
+model::Object* array_add(model::Object* self, const model::List* args) {
+    return binary_op(self, args, BinOp::Add, "__add__");
+}
+
+model::Object* array_sub(model::Object* self, const model::List* args) {
+    return binary_op(self, args, BinOp::Sub, "__sub__");
+}
+
+model::Object* array_mul(model::Object* self, const model::List* args) {
+    return binary_op(self, args, BinOp::Mul, "__mul__");
+}
+
+model::Object* array_div(model::Object* self, const model::List* args) {
+    return binary_op(self, args, BinOp::Div, "__div__");
+}
+
+model::Object* array_mod(model::Object* self, const model::List* args) {
+    return binary_op(self, args, BinOp::Mod, "__mod__");
+}
+
+model::Object* array_pow(model::Object* self, const model::List* args) {
+    return binary_op(self, args, BinOp::Pow, "__pow__");
+}
+
+// 整数取反按补码回绕; f64乘以-1以保留-0.0与nan
+model::Object* array_neg(model::Object* self, const model::List* args) {
+    const auto arr = self_array(self, "__neg__");
+    const auto out = new Array(arr->dtype, arr->length);
+    switch (arr->dtype) {
+    case DType::U8: {
+        constexpr uint8_t zero = 0;
+        kernels::binary(BinOp::Sub, &zero, 0, arr->data<uint8_t>(), 1, out->data<uint8_t>(), arr->length);
+        break;
+    }
+    case DType::I64: {
+        constexpr int64_t zero = 0;
+        kernels::binary(BinOp::Sub, &zero, 0, arr->data<int64_t>(), 1, out->data<int64_t>(), arr->length);
+        break;
+    }
+    case DType::F64: {
+        constexpr double minus_one = -1;
+        kernels::binary(BinOp::Mul, arr->data<double>(), 1, &minus_one, 0, out->data<double>(), arr->length);
+        break;
+    }
+    }
+    return out;
+}
+
+model::Object* array_eq(model::Object* self, const model::List* args) {
+    return compare_op(self, args, CmpOp::Eq, "eq");
+}
+
+model::Object* array_ne(model::Object* self, const model::List* args) {
+    return compare_op(self, args, CmpOp::Ne, "ne");
+}
+
+model::Object* array_lt(model::Object* self, const model::List* args) {
+    return compare_op(self, args, CmpOp::Lt, "lt");
+}
+
+model::Object* array_le(model::Object* self, const model::List* args) {
+    return compare_op(self, args, CmpOp::Le, "le");
+}
+
+model::Object* array_gt(model::Object* self, const model::List* args) {
+    return compare_op(self, args, CmpOp::Gt, "gt");
+}
+
+model::Object* array_ge(model::Object* self, const model::List* args) {
+    return compare_op(self, args, CmpOp::Ge, "ge");
+}
+
+static size_t count_truthy(const Array* arr);
+
+// 多个元素的真值不明确, 需改用any()/all()
+model::Object* array_bool(model::Object* self, const model::List* args) {
+    const auto arr = self_array(self, "__bool__");
+    if (arr->length == 0) return model::load_bool(false);
+    if (arr->length > 1) {
+        throw NativeFuncError("ValueError", "the truth value of an Array with more than one element is ambiguous, use any() or all()");
+    }
+    return model::load_bool(count_truthy(arr) != 0);
+}
+
+// -------------------------- 下标 --------------------------
+static size_t index_of(const Array* arr, const model::Object* idx_obj) {
+    const auto idx = dynamic_cast<const model::Int*>(idx_obj);
+    if (idx == nullptr) throw NativeFuncError("TypeError", "Array index must be Int, Slice or Array");
+    int64_t index;
+    if (!idx->val.to_int64(index)) index = INT64_MIN;
+    if (index < 0) index += static_cast<int64_t>(arr->length);
+    if (index < 0 or static_cast<size_t>(index) >= arr->length) {
+        throw NativeFuncError("IndexError", "Array index out of range");
+    }
+    return static_cast<size_t>(index);
+}
+
+// 下标数组(i64)中的每个下标, 负数从末尾算起
+static std::vector<size_t> indices_of(const Array* arr, const Array* idx) {
+    const Elements src = convert_elements(idx, DType::I64);
+    std::vector<size_t> out(src.length);
+    const auto n = static_cast<int64_t>(arr->length);
+    bool ok = true;
+    for (size_t i = 0; i < src.length; ++i) {
+        int64_t v = src.data<int64_t>()[i];
+        if (v < 0) v += n;
+        if (v < 0 or v >= n) ok = false;
+        out[i] = static_cast<size_t>(v);
+    }
+    if (!ok) throw NativeFuncError("IndexError", "Array index out of range");
+    return out;
+}
+
+static void check_mask(const Array* arr, const Array* mask) {
+    if (mask->length != arr->length) {
+        throw NativeFuncError("IndexError", "mask length " + std::to_string(mask->length)
+            + " does not match Array length " + std::to_string(arr->length));
+    }
+}
+
+template <typename T>
+static void gather(const T* src, const std::vector<size_t>& idx, T* dst) {
+    for (size_t i = 0; i < idx.size(); ++i) dst[i] = src[idx[i]];
+}
+
+template <typename T>
+static void compress(const T* src, const uint8_t* mask, const size_t n, T* dst) {
+    size_t k = 0;
+    for (size_t i = 0; i < n; ++i) {
+        dst[k] = src[i];
+        k += mask[i] != 0;
+    }
+}
+
+static Array* take(const Array* arr, const std::vector<size_t>& idx) {
+    const auto out = new Array(arr->dtype, idx.size());
+    switch (arr->dtype) {
+    case DType::U8: gather(arr->data<uint8_t>(), idx, out->data<uint8_t>()); break;
+    case DType::I64: gather(arr->data<int64_t>(), idx, out->data<int64_t>()); break;
+    case DType::F64: gather(arr->data<double>(), idx, out->data<double>()); break;
+    }
+    return out;
+}
+
+// Array[i]为标量; Array[i:j]为共享内存的视图(步长不为1时复制);
+// Array[mask](u8数组, 长度相同)取出掩码为真的元素; Array[idx](i64数组)按下标取元素
+model::Object* array_getitem(model::Object* self, const model::List* args) {
+    const auto arr = self_array(self, "__getitem__");
+    const auto key = builtin::get_one_arg(args);
+
+    if (const auto slice = dynamic_cast<model::Slice*>(key)) {
+        int64_t start, stop, step;
+        const size_t count = model::resolve_slice(slice, arr->length, start, stop, step);
+        if (step == 1 or count <= 1) {
+            const size_t first = count == 0 ? 0 : static_cast<size_t>(start);
+            return new Array(arr->dtype, arr->buffer, arr->offset + first * elem_size(arr->dtype), count);
+        }
+        std::vector<size_t> idx(count);
+        for (size_t i = 0; i < count; ++i) idx[i] = static_cast<size_t>(start + static_cast<int64_t>(i) * step);
+        return take(arr, idx);
+    }
+
+    if (const auto key_arr = dynamic_cast<Array*>(key)) {
+        if (key_arr->dtype != DType::U8) return take(arr, indices_of(arr, key_arr));
+        check_mask(arr, key_arr);
+        const uint8_t* mask = key_arr->data<uint8_t>();
+        const auto out = new Array(arr->dtype, kernels::count_nonzero(mask, arr->length));
+        // compress会多写一个位置, 先写入临时区再复制
+        const size_t esize = elem_size(arr->dtype);
+        std::vector<char> tmp((arr->length + 1) * esize);
+        switch (arr->dtype) {
+        case DType::U8: compress(arr->data<uint8_t>(), mask, arr->length, reinterpret_cast<uint8_t*>(tmp.data())); break;
+        case DType::I64: compress(arr->data<int64_t>(), mask, arr->length, reinterpret_cast<int64_t*>(tmp.data())); break;
+        case DType::F64: compress(arr->data<double>(), mask, arr->length, reinterpret_cast<double*>(tmp.data())); break;
+        }
+        std::memcpy(out->data<char>(), tmp.data(), out->length * esize);
+        return out;
+    }
+
+    return box(arr, index_of(arr, key));
+}
+
+// 把value写入positions选中的元素: value为标量时全部赋同一值, 为Array时逐个对应(长度为1时广播)
+template <typename T>
+static void assign(const Array* arr, const std::vector<size_t>& positions, model::Object* value) {
+    T* dst = arr->data<T>();
+    if (const auto src = dynamic_cast<Array*>(value)) {
+        if (src->length != positions.size() and src->length != 1) {
+            throw NativeFuncError("ValueError", "cannot assign " + std::to_string(src->length)
+                + " values to " + std::to_string(positions.size()) + " Array elements");
+        }
+        std::vector<T> tmp;
+        Operand op;
+        operand_of(src, op);
+        const T* values = operand_data(op, tmp);
+        // 先取出全部值再写入, 来源与目标共享内存时也不受影响
+        std::vector<T> copied(values, values + src->length);
+        for (size_t i = 0; i < positions.size(); ++i) dst[positions[i]] = copied[src->length == 1 ? 0 : i];
+        return;
+    }
+    const T v = scalar_as<T>(value);
+    for (const size_t pos : positions) dst[pos] = v;
+}
+
+model::Object* array_setitem(model::Object* self, const model::List* args) {
+    const auto arr = self_array(self, "__setitem__");
+    if (args->val.size() != 2) throw NativeFuncError("TypeError", "Array.__setitem__ need 2 args");
+    const auto key = args->val[0];
+    const auto value = args->val[1];
+
+    std::vector<size_t> positions;
+    if (const auto slice = dynamic_cast<model::Slice*>(key)) {
+        int64_t start, stop, step;
+        const size_t count = model::resolve_slice(slice, arr->length, start, stop, step);
+        positions.resize(count);
+        for (size_t i = 0; i < count; ++i) positions[i] = static_cast<size_t>(start + static_cast<int64_t>(i) * step);
+    } else if (const auto key_arr = dynamic_cast<Array*>(key)) {
+        if (key_arr->dtype != DType::U8) {
+            positions = indices_of(arr, key_arr);
+        } else {
+            check_mask(arr, key_arr);
+            for (size_t i = 0; i < arr->length; ++i) {
+                if (key_arr->data<uint8_t>()[i] != 0) positions.push_back(i);
+            }
+        }
+    } else {
+        positions.push_back(index_of(arr, key));
+    }
+
+    switch (arr->dtype) {
+    case DType::U8: assign<uint8_t>(arr, positions, value); break;
+    case DType::I64: assign<int64_t>(arr, positions, value); break;
+    case DType::F64: assign<double>(arr, positions, value); break;
+    }
+    return model::load_nil();
+}
+
+model::Object* array_next(model::Object* self, const model::List* args) {
+    const auto arr = self_array(self, "__next__");
+    if (arr->next_index < arr->length) return box(arr, arr->next_index++);
+    arr->next_index = 0;
+    return model::load_stop_iter();
+}
+
+model::Object* array_str(model::Object* self, const model::List* args) {
+    return model::create_str(self_array(self, "__str__")->debug_string());
+}
+
+model::Object* array_len(model::Object* self, const model::List* args) {
+    return model::create_int(dep::BigInt(self_array(self, "len")->length));
+}
+
+model::Object* array_dtype(model::Object* self, const model::List* args) {
+    return model::create_str(dtype_name(self_array(self, "dtype")->dtype));
+}
+
+// -------------------------- 归约 --------------------------
+// 128位整数转BigInt(经十进制字符串)
+dep::BigInt int128_to_bigint(const __int128 v) {
+    auto mag = static_cast<unsigned __int128>(v < 0 ? -v : v);
+    std::string digits;
+    do {
+        digits += static_cast<char>('0' + static_cast<int>(mag % 10));
+        mag /= 10;
+    } while (mag != 0);
+    if (v < 0) digits += '-';
+    return dep::BigInt(std::string(digits.rbegin(), digits.rend()));
+}
+
+static __int128 exact_sum(const Array* arr) {
+    if (arr->dtype == DType::U8) return kernels::sum(arr->data<uint8_t>(), arr->length);
+    // 每块的低位和不超过2^63, 全部块的和不超过2^127
+    constexpr size_t block = size_t{1} << 31;
+    __int128 total = 0;
+    for (size_t begin = 0; begin < arr->length; begin += block) {
+        int64_t high;
+        uint64_t low;
+        kernels::sum(arr->data<int64_t>() + begin, std::min(block, arr->length - begin), high, low);
+        total += static_cast<__int128>(high) * (int64_t{1} << 32) + low;
+    }
+    return total;
+}
+
+// 整数数组的和是精确的Int, f64数组的和为Float
+model::Object* array_sum(model::Object* self, const model::List* args) {
+    const auto arr = self_array(self, "sum");
+    if (arr->dtype == DType::F64) return model::create_float(kernels::sum(arr->data<double>(), arr->length));
+    return model::create_int(int128_to_bigint(exact_sum(arr)));
+}
+
+static model::Object* extreme(model::Object* self, const std::string& method, const bool want_max) {
+    const auto arr = self_array(self, method);
+    if (arr->length == 0) throw NativeFuncError("ValueError", "Array." + method + "() of an empty Array");
+    switch (arr->dtype) {
+    case DType::U8:
+        return model::create_int(dep::BigInt::from_int64(kernels::extreme(arr->data<uint8_t>(), arr->length, want_max)));
+    case DType::I64:
+        return model::create_int(dep::BigInt::from_int64(kernels::extreme(arr->data<int64_t>(), arr->length, want_max)));
+    case DType::F64:
+        return model::create_float(kernels::extreme(arr->data<double>(), arr->length, want_max));
+    }
+    return model::load_nil();
+}
+
+model::Object* array_min(model::Object* self, const model::List* args) {
+    return extreme(self, "min", false);
+}
+
+model::Object* array_max(model::Object* self, const model::List* args) {
+    return extreme(self, "max", true);
+}
+
+// 空数组的均值为nan
+model::Object* array_mean(model::Object* self, const model::List* args) {
+    const auto arr = self_array(self, "mean");
+    if (arr->length == 0) return model::create_float(std::numeric_limits<double>::quiet_NaN());
+    const double total = arr->dtype == DType::F64
+        ? kernels::sum(arr->data<double>(), arr->length)
+        : static_cast<double>(exact_sum(arr));
+    return model::create_float(total / static_cast<double>(arr->length));
+}
+
+// a.dot(b): 长度必须相同; 含f64时为Float, 否则为精确的Int
+model::Object* array_dot(model::Object* self, const model::List* args) {
+    const auto a = self_array(self, "dot");
+    const auto b = args->val.empty() ? nullptr : dynamic_cast<Array*>(args->val[0]);
+    if (b == nullptr) throw NativeFuncError("TypeError", "Array.dot need an Array argument");
+    if (a->length != b->length) {
+        throw NativeFuncError("ValueError", "Array.dot lengths " + std::to_string(a->length)
+            + " and " + std::to_string(b->length) + " do not match");
+    }
+    Operand oa, ob;
+    operand_of(a, oa);
+    operand_of(b, ob);
+    if (a->dtype == DType::F64 or b->dtype == DType::F64) {
+        std::vector<double> ta, tb;
+        return model::create_float(kernels::dot(operand_data(oa, ta), operand_data(ob, tb), a->length));
+    }
+
+    // 整数乘积之和用128位累加, 将要溢出时转入BigInt
+    std::vector<int64_t> ta, tb;
+    const int64_t* pa = operand_data(oa, ta);
+    const int64_t* pb = operand_data(ob, tb);
+    dep::BigInt total(0);
+    __int128 acc = 0;
+    for (size_t i = 0; i < a->length; ++i) {
+        const __int128 product = static_cast<__int128>(pa[i]) * pb[i];
+        __int128 next;
+        if (__builtin_add_overflow(acc, product, &next)) {
+            total += int128_to_bigint(acc);
+            next = product;
+        }
+        acc = next;
+    }
+    total += int128_to_bigint(acc);
+    return model::create_int(total);
+}
+
+static size_t count_truthy(const Array* arr) {
+    switch (arr->dtype) {
+    case DType::U8:
+        return kernels::count_nonzero(arr->data<uint8_t>(), arr->length);
+    case DType::I64:
+        return static_cast<size_t>(std::count_if(arr->data<int64_t>(), arr->data<int64_t>() + arr->length,
+            [](const int64_t v) { return v != 0; }));
+    case DType::F64:
+        return static_cast<size_t>(std::count_if(arr->data<double>(), arr->data<double>() + arr->length,
+            [](const double v) { return v != 0; }));
+    }
+    return 0;
+}
+
+model::Object* array_any(model::Object* self, const model::List* args) {
+    return model::load_bool(count_truthy(self_array(self, "any")) != 0);
+}
+
+model::Object* array_all(model::Object* self, const model::List* args) {
+    const auto arr = self_array(self, "all");
+    return model::load_bool(count_truthy(arr) == arr->length);
+}
+
+// -------------------------- 排序与转换 --------------------------
+// 原地升序排序(视图排序会修改来源数组中的对应区间), nan排在最后
+model::Object* array_sort(model::Object* self, const model::List* args) {
+    const auto arr = self_array(self, "sort");
+    switch (arr->dtype) {
+    case DType::U8: kernels::sort(arr->data<uint8_t>(), arr->length); break;
+    case DType::I64: kernels::sort(arr->data<int64_t>(), arr->length); break;
+    case DType::F64: kernels::sort(arr->data<double>(), arr->length); break;
+    }
+    return model::load_nil();
+}
+
+// 稳定排序的下标, 结果为i64数组
+model::Object* array_argsort(model::Object* self, const model::List* args) {
+    const auto arr = self_array(self, "argsort");
+    const auto out = new Array(DType::I64, arr->length);
+    switch (arr->dtype) {
+    case DType::U8: kernels::argsort(arr->data<uint8_t>(), arr->length, out->data<int64_t>()); break;
+    case DType::I64: kernels::argsort(arr->data<int64_t>(), arr->length, out->data<int64_t>()); break;
+    case DType::F64: kernels::argsort(arr->data<double>(), arr->length, out->data<int64_t>()); break;
+    }
+    return out;
+}
+
+model::Object* array_astype(model::Object* self, const model::List* args) {
+    const auto arr = self_array(self, "astype");
+    DType dtype;
+    if (!dtype_arg(args, 0, "astype", dtype)) throw NativeFuncError("TypeError", "astype() need a dtype");
+    return astype_copy(arr, dtype);
+}
+
+model::Object* array_copy(model::Object* self, const model::List* args) {
+    const auto arr = self_array(self, "copy");
+    return astype_copy(arr, arr->dtype);
+}
+
+// 整数数组直接生成拆箱的Int列表, 不逐个创建Int对象
+model::Object* array_to_list(model::Object* self, const model::List* args) {
+    const auto arr = self_array(self, "to_list");
+    switch (arr->dtype) {
+    case DType::U8: {
+        std::vector<int64_t> ints(arr->length);
+        convert(arr->data<uint8_t>(), ints.data(), arr->length);
+        return model::List::from_ints(std::move(ints));
+    }
+    case DType::I64:
+        return model::List::from_ints(std::vector(arr->data<int64_t>(), arr->data<int64_t>() + arr->length));
+    case DType::F64: {
+        std::vector<model::Object*> elems(arr->length);
+        for (size_t i = 0; i < arr->length; ++i) elems[i] = model::create_float(arr->data<double>()[i]);
+        return new model::List(std::move(elems));
+    }
+    }
+    return model::load_nil();
+}
+
+model::Object* array_tobytes(model::Object* self, const model::List* args) {
+    const auto arr = self_array(self, "tobytes");
+    return model::create_str(std::string(arr->data<char>(), arr->length * elem_size(arr->dtype)));
+}
+
+model::Object* array_tofile(model::Object* self, const model::List* args) {
+    const auto arr = self_array(self, "tofile");
+    const auto path = args->val.empty() ? nullptr : dynamic_cast<model::String*>(args->val[0]);
+    if (path == nullptr) throw NativeFuncError("TypeError", "tofile() need a Str path");
+    std::ofstream file(path->val(), std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) throw NativeFuncError("PathError", "Failed to open file: " + path->val());
+    file.write(arr->data<char>(), static_cast<std::streamsize>(arr->length * elem_size(arr->dtype)));
+    if (!file) throw NativeFuncError("IOError", "Array.tofile write failed");
+    return model::load_nil();
+}
+
+}
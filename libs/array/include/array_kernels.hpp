@@ -0,0 +1,47 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+namespace array_lib::kernels {
+
+// 运行时检测到AVX2+FMA时使用256位向量实现, 否则使用SSE2(x86-64基线)或标量实现
+bool has_avx2();
+
+enum class BinOp : uint8_t { Add, Sub, Mul, Div, Mod, Pow };
+enum class CmpOp : uint8_t { Eq, Ne, Lt, Le, Gt, Ge };
+
+// 逐元素运算 out[i] = a[i·a_step] op b[i·b_step], step为0时该操作数按标量广播
+// 整数加减乘按补码回绕; 整数Div不在此处理(调用方先转为f64), Mod/Pow的除零与负指数由调用方检查
+void binary(BinOp op, const int64_t* a, size_t a_step, const int64_t* b, size_t b_step, int64_t* out, size_t n);
+void binary(BinOp op, const double* a, size_t a_step, const double* b, size_t b_step, double* out, size_t n);
+void binary(BinOp op, const uint8_t* a, size_t a_step, const uint8_t* b, size_t b_step, uint8_t* out, size_t n);
+
+// 逐元素比较, 结果为0/1掩码
+void compare(CmpOp op, const int64_t* a, size_t a_step, const int64_t* b, size_t b_step, uint8_t* out, size_t n);
+void compare(CmpOp op, const double* a, size_t a_step, const double* b, size_t b_step, uint8_t* out, size_t n);
+void compare(CmpOp op, const uint8_t* a, size_t a_step, const uint8_t* b, size_t b_step, uint8_t* out, size_t n);
+
+// 求和: 整数结果精确, 为 high·2^32 + low
+double sum(const double* a, size_t n);
+void sum(const int64_t* a, size_t n, int64_t& high, uint64_t& low);
+uint64_t sum(const uint8_t* a, size_t n);
+
+double dot(const double* a, const double* b, size_t n);
+
+// 最值, n > 0; f64含nan时结果为nan
+double extreme(const double* a, size_t n, bool want_max);
+int64_t extreme(const int64_t* a, size_t n, bool want_max);
+uint8_t extreme(const uint8_t* a, size_t n, bool want_max);
+
+size_t count_nonzero(const uint8_t* a, size_t n);
+
+// 升序排序; nan排在最后
+void sort(int64_t* a, size_t n);
+void sort(double* a, size_t n);
+void sort(uint8_t* a, size_t n);
+// 稳定的升序下标序列
+void argsort(const int64_t* a, size_t n, int64_t* out);
+void argsort(const double* a, size_t n, int64_t* out);
+void argsort(const uint8_t* a, size_t n, int64_t* out);
+
+}
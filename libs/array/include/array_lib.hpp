@@ -0,0 +1,125 @@
+#pragma once
+#include <memory>
+
+#include "models/models.hpp"
+
+namespace array_lib {
+
+inline auto based_array = new model::Object();
+
+enum class DType : uint8_t { U8, I64, F64 };
+
+// 连续内存块: 64字节对齐的堆内存, 或文件的私有映射(写入时复制, 不影响文件)
+class Buffer {
+public:
+    explicit Buffer(size_t bytes);
+    // 接管一段已映射的内存, 析构时解除映射
+    Buffer(char* mapped, size_t bytes);
+    ~Buffer();
+
+    Buffer(const Buffer&) = delete;
+    Buffer& operator=(const Buffer&) = delete;
+
+    [[nodiscard]] char* data() const { return data_; }
+
+private:
+    char* data_;
+    size_t bytes_;
+    bool mapped_;
+};
+
+// 定长的同类型数值数组; 切片(步长为1)与fromfile得到的数组和来源共享Buffer, 不复制数据
+class Array : public model::Object {
+public:
+    DType dtype;
+    std::shared_ptr<Buffer> buffer;
+    size_t offset = 0;  // 在buffer中的字节偏移
+    size_t length = 0;
+
+    // for循环直接遍历Array时使用的游标(同List.__next__)
+    size_t next_index = 0;
+
+    // 新分配, 内容未初始化
+    Array(DType dtype, size_t length);
+    Array(DType dtype, std::shared_ptr<Buffer> buffer, size_t offset, size_t length);
+
+    template <typename T>
+    [[nodiscard]] T* data() const { return reinterpret_cast<T*>(buffer->data() + offset); }
+
+    [[nodiscard]] std::string debug_string() const override;
+};
+
+// 连续的一组元素, 尚未包装为Array(转换出错时不必清理对象)
+struct Elements {
+    DType dtype;
+    std::shared_ptr<Buffer> buffer;
+    size_t length;
+
+    template <typename T>
+    [[nodiscard]] T* data() const { return reinterpret_cast<T*>(buffer->data()); }
+};
+
+size_t elem_size(DType dtype);
+const char* dtype_name(DType dtype);
+// "u8" "i64" "f64"之外返回false
+bool parse_dtype(const model::Object* obj, DType& out);
+// 标量按元素类型取值(T为uint8_t/int64_t/double), 越界或类型不符时报错
+template <typename T>
+T scalar_as(const model::Object* obj);
+// 转换为dtype的新数组(不共享内存)
+Array* astype_copy(const Array* src, DType dtype);
+// 由Array、List或可迭代对象转换出的数据, has_dtype为false时推断类型(同array.array)
+Elements to_elements(model::Object* src, bool has_dtype, DType dtype);
+Array* to_array(Elements elems);
+dep::BigInt int128_to_bigint(__int128 v);
+
+// 向based_array注册Array的方法; 其他模块返回Array前也需调用, 可重复调用
+void register_array_type();
+
+model::Object* init_module(model::Object* self, const model::List* args);
+
+// 模块函数
+model::Object* array(model::Object* self, const model::List* args);
+model::Object* zeros(model::Object* self, const model::List* args);
+model::Object* full(model::Object* self, const model::List* args);
+model::Object* arange(model::Object* self, const model::List* args);
+model::Object* frombytes(model::Object* self, const model::List* args);
+model::Object* fromfile(model::Object* self, const model::List* args);
+
+// Array方法
+model::Object* array_add(model::Object* self, const model::List* args);
+model::Object* array_sub(model::Object* self, const model::List* args);
+model::Object* array_mul(model::Object* self, const model::List* args);
+model::Object* array_div(model::Object* self, const model::List* args);
+model::Object* array_mod(model::Object* self, const model::List* args);
+model::Object* array_pow(model::Object* self, const model::List* args);
+model::Object* array_neg(model::Object* self, const model::List* args);
+model::Object* array_eq(model::Object* self, const model::List* args);
+model::Object* array_ne(model::Object* self, const model::List* args);
+model::Object* array_lt(model::Object* self, const model::List* args);
+model::Object* array_le(model::Object* self, const model::List* args);
+model::Object* array_gt(model::Object* self, const model::List* args);
+model::Object* array_ge(model::Object* self, const model::List* args);
+model::Object* array_bool(model::Object* self, const model::List* args);
+model::Object* array_getitem(model::Object* self, const model::List* args);
+model::Object* array_setitem(model::Object* self, const model::List* args);
+model::Object* array_next(model::Object* self, const model::List* args);
+model::Object* array_str(model::Object* self, const model::List* args);
+model::Object* array_len(model::Object* self, const model::List* args);
+model::Object* array_dtype(model::Object* self, const model::List* args);
+model::Object* array_sum(model::Object* self, const model::List* args);
+model::Object* array_min(model::Object* self, const model::List* args);
+model::Object* array_max(model::Object* self, const model::List* args);
+model::Object* array_mean(model::Object* self, const model::List* args);
+model::Object* array_dot(model::Object* self, const model::List* args);
+model::Object* array_any(model::Object* self, const model::List* args);
+model::Object* array_all(model::Object* self, const model::List* args);
+model::Object* array_sort(model::Object* self, const model::List* args);
+model::Object* array_argsort(model::Object* self, const model::List* args);
+model::Object* array_astype(model::Object* self, const model::List* args);
+model::Object* array_copy(model::Object* self, const model::List* args);
+model::Object* array_to_list(model::Object* self, const model::List* args);
+model::Object* array_tobytes(model::Object* self, const model::List* args);
+model::Object* array_tofile(model::Object* self, const model::List* args);
+
+}
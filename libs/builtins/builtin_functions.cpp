@@ -1,27 +1,53 @@
 #include "include/builtin_functions.hpp"
 
+#include <algorithm>
 #include <chrono>
 #include <cstdint>
+#include <optional>
 
 #include "../../src/models/models.hpp"
+#include "include/builtin_methods.hpp"
 #include "../deps/u8str.hpp"
 
 namespace builtin {
 
 model::Object* print(model::Object* self, const model::List* args) {
-    dep::UTF8String text;
+    std::string text;
     for (auto arg : args->val) {
-        text += dep::UTF8String(kiz::Vm::obj_to_debug_str(arg)) + " ";
+        kiz::Vm::write_debug_str(arg, text);
+        text += ' ';
     }
-    std::cout << text << std::endl;
+    text += '\n';
+    kiz::Vm::write_stdout(text);
+    return model::load_nil();
+}
+
+// write(sep, end, ...)：以sep分隔各参数的__str__结果, 以end结尾
+model::Object* write(model::Object* self, const model::List* args) {
+    assert(args->val.size() >= 2 && "function write need at least 2 args (sep, end)");
+    const auto& sep = model::cast_to_str(args->val[0])->val();
+    const auto& end = model::cast_to_str(args->val[1])->val();
+    std::string text;
+    for (size_t i = 2; i < args->val.size(); ++i) {
+        if (i != 2) text += sep;
+        kiz::Vm::write_str(args->val[i], text);
+    }
+    text += end;
+    kiz::Vm::write_stdout(text);
+    return model::load_nil();
+}
+
+model::Object* flush(model::Object* self, const model::List* args) {
+    kiz::Vm::flush_stdout();
     return model::load_nil();
 }
 
 model::Object* input(model::Object* self, const model::List* args) {
     if (! args->val.empty()) {
         const auto prompt_obj = get_one_arg(args);
-        std::cout << model::cast_to_str(prompt_obj)->val;
+        kiz::Vm::write_stdout(model::cast_to_str(prompt_obj)->val());
     }
+    kiz::Vm::flush_stdout();
     std::string result;
     std::getline(std::cin, result);
     return model::create_str(result);
@@ -45,12 +71,20 @@ The kiz help
 Built-in Functions:
 ===========================
     print(...)
+    write(sep, end, ...)
+    flush()
     input(prompt="")
     ischild(obj, for_check_obj)
     create(parent_obj=Object)
     breakpoint()
     help()
     range(start, step, end)
+    sorted(list, key=Nil, reverse=False)
+    sum(iterable, start)
+    min(iterable) / min(a, b, ...)
+    max(iterable) / max(a, b, ...)
+    any(iterable)
+    all(iterable)
     cmd(command)
     now()
     type_of(obj)
@@ -66,7 +100,13 @@ Built-in Objects:
     Int
     Dec
     Str
+    StrBuilder
     List
+    Tuple
+    Set
+    Iterator
+    StopIter
+    Slice
     Dict
     Bool
     Func
@@ -81,6 +121,7 @@ Built-in Objects:
 }
 
 model::Object* breakpoint(model::Object* self, const model::List* args) {
+    kiz::Vm::flush_stdout();
     size_t i = 0;
     for (auto& frame: kiz::Vm::call_stack) {
         std::cout << "Frame [" << i << "] " << frame->name << "\n";
@@ -132,7 +173,8 @@ model::Object* cmd(model::Object* self, const model::List* args) {
         return model::load_nil();
     }
     auto instruction = arg_vector[0];
-    std::system(model::cast_to_str(instruction)->val.c_str());
+    kiz::Vm::flush_stdout();
+    std::system(model::cast_to_str(instruction)->val().c_str());
     return model::load_nil();
 }
 
@@ -179,6 +221,25 @@ model::Object* range(model::Object* self, const model::List* args) {
         end_int = end_int_obj->val;
     } else return model::load_nil();
 
+    // 范围落在int64内时直接生成拆箱的整数数组
+    int64_t start_i64, step_i64, end_i64;
+    if (start_int.to_int64(start_i64) and step_int.to_int64(step_i64) and end_int.to_int64(end_i64)
+        and step_i64 > 0) {
+        std::vector<int64_t> ints;
+        if (start_i64 < end_i64) {
+            const auto span = static_cast<uint64_t>(end_i64) - static_cast<uint64_t>(start_i64);
+            ints.reserve((span - 1) / static_cast<uint64_t>(step_i64) + 1);
+            for (int64_t i = start_i64; i < end_i64; i += step_i64) {
+                ints.push_back(i);
+                // 下一步会越过end(或溢出)时停止
+                if (static_cast<uint64_t>(end_i64) - static_cast<uint64_t>(i) <= static_cast<uint64_t>(step_i64)) break;
+            }
+        }
+        auto range_list = model::List::from_ints(std::move(ints));
+        range_list->make_ref();
+        return range_list;
+    }
+
     for (dep::BigInt i = start_int; i < end_int; i+=step_int) {
         auto i_obj = model::create_int(i);
         range_vector.emplace_back(i_obj);
@@ -186,6 +247,291 @@ model::Object* range(model::Object* self, const model::List* args) {
     return model::create_list(range_vector);
 }
 
+// 返回排序后的新列表, 原列表不变
+model::Object* sorted(model::Object* self, const model::List* args) {
+    if (args->val.empty()) {
+        throw NativeFuncError("TypeError", "sorted() need at least 1 arg");
+    }
+    const auto src_list = dynamic_cast<model::List*>(args->val[0]);
+    if (src_list == nullptr) {
+        throw NativeFuncError("TypeError", "sorted() only supports List type argument");
+    }
+
+    model::Object* key_func = nullptr;
+    if (args->val.size() > 1 and args->val[1]->get_type() != model::Object::ObjectType::OT_Nil) {
+        key_func = args->val[1];
+    }
+    const bool reverse = args->val.size() > 2 and kiz::Vm::is_true(args->val[2]);
+
+    // 复制到可特化的空列表, 同类元素排序时走拆箱数组
+    auto result = model::List::create_empty();
+    result->make_ref();
+    result->extend(*src_list);
+    model::sort_list(result, key_func, reverse);
+    return result;
+}
+
+// -------------------------- 归约函数 --------------------------
+
+// 依次访问List元素或迭代器产出的元素, f返回false时提前结束
+template <typename F>
+static void for_each_elem(model::Object* src, F f) {
+    if (const auto list = dynamic_cast<model::List*>(src)) {
+        for (size_t i = 0; i < list->size(); ++i) {
+            if (!f(list->get(i))) return;
+        }
+        return;
+    }
+    const auto it = model::make_iterator(src);
+    while (const auto elem = model::iterator_step(it)) {
+        if (!f(elem)) return;
+    }
+}
+
+// int64数组精确求和: 每个数拆成高32位(算术右移)与低32位分别累加,
+// 内层循环无分支且不会溢出, 编译器可向量化
+static dep::BigInt sum_int64(const std::vector<int64_t>& values) {
+    // 每块至多2^30个元素: 低位和 < 2^62, 高位和的绝对值 <= 2^61
+    constexpr size_t chunk = size_t{1} << 30;
+    const auto low_base = dep::BigInt::from_int64(int64_t{1} << 32);
+    dep::BigInt total(0);
+    for (size_t begin = 0; begin < values.size(); begin += chunk) {
+        const size_t end = std::min(values.size(), begin + chunk);
+        uint64_t low = 0;
+        int64_t high = 0;
+        for (size_t i = begin; i < end; ++i) {
+            low += static_cast<uint32_t>(values[i]);
+            high += values[i] >> 32;
+        }
+        total += dep::BigInt::from_int64(high) * low_base + dep::BigInt::from_int64(static_cast<int64_t>(low));
+    }
+    return total;
+}
+
+static bool is_numeric(const model::Object* obj) {
+    const auto type = obj->get_type();
+    return type == model::Object::ObjectType::OT_Int or type == model::Object::ObjectType::OT_Decimal;
+}
+
+static dep::Decimal to_decimal(model::Object* obj) {
+    if (const auto obj_int = dynamic_cast<model::Int*>(obj)) return dep::Decimal(obj_int->val);
+    return dynamic_cast<model::Decimal*>(obj)->val;
+}
+
+// a + b: 数值与字符串在C++中直接计算, 其余经VM调用__add__
+static model::Object* add_values(model::Object* a, model::Object* b) {
+    const auto a_int = dynamic_cast<model::Int*>(a);
+    const auto b_int = dynamic_cast<model::Int*>(b);
+    if (a_int and b_int) return model::create_int(a_int->val + b_int->val);
+    if (double x, y; model::float_operands(a, b, x, y)) return model::create_float(x + y);
+    if (is_numeric(a) and is_numeric(b)) return model::create_decimal(to_decimal(a) + to_decimal(b));
+    const auto a_str = dynamic_cast<model::String*>(a);
+    const auto b_str = dynamic_cast<model::String*>(b);
+    if (a_str and b_str) return model::concat_str(a_str, b_str);
+
+    kiz::Vm::call_function(kiz::Vm::get_attr(a, "__add__"), new model::List({b}), a);
+    return kiz::Vm::fetch_one_from_stack_top();
+}
+
+// a < b: 数值与字符串在C++中直接比较, 其余经VM调用__lt__
+static bool less_than(model::Object* a, model::Object* b) {
+    const auto a_int = dynamic_cast<model::Int*>(a);
+    const auto b_int = dynamic_cast<model::Int*>(b);
+    if (a_int and b_int) return a_int->val < b_int->val;
+    if (double x, y; model::float_operands(a, b, x, y)) return x < y;
+    if (is_numeric(a) and is_numeric(b)) return to_decimal(a) < to_decimal(b);
+    const auto a_str = dynamic_cast<model::String*>(a);
+    const auto b_str = dynamic_cast<model::String*>(b);
+    if (a_str and b_str) return a_str->val() < b_str->val();
+
+    kiz::Vm::call_function(kiz::Vm::get_attr(a, "__lt__"), new model::List({b}), a);
+    return kiz::Vm::is_true(kiz::Vm::fetch_one_from_stack_top());
+}
+
+// 求和; 省略start时从第一个元素开始累加(空序列返回0), 因此也可用于字符串与自定义对象
+model::Object* sum(model::Object* self, const model::List* args) {
+    if (args->val.empty()) {
+        throw NativeFuncError("TypeError", "sum() need at least 1 arg");
+    }
+    const auto src = args->val[0];
+    model::Object* start = args->val.size() > 1 ? args->val[1] : nullptr;
+
+    // 拆箱列表直接在底层数组上计算
+    if (const auto list = dynamic_cast<model::List*>(src)) {
+        model::Object* total = nullptr;
+        switch (list->strategy()) {
+        case model::List::Strategy::Int:
+            total = model::create_int(sum_int64(list->ints()));
+            break;
+        case model::List::Strategy::Decimal: {
+            dep::Decimal dec_total(dep::BigInt(0));
+            for (const auto& d : list->decimals()) dec_total += d;
+            total = model::create_decimal(std::move(dec_total));
+            break;
+        }
+        case model::List::Strategy::Str: {
+            size_t byte_size = 0;
+            for (const auto& str : list->strs()) byte_size += str.size();
+            std::string str_total;
+            str_total.reserve(byte_size);
+            for (const auto& str : list->strs()) str_total += str;
+            total = model::create_str(std::move(str_total));
+            break;
+        }
+        case model::List::Strategy::Empty:
+            return start ? start : model::create_int(dep::BigInt(0));
+        default:
+            break;
+        }
+        if (total != nullptr) return start ? add_values(start, total) : total;
+    }
+
+    // 连续的Int在BigInt上原地累加, 避免逐个创建中间对象
+    model::Object* acc = nullptr;
+    dep::BigInt int_total(0);
+    bool in_int = false;
+    if (start != nullptr) {
+        if (const auto start_int = dynamic_cast<model::Int*>(start)) {
+            int_total = start_int->val;
+            in_int = true;
+        } else {
+            acc = start;
+        }
+    }
+
+    for_each_elem(src, [&](model::Object* elem) {
+        const auto elem_int = dynamic_cast<model::Int*>(elem);
+        if (in_int and elem_int) {
+            int_total += elem_int->val;
+            return true;
+        }
+        if (in_int) {
+            acc = model::create_int(int_total);
+            in_int = false;
+        }
+        if (acc == nullptr) {
+            if (elem_int) {
+                int_total = elem_int->val;
+                in_int = true;
+            } else {
+                acc = elem;
+            }
+            return true;
+        }
+        acc = add_values(acc, elem);
+        return true;
+    });
+
+    if (in_int) return model::create_int(int_total);
+    return acc ? acc : model::create_int(dep::BigInt(0));
+}
+
+// min/max共用: 单个参数时遍历该List/迭代器, 多个参数时在参数之间比较
+static model::Object* extreme(const model::List* args, const std::string& name, const bool want_max) {
+    if (args->val.empty()) {
+        throw NativeFuncError("TypeError", name + "() need at least 1 arg");
+    }
+    const std::string empty_msg = name + "() arg is an empty sequence";
+
+    model::Object* src = args->val[0];
+    if (args->val.size() > 1) src = const_cast<model::List*>(args);
+
+    if (const auto list = dynamic_cast<model::List*>(src)) {
+        switch (list->strategy()) {
+        case model::List::Strategy::Int: {
+            const auto& ints = list->ints();
+            if (ints.empty()) throw NativeFuncError("ValueError", empty_msg);
+            // 无分支的归约循环, 可向量化
+            int64_t best = ints[0];
+            if (want_max) for (const auto v : ints) best = v > best ? v : best;
+            else for (const auto v : ints) best = v < best ? v : best;
+            return model::create_int(dep::BigInt::from_int64(best));
+        }
+        case model::List::Strategy::Decimal: {
+            const auto& decs = list->decimals();
+            if (decs.empty()) throw NativeFuncError("ValueError", empty_msg);
+            const auto best = want_max
+                ? std::ranges::max_element(decs, [](const dep::Decimal& a, const dep::Decimal& b) { return a < b; })
+                : std::ranges::min_element(decs, [](const dep::Decimal& a, const dep::Decimal& b) { return a < b; });
+            return model::create_decimal(*best);
+        }
+        case model::List::Strategy::Str: {
+            const auto& strs = list->strs();
+            if (strs.empty()) throw NativeFuncError("ValueError", empty_msg);
+            const auto best = want_max ? std::ranges::max_element(strs) : std::ranges::min_element(strs);
+            return model::create_str(*best);
+        }
+        default:
+            break;
+        }
+    }
+
+    // 相等时保留先出现的元素
+    model::Object* best = nullptr;
+    for_each_elem(src, [&](model::Object* elem) {
+        if (best == nullptr or (want_max ? less_than(best, elem) : less_than(elem, best))) {
+            best = elem;
+        }
+        return true;
+    });
+    if (best == nullptr) throw NativeFuncError("ValueError", empty_msg);
+    return best;
+}
+
+model::Object* min(model::Object* self, const model::List* args) {
+    return extreme(args, "min", false);
+}
+
+model::Object* max(model::Object* self, const model::List* args) {
+    return extreme(args, "max", true);
+}
+
+// any/all共用: 找到真值(any)或假值(all)时立即结束
+static model::Object* any_or_all(const model::List* args, const std::string& name, const bool want_true) {
+    if (args->val.empty()) {
+        throw NativeFuncError("TypeError", name + "() need 1 arg");
+    }
+    const auto src = args->val[0];
+
+    if (const auto list = dynamic_cast<model::List*>(src)) {
+        std::optional<bool> found;
+        switch (list->strategy()) {
+        case model::List::Strategy::Int:
+            found = std::ranges::any_of(list->ints(), [&](const int64_t v) { return (v != 0) == want_true; });
+            break;
+        case model::List::Strategy::Decimal: {
+            const dep::Decimal zero(dep::BigInt(0));
+            found = std::ranges::any_of(list->decimals(), [&](const dep::Decimal& v) { return !(v == zero) == want_true; });
+            break;
+        }
+        case model::List::Strategy::Str:
+            found = std::ranges::any_of(list->strs(), [&](const std::string& v) { return !v.empty() == want_true; });
+            break;
+        case model::List::Strategy::Empty:
+            found = false;
+            break;
+        default:
+            break;
+        }
+        if (found.has_value()) return model::load_bool(want_true ? *found : !*found);
+    }
+
+    bool found = false;
+    for_each_elem(src, [&](model::Object* elem) {
+        found = kiz::Vm::is_true(elem) == want_true;
+        return !found;
+    });
+    return model::load_bool(want_true ? found : !found);
+}
+
+model::Object* any(model::Object* self, const model::List* args) {
+    return any_or_all(args, "any", true);
+}
+
+model::Object* all(model::Object* self, const model::List* args) {
+    return any_or_all(args, "all", false);
+}
+
 model::Object* setattr(model::Object* self, const model::List* args) {
     auto arg_vector = args->val;
     if (arg_vector.size() != 3) {
@@ -194,7 +540,7 @@ model::Object* setattr(model::Object* self, const model::List* args) {
     auto for_set = arg_vector[0];
     auto attr_name = arg_vector[1];
     auto value = arg_vector[2];
-    for_set->attrs.insert(model::cast_to_str(attr_name)->val, value);
+    for_set->attrs.insert(model::cast_to_str(attr_name)->val(), value);
     return model::load_nil();
 }
 
@@ -213,7 +559,7 @@ model::Object* getattr(model::Object* self, const model::List* args) {
             default_value = arg_vector[2];
         }
         try {
-            return kiz::Vm::get_attr(obj, model::cast_to_str(attr_name)->val);
+            return kiz::Vm::get_attr(obj, model::cast_to_str(attr_name)->val());
         } catch (...) {
             return default_value;
         }
@@ -225,13 +571,13 @@ model::Object* getattr(model::Object* self, const model::List* args) {
         default_value = arg_vector[3];
         if (kiz::Vm::is_true(current_only)) {
             if (const auto value =
-                obj->attrs.find(model::cast_to_str(attr_name)->val)
+                obj->attrs.find(model::cast_to_str(attr_name)->val())
             ) return value->value;
             return default_value;
         }
 
         try {
-            return kiz::Vm::get_attr(obj, model::cast_to_str(attr_name)->val);
+            return kiz::Vm::get_attr(obj, model::cast_to_str(attr_name)->val());
         } catch (...) {
             return default_value;
         }
@@ -247,7 +593,7 @@ model::Object* delattr(model::Object* self, const model::List* args) {
     }
     model::Object* obj = arg_vector[0];
     model::Object* attr_name = arg_vector[1];
-    obj->attrs.del(model::cast_to_str(attr_name)->val);
+    obj->attrs.del(model::cast_to_str(attr_name)->val());
     return model::load_nil();
 }
 
@@ -263,7 +609,7 @@ model::Object* hasattr(model::Object* self, const model::List* args) {
         attr_name = arg_vector[1];
 
         try {
-            kiz::Vm::get_attr(obj, model::cast_to_str(attr_name)->val);
+            kiz::Vm::get_attr(obj, model::cast_to_str(attr_name)->val());
             return model::load_true();
         } catch (...) {
             return model::load_false();
@@ -275,12 +621,12 @@ model::Object* hasattr(model::Object* self, const model::List* args) {
         attr_name = arg_vector[2];
         if (kiz::Vm::is_true(current_only)) {
             if (const auto value =
-                obj->attrs.find(model::cast_to_str(attr_name)->val)
+                obj->attrs.find(model::cast_to_str(attr_name)->val())
             ) return model::load_true();
             return model::load_false();
         }
         try {
-            kiz::Vm::get_attr(obj, model::cast_to_str(attr_name)->val);
+            kiz::Vm::get_attr(obj, model::cast_to_str(attr_name)->val());
             return model::load_true();
         } catch (...) {
             return model::load_false();
@@ -322,9 +668,16 @@ model::Object* type_of_obj(model::Object* self, const model::List* args) {
         case model::Object::ObjectType::OT_List: type_str = "List"; break;
         case model::Object::ObjectType::OT_Dictionary: type_str = "Dict"; break;
         case model::Object::ObjectType::OT_Decimal: type_str = "Decimal"; break;
+        case model::Object::ObjectType::OT_Float: type_str = "Float"; break;
         case model::Object::ObjectType::OT_CodeObject: type_str = "__CodeObject"; break;
         case model::Object::ObjectType::OT_CppFunction: type_str = "NFunc"; break;
         case model::Object::ObjectType::OT_Module: type_str = "Module"; break;
+        case model::Object::ObjectType::OT_StrBuilder: type_str = "StrBuilder"; break;
+        case model::Object::ObjectType::OT_Iterator: type_str = "Iterator"; break;
+        case model::Object::ObjectType::OT_Slice: type_str = "Slice"; break;
+        case model::Object::ObjectType::OT_Set: type_str = "Set"; break;
+        case model::Object::ObjectType::OT_Tuple: type_str = "Tuple"; break;
+        case model::Object::ObjectType::OT_DictView: type_str = "DictView"; break;
         default: type_str = "<Unknown>"; break;
     }
     return model::create_str(type_str);
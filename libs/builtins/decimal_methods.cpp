@@ -5,14 +5,14 @@
 
 namespace model {
 
-// Decimal.__call__：构造Decimal对象（支持字符串/Int/Decimal初始化）
+// Decimal.__call__：构造Decimal对象（支持字符串/Int/Decimal/Float初始化）
 Object* decimal_call(Object* self, const List* args) {
     auto a = builtin::get_one_arg(args);
     dep::Decimal val(0);
 
     // 从String初始化（如 "123.45", "-67.89e2"）
     if (auto s = dynamic_cast<String*>(a)) {
-        val = dep::Decimal(s->val);
+        val = dep::Decimal(s->val());
     }
     // 从Int初始化
     else if (auto i = dynamic_cast<Int*>(a)) {
@@ -22,6 +22,13 @@ Object* decimal_call(Object* self, const List* args) {
     else if (auto d = dynamic_cast<Decimal*>(a)) {
         val = d->val;
     }
+    // 从Float初始化（按最短往返表示转换, 如 0.1f -> 0.1）
+    else if (auto f = dynamic_cast<Float*>(a)) {
+        if (!std::isfinite(f->val)) throw NativeFuncError("ValueError", "cannot convert " + f->debug_string() + " to Decimal");
+        char buf[32];
+        const auto end = std::to_chars(buf, buf + sizeof(buf), f->val).ptr;
+        val = dep::Decimal(std::string(buf, end));
+    }
     // 假值（Nil/Bool(false)）初始化为0
     else if (!kiz::Vm::is_true(a)) {
         val = dep::Decimal(0);
@@ -39,7 +46,7 @@ Object* decimal_bool(Object* self, const List* args) {
     return new Bool(!(self_dec->val == dep::Decimal(dep::BigInt(0))));
 }
 
-// Decimal.__add__：加法（self + args[0]），支持Int/Decimal
+// Decimal.__add__：加法（self + args[0]），支持Int/Decimal/Float
 Object* decimal_add(Object* self, const List* args) {
     DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (decimal_add)");
     assert(args->val.size() == 1 && "function Decimal.add need 1 arg");
@@ -57,11 +64,16 @@ Object* decimal_add(Object* self, const List* args) {
         dep::Decimal res = self_dec->val + another_dec->val;
         return new Decimal(res);
     }
-    // 仅允许Int/Decimal
-    assert(false && "function Decimal.add second arg need be Int or Decimal");
+    // 与Float相加（返回Float）
+    if (const auto another_float = dynamic_cast<Float*>(args->val[0])) {
+        const double left = decimal_to_double(self_dec->val);
+        return new Float(left + another_float->val);
+    }
+    // 仅允许Int/Decimal/Float
+    assert(false && "function Decimal.add second arg need be Int, Decimal or Float");
 }
 
-// Decimal.__sub__：减法（self - args[0]），支持Int/Decimal
+// Decimal.__sub__：减法（self - args[0]），支持Int/Decimal/Float
 Object* decimal_sub(Object* self, const List* args) {
     DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (decimal_sub)");
     assert(args->val.size() == 1 && "function Decimal.sub need 1 arg");
@@ -79,11 +91,16 @@ Object* decimal_sub(Object* self, const List* args) {
         dep::Decimal res = self_dec->val - another_dec->val;
         return new Decimal(res);
     }
-    // 仅允许Int/Decimal
-    assert(false && "function Decimal.sub second arg need be Int or Decimal");
+    // 与Float相减（返回Float）
+    if (const auto another_float = dynamic_cast<Float*>(args->val[0])) {
+        const double left = decimal_to_double(self_dec->val);
+        return new Float(left - another_float->val);
+    }
+    // 仅允许Int/Decimal/Float
+    assert(false && "function Decimal.sub second arg need be Int, Decimal or Float");
 }
 
-// Decimal.__mul__：乘法（self * args[0]），支持Int/Decimal
+// Decimal.__mul__：乘法（self * args[0]），支持Int/Decimal/Float
 Object* decimal_mul(Object* self, const List* args) {
     DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (decimal_mul)");
     assert(args->val.size() == 1 && "function Decimal.mul need 1 arg");
@@ -101,11 +118,16 @@ Object* decimal_mul(Object* self, const List* args) {
         dep::Decimal res = self_dec->val * another_dec->val;
         return new Decimal(res);
     }
-    // 仅允许Int/Decimal
-    assert(false && "function Decimal.mul second arg need be Int or Decimal");
+    // 与Float相乘（返回Float）
+    if (const auto another_float = dynamic_cast<Float*>(args->val[0])) {
+        const double left = decimal_to_double(self_dec->val);
+        return new Float(left * another_float->val);
+    }
+    // 仅允许Int/Decimal/Float
+    assert(false && "function Decimal.mul second arg need be Int, Decimal or Float");
 }
 
-// Decimal.__div__：除法（self / args[0]），支持Int/Decimal（默认保留10位小数）
+// Decimal.__div__：除法（self / args[0]），支持Int/Decimal（默认保留10位小数）与Float（返回Float）
 Object* decimal_div(Object* self, const List* args) {
     DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (decimal_div)");
     assert(args->val.size() == 1 && "function Decimal.div need 1 arg");
@@ -131,11 +153,16 @@ Object* decimal_div(Object* self, const List* args) {
         dep::Decimal res = self_dec->val.div(another_dec->val, 10); // 保留10位小数
         return new Decimal(res);
     }
-    // 仅允许Int/Decimal
-    assert(false && "function Decimal.div second arg need be Int or Decimal");
+    // 与Float相除（返回Float）
+    if (const auto another_float = dynamic_cast<Float*>(args->val[0])) {
+        const double left = decimal_to_double(self_dec->val);
+        return new Float(left / another_float->val);
+    }
+    // 仅允许Int/Decimal/Float
+    assert(false && "function Decimal.div second arg need be Int, Decimal or Float");
 }
 
-// Decimal.__pow__：幂运算（self ^ args[0]），仅支持Int类型的指数（非负）
+// Decimal.__pow__：幂运算（self ^ args[0]），支持Int类型的指数（非负）与Float指数
 Object* decimal_pow(Object* self, const List* args) {
     DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (decimal_pow)");
     assert(args->val.size() == 1 && "function Decimal.pow need 1 arg");
@@ -143,6 +170,12 @@ Object* decimal_pow(Object* self, const List* args) {
     const auto self_dec = dynamic_cast<Decimal*>(self);
     assert(self_dec != nullptr && "decimal_pow must be called by Decimal object");
 
+    // Float指数（返回Float）
+    if (const auto exp_float = dynamic_cast<Float*>(args->val[0])) {
+        const double base = decimal_to_double(self_dec->val);
+        return new Float(std::pow(base, exp_float->val));
+    }
+
     // 指数仅支持Int（非负）
     auto exp_int = dynamic_cast<Int*>(args->val[0]);
     assert(exp_int != nullptr && "function Decimal.pow second arg need be Int");
@@ -152,7 +185,7 @@ Object* decimal_pow(Object* self, const List* args) {
     return new Decimal(res);
 }
 
-// Decimal.__eq__：相等判断（self == args[0]），支持Int/Decimal
+// Decimal.__eq__：相等判断（self == args[0]），支持Int/Decimal/Float
 Object* decimal_eq(Object* self, const List* args) {
     DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (decimal_eq)");
     assert(args->val.size() == 1 && "function Decimal.eq need 1 arg");
@@ -169,11 +202,15 @@ Object* decimal_eq(Object* self, const List* args) {
     else if (auto another_dec = dynamic_cast<Decimal*>(args->val[0])) {
         return new Bool(self_dec->val == another_dec->val);
     }
-    // 仅允许Int/Decimal
-    assert(false && "function Decimal.eq second arg need be Int or Decimal");
+    // 与Float比较
+    if (const auto another_float = dynamic_cast<Float*>(args->val[0])) {
+        return new Bool(float_equals(another_float->val, self_dec));
+    }
+    // 仅允许Int/Decimal/Float
+    assert(false && "function Decimal.eq second arg need be Int, Decimal or Float");
 }
 
-// Decimal.__lt__：小于判断（self < args[0]），支持Int/Decimal
+// Decimal.__lt__：小于判断（self < args[0]），支持Int/Decimal/Float
 Object* decimal_lt(Object* self, const List* args) {
     DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (decimal_lt)");
     assert(args->val.size() == 1 && "function Decimal.lt need 1 arg");
@@ -190,11 +227,16 @@ Object* decimal_lt(Object* self, const List* args) {
     else if (auto another_dec = dynamic_cast<Decimal*>(args->val[0])) {
         return new Bool(self_dec->val < another_dec->val);
     }
-    // 仅允许Int/Decimal
-    assert(false && "function Decimal.lt second arg need be Int or Decimal");
+    // 与Float比较
+    if (const auto another_float = dynamic_cast<Float*>(args->val[0])) {
+        const double left = decimal_to_double(self_dec->val);
+        return new Bool(left < another_float->val);
+    }
+    // 仅允许Int/Decimal/Float
+    assert(false && "function Decimal.lt second arg need be Int, Decimal or Float");
 }
 
-// Decimal.__gt__：大于判断（self > args[0]），支持Int/Decimal
+// Decimal.__gt__：大于判断（self > args[0]），支持Int/Decimal/Float
 Object* decimal_gt(Object* self, const List* args) {
     DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (decimal_gt)");
     assert(args->val.size() == 1 && "function Decimal.gt need 1 arg");
@@ -211,8 +253,13 @@ Object* decimal_gt(Object* self, const List* args) {
     else if (auto another_dec = dynamic_cast<Decimal*>(args->val[0])) {
         return new Bool(self_dec->val > another_dec->val);
     }
-    // 仅允许Int/Decimal
-    assert(false && "function Decimal.gt second arg need be Int or Decimal");
+    // 与Float比较
+    if (const auto another_float = dynamic_cast<Float*>(args->val[0])) {
+        const double left = decimal_to_double(self_dec->val);
+        return new Bool(left > another_float->val);
+    }
+    // 仅允许Int/Decimal/Float
+    assert(false && "function Decimal.gt second arg need be Int, Decimal or Float");
 }
 
 // Decimal.__neg__：取反操作(-self)
@@ -230,10 +277,10 @@ Object* decimal_neg(Object* self, const List* args) {
     return new Decimal(neg_val);
 }
 
-// Decimal.__hash__
+// Decimal.__hash__：整数值与对应Int的哈希一致
 Object* decimal_hash(Object* self, const List* args) {
     const auto self_dec = dynamic_cast<Decimal*>(self);
-    return new Int(self_dec->val.hash());
+    return new Int(decimal_value_hash(self_dec->val));
 }
 
 
@@ -1,9 +1,18 @@
 #include "../../src/models/models.hpp"
 #include "include/builtin_functions.hpp"
+#include "include/builtin_methods.hpp"
 
 namespace model {
 
 dep::BigInt hash_object(Object* key_obj) {
+    // 元组直接取缓存的结构哈希, 与Tuple.__hash__结果一致
+    if (const auto key_tuple = dynamic_cast<Tuple*>(key_obj)) {
+        return dep::BigInt::from_int64(static_cast<int64_t>(key_tuple->hash()));
+    }
+    // 字符串取缓存的哈希, 与Str.__hash__结果一致
+    if (const auto key_str = dynamic_cast<String*>(key_obj)) {
+        return dep::BigInt(key_str->hash());
+    }
     // hash对象
     auto hash_method = kiz::Vm::get_attr(key_obj, "__hash__");
     kiz::Vm::call_function(hash_method, new List({}), key_obj);
@@ -12,35 +21,170 @@ dep::BigInt hash_object(Object* key_obj) {
     assert(result != nullptr);
 
     const auto result_int = dynamic_cast<Int*>(result);
-    assert(result_int != nullptr);
+    if (result_int == nullptr) throw NativeFuncError("TypeError", "__hash__ must return an integer");
     dep::BigInt key_hash_val = result_int->val;
     return key_hash_val;
 }
 
-// Dictionary.__add__：添加键值对 self + x（key: String，value: 任意Object），返回新Dictionary（不可变语义）
+// -------------------------- 哈希表 --------------------------
+int64_t Dictionary::str_find(const std::string_view key, const size_t hash) const {
+    if (str_index_.empty()) return -1;
+    const size_t mask = str_index_.size() - 1;
+    for (size_t pos = hash & mask;; pos = (pos + 1) & mask) {
+        const int32_t slot = str_index_[pos];
+        if (slot == empty_slot) return -1;
+        if (slot < 0) continue;
+        const auto& e = str_entries_[slot];
+        if (e.hash == hash and dynamic_cast<String*>(e.kv.first)->view() == key) return slot;
+    }
+}
+
+void Dictionary::str_rebuild(const size_t capacity) {
+    std::erase_if(str_entries_, [](const StrEntry& e) { return e.kv.first == nullptr; });
+    // 装载率不超过2/3, 保证探测总能遇到空槽
+    size_t size = 8;
+    while (size * 2 < capacity * 3) size *= 2;
+    str_index_.assign(size, empty_slot);
+    const size_t mask = size - 1;
+    for (size_t i = 0; i < str_entries_.size(); ++i) {
+        size_t pos = str_entries_[i].hash & mask;
+        while (str_index_[pos] != empty_slot) pos = (pos + 1) & mask;
+        str_index_[pos] = static_cast<int32_t>(i);
+    }
+}
+
+void Dictionary::generalize() {
+    generic_.reserve(str_count_);
+    for (const auto& e : str_entries_) {
+        if (e.kv.first != nullptr) generic_.insert(dep::BigInt(e.hash), e.kv);
+    }
+    str_entries_.clear();
+    str_entries_.shrink_to_fit();
+    str_index_.clear();
+    str_index_.shrink_to_fit();
+    str_count_ = 0;
+    str_mode_ = false;
+    ++version_;
+}
+
+Dictionary::Pair* Dictionary::find(Object* key) {
+    if (str_mode_) {
+        // Str表中只有Str键, 其他键必然不存在
+        const auto key_str = dynamic_cast<String*>(key);
+        if (key_str == nullptr) return nullptr;
+        const int64_t slot = str_find(key_str->view(), key_str->hash());
+        return slot < 0 ? nullptr : &str_entries_[slot].kv;
+    }
+    const auto node = generic_.find(hash_object(key));
+    return node ? &node->value : nullptr;
+}
+
+void Dictionary::insert(Object* key, Object* value) {
+    const auto key_str = dynamic_cast<String*>(key);
+    if (str_mode_ and key_str == nullptr) generalize();
+
+    if (!str_mode_) {
+        const dep::BigInt hash = hash_object(key);
+        // 键已存在时保留原键对象
+        if (const auto node = generic_.find(hash)) {
+            node->value.second = value;
+            return;
+        }
+        generic_.insert(hash, Pair{key, value});
+        ++version_;
+        return;
+    }
+
+    const size_t hash = key_str->hash();
+    const std::string_view key_view = key_str->view();
+    if (const int64_t slot = str_find(key_view, hash); slot >= 0) {
+        str_entries_[slot].kv.second = value;
+        return;
+    }
+    // 下标表中的非空槽位不多于str_entries_的长度
+    if ((str_entries_.size() + 1) * 3 > str_index_.size() * 2) str_rebuild(str_count_ + 1);
+
+    const size_t mask = str_index_.size() - 1;
+    size_t pos = hash & mask;
+    while (str_index_[pos] >= 0) pos = (pos + 1) & mask;
+    str_index_[pos] = static_cast<int32_t>(str_entries_.size());
+    str_entries_.push_back(StrEntry{hash, Pair{key, value}});
+    ++str_count_;
+    ++version_;
+}
+
+bool Dictionary::erase(Object* key) {
+    if (!str_mode_) {
+        if (!generic_.erase(hash_object(key))) return false;
+        ++version_;
+        return true;
+    }
+    const auto key_str = dynamic_cast<String*>(key);
+    if (key_str == nullptr or str_index_.empty()) return false;
+
+    const size_t hash = key_str->hash();
+    const std::string_view key_view = key_str->view();
+    const size_t mask = str_index_.size() - 1;
+    for (size_t pos = hash & mask;; pos = (pos + 1) & mask) {
+        const int32_t slot = str_index_[pos];
+        if (slot == empty_slot) return false;
+        if (slot < 0) continue;
+        auto& e = str_entries_[slot];
+        if (e.hash != hash or dynamic_cast<String*>(e.kv.first)->view() != key_view) continue;
+
+        e.kv = Pair{nullptr, nullptr};
+        str_index_[pos] = deleted_slot;
+        --str_count_;
+        ++version_;
+        return true;
+    }
+}
+
+void Dictionary::reserve(const size_t n) {
+    if (!str_mode_) {
+        generic_.reserve(n);
+        return;
+    }
+    str_entries_.reserve(n);
+    if (n * 3 > str_index_.size() * 2) {
+        str_rebuild(n);
+        ++version_;
+    }
+}
+
+const Dictionary::Pair* Dictionary::cursor_next(size_t& index, size_t& pos) const {
+    if (!str_mode_) {
+        const auto node = generic_.cursor_next(index, pos);
+        return node ? &node->value : nullptr;
+    }
+    for (; index < str_entries_.size(); ++index) {
+        if (str_entries_[index].kv.first != nullptr) return &str_entries_[index++].kv;
+    }
+    return nullptr;
+}
+
+// -------------------------- 原生方法 --------------------------
+
+// Dictionary.__add__：合并两个字典 self + x，x中的同名键覆盖self，返回新Dictionary（不可变语义）
 Object* dict_add(Object* self, const List* args) {
     DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (dict_add)");
-    assert(args->val.size() == 2 && "function Dictionary.add need 2 args: (key: String, value: Object)");
-    
+    assert(args->val.size() == 1 && "function Dictionary.__add__ need 1 arg: (other: Dictionary)");
+
     auto self_dict = dynamic_cast<Dictionary*>(self);
     assert(self_dict != nullptr && "dict_add must be called by Dictionary object");
-    
+
     auto another_dict = dynamic_cast<Dictionary*>(args->val[0]);
-    assert(another_dict != nullptr);
+    if (another_dict == nullptr) throw NativeFuncError("TypeError", "Dict can only be added with Dict");
 
-    auto self_dict_to_vec = self_dict->val.to_vector();
-    auto another_dict_to_vec = another_dict->val.to_vector();
+    // 按两者元素总数预留容量, 合并过程中不再扩容
+    auto new_dict = new Dictionary();
+    new_dict->reserve(self_dict->size() + another_dict->size());
+    const auto merge = [&](const Dictionary::Pair& kv_pair) {
+        new_dict->insert(kv_pair.first, kv_pair.second);
+    };
+    self_dict->for_each(merge);
+    another_dict->for_each(merge);
 
-    self_dict_to_vec.insert(
-        self_dict_to_vec.end(),
-        another_dict_to_vec.begin(),
-        another_dict_to_vec.end()
-    );
-    
-    auto new_dict = new Dictionary(dep::Dict(
-        self_dict_to_vec
-    ));
-    
     return new_dict;
 };
 
@@ -52,40 +196,147 @@ Object* dict_contains(Object* self, const List* args) {
     auto self_dict = dynamic_cast<Dictionary*>(self);
     assert(self_dict != nullptr && "dict_contains must be called by Dictionary object");
     
-    // 键
-    auto key_obj = args->val[0];
+    if (self_dict->find(args->val[0])) {
+        return new Bool(true);
+    }
+    return new Bool(false);
+};
 
-    auto hash_method = kiz::Vm::get_attr(key_obj, "__hash__");
-    kiz::Vm::call_function(hash_method, new List({}), key_obj);
+Object* dict_len(Object* self, const List* args) {
+    const auto self_dict = dynamic_cast<Dictionary*>(self);
+    assert(self_dict != nullptr && "dict_len must be called by Dictionary object");
+    return create_int(dep::BigInt(self_dict->size()));
+}
 
-    const auto result = kiz::Vm::fetch_one_from_stack_top();
-    assert(result != nullptr);
+// Dictionary.get(key, default=Nil)：键不存在时返回default
+Object* dict_get(Object* self, const List* args) {
+    const auto self_dict = dynamic_cast<Dictionary*>(self);
+    assert(self_dict != nullptr && "dict_get must be called by Dictionary object");
+    if (const auto found = self_dict->find(builtin::get_one_arg(args))) return found->second;
+    return args->val.size() > 1 ? args->val[1] : load_nil();
+}
 
-    const auto result_int = dynamic_cast<Int*>(result);
-    assert(result_int != nullptr);
-    dep::BigInt key_hash_val = result_int->val;
+// Dictionary.pop(key, default)：删除键并返回其值；键不存在时返回default，未给出default则报KeyError
+Object* dict_pop(Object* self, const List* args) {
+    const auto self_dict = dynamic_cast<Dictionary*>(self);
+    assert(self_dict != nullptr && "dict_pop must be called by Dictionary object");
+    const auto key_obj = builtin::get_one_arg(args);
 
-    auto found_pair_it = self_dict->val.find(
-        key_hash_val
-    );
+    const auto found = self_dict->find(key_obj);
+    if (!found) {
+        if (args->val.size() > 1) return args->val[1];
+        throw NativeFuncError("KeyError", "Undefined key " + key_obj->debug_string() + " in Dictionary object");
+    }
+    const auto value = found->second;
+    self_dict->erase(key_obj);
+    return value;
+}
 
-    if (found_pair_it) {
-        return new Bool(true);
+Object* dict_keys(Object* self, const List* args) {
+    const auto self_dict = dynamic_cast<Dictionary*>(self);
+    assert(self_dict != nullptr && "dict_keys must be called by Dictionary object");
+    return new DictView(self_dict, DictView::Kind::Keys);
+}
+
+Object* dict_values(Object* self, const List* args) {
+    const auto self_dict = dynamic_cast<Dictionary*>(self);
+    assert(self_dict != nullptr && "dict_values must be called by Dictionary object");
+    return new DictView(self_dict, DictView::Kind::Values);
+}
+
+Object* dict_items(Object* self, const List* args) {
+    const auto self_dict = dynamic_cast<Dictionary*>(self);
+    assert(self_dict != nullptr && "dict_items must be called by Dictionary object");
+    return new DictView(self_dict, DictView::Kind::Items);
+}
+
+// Dictionary.iter：按键遍历的迭代器，遍历中增删键会报RuntimeError
+Object* dict_iter(Object* self, const List* args) {
+    assert(dynamic_cast<Dictionary*>(self) != nullptr && "dict_iter must be called by Dictionary object");
+    return make_iterator(self);
+}
+
+static DictView* self_view(Object* self, const std::string& method) {
+    const auto view = dynamic_cast<DictView*>(self);
+    if (view == nullptr) {
+        throw NativeFuncError("TypeError", "DictView." + method + " must be called by DictView object");
     }
-    return new Bool(false);
-};
+    return view;
+}
+
+Object* dict_view_len(Object* self, const List* args) {
+    return create_int(dep::BigInt(self_view(self, "len")->dict->size()));
+}
+
+// keys按哈希查找；values逐个比较；items要求(key, value)元组且键存在、值相等
+Object* dict_view_contains(Object* self, const List* args) {
+    const auto view = self_view(self, "contains");
+    const auto target = builtin::get_one_arg(args);
+    switch (view->kind) {
+    case DictView::Kind::Keys:
+        return load_bool(view->dict->find(target) != nullptr);
+    case DictView::Kind::Values: {
+        bool found = false;
+        view->dict->for_each([&](const Dictionary::Pair& kv_pair) {
+            if (!found and kiz::Vm::is_equal(kv_pair.second, target)) found = true;
+        });
+        return load_bool(found);
+    }
+    case DictView::Kind::Items: {
+        const auto pair = dynamic_cast<Tuple*>(target);
+        if (pair == nullptr or pair->size() != 2) return load_bool(false);
+        const auto found = view->dict->find(pair->get(0));
+        return load_bool(found and kiz::Vm::is_equal(found->second, pair->get(1)));
+    }
+    }
+    return load_bool(false);
+}
+
+Object* dict_view_iter(Object* self, const List* args) {
+    return make_iterator(self_view(self, "iter"));
+}
+
+static Object* dict_view_to_str(Object* self, const bool debug) {
+    const auto view = self_view(self, debug ? "__dstr__" : "__str__");
+    const auto write = debug ? kiz::Vm::write_debug_str : kiz::Vm::write_str;
+    std::string result;
+    switch (view->kind) {
+    case DictView::Kind::Keys: result = "DictKeys(["; break;
+    case DictView::Kind::Values: result = "DictValues(["; break;
+    case DictView::Kind::Items: result = "DictItems(["; break;
+    }
+    bool first = true;
+    view->dict->for_each([&](const Dictionary::Pair& kv_pair) {
+        if (!first) result += ", ";
+        first = false;
+        switch (view->kind) {
+        case DictView::Kind::Keys: write(kv_pair.first, result); break;
+        case DictView::Kind::Values: write(kv_pair.second, result); break;
+        case DictView::Kind::Items:
+            result += '(';
+            write(kv_pair.first, result);
+            result += ", ";
+            write(kv_pair.second, result);
+            result += ')';
+            break;
+        }
+    });
+    result += "])";
+    return create_str(std::move(result));
+}
+
+Object* dict_view_str(Object* self, const List* args) {
+    return dict_view_to_str(self, false);
+}
+
+Object* dict_view_dstr(Object* self, const List* args) {
+    return dict_view_to_str(self, true);
+}
 
 Object* dict_setitem(Object* self, const List* args) {
     assert(args->val.size() == 2);
     auto self_dict = dynamic_cast<Dictionary*>(self);
-    auto key_obj = args->val[0];
-    auto value_obj = args->val[1];
-    dep::BigInt key_hash_val = hash_object(key_obj);
-
-    self_dict->val.insert(
-        key_hash_val,
-        std::pair{key_obj, value_obj}
-    );
+    self_dict->insert(args->val[0], args->val[1]);
     return new Nil();
 }
 
@@ -93,11 +344,8 @@ Object* dict_getitem(Object* self, const List* args) {
     auto self_dict = dynamic_cast<Dictionary*>(self);
     auto key_obj = builtin::get_one_arg(args);
 
-    dep::BigInt key_hash_val = hash_object(key_obj);
-
-    auto found_pair_it = self_dict->val.find(key_hash_val);
-    if (found_pair_it) {
-        return found_pair_it->value.second;
+    if (const auto found = self_dict->find(key_obj)) {
+        return found->second;
     }
 
     throw NativeFuncError("KeyError",
@@ -109,33 +357,31 @@ Object* dict_getitem(Object* self, const List* args) {
 Object* dict_str(Object* self, const List* args) {
     auto self_dict = dynamic_cast<Dictionary*>(self);
     std::string result = "{";
-    auto kv_list = self_dict->val.to_vector();
-    size_t i = 0;
-    for (auto& [_, kv_pair] : kv_list) {
-        result += kiz::Vm::obj_to_str(kv_pair.first) + ": " + kiz::Vm::obj_to_str(kv_pair.second);
-        if (i != kv_list.size() - 1) {
-            result += ", ";
-        }
-        ++i;
-    }
+    bool first = true;
+    self_dict->for_each([&](const Dictionary::Pair& kv_pair) {
+        if (!first) result += ", ";
+        first = false;
+        kiz::Vm::write_str(kv_pair.first, result);
+        result += ": ";
+        kiz::Vm::write_str(kv_pair.second, result);
+    });
     result += "}";
-    return create_str(result);
+    return create_str(std::move(result));
 }
 
 Object* dict_dstr(Object* self, const List* args) {
     auto self_dict = dynamic_cast<Dictionary*>(self);
     std::string result = "{";
-    auto kv_list = self_dict->val.to_vector();
-    size_t i = 0;
-    for (auto& [_, kv_pair] : kv_list) {
-        result += kiz::Vm::obj_to_debug_str(kv_pair.first) + ": " + kiz::Vm::obj_to_debug_str(kv_pair.second);
-        if (i != kv_list.size() - 1) {
-            result += ", ";
-        }
-        ++i;
-    }
+    bool first = true;
+    self_dict->for_each([&](const Dictionary::Pair& kv_pair) {
+        if (!first) result += ", ";
+        first = false;
+        kiz::Vm::write_debug_str(kv_pair.first, result);
+        result += ": ";
+        kiz::Vm::write_debug_str(kv_pair.second, result);
+    });
     result += "}";
-    return create_str(result);
+    return create_str(std::move(result));
 }
 
 }  // namespace model
\ No newline at end of file
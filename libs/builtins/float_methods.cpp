@@ -0,0 +1,122 @@
+#include <cstring>
+
+#include "../../src/models/models.hpp"
+#include "../../src/vm/vm.hpp"
+#include "include/builtin_methods.hpp"
+#include "include/builtin_functions.hpp"
+
+namespace model {
+
+// 取另一个操作数的双精度值, 仅允许Int/Decimal/Float
+static double other_operand(const List* args, const std::string& method) {
+    double val;
+    if (args->val.size() != 1 or !as_double(args->val[0], val)) {
+        throw NativeFuncError("TypeError", "function Float." + method + " second arg need be Int, Decimal or Float");
+    }
+    return val;
+}
+
+static double self_val(const Object* self) {
+    const auto self_float = dynamic_cast<const Float*>(self);
+    assert(self_float != nullptr && "Float method must be called by Float object");
+    return self_float->val;
+}
+
+// Float.__call__：构造Float对象（支持字符串/Int/Decimal/Float初始化）
+Object* float_call(Object* self, const List* args) {
+    auto a = builtin::get_one_arg(args);
+    double val = 0;
+
+    // 从String初始化（如 "1.5", "-2e10", "inf", "nan"）
+    if (auto s = dynamic_cast<String*>(a)) {
+        const std::string text(s->view());
+        char* end = nullptr;
+        val = std::strtod(text.c_str(), &end);
+        if (text.empty() or end != text.c_str() + text.size()) {
+            throw NativeFuncError("ValueError", "could not convert string to Float: '" + text + "'");
+        }
+    }
+    // 从Int/Decimal/Float初始化（就近舍入）
+    else if (as_double(a, val)) {}
+    // 假值（Nil/Bool(false)）初始化为0
+    else if (!kiz::Vm::is_true(a)) {
+        val = 0;
+    }
+
+    return new Float(val);
+}
+
+// Float.__bool__：非零判断（0.0与-0.0为false, nan为true）
+Object* float_bool(Object* self, const List* args) {
+    return new Bool(self_val(self) != 0);
+}
+
+// Float.__add__：加法（self + args[0]），结果为Float
+Object* float_add(Object* self, const List* args) {
+    return new Float(self_val(self) + other_operand(args, "add"));
+}
+
+// Float.__sub__：减法（self - args[0]）
+Object* float_sub(Object* self, const List* args) {
+    return new Float(self_val(self) - other_operand(args, "sub"));
+}
+
+// Float.__mul__：乘法（self * args[0]）
+Object* float_mul(Object* self, const List* args) {
+    return new Float(self_val(self) * other_operand(args, "mul"));
+}
+
+// Float.__div__：除法（self / args[0]），按IEEE-754, 除以0得到inf或nan
+Object* float_div(Object* self, const List* args) {
+    return new Float(self_val(self) / other_operand(args, "div"));
+}
+
+// Float.__mod__：取模（self % args[0]），结果与除数同号
+Object* float_mod(Object* self, const List* args) {
+    return new Float(floor_fmod(self_val(self), other_operand(args, "mod")));
+}
+
+// Float.__pow__：幂运算（self ^ args[0]）
+Object* float_pow(Object* self, const List* args) {
+    return new Float(std::pow(self_val(self), other_operand(args, "pow")));
+}
+
+// Float.__neg__：取反操作(-self)
+Object* float_neg(Object* self, const List* args) {
+    return new Float(-self_val(self));
+}
+
+// Float.__eq__：相等判断（nan与任何值都不相等）
+Object* float_eq(Object* self, const List* args) {
+    if (args->val.size() != 1) return new Bool(false);
+    return new Bool(float_equals(self_val(self), args->val[0]));
+}
+
+// Float.__lt__：小于判断（self < args[0]）
+Object* float_lt(Object* self, const List* args) {
+    return new Bool(self_val(self) < other_operand(args, "lt"));
+}
+
+// Float.__gt__：大于判断（self > args[0]）
+Object* float_gt(Object* self, const List* args) {
+    return new Bool(self_val(self) > other_operand(args, "gt"));
+}
+
+// Float.__hash__：与相等的Int/Decimal哈希一致(如 2.0f 与 2, 1.5f 与 1.5), nan/inf按位模式
+Object* float_hash(Object* self, const List* args) {
+    const double val = self_val(self);
+    if (val == 0) return new Int(dep::BigInt(0));
+    if (std::trunc(val) == val and std::abs(val) < 9.2e18) {
+        return new Int(dep::BigInt::from_int64(static_cast<int64_t>(val)));
+    }
+    if (dep::Decimal exact; exact_decimal(val, exact)) return new Int(decimal_value_hash(exact));
+    int64_t bits;
+    std::memcpy(&bits, &val, sizeof(bits));
+    return new Int(dep::BigInt::from_int64(bits));
+}
+
+Object* float_str(Object* self, const List* args) {
+    return create_str(dynamic_cast<Float*>(self)->debug_string());
+}
+
+}  // namespace model
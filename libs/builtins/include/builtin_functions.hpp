@@ -40,11 +40,19 @@ inline model::Object* check_based_object(model::Object* src_obj, model::Object*
 
 // 内置函数
 model::Object* print(model::Object* self, const model::List* args);
+model::Object* write(model::Object* self, const model::List* args);
+model::Object* flush(model::Object* self, const model::List* args);
 model::Object* input(model::Object* self, const model::List* args);
 model::Object* ischild(model::Object* self, const model::List* args);
 model::Object* help(model::Object* self, const model::List* args);
 model::Object* breakpoint(model::Object* self, const model::List* args);
 model::Object* range(model::Object* self, const model::List* args);
+model::Object* sorted(model::Object* self, const model::List* args);
+model::Object* sum(model::Object* self, const model::List* args);
+model::Object* min(model::Object* self, const model::List* args);
+model::Object* max(model::Object* self, const model::List* args);
+model::Object* any(model::Object* self, const model::List* args);
+model::Object* all(model::Object* self, const model::List* args);
 model::Object* cmd(model::Object* self, const model::List* args);
 model::Object* now(model::Object* self, const model::List* args);
 model::Object* setattr(model::Object* self, const model::List* args);
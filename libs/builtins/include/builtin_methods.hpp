@@ -37,6 +37,22 @@ Object* decimal_hash(Object* self, const List* args);
 Object* decimal_str(Object* self, const List* args);
 Object* decimal_safe_div(Object* self, const List* args);
 
+// Float类型原生函数
+Object* float_add(Object* self, const List* args);
+Object* float_sub(Object* self, const List* args);
+Object* float_mul(Object* self, const List* args);
+Object* float_div(Object* self, const List* args);
+Object* float_mod(Object* self, const List* args);
+Object* float_pow(Object* self, const List* args);
+Object* float_neg(Object* self, const List* args);
+Object* float_eq(Object* self, const List* args);
+Object* float_lt(Object* self, const List* args);
+Object* float_gt(Object* self, const List* args);
+Object* float_bool(Object* self, const List* args);
+Object* float_call(Object* self, const List* args);
+Object* float_hash(Object* self, const List* args);
+Object* float_str(Object* self, const List* args);
+
 // Nil 类型原生函数
 Object* nil_eq(Object* self, const List* args);
 Object* nil_hash(Object* self, const List* args);
@@ -71,6 +87,19 @@ Object* str_is_alaph(Object* self, const List* args);
 Object* str_is_digit(Object* self, const List* args);
 Object* str_to_lower(Object* self, const List* args);
 Object* str_to_upper(Object* self, const List* args);
+Object* str_find(Object* self, const List* args);
+Object* str_split(Object* self, const List* args);
+Object* str_replace(Object* self, const List* args);
+Object* str_join(Object* self, const List* args);
+Object* str_strip(Object* self, const List* args);
+
+// StrBuilder 类型原生函数
+Object* str_builder_call(Object* self, const List* args);
+Object* str_builder_str(Object* self, const List* args);
+Object* str_builder_append(Object* self, const List* args);
+Object* str_builder_join(Object* self, const List* args);
+Object* str_builder_len(Object* self, const List* args);
+Object* str_builder_clear(Object* self, const List* args);
 
 
 // Dict 类型原生函数
@@ -81,6 +110,20 @@ Object* dict_setitem(Object* self, const List* args);
 Object* dict_getitem(Object* self, const List* args);
 Object* dict_str(Object* self, const List* args);
 Object* dict_dstr(Object* self, const List* args);
+Object* dict_len(Object* self, const List* args);
+Object* dict_get(Object* self, const List* args);
+Object* dict_pop(Object* self, const List* args);
+Object* dict_keys(Object* self, const List* args);
+Object* dict_values(Object* self, const List* args);
+Object* dict_items(Object* self, const List* args);
+Object* dict_iter(Object* self, const List* args);
+
+// DictView 类型原生函数
+Object* dict_view_len(Object* self, const List* args);
+Object* dict_view_contains(Object* self, const List* args);
+Object* dict_view_iter(Object* self, const List* args);
+Object* dict_view_str(Object* self, const List* args);
+Object* dict_view_dstr(Object* self, const List* args);
 
 // List 类型原生函数
 Object* list_eq(Object* self, const List* args);
@@ -106,6 +149,66 @@ Object* list_map(Object* self, const List* args);
 Object* list_count(Object* self, const List* args);
 Object* list_len(Object* self, const List* args);
 Object* list_filter(Object* self, const List* args);
+Object* list_sort(Object* self, const List* args);
+Object* list_iter(Object* self, const List* args);
+
+// 稳定排序list, key_func为nullptr时按元素本身比较(List.sort与sorted共用)
+void sort_list(List* list, Object* key_func, bool reverse);
+
+// Iterator 类型原生函数
+Object* iterator_next(Object* self, const List* args);
+Object* iterator_iter(Object* self, const List* args);
+Object* iterator_map(Object* self, const List* args);
+Object* iterator_filter(Object* self, const List* args);
+Object* iterator_take(Object* self, const List* args);
+Object* iterator_zip(Object* self, const List* args);
+Object* iterator_enumerate(Object* self, const List* args);
+Object* iterator_chain(Object* self, const List* args);
+Object* iterator_collect(Object* self, const List* args);
+
+// 把List/Dict/迭代器/带__next__的对象包装为迭代器(已是迭代器时原样返回, Dict产出键)
+Iterator* make_iterator(Object* obj);
+// 原地遍历dict的迭代器, 记录当前修改计数
+Iterator* make_dict_iterator(Dictionary* dict, Iterator::Kind kind);
+// 取下一个元素, 耗尽时返回nullptr(for循环与各消费方法共用)
+Object* iterator_step(Iterator* it);
+// 剩余元素个数的估计(未知时为0), 用于预分配结果列表
+size_t iterator_size_hint(const Iterator* it);
+
+// Set 类型原生函数
+Object* set_call(Object* self, const List* args);
+Object* set_add(Object* self, const List* args);
+Object* set_remove(Object* self, const List* args);
+Object* set_discard(Object* self, const List* args);
+Object* set_contains(Object* self, const List* args);
+Object* set_len(Object* self, const List* args);
+Object* set_clear(Object* self, const List* args);
+Object* set_bool(Object* self, const List* args);
+Object* set_eq(Object* self, const List* args);
+Object* set_union(Object* self, const List* args);
+Object* set_intersection(Object* self, const List* args);
+Object* set_difference(Object* self, const List* args);
+Object* set_iter(Object* self, const List* args);
+Object* set_str(Object* self, const List* args);
+Object* set_dstr(Object* self, const List* args);
+
+// Tuple 类型原生函数
+Object* tuple_call(Object* self, const List* args);
+Object* tuple_getitem(Object* self, const List* args);
+Object* tuple_len(Object* self, const List* args);
+Object* tuple_contains(Object* self, const List* args);
+Object* tuple_eq(Object* self, const List* args);
+Object* tuple_hash(Object* self, const List* args);
+Object* tuple_bool(Object* self, const List* args);
+Object* tuple_iter(Object* self, const List* args);
+Object* tuple_str(Object* self, const List* args);
+Object* tuple_dstr(Object* self, const List* args);
+
+// Slice 类型原生函数
+Object* slice_indices(Object* self, const List* args);
+
+// 按序列长度解析切片, 返回元素个数(List与Str的__getitem__共用)
+size_t resolve_slice(const Slice* slice, size_t len, int64_t& start, int64_t& stop, int64_t& step);
 
 
 
@@ -8,7 +8,14 @@ namespace model {
 Object* int_call(Object* self, const List* args) {
     auto a = builtin::get_one_arg(args);
     dep::BigInt val(0);
-    if (auto s = dynamic_cast<String*>(a)) val = dep::BigInt(s->val);
+    if (auto s = dynamic_cast<String*>(a)) val = dep::BigInt(s->val());
+    // Float向零取整
+    else if (auto f = dynamic_cast<Float*>(a)) {
+        if (!std::isfinite(f->val)) throw NativeFuncError("ValueError", "cannot convert " + f->debug_string() + " to Int");
+        char buf[400];
+        const auto end = std::to_chars(buf, buf + sizeof(buf), std::trunc(f->val), std::chars_format::fixed).ptr;
+        val = dep::BigInt(std::string(buf, end));
+    }
     else if (!kiz::Vm::is_true(a)) val = dep::BigInt(0);
     return new Int(val);
 }
@@ -20,7 +27,7 @@ Object* int_bool(Object* self, const List* args) {
     return new Bool(true);
 }
 
-// Int.__add__ 整数加法：self + args[0]（仅支持Int/Decimal）
+// Int.__add__ 整数加法：self + args[0]（支持Int/Decimal/Float）
 Object* int_add(Object* self, const List* args) {
     DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments");
     assert(args->val.size() == 1 && "function Int.add need 1 arg");
@@ -39,11 +46,16 @@ Object* int_add(Object* self, const List* args) {
         dep::Decimal left_dec(self_int->val);
         return new Decimal(left_dec + another_dec->val);
     }
-    // 仅允许Int/Decimal
-    assert(false && "function Int.add second arg need be Int or Decimal");
+    // 与Float相加（返回Float）
+    if (const auto another_float = dynamic_cast<Float*>(args->val[0])) {
+        const double left = int_to_double(self_int->val);
+        return new Float(left + another_float->val);
+    }
+    // 仅允许Int/Decimal/Float
+    assert(false && "function Int.add second arg need be Int, Decimal or Float");
 };
 
-// Int.__sub__ 整数减法：self - args[0]（仅支持Int/Decimal）
+// Int.__sub__ 整数减法：self - args[0]（支持Int/Decimal/Float）
 Object* int_sub(Object* self, const List* args) {
     DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (int_sub)");
     assert(args->val.size() == 1 && "function Int.sub need 1 arg");
@@ -60,11 +72,16 @@ Object* int_sub(Object* self, const List* args) {
         dep::Decimal left_dec(self_int->val);
         return new Decimal(left_dec - another_dec->val);
     }
-    // 仅允许Int/Decimal
-    assert(false && "function Int.sub second arg need be Int or Decimal");
+    // 与Float相减（返回Float）
+    if (const auto another_float = dynamic_cast<Float*>(args->val[0])) {
+        const double left = int_to_double(self_int->val);
+        return new Float(left - another_float->val);
+    }
+    // 仅允许Int/Decimal/Float
+    assert(false && "function Int.sub second arg need be Int, Decimal or Float");
 };
 
-// Int.__mul__ 整数乘法：self * args[0]（仅支持Int/Decimal）
+// Int.__mul__ 整数乘法：self * args[0]（支持Int/Decimal/Float）
 Object* int_mul(Object* self, const List* args) {
     DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (int_mul)");
     assert(args->val.size() == 1 && "function Int.mul need 1 arg");
@@ -81,8 +98,13 @@ Object* int_mul(Object* self, const List* args) {
         dep::Decimal left_dec(self_int->val);
         return new Decimal(left_dec * another_dec->val);
     }
-    // 仅允许Int/Decimal
-    assert(false && "function Int.mul second arg need be Int or Decimal");
+    // 与Float相乘（返回Float）
+    if (const auto another_float = dynamic_cast<Float*>(args->val[0])) {
+        const double left = int_to_double(self_int->val);
+        return new Float(left * another_float->val);
+    }
+    // 仅允许Int/Decimal/Float
+    assert(false && "function Int.mul second arg need be Int, Decimal or Float");
 };
 
 // Int.__neg__ 取反
@@ -93,7 +115,7 @@ Object* int_neg(Object* self, const List* args) {
     return new Int(new_int);
 }
 
-// Int.__div__ 整数除法 self / args[0]（仅支持Int/Decimal，返回Decimal）
+// Int.__div__ 整数除法 self / args[0]（Int/Decimal返回Decimal，Float返回Float）
 Object* int_div(Object* self, const List* args) {
     DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (int_div)");
     assert(args->val.size() == 1 && "function Int.div need 1 arg");
@@ -114,16 +136,26 @@ Object* int_div(Object* self, const List* args) {
         dep::Decimal left_dec(self_int->val);
         return new Decimal(left_dec.div(another_dec->val, 10));
     }
-    // 仅允许Int/Decimal
-    assert(false && "function Int.div second arg need be Int or Decimal");
+    // 与Float相除（返回Float）
+    if (const auto another_float = dynamic_cast<Float*>(args->val[0])) {
+        const double left = int_to_double(self_int->val);
+        return new Float(left / another_float->val);
+    }
+    // 仅允许Int/Decimal/Float
+    assert(false && "function Int.div second arg need be Int, Decimal or Float");
 };
 
-// Int.__pow__ 整数幂运算：self ^ args[0]（self的args[0]次方，仅支持Int指数）
+// Int.__pow__ 整数幂运算：self ^ args[0]（self的args[0]次方，支持Int指数与Float指数）
 Object* int_pow(Object* self, const List* args) {
     DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (int_pow)");
     assert(args->val.size() == 1 && "function Int.pow need 1 arg");
 
     auto self_int = dynamic_cast<Int*>(self);
+    // Float指数（返回Float）
+    if (const auto exp_float = dynamic_cast<Float*>(args->val[0])) {
+        const double base = int_to_double(self_int->val);
+        return new Float(std::pow(base, exp_float->val));
+    }
     auto exp_int = dynamic_cast<Int*>(args->val[0]);
     assert(exp_int != nullptr && "function Int.pow second arg need be Int");
 
@@ -140,11 +172,17 @@ Object* int_pow(Object* self, const List* args) {
     }
 };
 
-// Int.__mod__ 整数取模：self % args[0]（仅支持Int）
+// Int.__mod__ 整数取模：self % args[0]（支持Int与Float）
 Object* int_mod(Object* self, const List* args) {
     DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (int_mod)");
     assert(args->val.size() == 1 && "function Int.mod need 1 arg");
 
+    // 与Float取模（返回Float）
+    if (const auto another_float = dynamic_cast<Float*>(args->val[0])) {
+        const double left = int_to_double(dynamic_cast<Int*>(self)->val);
+        return new Float(floor_fmod(left, another_float->val));
+    }
+
     auto another_int = dynamic_cast<Int*>(args->val[0]);
     assert(another_int != nullptr && "function Int.mod second arg need be Int");
     assert(another_int->val != dep::BigInt(0) && "mod by zero");
@@ -160,7 +198,7 @@ Object* int_mod(Object* self, const List* args) {
     return new Int(dep::BigInt(remainder));
 };
 
-// Int.__eq__ 相等判断：self == args[0]（仅支持Int/Decimal）
+// Int.__eq__ 相等判断：self == args[0]（支持Int/Decimal/Float）
 Object* int_eq(Object* self, const List* args) {
     DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (int_eq)");
     assert(args->val.size() == 1 && "function Int.eq need 1 arg");
@@ -177,11 +215,15 @@ Object* int_eq(Object* self, const List* args) {
         dep::Decimal cmp_val(self_int->val);
         return new Bool(cmp_val == another_dec->val);
     }
-    // 仅允许Int/Decimal
-    assert(false && "function Int.eq second arg need be Int or Decimal");
+    // 与Float比较
+    if (const auto another_float = dynamic_cast<Float*>(args->val[0])) {
+        return new Bool(float_equals(another_float->val, self_int));
+    }
+    // 仅允许Int/Decimal/Float
+    assert(false && "function Int.eq second arg need be Int, Decimal or Float");
 };
 
-// Int.__lt__ 小于判断：self < args[0]（仅支持Int/Decimal）
+// Int.__lt__ 小于判断：self < args[0]（支持Int/Decimal/Float）
 Object* int_lt(Object* self, const List* args) {
     DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (int_lt)");
     assert(args->val.size() == 1 && "function Int.lt need 1 arg");
@@ -198,11 +240,16 @@ Object* int_lt(Object* self, const List* args) {
         dep::Decimal cmp_val(self_int->val);
         return new Bool(cmp_val < another_dec->val);
     }
-    // 仅允许Int/Decimal
-    assert(false && "function Int.lt second arg need be Int or Decimal");
+    // 与Float比较
+    if (const auto another_float = dynamic_cast<Float*>(args->val[0])) {
+        const double left = int_to_double(self_int->val);
+        return new Bool(left < another_float->val);
+    }
+    // 仅允许Int/Decimal/Float
+    assert(false && "function Int.lt second arg need be Int, Decimal or Float");
 };
 
-// Int.__gt__ 大于判断：self > args[0]（仅支持Int/Decimal）
+// Int.__gt__ 大于判断：self > args[0]（支持Int/Decimal/Float）
 Object* int_gt(Object* self, const List* args) {
     DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (int_gt)");
     assert(args->val.size() == 1 && "function Int.gt need 1 arg");
@@ -219,8 +266,13 @@ Object* int_gt(Object* self, const List* args) {
         dep::Decimal cmp_val(self_int->val);
         return new Bool(cmp_val > another_dec->val);
     }
-    // 仅允许Int/Decimal
-    assert(false && "function Int.gt second arg need be Int or Decimal");
+    // 与Float比较
+    if (const auto another_float = dynamic_cast<Float*>(args->val[0])) {
+        const double left = int_to_double(self_int->val);
+        return new Bool(left > another_float->val);
+    }
+    // 仅允许Int/Decimal/Float
+    assert(false && "function Int.gt second arg need be Int, Decimal or Float");
 };
 
 // Int.__hash__
@@ -0,0 +1,284 @@
+#include "../../src/models/models.hpp"
+#include "include/builtin_functions.hpp"
+#include "include/builtin_methods.hpp"
+
+namespace model {
+
+// 把List/迭代器/带__iter__或__next__的对象统一包装为迭代器, 已是迭代器时原样返回
+Iterator* make_dict_iterator(Dictionary* dict, const Iterator::Kind kind) {
+    const auto it = new Iterator(kind, dict);
+    it->version = dict->version();
+    return it;
+}
+
+// 沿__parent__链查找属性, 不存在时返回nullptr
+static Object* find_attr(const Object* obj, const std::string& name) {
+    while (obj != nullptr) {
+        if (const auto attr = obj->attrs.find(name)) return attr->value;
+        const auto parent = obj->attrs.find(magic_name::parent);
+        obj = parent ? parent->value : nullptr;
+    }
+    return nullptr;
+}
+
+Iterator* make_iterator(Object* obj) {
+    if (const auto it = dynamic_cast<Iterator*>(obj)) return it;
+    if (obj->get_type() == Object::ObjectType::OT_List) {
+        return new Iterator(Iterator::Kind::ListSource, obj);
+    }
+    if (obj->get_type() == Object::ObjectType::OT_Set) {
+        return new Iterator(Iterator::Kind::SetSource, obj);
+    }
+    if (obj->get_type() == Object::ObjectType::OT_Tuple) {
+        return new Iterator(Iterator::Kind::TupleSource, obj);
+    }
+    // 直接遍历字典时产出键
+    if (const auto dict = dynamic_cast<Dictionary*>(obj)) {
+        return make_dict_iterator(dict, Iterator::Kind::DictKeys);
+    }
+    if (const auto view = dynamic_cast<DictView*>(obj)) {
+        switch (view->kind) {
+        case DictView::Kind::Keys: return make_dict_iterator(view->dict, Iterator::Kind::DictKeys);
+        case DictView::Kind::Values: return make_dict_iterator(view->dict, Iterator::Kind::DictValues);
+        case DictView::Kind::Items: return make_dict_iterator(view->dict, Iterator::Kind::DictItems);
+        }
+    }
+    // 有__iter__时每次遍历取一个新的迭代器, 各次遍历互不影响
+    if (const auto iter_func = find_attr(obj, magic_name::iter)) {
+        kiz::Vm::call_function(iter_func, new List({}), obj);
+        const auto res = kiz::Vm::fetch_one_from_stack_top();
+        if (const auto it = dynamic_cast<Iterator*>(res)) return it;
+        return new Iterator(Iterator::Kind::ObjectSource, res);
+    }
+    return new Iterator(Iterator::Kind::ObjectSource, obj);
+}
+
+// 以复用的参数列表调用回调, 返回回调结果
+static Object* call_with_slot(Iterator* it, Object* elem) {
+    it->arg_slot->val[0] = elem;
+    kiz::Vm::call_function(it->func, it->arg_slot, nullptr);
+    return kiz::Vm::fetch_one_from_stack_top();
+}
+
+Object* iterator_step(Iterator* it) {
+    if (it->exhausted) return nullptr;
+
+    switch (it->kind) {
+    case Iterator::Kind::ListSource: {
+        // 每次重新读取长度, 循环体中修改列表时与下标访问一致
+        const auto list = dynamic_cast<List*>(it->source);
+        if (it->index < list->size()) return list->get(it->index++);
+        break;
+    }
+    case Iterator::Kind::SetSource: {
+        // 跳过已删除的条目
+        const auto& entries = dynamic_cast<Set*>(it->source)->entries();
+        while (it->index < entries.size() and entries[it->index].kind == Set::Kind::Deleted) ++it->index;
+        if (it->index < entries.size()) return Set::box(entries[it->index++]);
+        break;
+    }
+    case Iterator::Kind::TupleSource: {
+        const auto tuple = dynamic_cast<Tuple*>(it->source);
+        if (it->index < tuple->size()) return tuple->get(it->index++);
+        break;
+    }
+    case Iterator::Kind::DictKeys:
+    case Iterator::Kind::DictValues:
+    case Iterator::Kind::DictItems: {
+        // 游标原地前进; 两步之间增删过键则游标已失效
+        const auto dict = dynamic_cast<Dictionary*>(it->source);
+        if (dict->version() != it->version) {
+            it->exhausted = true;
+            throw NativeFuncError("RuntimeError", "Dict changed size during iteration");
+        }
+        const auto kv = dict->cursor_next(it->index, it->limit);
+        if (kv == nullptr) break;
+        const auto& [key, value] = *kv;
+        if (it->kind == Iterator::Kind::DictKeys) return key;
+        if (it->kind == Iterator::Kind::DictValues) return value;
+        return Tuple::create({key, value});
+    }
+    case Iterator::Kind::ObjectSource: {
+        const auto next_func = kiz::Vm::get_attr(it->source, magic_name::next_item);
+        kiz::Vm::call_function(next_func, new List({}), it->source);
+        const auto res = kiz::Vm::fetch_one_from_stack_top();
+        if (res == unique_stop_iter) break;
+        // 兼容旧约定: 自定义的__next__返回Nil或False同样表示结束
+        if (dynamic_cast<NativeFunction*>(next_func) == nullptr) {
+            if (res->get_type() == Object::ObjectType::OT_Nil) break;
+            if (const auto b = dynamic_cast<Bool*>(res); b != nullptr and !b->val) break;
+        }
+        return res;
+    }
+    case Iterator::Kind::Map: {
+        const auto elem = iterator_step(static_cast<Iterator*>(it->source));
+        if (elem == nullptr) break;
+        return call_with_slot(it, elem);
+    }
+    case Iterator::Kind::Filter: {
+        while (const auto elem = iterator_step(static_cast<Iterator*>(it->source))) {
+            if (kiz::Vm::is_true(call_with_slot(it, elem))) return elem;
+        }
+        break;
+    }
+    case Iterator::Kind::Take: {
+        if (it->index >= it->limit) break;
+        const auto elem = iterator_step(static_cast<Iterator*>(it->source));
+        if (elem == nullptr) break;
+        ++it->index;
+        return elem;
+    }
+    case Iterator::Kind::Zip: {
+        const auto first = iterator_step(static_cast<Iterator*>(it->source));
+        if (first == nullptr) break;
+        const auto second = iterator_step(static_cast<Iterator*>(it->other));
+        if (second == nullptr) break;
+        return new List({first, second});
+    }
+    case Iterator::Kind::Enumerate: {
+        const auto elem = iterator_step(static_cast<Iterator*>(it->source));
+        if (elem == nullptr) break;
+        return new List({create_int(dep::BigInt(it->index++)), elem});
+    }
+    case Iterator::Kind::Chain: {
+        if (it->index == 0) {
+            if (const auto elem = iterator_step(static_cast<Iterator*>(it->source))) return elem;
+            it->index = 1;
+        }
+        if (const auto elem = iterator_step(static_cast<Iterator*>(it->other))) return elem;
+        break;
+    }
+    }
+
+    it->exhausted = true;
+    return nullptr;
+}
+
+size_t iterator_size_hint(const Iterator* it) {
+    if (it->exhausted) return 0;
+    const auto upstream = [](Object* obj) { return iterator_size_hint(static_cast<Iterator*>(obj)); };
+
+    switch (it->kind) {
+    case Iterator::Kind::ListSource: {
+        const size_t n = dynamic_cast<List*>(it->source)->size();
+        return it->index < n ? n - it->index : 0;
+    }
+    case Iterator::Kind::TupleSource: {
+        const size_t n = dynamic_cast<Tuple*>(it->source)->size();
+        return it->index < n ? n - it->index : 0;
+    }
+    case Iterator::Kind::SetSource: {
+        const auto set = dynamic_cast<Set*>(it->source);
+        return std::min(set->size(), set->entries().size() - std::min(it->index, set->entries().size()));
+    }
+    case Iterator::Kind::DictKeys:
+    case Iterator::Kind::DictValues:
+    case Iterator::Kind::DictItems:
+        // 桶内游标不记录已产出个数, 只在开始前给出准确值
+        return it->index == 0 and it->limit == 0 ? dynamic_cast<Dictionary*>(it->source)->size() : 0;
+    case Iterator::Kind::Map:
+    case Iterator::Kind::Enumerate:
+        return upstream(it->source);
+    case Iterator::Kind::Take:
+        return std::min(it->limit - it->index, upstream(it->source));
+    case Iterator::Kind::Zip:
+        return std::min(upstream(it->source), upstream(it->other));
+    case Iterator::Kind::Chain:
+        return (it->index == 0 ? upstream(it->source) : 0) + upstream(it->other);
+    default:
+        // filter与自定义__next__的长度无法预知
+        return 0;
+    }
+}
+
+// 取得self迭代器, 用于各适配器方法
+static Iterator* self_iterator(Object* self, const std::string& method) {
+    const auto it = dynamic_cast<Iterator*>(self);
+    if (it == nullptr) {
+        throw NativeFuncError("TypeError", "Iterator." + method + " must be called by Iterator object");
+    }
+    return it;
+}
+
+// 取得回调参数, 须为可调用对象
+static Object* callback_arg(const List* args, const std::string& method) {
+    const auto func = builtin::get_one_arg(args);
+    const auto type = func->get_type();
+    if (type != Object::ObjectType::OT_Function and type != Object::ObjectType::OT_CppFunction) {
+        throw NativeFuncError("TypeError", "Iterator." + method + " need a function argument");
+    }
+    return func;
+}
+
+// Iterator.__next__：返回下一个元素, 耗尽后返回StopIter
+Object* iterator_next(Object* self, const List* args) {
+    const auto elem = iterator_step(self_iterator(self, "__next__"));
+    if (elem == nullptr) return load_stop_iter();
+    return elem;
+}
+
+// Iterator.iter：迭代器本身即可迭代, 返回自身
+Object* iterator_iter(Object* self, const List* args) {
+    self->make_ref();
+    return self;
+}
+
+// Iterator.map：惰性地对每个元素调用func
+Object* iterator_map(Object* self, const List* args) {
+    const auto it = self_iterator(self, "map");
+    return new Iterator(Iterator::Kind::Map, it, nullptr, callback_arg(args, "map"));
+}
+
+// Iterator.filter：惰性地保留使func为真的元素
+Object* iterator_filter(Object* self, const List* args) {
+    const auto it = self_iterator(self, "filter");
+    return new Iterator(Iterator::Kind::Filter, it, nullptr, callback_arg(args, "filter"));
+}
+
+// Iterator.take：最多产出n个元素, 之后不再拉取上游
+Object* iterator_take(Object* self, const List* args) {
+    const auto it = self_iterator(self, "take");
+    const auto n_obj = dynamic_cast<Int*>(builtin::get_one_arg(args));
+    if (n_obj == nullptr) {
+        throw NativeFuncError("TypeError", "Iterator.take need an Int argument");
+    }
+    const auto taken = new Iterator(Iterator::Kind::Take, it);
+    taken->limit = n_obj->val < dep::BigInt(0) ? 0 : n_obj->val.to_unsigned_long_long();
+    return taken;
+}
+
+// Iterator.zip：与other(List/迭代器)逐个配对为[a, b], 任一方耗尽即结束
+Object* iterator_zip(Object* self, const List* args) {
+    const auto it = self_iterator(self, "zip");
+    const auto other = make_iterator(builtin::get_one_arg(args));
+    const auto zipped = new Iterator(Iterator::Kind::Zip, it, other);
+    if (other != args->val[0]) other->del_ref();
+    return zipped;
+}
+
+// Iterator.enumerate：产出[下标, 元素]
+Object* iterator_enumerate(Object* self, const List* args) {
+    return new Iterator(Iterator::Kind::Enumerate, self_iterator(self, "enumerate"));
+}
+
+// Iterator.chain：本迭代器耗尽后继续产出other(List/迭代器)的元素
+Object* iterator_chain(Object* self, const List* args) {
+    const auto it = self_iterator(self, "chain");
+    const auto other = make_iterator(builtin::get_one_arg(args));
+    const auto chained = new Iterator(Iterator::Kind::Chain, it, other);
+    if (other != args->val[0]) other->del_ref();
+    return chained;
+}
+
+// Iterator.collect：一次遍历整条链, 结果收集为List
+Object* iterator_collect(Object* self, const List* args) {
+    const auto it = self_iterator(self, "collect");
+    auto result = List::create_empty();
+    result->make_ref();
+    while (const auto elem = iterator_step(it)) {
+        result->append(elem);
+    }
+    return result;
+}
+
+}
@@ -1,18 +1,23 @@
 #include "../../src/models/models.hpp"
 #include "include/builtin_functions.hpp"
+#include "include/builtin_methods.hpp"
+
+#include <numeric>
+
+#include "../../deps/timsort.hpp"
 
 namespace model {
 
 // List.__call__
 Object* list_call(Object* self, const List* args) {
-    auto obj = new List({});
+    auto obj = List::create_empty();
     return obj;
 }
 
 // List.__bool__
 Object* list_bool(Object* self, const List* args) {
     const auto self_int = dynamic_cast<List*>(self);
-    if (self_int->val.empty()) return new Bool(false);
+    if (self_int->empty()) return new Bool(false);
     return new Bool(true);
 }
 
@@ -27,11 +32,11 @@ Object* list_add(Object* self, const List* args) {
     auto another_list = dynamic_cast<List*>(args->val[0]);
     assert(another_list != nullptr && "List.add only supports List type argument");
     
-    // 浅拷贝
-    std::vector<Object*> new_vals = self_list->val;
-    new_vals.insert(new_vals.end(), another_list->val.begin(), another_list->val.end());
-    
-    return new List(std::move(new_vals));
+    // 浅拷贝, 两侧策略相同时直接拼接拆箱数组
+    auto new_list = List::create_empty();
+    new_list->extend(*self_list);
+    new_list->extend(*another_list);
+    return new_list;
 };
 
 // List.__mul__：重复自身n次 self * n
@@ -46,15 +51,63 @@ Object* list_mul(Object* self, const List* args) {
     assert(times_int != nullptr && "List.mul only supports Int type argument");
     assert(times_int->val >= dep::BigInt(0) && "List.mul requires non-negative integer argument");
     
-    std::vector<Object*> new_vals;
+    auto new_list = List::create_empty();
     dep::BigInt times = times_int->val;
     for (dep::BigInt i = dep::BigInt(0); i < times; i+=dep::BigInt(1)) {
-        new_vals.insert(new_vals.end(), self_list->val.begin(), self_list->val.end());
+        new_list->extend(*self_list);
     }
     
-    return new List(std::move(new_vals));
+    return new_list;
 };
 
+// 依次回调与target相等的元素下标, on_match返回false时停止;
+// 拆箱存储按原生值比较, 其余元素走 Vm::is_equal
+template <typename F>
+static void for_each_equal(const List* list, Object* target, F on_match) {
+    const auto target_type = target->get_type();
+    switch (list->strategy()) {
+    case List::Strategy::Empty:
+        return;
+    case List::Strategy::Int: {
+        if (target_type == Object::ObjectType::OT_Decimal or target_type == Object::ObjectType::OT_Float) break;
+        int64_t v;
+        // 非整数或超出int64的整数不可能与数组元素相等
+        if (target_type != Object::ObjectType::OT_Int or !dynamic_cast<Int*>(target)->val.to_int64(v)) return;
+        const auto& ints = list->ints();
+        for (size_t i = 0; i < ints.size(); ++i) {
+            if (ints[i] == v and !on_match(i)) return;
+        }
+        return;
+    }
+    case List::Strategy::Decimal: {
+        dep::Decimal v;
+        if (target_type == Object::ObjectType::OT_Decimal) v = dynamic_cast<Decimal*>(target)->val;
+        else if (target_type == Object::ObjectType::OT_Int) v = dep::Decimal(dynamic_cast<Int*>(target)->val);
+        else if (target_type == Object::ObjectType::OT_Float) break;
+        else return;
+        const auto& decimals = list->decimals();
+        for (size_t i = 0; i < decimals.size(); ++i) {
+            if (decimals[i] == v and !on_match(i)) return;
+        }
+        return;
+    }
+    case List::Strategy::Str: {
+        if (target_type != Object::ObjectType::OT_String) return;
+        const std::string_view v = dynamic_cast<String*>(target)->val();
+        const auto& strs = list->strs();
+        for (size_t i = 0; i < strs.size(); ++i) {
+            if (strs[i] == v and !on_match(i)) return;
+        }
+        return;
+    }
+    default:
+        break;
+    }
+    for (size_t i = 0; i < list->size(); ++i) {
+        if (kiz::Vm::is_equal(list->get(i), target) and !on_match(i)) return;
+    }
+}
+
 // List.__eq__：判断两个List是否相等
 Object* list_eq(Object* self, const List* args) {
     DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (list_eq)");
@@ -63,75 +116,44 @@ Object* list_eq(Object* self, const List* args) {
     auto self_list = dynamic_cast<List*>(self);
     assert(self_list != nullptr && "list_eq must be called by List object");
     
-    auto another_list = dynamic_cast<List*>(args->val[0]);
-    assert(another_list != nullptr && "List.eq only supports List type argument");
-    
-    // 比较元素个数，不同直接返回false
-    if (self_list->val.size() != another_list->val.size()) {
-        return load_false();
-    }
-    
-    // 逐个比较元素
-    for (size_t i = 0; i < self_list->val.size(); ++i) {
-        Object* self_elem = self_list->val[i];
-        Object* another_elem = another_list->val[i];
-
-        // 获取当前元素的 __eq__ 方法
-        const auto elem_eq_method = kiz::Vm::get_attr(self_elem, "__eq__");
-        assert(elem_eq_method != nullptr && "Element must implement __eq__ method");
-        
-        // 调用 __eq__
-        kiz::Vm::call_function(
-            elem_eq_method, new List({another_elem}), self_elem
-        );
-        const auto eq_result = kiz::Vm::fetch_one_from_stack_top();
-
-        // 解析比较结果
-        const auto eq_bool = dynamic_cast<Bool*>(eq_result);
-        assert(eq_bool != nullptr && "__eq__ method must return Bool type");
-        
-        // 任意元素不相等，返回 false
-        if (!eq_bool->val) {
-            return load_false();
-        }
-    }
-    
-    // 所有元素均相等，返回 true
-    return load_true();
+    // 长度/拆箱数组/逐元素比较均由相等协议处理, 非List参数直接不相等
+    return load_bool(kiz::Vm::is_equal(self_list, args->val[0]));
 };
 
 Object* list_str(Object* self, const List* args) {
     auto self_list = dynamic_cast<List*>(self);
     std::string result = "[";
-    for (size_t i = 0; i < self_list->val.size(); ++i) {
-        if (self_list->val[i] != nullptr) {
-            result += kiz::Vm::obj_to_str(self_list->val[i]);
+    const bool unboxed = self_list->strategy() != List::Strategy::Generic;
+    for (size_t i = 0; i < self_list->size(); ++i) {
+        if (i != 0) result += ", ";
+        if (unboxed) {
+            self_list->write_unboxed(i, result, false);
+        } else if (self_list->val[i] != nullptr) {
+            kiz::Vm::write_str(self_list->val[i], result);
         } else {
             result += "Nil";
         }
-        if (i != self_list->val.size() - 1) {
-            result += ", ";
-        }
     }
     result += "]";
-    return create_str(result);
+    return create_str(std::move(result));
 }
 
 Object* list_dstr(Object* self, const List* args) {
     auto self_list = dynamic_cast<List*>(self);
     std::string result = "[";
-    for (size_t i = 0; i < self_list->val.size(); ++i) {
-        if (self_list->val[i] != nullptr) {
-            result += kiz::Vm::obj_to_debug_str(self_list->val[i]);
+    const bool unboxed = self_list->strategy() != List::Strategy::Generic;
+    for (size_t i = 0; i < self_list->size(); ++i) {
+        if (i != 0) result += ", ";
+        if (unboxed) {
+            self_list->write_unboxed(i, result, true);
+        } else if (self_list->val[i] != nullptr) {
+            kiz::Vm::write_debug_str(self_list->val[i], result);
         } else {
             result += "Nil";
         }
-        if (i != self_list->val.size() - 1) {
-            result += ", ";
-        }
     }
     result += "]";
-    return create_str(result);
+    return create_str(std::move(result));
 }
 
 // List.contains：判断列表是否包含目标元素
@@ -145,21 +167,12 @@ Object* list_contains(Object* self, const List* args) {
     Object* target_elem = args->val[0];
     assert(target_elem != nullptr && "List.contains target argument cannot be nullptr");
     
-    // 遍历列表元素，逐个判断是否与目标元素相等
-    for (Object* elem : self_list->val) {
-        const auto elem_eq_method = kiz::Vm::get_attr(elem, "__eq__");
-
-        kiz::Vm::call_function(
-            elem_eq_method, new List({target_elem}), elem
-        );
-        const auto result = kiz::Vm::fetch_one_from_stack_top();
-
-        // 找到匹配元素，立即返回true
-        if (kiz::Vm::is_true(result)) return new Bool(true);
-    }
-    
-    // 遍历完未找到匹配元素，返回false
-    return new Bool(false);
+    bool found = false;
+    for_each_equal(self_list, target_elem, [&](size_t) {
+        found = true;
+        return false;
+    });
+    return new Bool(found);
 };
 
 // List.append：向列表尾部添加一个元素
@@ -173,9 +186,8 @@ Object* list_append(Object* self, const List* args) {
     Object* elem_to_add = args->val[0];
     assert(elem_to_add != nullptr && "List.append argument cannot be nullptr");
     
-    // 添加元素到列表尾部
-    self_list->val.push_back(elem_to_add);
-    elem_to_add->make_ref();
+    // 添加元素到列表尾部(同类元素拆箱存储)
+    self_list->append(elem_to_add);
     
     // 返回列表自身，支持链式调用
     self->make_ref();
@@ -191,13 +203,13 @@ Object* list_next(Object* self, const List* args) {
     auto index =  cast_to_int(curr_idx) ->val.to_unsigned_long_long();
 
     auto self_list = dynamic_cast<List*>(self);
-    if (index < self_list->val.size()) {
-        auto res = self_list->val[index];
+    if (index < self_list->size()) {
+        auto res = self_list->get(index);
         self->attrs.insert("__current_index__", new Int(index+1));
         return res;
     }
     self->attrs.insert("__current_index__", new Int(0));
-    return new Bool(false);
+    return load_stop_iter();
 }
 
 Object* list_foreach(Object* self, const List* args) {
@@ -206,10 +218,11 @@ Object* list_foreach(Object* self, const List* args) {
     auto self_list = dynamic_cast<List*>(self);
     assert(self_list != nullptr);
 
-    dep::BigInt idx = 0;
-    for (auto e : self_list->val) {
-        kiz::Vm::call_function(func_obj, new List({e}), nullptr);
-        idx += 1;
+    // 整个遍历复用同一个参数列表
+    const auto arg_slot = new List({nullptr});
+    for (size_t i = 0; i < self_list->size(); ++i) {
+        arg_slot->val[0] = self_list->get(i);
+        kiz::Vm::call_function(func_obj, arg_slot, nullptr);
     }
     return new Nil();
 }
@@ -217,7 +230,7 @@ Object* list_foreach(Object* self, const List* args) {
 Object* list_reverse(Object* self, const List* args) {
     const auto self_list = dynamic_cast<List*>(self);
     assert(self_list != nullptr);
-    std::ranges::reverse(self_list->val);
+    self_list->reverse();
     return new Nil();
 }
 
@@ -228,16 +241,14 @@ Object* list_extend(Object* self, const List* args) {
 
     auto self_list = dynamic_cast<List*>(self);
     assert(self_list != nullptr);
-    for (auto e: other_list->val) {
-        self_list->val.push_back(e);
-    }
+    self_list->extend(*other_list);
     return new Nil();
 }
 
 Object* list_pop(Object* self, const List* args) {
     auto self_list = dynamic_cast<List*>(self);
     assert(self_list != nullptr);
-    self_list->val.pop_back();
+    self_list->pop_back();
     return new Nil();
 }
 
@@ -250,8 +261,8 @@ Object* list_insert(Object* self, const List* args) {
         auto idx_int = dynamic_cast<Int*>(idx_obj);
         assert(idx_int != nullptr);
         auto idx = idx_int->val.to_unsigned_long_long();
-        if (idx < self_list->val.size()) {
-            self_list->val[idx] = value_obj;
+        if (idx < self_list->size()) {
+            self_list->set(idx, value_obj);
         }
     }
     return new Nil();
@@ -265,35 +276,66 @@ Object* list_setitem(Object* self, const List* args) {
     auto index = idx_obj->val.to_unsigned_long_long();
 
     auto value_obj = args->val[1];
-    self_list->val[index] = value_obj;
+    self_list->set(index, value_obj);
     return new Nil();
 }
 
 Object* list_getitem(Object* self, const List* args) {
     auto self_list = dynamic_cast<List*>(self);
+    // 切片: 按当前存储策略直接复制选中区间, 拆箱列表不产生中间对象
+    if (const auto slice = dynamic_cast<Slice*>(builtin::get_one_arg(args))) {
+        int64_t start, stop, step;
+        const size_t count = resolve_slice(slice, self_list->size(), start, stop, step);
+        return self_list->slice(static_cast<size_t>(start), step, count);
+    }
     auto idx_obj = dynamic_cast<Int*>(builtin::get_one_arg(args));
     assert(idx_obj != nullptr);
 
     auto index = idx_obj->val.to_unsigned_long_long();
-    return self_list->val[index];
+    return self_list->get(index);
 }
 
+// List.count：统计与目标相等的元素个数
 Object* list_count(Object* self, const List* args) {
-    return new Nil();
+    auto self_list = dynamic_cast<List*>(self);
+    assert(self_list != nullptr && "list_count must be called by List object");
+
+    size_t count = 0;
+    for_each_equal(self_list, builtin::get_one_arg(args), [&](size_t) {
+        ++count;
+        return true;
+    });
+    return create_int(dep::BigInt(count));
 }
 
+// List.find：参数为函数时返回第一个使其为真的元素(找不到返回Nil);
+// 否则返回第一个与参数相等的元素下标(找不到返回-1)
 Object* list_find(Object* self, const List* args) {
     auto func_obj = builtin::get_one_arg(args);
 
     auto self_list = dynamic_cast<List*>(self);
     assert(self_list != nullptr);
 
-    for (auto e : self_list->val) {
-        kiz::Vm::call_function(func_obj, new List({e}), nullptr);
+    const auto arg_type = func_obj->get_type();
+    if (arg_type != Object::ObjectType::OT_Function and arg_type != Object::ObjectType::OT_CppFunction) {
+        size_t index = SIZE_MAX;
+        for_each_equal(self_list, func_obj, [&](const size_t i) {
+            index = i;
+            return false;
+        });
+        if (index == SIZE_MAX) return create_int(dep::BigInt(0) - dep::BigInt(1));
+        return create_int(dep::BigInt(index));
+    }
+
+    const auto arg_slot = new List({nullptr});
+    for (size_t i = 0; i < self_list->size(); ++i) {
+        auto e = self_list->get(i);
+        arg_slot->val[0] = e;
+        kiz::Vm::call_function(func_obj, arg_slot, nullptr);
         auto res = kiz::Vm::fetch_one_from_stack_top();
         if (kiz::Vm::is_true(res)) {
-            res->make_ref();
-            return res;
+            e->make_ref();
+            return e;
         }
     }
     return new Nil();
@@ -305,15 +347,19 @@ Object* list_map(Object* self, const List* args) {
     auto self_list = dynamic_cast<List*>(self);
     assert(self_list != nullptr);
 
-    std::vector<Object*> new_vec;
+    // 结果同类时保持拆箱存储
+    auto new_list = List::create_empty();
+    new_list->make_ref();
 
-    for (auto e : self_list->val) {
-        kiz::Vm::call_function(func_obj, new List({e}), nullptr);
+    const auto arg_slot = new List({nullptr});
+    for (size_t i = 0; i < self_list->size(); ++i) {
+        arg_slot->val[0] = self_list->get(i);
+        kiz::Vm::call_function(func_obj, arg_slot, nullptr);
         auto res = kiz::Vm::fetch_one_from_stack_top();
         
-        new_vec.push_back(res);
+        new_list->append(res);
     }
-    return create_list(new_vec);
+    return new_list;
 }
 
 Object* list_filter(Object* self, const List* args) {
@@ -322,22 +368,174 @@ Object* list_filter(Object* self, const List* args) {
     auto self_list = dynamic_cast<List*>(self);
     assert(self_list != nullptr);
 
-    std::vector<Object*> new_vec;
+    auto new_list = List::create_empty();
+    new_list->make_ref();
 
-    for (auto e : self_list->val) {
-        kiz::Vm::call_function(func_obj, new List({e}), nullptr);
+    const auto arg_slot = new List({nullptr});
+    for (size_t i = 0; i < self_list->size(); ++i) {
+        auto e = self_list->get(i);
+        arg_slot->val[0] = e;
+        kiz::Vm::call_function(func_obj, arg_slot, nullptr);
         auto res = kiz::Vm::fetch_one_from_stack_top();
         if (kiz::Vm::is_true(res)) {
-            new_vec.push_back(res);
+            new_list->append(e);
         }
     }
-    return create_list(new_vec);
+    return new_list;
+}
+
+// 排序键的比较方式, 由一次预扫描确定
+enum class SortKeyKind { Int64, BigInt, Numeric, Str, Generic };
+
+static SortKeyKind classify_sort_keys(const std::vector<Object*>& keys) {
+    bool all_int64 = true, all_int = true, all_numeric = true, all_str = true;
+    for (const auto key : keys) {
+        switch (key->get_type()) {
+        case Object::ObjectType::OT_Int: {
+            int64_t v;
+            if (!dynamic_cast<Int*>(key)->val.to_int64(v)) all_int64 = false;
+            all_str = false;
+            break;
+        }
+        case Object::ObjectType::OT_Decimal:
+            all_int64 = all_int = all_str = false;
+            break;
+        case Object::ObjectType::OT_String:
+            all_int64 = all_int = all_numeric = false;
+            break;
+        default:
+            return SortKeyKind::Generic;
+        }
+    }
+    if (all_int64) return SortKeyKind::Int64;
+    if (all_int) return SortKeyKind::BigInt;
+    if (all_numeric) return SortKeyKind::Numeric;
+    if (all_str) return SortKeyKind::Str;
+    return SortKeyKind::Generic;
+}
+
+// 通过VM调用 a.__lt__(b)
+static bool vm_less(Object* a, Object* b) {
+    kiz::Vm::call_function(kiz::Vm::get_attr(a, "__lt__"), new List({b}), a);
+    return kiz::Vm::is_true(kiz::Vm::fetch_one_from_stack_top());
+}
+
+// 对值数组原地稳定排序; reverse时比较取反, 相等元素仍保持原顺序
+template <typename T, typename Less>
+static void sort_values(std::vector<T>& values, Less less, const bool reverse) {
+    if (reverse) dep::timsort(values, [&](const T& a, const T& b) { return less(b, a); });
+    else dep::timsort(values, less);
+}
+
+// 按键排序下标; 只重排下标, 比较出错时原列表不受影响
+template <typename Key, typename Less>
+static std::vector<size_t> sorted_order(const std::vector<Key>& keys, Less less, const bool reverse) {
+    std::vector<size_t> order(keys.size());
+    std::iota(order.begin(), order.end(), size_t{0});
+    sort_values(order, [&](const size_t a, const size_t b) { return less(keys[a], keys[b]); }, reverse);
+    return order;
+}
+
+void sort_list(List* list, Object* key_func, const bool reverse) {
+    const size_t n = list->size();
+    if (n < 2) return;
+
+    // 无key的拆箱列表直接排序底层数组
+    if (key_func == nullptr) {
+        switch (list->strategy()) {
+        case List::Strategy::Int:
+            sort_values(list->ints(), std::less<int64_t>{}, reverse);
+            return;
+        case List::Strategy::Decimal:
+            sort_values(list->decimals(), [](const dep::Decimal& a, const dep::Decimal& b) { return a < b; }, reverse);
+            return;
+        case List::Strategy::Str:
+            sort_values(list->strs(), std::less<std::string>{}, reverse);
+            return;
+        default:
+            break;
+        }
+    }
+
+    // 每个元素只计算一次键(decorate-sort-undecorate)
+    std::vector<Object*> keys;
+    keys.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+        Object* elem = list->get(i);
+        if (key_func != nullptr) {
+            kiz::Vm::call_function(key_func, new List({elem}), nullptr);
+            keys.push_back(kiz::Vm::fetch_one_from_stack_top());
+        } else {
+            keys.push_back(elem);
+        }
+    }
+
+    std::vector<size_t> order;
+    switch (classify_sort_keys(keys)) {
+    case SortKeyKind::Int64: {
+        std::vector<int64_t> native_keys;
+        native_keys.reserve(n);
+        // classify_sort_keys已确认各键可转为int64
+        for (const auto key : keys) static_cast<void>(dynamic_cast<Int*>(key)->val.to_int64(native_keys.emplace_back()));
+        order = sorted_order(native_keys, std::less<int64_t>{}, reverse);
+        break;
+    }
+    case SortKeyKind::BigInt: {
+        std::vector<const dep::BigInt*> native_keys;
+        native_keys.reserve(n);
+        for (const auto key : keys) native_keys.push_back(&dynamic_cast<Int*>(key)->val);
+        order = sorted_order(native_keys, [](const dep::BigInt* a, const dep::BigInt* b) { return *a < *b; }, reverse);
+        break;
+    }
+    case SortKeyKind::Numeric: {
+        std::vector<dep::Decimal> native_keys;
+        native_keys.reserve(n);
+        for (const auto key : keys) {
+            if (const auto key_int = dynamic_cast<Int*>(key)) native_keys.emplace_back(key_int->val);
+            else native_keys.push_back(dynamic_cast<Decimal*>(key)->val);
+        }
+        order = sorted_order(native_keys, [](const dep::Decimal& a, const dep::Decimal& b) { return a < b; }, reverse);
+        break;
+    }
+    case SortKeyKind::Str: {
+        std::vector<std::string_view> native_keys;
+        native_keys.reserve(n);
+        for (const auto key : keys) native_keys.emplace_back(dynamic_cast<String*>(key)->val());
+        order = sorted_order(native_keys, std::less<std::string_view>{}, reverse);
+        break;
+    }
+    case SortKeyKind::Generic:
+        order = sorted_order(keys, vm_less, reverse);
+        break;
+    }
+    list->permute(order);
+}
+
+// List.sort(key=Nil, reverse=False)：原地稳定排序
+Object* list_sort(Object* self, const List* args) {
+    auto self_list = dynamic_cast<List*>(self);
+    assert(self_list != nullptr && "list_sort must be called by List object");
+
+    Object* key_func = nullptr;
+    if (!args->val.empty() and args->val[0]->get_type() != Object::ObjectType::OT_Nil) {
+        key_func = args->val[0];
+    }
+    const bool reverse = args->val.size() > 1 and kiz::Vm::is_true(args->val[1]);
+
+    sort_list(self_list, key_func, reverse);
+    return new Nil();
+}
+
+// List.iter：返回按下标读取本列表的惰性迭代器
+Object* list_iter(Object* self, const List* args) {
+    assert(dynamic_cast<List*>(self) != nullptr && "list_iter must be called by List object");
+    return new Iterator(Iterator::Kind::ListSource, self);
 }
 
 Object* list_len(Object* self, const List* args) {
     auto self_list = dynamic_cast<List*>(self);
     assert(self_list != nullptr);
-    return create_int(dep::BigInt(self_list->val.size()));
+    return create_int(dep::BigInt(self_list->size()));
 }
 
 }  // namespace model
\ No newline at end of file
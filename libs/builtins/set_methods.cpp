@@ -0,0 +1,324 @@
+#include <cmath>
+
+#include "../../src/models/models.hpp"
+#include "include/builtin_functions.hpp"
+#include "include/builtin_methods.hpp"
+
+namespace model {
+
+// -------------------------- 哈希表 --------------------------
+// 值为整数且在int64范围内的Float/Decimal(如 2.0f), 与对应Int相等, 取出其整数值
+static bool integral_value(const Object* elem, int64_t& out) {
+    if (const auto elem_float = dynamic_cast<const Float*>(elem)) {
+        const double v = elem_float->val;
+        if (std::trunc(v) != v or !(std::abs(v) < 9.2e18)) return false;
+        out = static_cast<int64_t>(v);
+        return true;
+    }
+    if (const auto elem_dec = dynamic_cast<const Decimal*>(elem)) {
+        // 归一化后尾数无末尾零, 指数非负即为整数
+        const int exponent = elem_dec->val.exponent();
+        if (exponent < 0 or exponent > 18 or !elem_dec->val.mantissa().to_int64(out)) return false;
+        for (int i = 0; i < exponent; ++i) {
+            if (__builtin_mul_overflow(out, 10, &out)) return false;
+        }
+        return true;
+    }
+    return false;
+}
+
+Set::Key Set::key_of(Object* elem) {
+    if (const auto elem_int = dynamic_cast<Int*>(elem)) {
+        int64_t v;
+        if (elem_int->val.to_int64(v)) return int_key(v);
+    }
+    // 与Dict和==一致: 整数值的Float/Decimal按对应的Int键保存
+    if (int64_t v; integral_value(elem, v)) return int_key(v);
+    if (const auto elem_str = dynamic_cast<String*>(elem)) {
+        return str_key(elem_str->view(), elem_str->hash());
+    }
+    // 元组使用缓存的结构哈希
+    if (const auto elem_tuple = dynamic_cast<Tuple*>(elem)) {
+        return Key{elem_tuple->hash(), Kind::Object, 0, {}, elem};
+    }
+
+    // 其他对象经过__hash__, 结果超出int64时按十进制串哈希
+    kiz::Vm::call_function(kiz::Vm::get_attr(elem, magic_name::hash), new List({}), elem);
+    const auto result = dynamic_cast<Int*>(kiz::Vm::fetch_one_from_stack_top());
+    if (result == nullptr) throw NativeFuncError("TypeError", "__hash__ must return an integer");
+    int64_t v;
+    const size_t hash = result->val.to_int64(v) ? hash_int(v) : dep::hash_string(result->val.to_string());
+    return Key{hash, Kind::Object, 0, {}, elem};
+}
+
+bool Set::key_equals(const Entry& e, const Key& key) {
+    if (e.kind != key.kind) return false;
+    switch (e.kind) {
+    case Kind::Int: return e.int_val == key.int_val;
+    case Kind::Str: return e.str_val == key.str_val;
+    case Kind::Object: return kiz::Vm::is_equal(e.obj, key.obj);
+    default: return false;
+    }
+}
+
+int64_t Set::find(const Key& key) const {
+    if (index_.empty()) return -1;
+    const size_t mask = index_.size() - 1;
+    for (size_t pos = key.hash & mask;; pos = (pos + 1) & mask) {
+        const int32_t slot = index_[pos];
+        if (slot == empty_slot) return -1;
+        if (slot >= 0) {
+            const auto& e = entries_[slot];
+            if (e.hash == key.hash and key_equals(e, key)) return slot;
+        }
+    }
+}
+
+void Set::rebuild(const size_t capacity) {
+    std::erase_if(entries_, [](const Entry& e) { return e.kind == Kind::Deleted; });
+    // 装载率不超过2/3, 保证探测总能遇到空槽
+    size_t size = 8;
+    while (size * 2 < capacity * 3) size *= 2;
+    index_.assign(size, empty_slot);
+    const size_t mask = size - 1;
+    for (size_t i = 0; i < entries_.size(); ++i) {
+        size_t pos = entries_[i].hash & mask;
+        while (index_[pos] != empty_slot) pos = (pos + 1) & mask;
+        index_[pos] = static_cast<int32_t>(i);
+    }
+}
+
+bool Set::add(const Key& key) {
+    if (find(key) >= 0) return false;
+    // 下标表中的非空槽位不多于entries_的长度
+    if ((entries_.size() + 1) * 3 > index_.size() * 2) rebuild(count_ + 1);
+
+    const size_t mask = index_.size() - 1;
+    size_t pos = key.hash & mask;
+    while (index_[pos] >= 0) pos = (pos + 1) & mask;
+    index_[pos] = static_cast<int32_t>(entries_.size());
+
+    if (key.kind == Kind::Object) key.obj->make_ref();
+    entries_.push_back(Entry{key.hash, key.kind, key.int_val, std::string(key.str_val), key.obj});
+    ++count_;
+    return true;
+}
+
+bool Set::remove(const Key& key) {
+    if (index_.empty()) return false;
+    const size_t mask = index_.size() - 1;
+    for (size_t pos = key.hash & mask;; pos = (pos + 1) & mask) {
+        const int32_t slot = index_[pos];
+        if (slot == empty_slot) return false;
+        if (slot < 0) continue;
+        auto& e = entries_[slot];
+        if (e.hash != key.hash or !key_equals(e, key)) continue;
+
+        if (e.kind == Kind::Object) e.obj->del_ref();
+        e = Entry{};
+        index_[pos] = deleted_slot;
+        --count_;
+        return true;
+    }
+}
+
+void Set::clear() {
+    for (const auto& e : entries_) {
+        if (e.kind == Kind::Object) e.obj->del_ref();
+    }
+    entries_.clear();
+    index_.clear();
+    count_ = 0;
+}
+
+Object* Set::box(const Entry& e) {
+    switch (e.kind) {
+    case Kind::Int: return new Int(dep::BigInt::from_int64(e.int_val));
+    case Kind::Str: return new String(e.str_val);
+    default: return e.obj;
+    }
+}
+
+Set* Set::clone() const {
+    const auto set = new Set();
+    set->entries_ = entries_;
+    set->index_ = index_;
+    set->count_ = count_;
+    for (const auto& e : set->entries_) {
+        if (e.kind == Kind::Object) e.obj->make_ref();
+    }
+    return set;
+}
+
+void Set::write_debug_string(std::string& out) const {
+    if (count_ == 0) {
+        out += "Set()";
+        return;
+    }
+    out += '{';
+    bool first = true;
+    for (const auto& e : entries_) {
+        if (e.kind == Kind::Deleted) continue;
+        if (!first) out += ", ";
+        first = false;
+        switch (e.kind) {
+        case Kind::Int: out += std::to_string(e.int_val); break;
+        case Kind::Str: out += '"'; out += e.str_val; out += '"'; break;
+        default: e.obj->write_debug_string(out);
+        }
+    }
+    out += '}';
+}
+
+// -------------------------- 原生方法 --------------------------
+static Set* self_set(Object* self, const std::string& method) {
+    const auto set = dynamic_cast<Set*>(self);
+    if (set == nullptr) {
+        throw NativeFuncError("TypeError", "Set." + method + " must be called by Set object");
+    }
+    return set;
+}
+
+// 逐个取出src中元素的键: Set与拆箱List不装箱
+template <typename F>
+static void for_each_key(Object* src, F&& f) {
+    if (const auto src_set = dynamic_cast<Set*>(src)) {
+        for (const auto& e : src_set->entries()) {
+            if (e.kind != Set::Kind::Deleted) f(Set::entry_key(e));
+        }
+        return;
+    }
+    if (const auto src_list = dynamic_cast<List*>(src)) {
+        switch (src_list->strategy()) {
+        case List::Strategy::Int:
+            for (const auto v : src_list->ints()) f(Set::int_key(v));
+            return;
+        case List::Strategy::Str:
+            for (const auto& v : src_list->strs()) f(Set::str_key(v, dep::hash_string(v)));
+            return;
+        default:
+            for (size_t i = 0; i < src_list->size(); ++i) f(Set::key_of(src_list->get(i)));
+            return;
+        }
+    }
+    const auto it = make_iterator(src);
+    while (const auto elem = iterator_step(it)) f(Set::key_of(elem));
+}
+
+// Set(iterable=Nil)
+Object* set_call(Object* self, const List* args) {
+    const auto set = new Set();
+    if (!args->val.empty() and args->val[0]->get_type() != Object::ObjectType::OT_Nil) {
+        for_each_key(args->val[0], [&](const Set::Key& key) { set->add(key); });
+    }
+    return set;
+}
+
+Object* set_add(Object* self, const List* args) {
+    self_set(self, "add")->add(Set::key_of(builtin::get_one_arg(args)));
+    return load_nil();
+}
+
+// Set.remove: 元素不存在时报KeyError
+Object* set_remove(Object* self, const List* args) {
+    const auto elem = builtin::get_one_arg(args);
+    if (!self_set(self, "remove")->remove(Set::key_of(elem))) {
+        throw NativeFuncError("KeyError", "Undefined element " + elem->debug_string() + " in Set");
+    }
+    return load_nil();
+}
+
+// Set.discard: 元素不存在时忽略
+Object* set_discard(Object* self, const List* args) {
+    self_set(self, "discard")->remove(Set::key_of(builtin::get_one_arg(args)));
+    return load_nil();
+}
+
+Object* set_contains(Object* self, const List* args) {
+    return load_bool(self_set(self, "contains")->contains(Set::key_of(builtin::get_one_arg(args))));
+}
+
+Object* set_len(Object* self, const List* args) {
+    return create_int(dep::BigInt(self_set(self, "len")->size()));
+}
+
+Object* set_clear(Object* self, const List* args) {
+    self_set(self, "clear")->clear();
+    return load_nil();
+}
+
+Object* set_bool(Object* self, const List* args) {
+    return load_bool(!self_set(self, "__bool__")->empty());
+}
+
+// Set.__eq__: 元素个数相同且互相包含
+Object* set_eq(Object* self, const List* args) {
+    const auto a = self_set(self, "__eq__");
+    const auto b = dynamic_cast<Set*>(builtin::get_one_arg(args));
+    if (b == nullptr or a->size() != b->size()) return load_bool(false);
+    for (const auto& e : a->entries()) {
+        if (e.kind != Set::Kind::Deleted and !b->contains(Set::entry_key(e))) return load_bool(false);
+    }
+    return load_bool(true);
+}
+
+// Set.union/intersection/difference 接受任意可迭代对象, 返回新集合
+Object* set_union(Object* self, const List* args) {
+    const auto result = self_set(self, "union")->clone();
+    for_each_key(builtin::get_one_arg(args), [&](const Set::Key& key) { result->add(key); });
+    return result;
+}
+
+Object* set_intersection(Object* self, const List* args) {
+    const auto a = self_set(self, "intersection");
+    const auto result = new Set();
+    for_each_key(builtin::get_one_arg(args), [&](const Set::Key& key) {
+        if (a->contains(key)) result->add(key);
+    });
+    return result;
+}
+
+Object* set_difference(Object* self, const List* args) {
+    const auto result = self_set(self, "difference")->clone();
+    for_each_key(builtin::get_one_arg(args), [&](const Set::Key& key) { result->remove(key); });
+    return result;
+}
+
+Object* set_iter(Object* self, const List* args) {
+    return make_iterator(self_set(self, "iter"));
+}
+
+static Object* set_to_str(Object* self, const bool debug) {
+    const auto set = self_set(self, debug ? "__dstr__" : "__str__");
+    if (set->empty()) return create_str("Set()");
+    std::string result = "{";
+    bool first = true;
+    for (const auto& e : set->entries()) {
+        if (e.kind == Set::Kind::Deleted) continue;
+        if (!first) result += ", ";
+        first = false;
+        switch (e.kind) {
+        case Set::Kind::Int: result += std::to_string(e.int_val); break;
+        case Set::Kind::Str:
+            if (debug) result += '"';
+            result += e.str_val;
+            if (debug) result += '"';
+            break;
+        default:
+            if (debug) kiz::Vm::write_debug_str(e.obj, result);
+            else kiz::Vm::write_str(e.obj, result);
+        }
+    }
+    result += "}";
+    return create_str(std::move(result));
+}
+
+Object* set_str(Object* self, const List* args) {
+    return set_to_str(self, false);
+}
+
+Object* set_dstr(Object* self, const List* args) {
+    return set_to_str(self, true);
+}
+
+}
@@ -0,0 +1,58 @@
+#include "../../src/models/models.hpp"
+#include "include/builtin_functions.hpp"
+#include "include/builtin_methods.hpp"
+
+namespace model {
+
+// 读取切片的一个部分, Nil时返回false; 超出int64的值按符号截断(之后会被夹到序列范围内)
+static bool slice_part(const Object* part, int64_t& out) {
+    if (part->get_type() == Object::ObjectType::OT_Nil) return false;
+    const auto int_obj = dynamic_cast<const Int*>(part);
+    if (int_obj == nullptr) {
+        throw NativeFuncError("TypeError", "slice indices must be Int or Nil");
+    }
+    if (!int_obj->val.to_int64(out)) {
+        out = int_obj->val.is_negative() ? INT64_MIN / 2 : INT64_MAX / 2;
+    }
+    return true;
+}
+
+// 按序列长度解析切片(与Python相同): 负下标从末尾算起, 越界部分截断; 返回元素个数
+size_t resolve_slice(const Slice* slice, const size_t len, int64_t& start, int64_t& stop, int64_t& step) {
+    step = 1;
+    if (slice_part(slice->step, step) and step == 0) {
+        throw NativeFuncError("ValueError", "slice step cannot be zero");
+    }
+    const auto n = static_cast<int64_t>(len);
+    // step<0 时下标范围为[-1, n-1], -1 表示越过开头
+    const int64_t lower = step > 0 ? 0 : -1;
+    const int64_t upper = step > 0 ? n : n - 1;
+    auto clamp = [&](int64_t idx) {
+        if (idx < 0) idx += n;
+        return std::clamp(idx, lower, upper);
+    };
+
+    start = slice_part(slice->start, start) ? clamp(start) : (step > 0 ? lower : upper);
+    stop = slice_part(slice->stop, stop) ? clamp(stop) : (step > 0 ? upper : lower);
+
+    if (step > 0) {
+        return stop > start ? static_cast<size_t>((stop - start + step - 1) / step) : 0;
+    }
+    return start > stop ? static_cast<size_t>((start - stop - step - 1) / -step) : 0;
+}
+
+// Slice.indices(len): 返回按len解析后的[start, stop, step]
+Object* slice_indices(Object* self, const List* args) {
+    const auto self_slice = dynamic_cast<Slice*>(self);
+    assert(self_slice != nullptr && "slice_indices must be called by Slice object");
+    const auto len_obj = dynamic_cast<Int*>(builtin::get_one_arg(args));
+    if (len_obj == nullptr or len_obj->val.is_negative()) {
+        throw NativeFuncError("TypeError", "Slice.indices requires a non-negative Int length");
+    }
+
+    int64_t start, stop, step;
+    resolve_slice(self_slice, len_obj->val.to_unsigned_long_long(), start, stop, step);
+    return List::from_ints({start, stop, step});
+}
+
+}
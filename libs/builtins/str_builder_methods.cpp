@@ -0,0 +1,74 @@
+#include "../../src/models/models.hpp"
+#include "include/builtin_functions.hpp"
+
+namespace model {
+
+// 取得片段文本: String直接取值, 其他对象走__str__
+static std::string part_of(Object* obj) {
+    if (const auto s = dynamic_cast<String*>(obj)) {
+        return s->val();
+    }
+    return kiz::Vm::obj_to_str(obj);
+}
+
+// StrBuilder.__call__：StrBuilder(初始片段...)
+Object* str_builder_call(Object* self, const List* args) {
+    auto builder = new StrBuilder();
+    for (const auto arg : args->val) {
+        builder->append(part_of(arg));
+    }
+    return builder;
+}
+
+// StrBuilder.__str__：拼接全部片段
+Object* str_builder_str(Object* self, const List* args) {
+    const auto self_builder = dynamic_cast<StrBuilder*>(self);
+    assert(self_builder != nullptr && "str_builder_str must be called by StrBuilder object");
+    return create_str(self_builder->join(""));
+}
+
+// StrBuilder.append：追加片段, 返回自身以便链式调用
+Object* str_builder_append(Object* self, const List* args) {
+    const auto self_builder = dynamic_cast<StrBuilder*>(self);
+    assert(self_builder != nullptr && "str_builder_append must be called by StrBuilder object");
+    for (const auto arg : args->val) {
+        self_builder->append(part_of(arg));
+    }
+    self_builder->make_ref();
+    return self_builder;
+}
+
+// StrBuilder.join：以分隔符连接全部片段(默认空串)
+Object* str_builder_join(Object* self, const List* args) {
+    const auto self_builder = dynamic_cast<StrBuilder*>(self);
+    assert(self_builder != nullptr && "str_builder_join must be called by StrBuilder object");
+    std::string sep;
+    if (!args->val.empty()) {
+        sep = cast_to_str(args->val[0])->val();
+    }
+    return create_str(self_builder->join(sep));
+}
+
+// StrBuilder.len：当前内容的字符数(按UTF-8计)
+Object* str_builder_len(Object* self, const List* args) {
+    const auto self_builder = dynamic_cast<StrBuilder*>(self);
+    assert(self_builder != nullptr && "str_builder_len must be called by StrBuilder object");
+    size_t count = 0;
+    for (const auto& part : self_builder->parts) {
+        for (const unsigned char c : part) {
+            if ((c & 0xC0) != 0x80) ++count;
+        }
+    }
+    return create_int(count);
+}
+
+// StrBuilder.clear：清空全部片段
+Object* str_builder_clear(Object* self, const List* args) {
+    const auto self_builder = dynamic_cast<StrBuilder*>(self);
+    assert(self_builder != nullptr && "str_builder_clear must be called by StrBuilder object");
+    self_builder->parts.clear();
+    self_builder->byte_size = 0;
+    return load_nil();
+}
+
+}  // namespace model
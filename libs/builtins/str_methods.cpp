@@ -1,9 +1,49 @@
 #include "../deps/u8str.hpp"
+#include "../deps/str_search.hpp"
 #include "../../src/models/models.hpp"
 #include "include/builtin_functions.hpp"
+#include "include/builtin_methods.hpp"
 
 namespace model {
 
+// UTF-8 字符数
+static size_t utf8_length(std::string_view s) {
+    size_t count = 0;
+    for (const unsigned char c : s) {
+        if ((c & 0xC0) != 0x80) ++count;
+    }
+    return count;
+}
+
+// 第char_idx个UTF-8字符的字节偏移(越界时返回s.size())
+static size_t utf8_offset(std::string_view s, size_t char_idx) {
+    size_t count = 0;
+    for (size_t i = 0; i < s.size(); ++i) {
+        if ((static_cast<unsigned char>(s[i]) & 0xC0) != 0x80) {
+            if (count == char_idx) return i;
+            ++count;
+        }
+    }
+    return s.size();
+}
+
+// 第char_idx个字符的字节偏移, 纯ASCII时直接换算
+static size_t char_offset(std::string_view s, size_t char_idx, bool ascii) {
+    if (ascii) return std::min(char_idx, s.size());
+    return utf8_offset(s, char_idx);
+}
+
+// 从pos开始的UTF-8字符的字节数
+static size_t utf8_char_len(std::string_view s, size_t pos) {
+    size_t n = 1;
+    while (pos + n < s.size() and (static_cast<unsigned char>(s[pos + n]) & 0xC0) == 0x80) ++n;
+    return n;
+}
+
+static bool is_space(char c) {
+    return c == ' ' or c == '\t' or c == '\n' or c == '\r' or c == '\v' or c == '\f';
+}
+
 // String.__call__
 Object* str_call(Object* self, const List* args) {
     std::string val;
@@ -18,7 +58,7 @@ Object* str_call(Object* self, const List* args) {
 // String.__bool__
 Object* str_bool(Object* self, const List* args) {
     const auto self_int = dynamic_cast<String*>(self);
-    if (self_int->val.empty()) return new Bool(false);
+    if (self_int->val().empty()) return new Bool(false);
     return load_true();
 }
 
@@ -33,8 +73,8 @@ Object* str_add(Object* self, const List* args) {
     auto another_str = dynamic_cast<String*>(args->val[0]);
     assert(another_str != nullptr && "String.add only supports String type argument");
     
-    // 拼接并返回新String
-    return create_str(self_str->val + another_str->val);
+    // 拼接并返回新String(较长时为惰性rope, 循环拼接不再是平方复杂度)
+    return concat_str(self_str, another_str);
 };
 
 // String.__mul__：字符串重复n次（self * n，返回新String，n为非负整数）
@@ -49,10 +89,12 @@ Object* str_mul(Object* self, const List* args) {
     assert(times_int != nullptr && "String.mul only supports Int type argument");
     assert(times_int->val >= dep::BigInt(0) && "String.mul requires non-negative integer argument");
     
+    const auto& unit = self_str->val();
+    const size_t times = times_int->val.to_unsigned_long_long();
     std::string result;
-    dep::BigInt times = times_int->val;
-    for (dep::BigInt i = dep::BigInt(0); i < times; i+=dep::BigInt(1)) {
-        result += self_str->val;
+    result.reserve(unit.size() * times);
+    for (size_t i = 0; i < times; ++i) {
+        result += unit;
     }
     
     return new String(std::move(result));
@@ -69,7 +111,7 @@ Object* str_eq(Object* self, const List* args) {
     auto another_str = dynamic_cast<String*>(args->val[0]);
     assert(another_str != nullptr && "String.eq only supports String type argument");
     
-    return new Bool(self_str->val == another_str->val);
+    return new Bool(self_str->equals(*another_str));
 };
 
 // String.__contains__：判断是否包含子字符串 x in self
@@ -83,7 +125,7 @@ Object* str_contains(Object* self, const List* args) {
     auto sub_str = dynamic_cast<String*>(args->val[0]);
     assert(sub_str != nullptr && "String.contains only supports String type argument");
     
-    bool exists = self_str->val.find(sub_str->val) != std::string::npos;
+    bool exists = dep::str_find(self_str->val(), sub_str->val()) != std::string_view::npos;
     return new Bool(exists);
 };
 
@@ -91,8 +133,7 @@ Object* str_contains(Object* self, const List* args) {
 Object* str_hash(Object* self, const List* args) {
     auto self_str = dynamic_cast<String*>(self);
     assert(self_str != nullptr && "str_hash must be called by String object");
-    auto hashed_str = dep::hash_string(self_str->val);
-    return new Int(dep::BigInt(hashed_str));
+    return new Int(dep::BigInt(self_str->hash()));
 }
 
 Object* str_next(Object* self, const List* args) {
@@ -104,8 +145,8 @@ Object* str_next(Object* self, const List* args) {
     auto index = cast_to_int(curr_idx) ->val.to_unsigned_long_long();
 
     auto self_str = dynamic_cast<String*>(self);
-    if (index < self_str->val.size()) {
-        auto res = dep::UTF8String(self_str->val)[index];
+    if (index < self_str->val().size()) {
+        auto res = dep::UTF8String(self_str->val())[index];
         self->attrs.insert("__current_index__", new Int(index+1));
         return create_str(res.to_string());
     }
@@ -115,20 +156,55 @@ Object* str_next(Object* self, const List* args) {
 
 Object* str_str(Object* self, const List* args) {
     auto self_str = dynamic_cast<String*>(self);
-    return create_str(self_str->val);
+    return create_str(self_str->val());
 }
 
 Object* str_dstr(Object* self, const List* args) {
     auto self_str = dynamic_cast<String*>(self);
-    return create_str("\"" + self_str->val + "\"");
+    return create_str("\"" + self_str->val() + "\"");
 }
 
 Object* str_getitem(Object* self, const List* args) {
     auto self_str = dynamic_cast<String*>(self);
+    const auto s = self_str->view();
+    const bool ascii = self_str->char_size() == s.size();
+
+    if (const auto slice = dynamic_cast<Slice*>(builtin::get_one_arg(args))) {
+        int64_t start, stop, step;
+        const size_t count = resolve_slice(slice, self_str->char_size(), start, stop, step);
+        if (count == 0) return create_str("");
+        // 连续切片共享原字符串的缓冲区(见String::slice)
+        if (step == 1) {
+            const size_t begin = char_offset(s, start, ascii);
+            const size_t end = begin + char_offset(s.substr(begin), count, ascii);
+            return String::slice(self_str, begin, end);
+        }
+        // 带步长时逐字符挑选, 非ASCII先记录每个字符的起始偏移
+        std::string result;
+        if (ascii) {
+            result.reserve(count);
+            for (size_t k = 0; k < count; ++k) result += s[start + static_cast<int64_t>(k) * step];
+        } else {
+            std::vector<size_t> offsets;
+            offsets.reserve(self_str->char_size() + 1);
+            for (size_t i = 0; i < s.size(); ++i) {
+                if ((static_cast<unsigned char>(s[i]) & 0xC0) != 0x80) offsets.push_back(i);
+            }
+            offsets.push_back(s.size());
+            for (size_t k = 0; k < count; ++k) {
+                const auto ci = static_cast<size_t>(start + static_cast<int64_t>(k) * step);
+                result += s.substr(offsets[ci], offsets[ci + 1] - offsets[ci]);
+            }
+        }
+        return create_str(std::move(result));
+    }
+
     auto idx_obj = cast_to_int(builtin::get_one_arg(args));
     auto index = idx_obj->val.to_unsigned_long_long();
-
-    return create_str( dep::UTF8String(self_str->val)[index] .to_string() );
+    const size_t begin = char_offset(s, index, ascii);
+    if (begin >= s.size()) throw NativeFuncError("IndexError", "Str index out of range");
+    const size_t end = begin + char_offset(s.substr(begin), 1, ascii);
+    return create_str(std::string(s.substr(begin, end - begin)));
 }
 
 Object* str_foreach(Object* self, const List* args) {
@@ -137,7 +213,7 @@ Object* str_foreach(Object* self, const List* args) {
     auto self_str = cast_to_str(self);
 
     dep::BigInt idx = 0;
-    for (const auto& e : dep::UTF8String(self_str->val)) {
+    for (const auto& e : dep::UTF8String(self_str->val())) {
         kiz::Vm::call_function(func_obj, new List({
             create_str(e.to_string())
         }), nullptr);
@@ -146,43 +222,218 @@ Object* str_foreach(Object* self, const List* args) {
     return new Nil();
 }
 
+// String.count：子串不重叠出现的次数
 Object* str_count(Object* self, const List* args) {
-    const auto obj = builtin::get_one_arg(args);
-    size_t count = 0;
     auto self_str = cast_to_str(self);
+    auto sub_str = cast_to_str(builtin::get_one_arg(args));
+    const auto& sub = sub_str->val();
+    if (sub.empty()) {
+        return create_int(utf8_length(self_str->val()) + 1);
+    }
+    return create_int(dep::str_count(self_str->val(), sub));
+}
+
+// String.startswith：是否以prefix开头
+Object* str_startswith(Object* self, const List* args) {
+    auto self_str = cast_to_str(self);
+    const auto& prefix = cast_to_str(builtin::get_one_arg(args))->val();
+    return new Bool(std::string_view(self_str->val()).starts_with(prefix));
+}
+
+// String.endswith：是否以suffix结尾
+Object* str_endswith(Object* self, const List* args) {
+    auto self_str = cast_to_str(self);
+    const auto& suffix = cast_to_str(builtin::get_one_arg(args))->val();
+    return new Bool(std::string_view(self_str->val()).ends_with(suffix));
+}
+
+// String.find：子串首次出现的字符下标, 可选起始下标, 未找到返回-1
+Object* str_find(Object* self, const List* args) {
+    auto self_str = cast_to_str(self);
+    assert(!args->val.empty() && "function String.find need 1 or 2 args");
+    const std::string_view text = self_str->val();
+    const auto& sub = cast_to_str(args->val[0])->val();
+
+    size_t start = 0;
+    if (args->val.size() > 1) {
+        start = utf8_offset(text, cast_to_int(args->val[1])->val.to_unsigned_long_long());
+    }
+    const size_t pos = dep::str_find(text, sub, start);
+    if (pos == std::string_view::npos) {
+        return create_int(dep::BigInt(0) - dep::BigInt(1));
+    }
+    return create_int(utf8_length(text.substr(0, pos)));
+}
+
+// String.split：按分隔符一次扫描切分; 无参数时按连续空白切分并丢弃空段
+Object* str_split(Object* self, const List* args) {
+    auto self_str = cast_to_str(self);
+    const std::string_view text = self_str->val();
+    // 结果直接存为字符串数组, 不为每段创建String对象
+    std::vector<std::string> parts;
 
-    for (const auto& c : dep::UTF8String(self_str->val)) {
-        kiz::Vm::call_function(kiz::Vm::get_attr(obj, "__eq__"), new List({
-            create_str(c.to_string())
-        }), obj);
-        auto res = kiz::Vm::fetch_one_from_stack_top();
-        if (res) {
-            ++ count;
+    if (args->val.empty()) {
+        size_t i = 0;
+        while (i < text.size()) {
+            while (i < text.size() and is_space(text[i])) ++i;
+            const size_t begin = i;
+            while (i < text.size() and !is_space(text[i])) ++i;
+            if (i > begin) parts.emplace_back(text.substr(begin, i - begin));
         }
+        return List::from_strs(std::move(parts));
     }
-    return create_int(count);
+
+    const std::string_view sep = cast_to_str(args->val[0])->val();
+    if (sep.empty()) {
+        throw NativeFuncError("ValueError", "String.split: empty separator");
+    }
+    size_t begin = 0;
+    for (size_t pos = dep::str_find(text, sep); pos != std::string_view::npos;
+         pos = dep::str_find(text, sep, begin)) {
+        parts.emplace_back(text.substr(begin, pos - begin));
+        begin = pos + sep.size();
+    }
+    parts.emplace_back(text.substr(begin));
+    return List::from_strs(std::move(parts));
 }
 
+// String.replace：替换全部(或前count个)old为new, 先统计出现次数以一次分配结果
+Object* str_replace(Object* self, const List* args) {
+    auto self_str = cast_to_str(self);
+    assert(args->val.size() >= 2 && "function String.replace need 2 or 3 args");
+    const std::string_view text = self_str->val();
+    const std::string_view from = cast_to_str(args->val[0])->val();
+    const std::string_view to = cast_to_str(args->val[1])->val();
+    if (from.empty()) {
+        throw NativeFuncError("ValueError", "String.replace: empty pattern");
+    }
+
+    size_t limit = SIZE_MAX;
+    if (args->val.size() > 2) {
+        limit = cast_to_int(args->val[2])->val.to_unsigned_long_long();
+    }
 
-Object* str_startswith(Object* self, const List* args) {
-    return new Nil();
+    std::vector<size_t> hits;
+    for (size_t pos = dep::str_find(text, from); pos != std::string_view::npos and hits.size() < limit;
+         pos = dep::str_find(text, from, pos + from.size())) {
+        hits.push_back(pos);
+    }
+    if (hits.empty()) {
+        self->make_ref();
+        return self;
+    }
 
+    std::string result;
+    result.reserve(text.size() - hits.size() * from.size() + hits.size() * to.size());
+    size_t begin = 0;
+    for (const size_t pos : hits) {
+        result.append(text.substr(begin, pos - begin));
+        result.append(to);
+        begin = pos + from.size();
+    }
+    result.append(text.substr(begin));
+    return create_str(std::move(result));
 }
 
-Object* str_endswith(Object* self, const List* args) {
-    return new Nil();
+// String.join：以self为分隔符连接列表元素, 先求总长度再一次分配
+Object* str_join(Object* self, const List* args) {
+    auto self_str = cast_to_str(self);
+    const std::string_view sep = self_str->val();
+    const auto items = cast_to_list(builtin::get_one_arg(args));
+
+    // 非String元素先经__str__转换, 预留容量保证string_view不失效
+    std::vector<std::string> converted;
+    converted.reserve(items->size());
+    std::vector<std::string_view> pieces;
+    pieces.reserve(items->size());
+    size_t total = 0;
+    if (items->strategy() == List::Strategy::Str) {
+        // 拆箱的字符串数组直接引用
+        for (const auto& item : items->strs()) {
+            pieces.emplace_back(item);
+            total += item.size();
+        }
+    } else if (items->strategy() != List::Strategy::Generic) {
+        for (size_t i = 0; i < items->size(); ++i) {
+            items->write_unboxed(i, converted.emplace_back(), false);
+            pieces.emplace_back(converted.back());
+            total += pieces.back().size();
+        }
+    }
+    for (const auto item : items->val) {
+        if (const auto item_str = dynamic_cast<String*>(item)) {
+            pieces.emplace_back(item_str->val());
+        } else {
+            converted.push_back(kiz::Vm::obj_to_str(item));
+            pieces.emplace_back(converted.back());
+        }
+        total += pieces.back().size();
+    }
+    if (!pieces.empty()) total += sep.size() * (pieces.size() - 1);
+
+    std::string result;
+    result.reserve(total);
+    for (size_t i = 0; i < pieces.size(); ++i) {
+        if (i != 0) result.append(sep);
+        result.append(pieces[i]);
+    }
+    return create_str(std::move(result));
+}
 
+// String.strip：去除两端空白(或参数中给出的字符)
+Object* str_strip(Object* self, const List* args) {
+    auto self_str = cast_to_str(self);
+    const std::string_view text = self_str->val();
+
+    size_t begin = 0, end = text.size();
+    if (args->val.empty()) {
+        while (begin < end and is_space(text[begin])) ++begin;
+        while (end > begin and is_space(text[end - 1])) --end;
+    } else {
+        const auto chars_str = cast_to_str(args->val[0]);
+        const std::string_view chars = chars_str->val();
+        if (chars_str->char_size() == chars.size()) {
+            // ASCII字节不会出现在多字节序列中, 按字节比较即可
+            while (begin < end and chars.find(text[begin]) != std::string_view::npos) ++begin;
+            while (end > begin and chars.find(text[end - 1]) != std::string_view::npos) --end;
+        } else {
+            // 按整个字符比较, 不截断UTF-8序列
+            std::vector<std::string_view> set;
+            for (size_t i = 0; i < chars.size(); i += set.back().size()) {
+                set.push_back(chars.substr(i, utf8_char_len(chars, i)));
+            }
+            const auto in_set = [&](const std::string_view c) {
+                return std::find(set.begin(), set.end(), c) != set.end();
+            };
+            while (begin < end) {
+                const size_t n = utf8_char_len(text, begin);
+                if (!in_set(text.substr(begin, n))) break;
+                begin += n;
+            }
+            while (end > begin) {
+                size_t start = end - 1;
+                while (start > begin and (static_cast<unsigned char>(text[start]) & 0xC0) == 0x80) --start;
+                if (!in_set(text.substr(start, end - start))) break;
+                end = start;
+            }
+        }
+    }
+    if (begin == 0 and end == text.size()) {
+        self->make_ref();
+        return self;
+    }
+    return create_str(std::string(text.substr(begin, end - begin)));
 }
 
 Object* str_len(Object* self, const List* args) {
     auto self_str = cast_to_str(self);
 
-    return create_int(dep::UTF8String(self_str->val).size());
+    return create_int(self_str->char_size());
 }
 
 Object* str_is_alaph(Object* self, const List* args) {
     auto self_str = cast_to_str(self);
-    auto str = dep::UTF8String(self_str->val);
+    auto str = dep::UTF8String(self_str->val());
     bool is_alaph = true;
     for (const auto& c : str) {
         if (!c.is_alpha()) is_alaph = false;
@@ -192,7 +443,7 @@ Object* str_is_alaph(Object* self, const List* args) {
 
 Object* str_is_digit(Object* self, const List* args) {
     auto self_str = cast_to_str(self);
-    auto str = dep::UTF8String(self_str->val);
+    auto str = dep::UTF8String(self_str->val());
     bool is_digit = true;
     for (const auto& c : str) {
         if (!c.is_digit()) is_digit = false;
@@ -212,21 +463,23 @@ Object* str_substr(Object* self, const List* args) {
         len = cast_to_int(args_vec[1])->val.to_unsigned_long_long();
     }
 
-    return create_str(dep::UTF8String(self_str->val).substr(
-        pos, len
-    ).to_string());
+    const auto s = self_str->view();
+    const bool ascii = self_str->char_size() == s.size();
+    const size_t begin = char_offset(s, pos, ascii);
+    const size_t end = begin + char_offset(s.substr(begin), len, ascii);
+    return String::slice(self_str, begin, end);
 }
 
 Object* str_to_lower(Object* self, const List* args) {
     auto self_str = cast_to_str(self);
 
-    return create_str(dep::UTF8String(self_str->val).to_lower().to_string());
+    return create_str(dep::UTF8String(self_str->val()).to_lower().to_string());
 }
 
 Object* str_to_upper(Object* self, const List* args) {
     auto self_str = cast_to_str(self);
 
-    return create_str(dep::UTF8String(self_str->val).to_upper().to_string());
+    return create_str(dep::UTF8String(self_str->val()).to_upper().to_string());
 
 }
 
@@ -0,0 +1,117 @@
+#include "../../src/models/models.hpp"
+#include "include/builtin_functions.hpp"
+#include "include/builtin_methods.hpp"
+
+namespace model {
+
+// 组合方式同xxHash的累加步骤, 元素哈希与Set一致(Int/Str/Tuple不经过VM)
+size_t Tuple::hash() const {
+    if (hash_cached_) return hash_;
+    constexpr uint64_t prime1 = 11400714785074694791ULL;
+    constexpr uint64_t prime2 = 14029467366897019727ULL;
+    constexpr uint64_t prime5 = 2870177450012600261ULL;
+    uint64_t acc = prime5;
+    for (size_t i = 0; i < size_; ++i) {
+        acc += static_cast<uint64_t>(Set::key_of(data()[i]).hash) * prime2;
+        acc = (acc << 31) | (acc >> 33);
+        acc *= prime1;
+    }
+    acc += size_ ^ (prime5 ^ 3527539ULL);
+    hash_ = acc;
+    hash_cached_ = true;
+    return hash_;
+}
+
+static Tuple* self_tuple(Object* self, const std::string& method) {
+    const auto tuple = dynamic_cast<Tuple*>(self);
+    if (tuple == nullptr) {
+        throw NativeFuncError("TypeError", "Tuple." + method + " must be called by Tuple object");
+    }
+    return tuple;
+}
+
+// Tuple(iterable=Nil)
+Object* tuple_call(Object* self, const List* args) {
+    std::vector<Object*> elems;
+    if (!args->val.empty() and args->val[0]->get_type() != Object::ObjectType::OT_Nil) {
+        const auto it = make_iterator(args->val[0]);
+        while (const auto elem = iterator_step(it)) elems.push_back(elem);
+    }
+    return Tuple::create(elems);
+}
+
+Object* tuple_getitem(Object* self, const List* args) {
+    const auto tuple = self_tuple(self, "__getitem__");
+    const auto arg = builtin::get_one_arg(args);
+    if (const auto slice = dynamic_cast<Slice*>(arg)) {
+        int64_t start, stop, step;
+        const size_t count = resolve_slice(slice, tuple->size(), start, stop, step);
+        std::vector<Object*> elems;
+        elems.reserve(count);
+        for (size_t k = 0; k < count; ++k) {
+            elems.push_back(tuple->get(static_cast<size_t>(start + static_cast<int64_t>(k) * step)));
+        }
+        return Tuple::create(elems);
+    }
+
+    const auto idx_obj = dynamic_cast<Int*>(arg);
+    if (idx_obj == nullptr) throw NativeFuncError("TypeError", "Tuple index must be Int or Slice");
+    int64_t index;
+    if (!idx_obj->val.to_int64(index)) index = -1 - static_cast<int64_t>(tuple->size());
+    if (index < 0) index += static_cast<int64_t>(tuple->size());
+    if (index < 0 or static_cast<size_t>(index) >= tuple->size()) {
+        throw NativeFuncError("IndexError", "Tuple index out of range");
+    }
+    return tuple->get(static_cast<size_t>(index));
+}
+
+Object* tuple_len(Object* self, const List* args) {
+    return create_int(dep::BigInt(self_tuple(self, "len")->size()));
+}
+
+Object* tuple_contains(Object* self, const List* args) {
+    const auto target = builtin::get_one_arg(args);
+    for (const auto elem : *self_tuple(self, "contains")) {
+        if (kiz::Vm::is_equal(elem, target)) return load_bool(true);
+    }
+    return load_bool(false);
+}
+
+Object* tuple_eq(Object* self, const List* args) {
+    return load_bool(kiz::Vm::is_equal(self_tuple(self, "__eq__"), builtin::get_one_arg(args)));
+}
+
+Object* tuple_hash(Object* self, const List* args) {
+    return create_int(dep::BigInt::from_int64(static_cast<int64_t>(self_tuple(self, "__hash__")->hash())));
+}
+
+Object* tuple_bool(Object* self, const List* args) {
+    return load_bool(self_tuple(self, "__bool__")->size() != 0);
+}
+
+Object* tuple_iter(Object* self, const List* args) {
+    return make_iterator(self_tuple(self, "iter"));
+}
+
+static Object* tuple_to_str(Object* self, const bool debug) {
+    const auto tuple = self_tuple(self, debug ? "__dstr__" : "__str__");
+    std::string result = "(";
+    for (size_t i = 0; i < tuple->size(); ++i) {
+        if (i != 0) result += ", ";
+        if (debug) kiz::Vm::write_debug_str(tuple->get(i), result);
+        else kiz::Vm::write_str(tuple->get(i), result);
+    }
+    if (tuple->size() == 1) result += ",";
+    result += ")";
+    return create_str(std::move(result));
+}
+
+Object* tuple_str(Object* self, const List* args) {
+    return tuple_to_str(self, false);
+}
+
+Object* tuple_dstr(Object* self, const List* args) {
+    return tuple_to_str(self, true);
+}
+
+}
@@ -0,0 +1,441 @@
+#include "include/collections_lib.hpp"
+
+#include "builtins/include/builtin_functions.hpp"
+#include "builtins/include/builtin_methods.hpp"
+
+namespace collections_lib {
+
+// -------------------------- Deque --------------------------
+model::Object** Deque::alloc_block() {
+    if (spare_ != nullptr) {
+        const auto block = spare_;
+        spare_ = nullptr;
+        return block;
+    }
+    return new model::Object*[block_size];
+}
+
+void Deque::free_block(model::Object** block) {
+    if (spare_ == nullptr) spare_ = block;
+    else delete[] block;
+}
+
+void Deque::reset_blocks() {
+    for (size_t i = 0; i < blocks_; ++i) {
+        free_block(map_[first_ + i]);
+        map_[first_ + i] = nullptr;
+    }
+    blocks_ = 0;
+    head_ = 0;
+    first_ = map_.size() / 2;
+}
+
+void Deque::recenter_map() {
+    const size_t map_size = std::max({size_t{8}, map_.size(), blocks_ * 3 + 2});
+    std::vector<model::Object**> fresh(map_size, nullptr);
+    const size_t first = (map_size - blocks_) / 2;
+    std::copy_n(map_.begin() + static_cast<std::ptrdiff_t>(first_), blocks_,
+        fresh.begin() + static_cast<std::ptrdiff_t>(first));
+    map_.swap(fresh);
+    first_ = first;
+}
+
+void Deque::push_back(model::Object* elem) {
+    const size_t pos = head_ + size_;
+    if (pos == blocks_ * block_size) {
+        if (first_ + blocks_ == map_.size()) recenter_map();
+        map_[first_ + blocks_] = alloc_block();
+        ++blocks_;
+    }
+    elem->make_ref();
+    map_[first_ + pos / block_size][pos % block_size] = elem;
+    ++size_;
+}
+
+void Deque::push_front(model::Object* elem) {
+    if (head_ == 0) {
+        if (first_ == 0) recenter_map();
+        --first_;
+        map_[first_] = alloc_block();
+        ++blocks_;
+        head_ = block_size;
+    }
+    --head_;
+    elem->make_ref();
+    map_[first_][head_] = elem;
+    ++size_;
+}
+
+model::Object* Deque::pop_back() {
+    --size_;
+    const size_t pos = head_ + size_;
+    const auto elem = map_[first_ + pos / block_size][pos % block_size];
+    if (size_ == 0) {
+        reset_blocks();
+    } else if (pos % block_size == 0) {
+        // 弹出的是最后一个块中唯一的元素
+        --blocks_;
+        free_block(map_[first_ + blocks_]);
+        map_[first_ + blocks_] = nullptr;
+    }
+    return elem;
+}
+
+model::Object* Deque::pop_front() {
+    const auto elem = map_[first_][head_];
+    ++head_;
+    --size_;
+    if (size_ == 0) {
+        reset_blocks();
+    } else if (head_ == block_size) {
+        free_block(map_[first_]);
+        map_[first_] = nullptr;
+        ++first_;
+        --blocks_;
+        head_ = 0;
+    }
+    return elem;
+}
+
+void Deque::clear() {
+    for (size_t i = 0; i < size_; ++i) get(i)->del_ref();
+    size_ = 0;
+    reset_blocks();
+}
+
+static Deque* self_deque(model::Object* self, const std::string& method) {
+    const auto deque = dynamic_cast<Deque*>(self);
+    if (deque == nullptr) {
+        throw NativeFuncError("TypeError", "Deque." + method + " must be called by Deque object");
+    }
+    return deque;
+}
+
+static Deque* non_empty_deque(model::Object* self, const std::string& method) {
+    const auto deque = self_deque(self, method);
+    if (deque->empty()) throw NativeFuncError("IndexError", "Deque." + method + " from empty Deque");
+    return deque;
+}
+
+// Deque(iterable=Nil)
+model::Object* deque_call(model::Object* self, const model::List* args) {
+    const auto deque = new Deque();
+    if (!args->val.empty() and args->val[0]->get_type() != model::Object::ObjectType::OT_Nil) {
+        const auto src = args->val[0];
+        if (const auto src_list = dynamic_cast<model::List*>(src)) {
+            for (size_t i = 0; i < src_list->size(); ++i) deque->push_back(src_list->get(i));
+        } else {
+            const auto it = model::make_iterator(src);
+            while (const auto elem = model::iterator_step(it)) deque->push_back(elem);
+        }
+    }
+    return deque;
+}
+
+model::Object* deque_push_back(model::Object* self, const model::List* args) {
+    self_deque(self, "push_back")->push_back(builtin::get_one_arg(args));
+    return model::load_nil();
+}
+
+model::Object* deque_push_front(model::Object* self, const model::List* args) {
+    self_deque(self, "push_front")->push_front(builtin::get_one_arg(args));
+    return model::load_nil();
+}
+
+model::Object* deque_pop_back(model::Object* self, const model::List* args) {
+    return non_empty_deque(self, "pop_back")->pop_back();
+}
+
+model::Object* deque_pop_front(model::Object* self, const model::List* args) {
+    return non_empty_deque(self, "pop_front")->pop_front();
+}
+
+model::Object* deque_front(model::Object* self, const model::List* args) {
+    return non_empty_deque(self, "front")->get(0);
+}
+
+model::Object* deque_back(model::Object* self, const model::List* args) {
+    const auto deque = non_empty_deque(self, "back");
+    return deque->get(deque->size() - 1);
+}
+
+// Deque[idx]: 负下标从队尾算起
+model::Object* deque_getitem(model::Object* self, const model::List* args) {
+    const auto deque = self_deque(self, "__getitem__");
+    const auto idx_obj = dynamic_cast<model::Int*>(builtin::get_one_arg(args));
+    if (idx_obj == nullptr) throw NativeFuncError("TypeError", "Deque index must be Int");
+    int64_t index;
+    if (!idx_obj->val.to_int64(index)) index = -1 - static_cast<int64_t>(deque->size());
+    if (index < 0) index += static_cast<int64_t>(deque->size());
+    if (index < 0 or static_cast<size_t>(index) >= deque->size()) {
+        throw NativeFuncError("IndexError", "Deque index out of range");
+    }
+    return deque->get(static_cast<size_t>(index));
+}
+
+model::Object* deque_len(model::Object* self, const model::List* args) {
+    return model::create_int(dep::BigInt(self_deque(self, "len")->size()));
+}
+
+model::Object* deque_contains(model::Object* self, const model::List* args) {
+    const auto deque = self_deque(self, "contains");
+    const auto target = builtin::get_one_arg(args);
+    for (size_t i = 0; i < deque->size(); ++i) {
+        if (kiz::Vm::is_equal(deque->get(i), target)) return model::load_bool(true);
+    }
+    return model::load_bool(false);
+}
+
+model::Object* deque_clear(model::Object* self, const model::List* args) {
+    self_deque(self, "clear")->clear();
+    return model::load_nil();
+}
+
+model::Object* deque_bool(model::Object* self, const model::List* args) {
+    return model::load_bool(!self_deque(self, "__bool__")->empty());
+}
+
+model::Object* deque_iter(model::Object* self, const model::List* args) {
+    return model::make_iterator(new DequeCursor(self_deque(self, "iter")));
+}
+
+model::Object* deque_cursor_next(model::Object* self, const model::List* args) {
+    const auto cursor = dynamic_cast<DequeCursor*>(self);
+    assert(cursor != nullptr && "deque_cursor_next must be called by DequeCursor object");
+    // 每次重新读取长度, 遍历中修改Deque时与下标访问一致
+    if (cursor->index < cursor->deque->size()) return cursor->deque->get(cursor->index++);
+    return model::load_stop_iter();
+}
+
+static model::Object* deque_to_str(model::Object* self, const bool debug) {
+    const auto deque = self_deque(self, debug ? "__dstr__" : "__str__");
+    std::string result = "Deque([";
+    for (size_t i = 0; i < deque->size(); ++i) {
+        if (i != 0) result += ", ";
+        if (debug) kiz::Vm::write_debug_str(deque->get(i), result);
+        else kiz::Vm::write_str(deque->get(i), result);
+    }
+    result += "])";
+    return model::create_str(std::move(result));
+}
+
+model::Object* deque_str(model::Object* self, const model::List* args) {
+    return deque_to_str(self, false);
+}
+
+model::Object* deque_dstr(model::Object* self, const model::List* args) {
+    return deque_to_str(self, true);
+}
+
+// -------------------------- Heap --------------------------
+Heap::Node Heap::make_node(model::Object* elem) const {
+    model::Object* key = elem;
+    if (key_func != nullptr) {
+        kiz::Vm::call_function(key_func, new model::List({elem}), nullptr);
+        // 返回值的引用由操作数栈转交给节点
+        key = kiz::Vm::fetch_one_from_stack_top();
+    }
+    elem->make_ref();
+
+    Node node{elem, key, KeyKind::Object, 0};
+    switch (key->get_type()) {
+    case model::Object::ObjectType::OT_Int:
+        node.kind = dynamic_cast<model::Int*>(key)->val.to_int64(node.int_key) ? KeyKind::Int64 : KeyKind::BigInt;
+        break;
+    case model::Object::ObjectType::OT_Decimal: node.kind = KeyKind::Decimal; break;
+    case model::Object::ObjectType::OT_String: node.kind = KeyKind::Str; break;
+    default: break;
+    }
+    return node;
+}
+
+static dep::Decimal decimal_of(const Heap::Node& node) {
+    if (const auto key_int = dynamic_cast<model::Int*>(node.key)) return dep::Decimal(key_int->val);
+    return dynamic_cast<model::Decimal*>(node.key)->val;
+}
+
+// 比较方式与List.sort的键分类一致: 同为Int/Dec/Str时比较原生值, 否则调用__lt__
+bool Heap::less(const Node& a, const Node& b) const {
+    const Node& x = reverse ? b : a;
+    const Node& y = reverse ? a : b;
+    if (x.kind == KeyKind::Int64 and y.kind == KeyKind::Int64) return x.int_key < y.int_key;
+
+    const auto is_int = [](const KeyKind k) { return k == KeyKind::Int64 or k == KeyKind::BigInt; };
+    const auto is_numeric = [&](const KeyKind k) { return is_int(k) or k == KeyKind::Decimal; };
+    if (is_int(x.kind) and is_int(y.kind)) {
+        return dynamic_cast<model::Int*>(x.key)->val < dynamic_cast<model::Int*>(y.key)->val;
+    }
+    if (is_numeric(x.kind) and is_numeric(y.kind)) return decimal_of(x) < decimal_of(y);
+    if (x.kind == KeyKind::Str and y.kind == KeyKind::Str) {
+        return dynamic_cast<model::String*>(x.key)->view() < dynamic_cast<model::String*>(y.key)->view();
+    }
+
+    kiz::Vm::call_function(kiz::Vm::get_attr(x.key, model::magic_name::lt), new model::List({y.key}), x.key);
+    return kiz::Vm::is_true(kiz::Vm::fetch_one_from_stack_top());
+}
+
+void Heap::sift_up(size_t i) {
+    Node node = nodes_[i];
+    while (i > 0) {
+        const size_t parent = (i - 1) / arity;
+        if (!less(node, nodes_[parent])) break;
+        nodes_[i] = nodes_[parent];
+        i = parent;
+    }
+    nodes_[i] = node;
+}
+
+void Heap::sift_down(size_t i) {
+    const size_t n = nodes_.size();
+    Node node = nodes_[i];
+    while (true) {
+        const size_t first_child = i * arity + 1;
+        if (first_child >= n) break;
+        // 在至多arity个子节点中找最小者
+        size_t best = first_child;
+        const size_t last_child = std::min(first_child + arity, n);
+        for (size_t c = first_child + 1; c < last_child; ++c) {
+            if (less(nodes_[c], nodes_[best])) best = c;
+        }
+        if (!less(nodes_[best], node)) break;
+        nodes_[i] = nodes_[best];
+        i = best;
+    }
+    nodes_[i] = node;
+}
+
+void Heap::push(const Node node) {
+    nodes_.push_back(node);
+    sift_up(nodes_.size() - 1);
+}
+
+void Heap::push_all(std::vector<Node> nodes) {
+    if (nodes_.empty()) nodes_ = std::move(nodes);
+    else nodes_.insert(nodes_.end(), nodes.begin(), nodes.end());
+    if (nodes_.size() < 2) return;
+    for (size_t i = (nodes_.size() - 2) / arity + 1; i-- > 0;) sift_down(i);
+}
+
+model::Object* Heap::pop() {
+    const Node top = nodes_.front();
+    nodes_.front() = nodes_.back();
+    nodes_.pop_back();
+    if (!nodes_.empty()) sift_down(0);
+    if (top.key != top.elem) top.key->del_ref();
+    return top.elem;
+}
+
+void Heap::clear() {
+    for (const auto& node : nodes_) {
+        node.elem->del_ref();
+        if (node.key != node.elem) node.key->del_ref();
+    }
+    nodes_.clear();
+}
+
+static Heap* self_heap(model::Object* self, const std::string& method) {
+    const auto heap = dynamic_cast<Heap*>(self);
+    if (heap == nullptr) {
+        throw NativeFuncError("TypeError", "Heap." + method + " must be called by Heap object");
+    }
+    return heap;
+}
+
+// Heap(iterable=Nil, key=Nil, reverse=False): reverse为True时为最大堆
+model::Object* heap_call(model::Object* self, const model::List* args) {
+    const auto heap = new Heap();
+    if (args->val.size() > 1 and args->val[1]->get_type() != model::Object::ObjectType::OT_Nil) {
+        heap->key_func = args->val[1];
+        heap->key_func->make_ref();
+    }
+    heap->reverse = args->val.size() > 2 and kiz::Vm::is_true(args->val[2]);
+
+    if (!args->val.empty() and args->val[0]->get_type() != model::Object::ObjectType::OT_Nil) {
+        std::vector<Heap::Node> nodes;
+        const auto it = model::make_iterator(args->val[0]);
+        nodes.reserve(model::iterator_size_hint(it));
+        while (const auto elem = model::iterator_step(it)) nodes.push_back(heap->make_node(elem));
+        heap->push_all(std::move(nodes));
+    }
+    return heap;
+}
+
+model::Object* heap_push(model::Object* self, const model::List* args) {
+    const auto heap = self_heap(self, "push");
+    heap->push(heap->make_node(builtin::get_one_arg(args)));
+    return model::load_nil();
+}
+
+// Heap.pop: 弹出键最小(reverse时最大)的元素, 空堆报IndexError
+model::Object* heap_pop(model::Object* self, const model::List* args) {
+    const auto heap = self_heap(self, "pop");
+    if (heap->empty()) throw NativeFuncError("IndexError", "Heap.pop from empty Heap");
+    return heap->pop();
+}
+
+model::Object* heap_peek(model::Object* self, const model::List* args) {
+    const auto heap = self_heap(self, "peek");
+    if (heap->empty()) throw NativeFuncError("IndexError", "Heap.peek from empty Heap");
+    return heap->top().elem;
+}
+
+model::Object* heap_len(model::Object* self, const model::List* args) {
+    return model::create_int(dep::BigInt(self_heap(self, "len")->size()));
+}
+
+model::Object* heap_clear(model::Object* self, const model::List* args) {
+    self_heap(self, "clear")->clear();
+    return model::load_nil();
+}
+
+model::Object* heap_bool(model::Object* self, const model::List* args) {
+    return model::load_bool(!self_heap(self, "__bool__")->empty());
+}
+
+model::Object* heap_str(model::Object* self, const model::List* args) {
+    const auto heap = self_heap(self, "__str__");
+    return model::create_str("<Heap len=" + std::to_string(heap->size()) + " at " + model::ptr_to_string(heap) + ">");
+}
+
+// -------------------------- 模块 --------------------------
+model::Object* init_module(model::Object* self, const model::List* args) {
+    auto mod = new model::Module("collections");
+
+    based_deque->attrs.insert("__parent__", model::based_obj);
+    based_deque->attrs.insert("__call__", new model::NativeFunction(deque_call));
+    based_deque->attrs.insert("__bool__", new model::NativeFunction(deque_bool));
+    based_deque->attrs.insert("__str__", new model::NativeFunction(deque_str));
+    based_deque->attrs.insert("__dstr__", new model::NativeFunction(deque_dstr));
+    based_deque->attrs.insert("__getitem__", new model::NativeFunction(deque_getitem));
+    based_deque->attrs.insert("__iter__", new model::NativeFunction(deque_iter));
+    based_deque->attrs.insert("push_back", new model::NativeFunction(deque_push_back));
+    based_deque->attrs.insert("push_front", new model::NativeFunction(deque_push_front));
+    based_deque->attrs.insert("pop_back", new model::NativeFunction(deque_pop_back));
+    based_deque->attrs.insert("pop_front", new model::NativeFunction(deque_pop_front));
+    based_deque->attrs.insert("front", new model::NativeFunction(deque_front));
+    based_deque->attrs.insert("back", new model::NativeFunction(deque_back));
+    based_deque->attrs.insert("len", new model::NativeFunction(deque_len));
+    based_deque->attrs.insert("contains", new model::NativeFunction(deque_contains));
+    based_deque->attrs.insert("clear", new model::NativeFunction(deque_clear));
+    based_deque->attrs.insert("iter", new model::NativeFunction(deque_iter));
+
+    based_deque_cursor->attrs.insert("__parent__", model::based_obj);
+    based_deque_cursor->attrs.insert("__next__", new model::NativeFunction(deque_cursor_next));
+
+    based_heap->attrs.insert("__parent__", model::based_obj);
+    based_heap->attrs.insert("__call__", new model::NativeFunction(heap_call));
+    based_heap->attrs.insert("__bool__", new model::NativeFunction(heap_bool));
+    based_heap->attrs.insert("__str__", new model::NativeFunction(heap_str));
+    based_heap->attrs.insert("push", new model::NativeFunction(heap_push));
+    based_heap->attrs.insert("pop", new model::NativeFunction(heap_pop));
+    based_heap->attrs.insert("peek", new model::NativeFunction(heap_peek));
+    based_heap->attrs.insert("len", new model::NativeFunction(heap_len));
+    based_heap->attrs.insert("clear", new model::NativeFunction(heap_clear));
+
+    mod->attrs.insert("Deque", based_deque);
+    mod->attrs.insert("Heap", based_heap);
+
+    return mod;
+}
+
+}
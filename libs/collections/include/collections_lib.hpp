@@ -0,0 +1,154 @@
+#pragma once
+#include "models/models.hpp"
+
+namespace collections_lib {
+
+inline auto based_deque = new model::Object();
+inline auto based_deque_cursor = new model::Object();
+inline auto based_heap = new model::Object();
+
+// 分块环形缓冲区: 元素存放在定长块中, map_记录块指针, 两端增删均为O(1)且不移动已有元素
+class Deque : public model::Object {
+public:
+    static constexpr size_t block_size = 64;
+
+    Deque() {
+        attrs.insert("__parent__", based_deque);
+    }
+
+    ~Deque() override {
+        clear();
+        delete[] spare_;
+    }
+
+    [[nodiscard]] size_t size() const { return size_; }
+    [[nodiscard]] bool empty() const { return size_ == 0; }
+
+    // 下标从队首算起, 调用方保证 i < size()
+    [[nodiscard]] model::Object* get(const size_t i) const {
+        const size_t pos = head_ + i;
+        return map_[first_ + pos / block_size][pos % block_size];
+    }
+
+    void push_back(model::Object* elem);
+    void push_front(model::Object* elem);
+    // 与List.pop_back相同, 弹出时不释放容器持有的引用, 由调用方接管
+    model::Object* pop_back();
+    model::Object* pop_front();
+    void clear();
+
+    [[nodiscard]] std::string debug_string() const override {
+        return "<Deque at " + model::ptr_to_string(this) + ">";
+    }
+
+private:
+    std::vector<model::Object**> map_;
+    size_t first_ = 0;    // 第一个在用块在map_中的下标
+    size_t blocks_ = 0;   // 在用块个数
+    size_t head_ = 0;     // 队首元素在第一个块中的偏移
+    size_t size_ = 0;
+    model::Object** spare_ = nullptr;  // 缓存一个空闲块, 队列滑动时不反复分配
+
+    model::Object** alloc_block();
+    void free_block(model::Object** block);
+    // 元素全部移出后释放所有在用块
+    void reset_blocks();
+    // map_某一端没有空位时重新居中, 两端各留出不少于在用块数的空位
+    void recenter_map();
+};
+
+// 独立的遍历游标, 由Deque.iter()创建, 多个游标互不影响
+class DequeCursor : public model::Object {
+public:
+    Deque* deque;
+    size_t index = 0;
+
+    explicit DequeCursor(Deque* deque) : deque(deque) {
+        attrs.insert("__parent__", based_deque_cursor);
+        deque->make_ref();
+    }
+
+    ~DequeCursor() override {
+        deque->del_ref();
+    }
+};
+
+// d叉最小堆, 每个元素的比较键只计算一次; 键为Int/Dec/Str时与List.sort一样直接比较原生值
+class Heap : public model::Object {
+public:
+    static constexpr size_t arity = 4;
+
+    enum class KeyKind : uint8_t { Int64, BigInt, Decimal, Str, Object };
+
+    struct Node {
+        model::Object* elem;
+        model::Object* key;  // 无key函数时与elem相同
+        KeyKind kind;
+        int64_t int_key;
+    };
+
+    model::Object* key_func = nullptr;
+    bool reverse = false;
+
+    Heap() {
+        attrs.insert("__parent__", based_heap);
+    }
+
+    ~Heap() override {
+        clear();
+        if (key_func) key_func->del_ref();
+    }
+
+    [[nodiscard]] size_t size() const { return nodes_.size(); }
+    [[nodiscard]] bool empty() const { return nodes_.empty(); }
+    [[nodiscard]] const Node& top() const { return nodes_.front(); }
+
+    // 计算键并构造节点(有key函数时通过VM调用)
+    Node make_node(model::Object* elem) const;
+    void push(Node node);
+    // 批量加入后自底向上建堆, O(n)
+    void push_all(std::vector<Node> nodes);
+    model::Object* pop();
+    void clear();
+
+    [[nodiscard]] std::string debug_string() const override {
+        return "<Heap at " + model::ptr_to_string(this) + ">";
+    }
+
+private:
+    std::vector<Node> nodes_;
+
+    [[nodiscard]] bool less(const Node& a, const Node& b) const;
+    void sift_up(size_t i);
+    void sift_down(size_t i);
+};
+
+model::Object* init_module(model::Object* self, const model::List* args);
+
+model::Object* deque_call(model::Object* self, const model::List* args);
+model::Object* deque_push_back(model::Object* self, const model::List* args);
+model::Object* deque_push_front(model::Object* self, const model::List* args);
+model::Object* deque_pop_back(model::Object* self, const model::List* args);
+model::Object* deque_pop_front(model::Object* self, const model::List* args);
+model::Object* deque_front(model::Object* self, const model::List* args);
+model::Object* deque_back(model::Object* self, const model::List* args);
+model::Object* deque_getitem(model::Object* self, const model::List* args);
+model::Object* deque_len(model::Object* self, const model::List* args);
+model::Object* deque_contains(model::Object* self, const model::List* args);
+model::Object* deque_clear(model::Object* self, const model::List* args);
+model::Object* deque_bool(model::Object* self, const model::List* args);
+model::Object* deque_iter(model::Object* self, const model::List* args);
+model::Object* deque_str(model::Object* self, const model::List* args);
+model::Object* deque_dstr(model::Object* self, const model::List* args);
+model::Object* deque_cursor_next(model::Object* self, const model::List* args);
+
+model::Object* heap_call(model::Object* self, const model::List* args);
+model::Object* heap_push(model::Object* self, const model::List* args);
+model::Object* heap_pop(model::Object* self, const model::List* args);
+model::Object* heap_peek(model::Object* self, const model::List* args);
+model::Object* heap_len(model::Object* self, const model::List* args);
+model::Object* heap_clear(model::Object* self, const model::List* args);
+model::Object* heap_bool(model::Object* self, const model::List* args);
+model::Object* heap_str(model::Object* self, const model::List* args);
+
+}
@@ -0,0 +1,310 @@
+#include "include/csv_lib.hpp"
+#include "../deps/str_search.hpp"
+
+#include "builtins/include/builtin_functions.hpp"
+#include "builtins/include/builtin_methods.hpp"
+
+namespace csv_lib {
+
+// -------------------------- 读取 --------------------------
+bool CsvReader::fill() {
+    if (eof_ or !file_.is_open()) return false;
+    file_.read(buf_.data(), static_cast<std::streamsize>(chunk_size));
+    pos_ = 0;
+    len_ = static_cast<size_t>(file_.gcount());
+    if (len_ == 0) {
+        eof_ = true;
+        return false;
+    }
+    return true;
+}
+
+void CsvReader::close() {
+    file_.close();
+    eof_ = true;
+    pos_ = len_ = 0;
+}
+
+// 引号内的字段: 定位下一个引号, 连续两个引号表示一个字面引号
+void CsvReader::read_quoted(std::string& field) {
+    while (true) {
+        if (pos_ == len_ and !fill()) {
+            throw NativeFuncError("CsvError",
+                "Unexpected end of data in quoted field at line " + std::to_string(line_));
+        }
+        const char* p = buf_.data() + pos_;
+        const auto q = static_cast<const char*>(std::memchr(p, quote_, len_ - pos_));
+        if (q == nullptr) {
+            field.append(p, len_ - pos_);
+            pos_ = len_;
+            continue;
+        }
+        field.append(p, q);
+        pos_ = q - buf_.data() + 1;
+        if (pos_ == len_) fill();
+        if (pos_ < len_ and buf_[pos_] == quote_) {
+            field += quote_;
+            ++pos_;
+            continue;
+        }
+        return;
+    }
+}
+
+bool CsvReader::next_row(std::vector<std::string>& fields) {
+    if (pos_ == len_ and !fill()) return false;
+    ++line_;
+
+    // 空行得到空列表
+    if (buf_[pos_] == '\n' or buf_[pos_] == '\r') {
+        if (buf_[pos_++] == '\r' and (pos_ < len_ or fill()) and buf_[pos_] == '\n') ++pos_;
+        fields.clear();
+        return true;
+    }
+
+    size_t n = 0;
+    const auto new_field = [&] {
+        if (n == fields.size()) fields.emplace_back();
+        fields[n++].clear();
+    };
+    new_field();
+    bool field_start = true;
+
+    while (pos_ < len_ or fill()) {
+        // 仅字段开头的引号开始一个引号字段, 闭合引号之后的内容照常接在字段末尾
+        if (field_start and buf_[pos_] == quote_) {
+            ++pos_;
+            read_quoted(fields[n - 1]);
+            field_start = false;
+            continue;
+        }
+        field_start = false;
+
+        const std::string_view rest(buf_.data() + pos_, len_ - pos_);
+        const size_t stop = dep::find_any_of3(rest, delimiter_, '\n', '\r');
+        if (stop == std::string_view::npos) {
+            // 字段跨越读缓冲区边界, 读入下一块后继续
+            fields[n - 1].append(rest);
+            pos_ = len_;
+            continue;
+        }
+        fields[n - 1].append(rest.substr(0, stop));
+        pos_ += stop;
+
+        const char c = buf_[pos_++];
+        if (c == delimiter_) {
+            new_field();
+            field_start = true;
+            continue;
+        }
+        if (c == '\r' and (pos_ < len_ or fill()) and buf_[pos_] == '\n') ++pos_;
+        break;
+    }
+
+    fields.resize(n);
+    return true;
+}
+
+// -------------------------- 写入 --------------------------
+void CsvWriter::write_field(const std::string_view field) {
+    if (dep::find_any_of3(field, delimiter_, '\n', '\r') == std::string_view::npos
+        and field.find(quote_) == std::string_view::npos) {
+        buf_ += field;
+        return;
+    }
+    // 含分隔符、引号或换行的字段整体加引号, 其中的引号写两次
+    buf_ += quote_;
+    size_t from = 0;
+    for (size_t q = field.find(quote_); q != std::string_view::npos; q = field.find(quote_, from)) {
+        buf_.append(field.substr(from, q + 1 - from));
+        buf_ += quote_;
+        from = q + 1;
+    }
+    buf_.append(field.substr(from));
+    buf_ += quote_;
+}
+
+void CsvWriter::write_row(model::Object* row) {
+    if (!file_.is_open()) throw NativeFuncError("IOError", "CsvWriter is closed");
+
+    bool first = true;
+    std::string text;
+    const auto write_elem = [&](model::Object* elem) {
+        if (!first) buf_ += delimiter_;
+        first = false;
+        if (const auto elem_str = dynamic_cast<model::String*>(elem)) {
+            write_field(elem_str->view());
+        } else if (elem->get_type() != model::Object::ObjectType::OT_Nil) {
+            // Nil写为空字段, 其他对象按str转换
+            text.clear();
+            kiz::Vm::write_str(elem, text);
+            write_field(text);
+        }
+    };
+
+    const auto row_list = dynamic_cast<model::List*>(row);
+    if (row_list != nullptr and row_list->strategy() == model::List::Strategy::Str) {
+        for (const auto& s : row_list->strs()) {
+            if (!first) buf_ += delimiter_;
+            first = false;
+            write_field(s);
+        }
+    } else if (row_list != nullptr and row_list->strategy() == model::List::Strategy::Generic) {
+        for (const auto elem : row_list->val) write_elem(elem);
+    } else {
+        const auto it = model::make_iterator(row);
+        while (const auto elem = model::iterator_step(it)) write_elem(elem);
+    }
+    buf_ += '\n';
+
+    if (buf_.size() >= flush_threshold) flush();
+}
+
+void CsvWriter::flush() {
+    if (!file_.is_open()) throw NativeFuncError("IOError", "CsvWriter is closed");
+    file_.write(buf_.data(), static_cast<std::streamsize>(buf_.size()));
+    buf_.clear();
+    if (file_.fail()) throw NativeFuncError("IOError", "CSV write failed");
+}
+
+void CsvWriter::close() {
+    if (!file_.is_open()) return;
+    flush();
+    file_.close();
+}
+
+// -------------------------- 原生方法 --------------------------
+// 单字符参数(分隔符/引号), 缺省或Nil时取默认值
+static char char_arg(const model::List* args, const size_t pos, const char default_char, const std::string& name) {
+    if (args->val.size() <= pos or args->val[pos]->get_type() == model::Object::ObjectType::OT_Nil) {
+        return default_char;
+    }
+    const auto str = dynamic_cast<model::String*>(args->val[pos]);
+    if (str == nullptr or str->view().size() != 1 or str->view()[0] == '\n' or str->view()[0] == '\r') {
+        throw NativeFuncError("TypeError", "csv " + name + " must be a single-byte Str other than a newline");
+    }
+    return str->view()[0];
+}
+
+static const std::string& path_arg(const model::List* args, const std::string& func) {
+    const auto path = args->val.empty() ? nullptr : dynamic_cast<model::String*>(args->val[0]);
+    if (path == nullptr) throw NativeFuncError("TypeError", "csv." + func + " need a Str path");
+    return path->val();
+}
+
+static CsvReader* self_reader(model::Object* self, const std::string& method) {
+    const auto reader = dynamic_cast<CsvReader*>(self);
+    if (reader == nullptr) {
+        throw NativeFuncError("TypeError", "CsvReader." + method + " must be called by CsvReader object");
+    }
+    return reader;
+}
+
+static CsvWriter* self_writer(model::Object* self, const std::string& method) {
+    const auto writer = dynamic_cast<CsvWriter*>(self);
+    if (writer == nullptr) {
+        throw NativeFuncError("TypeError", "CsvWriter." + method + " must be called by CsvWriter object");
+    }
+    return writer;
+}
+
+model::Object* init_module(model::Object* self, const model::List* args) {
+    auto mod = new model::Module("csv");
+
+    based_csv_reader->attrs.insert("__parent__", model::based_obj);
+    based_csv_reader->attrs.insert("__next__", new model::NativeFunction(csv_reader_next));
+    based_csv_reader->attrs.insert("line_num", new model::NativeFunction(csv_reader_line_num));
+    based_csv_reader->attrs.insert("close", new model::NativeFunction(csv_reader_close));
+
+    based_csv_writer->attrs.insert("__parent__", model::based_obj);
+    based_csv_writer->attrs.insert("write_row", new model::NativeFunction(csv_writer_write_row));
+    based_csv_writer->attrs.insert("write_rows", new model::NativeFunction(csv_writer_write_rows));
+    based_csv_writer->attrs.insert("flush", new model::NativeFunction(csv_writer_flush));
+    based_csv_writer->attrs.insert("close", new model::NativeFunction(csv_writer_close));
+
+    mod->attrs.insert("reader", new model::NativeFunction(reader));
+    mod->attrs.insert("writer", new model::NativeFunction(writer));
+
+    return mod;
+}
+
+// csv.reader(path, delimiter=",", quote="\"", reuse=False)
+model::Object* reader(model::Object* self, const model::List* args) {
+    const auto& path = path_arg(args, "reader");
+    const auto csv_reader = new CsvReader(path, char_arg(args, 1, ',', "delimiter"), char_arg(args, 2, '"', "quote"));
+    if (!csv_reader->is_open()) {
+        delete csv_reader;
+        throw NativeFuncError("PathError", "Failed to open file: " + path);
+    }
+    csv_reader->reuse = args->val.size() > 3 and kiz::Vm::is_true(args->val[3]);
+    return csv_reader;
+}
+
+// csv.writer(path, delimiter=",", quote="\"")
+model::Object* writer(model::Object* self, const model::List* args) {
+    const auto& path = path_arg(args, "writer");
+    const auto csv_writer = new CsvWriter(path, char_arg(args, 1, ',', "delimiter"), char_arg(args, 2, '"', "quote"));
+    if (!csv_writer->is_open()) {
+        delete csv_writer;
+        throw NativeFuncError("IOError", "Failed to open/create file: " + path);
+    }
+    return csv_writer;
+}
+
+// 每次返回一行的字段(Str列表), 读完后返回StopIter
+model::Object* csv_reader_next(model::Object* self, const model::List* args) {
+    const auto csv_reader = self_reader(self, "__next__");
+    if (!csv_reader->reuse) {
+        std::vector<std::string> fields;
+        if (!csv_reader->next_row(fields)) return model::load_stop_iter();
+        return model::List::from_strs(std::move(fields));
+    }
+
+    // 复用的行若被调用方改成了其他存储方式, 换一个新列表
+    if (csv_reader->row == nullptr or csv_reader->row->strategy() != model::List::Strategy::Str) {
+        if (csv_reader->row) csv_reader->row->del_ref();
+        csv_reader->row = model::List::from_strs({});
+        csv_reader->row->make_ref();
+    }
+    if (!csv_reader->next_row(csv_reader->row->strs())) return model::load_stop_iter();
+    return csv_reader->row;
+}
+
+model::Object* csv_reader_line_num(model::Object* self, const model::List* args) {
+    return model::create_int(dep::BigInt(self_reader(self, "line_num")->line_num()));
+}
+
+model::Object* csv_reader_close(model::Object* self, const model::List* args) {
+    self_reader(self, "close")->close();
+    return model::load_nil();
+}
+
+model::Object* csv_writer_write_row(model::Object* self, const model::List* args) {
+    self_writer(self, "write_row")->write_row(builtin::get_one_arg(args));
+    return model::load_nil();
+}
+
+model::Object* csv_writer_write_rows(model::Object* self, const model::List* args) {
+    const auto csv_writer = self_writer(self, "write_rows");
+    const auto rows = builtin::get_one_arg(args);
+    const auto rows_list = dynamic_cast<model::List*>(rows);
+    if (rows_list != nullptr and rows_list->strategy() == model::List::Strategy::Generic) {
+        for (const auto row : rows_list->val) csv_writer->write_row(row);
+        return model::load_nil();
+    }
+    const auto it = model::make_iterator(rows);
+    while (const auto row = model::iterator_step(it)) csv_writer->write_row(row);
+    return model::load_nil();
+}
+
+model::Object* csv_writer_flush(model::Object* self, const model::List* args) {
+    self_writer(self, "flush")->flush();
+    return model::load_nil();
+}
+
+model::Object* csv_writer_close(model::Object* self, const model::List* args) {
+    self_writer(self, "close")->close();
+    return model::load_nil();
+}
+
+}
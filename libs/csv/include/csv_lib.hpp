@@ -0,0 +1,104 @@
+#pragma once
+#include "models/models.hpp"
+#include <fstream>
+
+namespace csv_lib {
+
+inline auto based_csv_reader = new model::Object();
+inline auto based_csv_writer = new model::Object();
+
+// 按块读取文件并逐行切分字段, 内存占用只有一个读缓冲区和当前行
+class CsvReader : public model::Object {
+public:
+    static constexpr size_t chunk_size = 64 * 1024;
+
+    CsvReader(const std::string& path, const char delimiter, const char quote)
+        : file_(path, std::ios::binary | std::ios::in), delimiter_(delimiter), quote_(quote) {
+        attrs.insert("__parent__", based_csv_reader);
+    }
+
+    ~CsvReader() override {
+        if (row) row->del_ref();
+    }
+
+    [[nodiscard]] bool is_open() const { return file_.is_open(); }
+    // 已读出的行数(一行带引号字段内的换行不单独计数)
+    [[nodiscard]] size_t line_num() const { return line_; }
+
+    // 读出下一行的字段, 复用fields中已有字符串的容量; 文件读完时返回false
+    bool next_row(std::vector<std::string>& fields);
+    void close();
+
+    // reuse模式下每次返回同一个List, 只替换其中的字符串
+    bool reuse = false;
+    model::List* row = nullptr;
+
+    [[nodiscard]] std::string debug_string() const override {
+        return "<CsvReader at " + model::ptr_to_string(this) + ">";
+    }
+
+private:
+    std::ifstream file_;
+    char delimiter_;
+    char quote_;
+    std::vector<char> buf_ = std::vector<char>(chunk_size);
+    size_t pos_ = 0;
+    size_t len_ = 0;
+    bool eof_ = false;
+    size_t line_ = 0;
+
+    // 缓冲区读空时读入下一块, 没有更多数据时返回false
+    bool fill();
+    void read_quoted(std::string& field);
+};
+
+// 行数据先写入内存缓冲区, 达到阈值后整块写入文件
+class CsvWriter : public model::Object {
+public:
+    static constexpr size_t flush_threshold = 64 * 1024;
+
+    CsvWriter(const std::string& path, const char delimiter, const char quote)
+        : file_(path, std::ios::binary | std::ios::out | std::ios::trunc), delimiter_(delimiter), quote_(quote) {
+        attrs.insert("__parent__", based_csv_writer);
+    }
+
+    ~CsvWriter() override {
+        if (file_.is_open()) {
+            file_.write(buf_.data(), static_cast<std::streamsize>(buf_.size()));
+        }
+    }
+
+    [[nodiscard]] bool is_open() const { return file_.is_open(); }
+
+    void write_row(model::Object* row);
+    void flush();
+    void close();
+
+    [[nodiscard]] std::string debug_string() const override {
+        return "<CsvWriter at " + model::ptr_to_string(this) + ">";
+    }
+
+private:
+    std::ofstream file_;
+    char delimiter_;
+    char quote_;
+    std::string buf_;
+
+    void write_field(std::string_view field);
+};
+
+model::Object* init_module(model::Object* self, const model::List* args);
+
+model::Object* reader(model::Object* self, const model::List* args);
+model::Object* writer(model::Object* self, const model::List* args);
+
+model::Object* csv_reader_next(model::Object* self, const model::List* args);
+model::Object* csv_reader_line_num(model::Object* self, const model::List* args);
+model::Object* csv_reader_close(model::Object* self, const model::List* args);
+
+model::Object* csv_writer_write_row(model::Object* self, const model::List* args);
+model::Object* csv_writer_write_rows(model::Object* self, const model::List* args);
+model::Object* csv_writer_flush(model::Object* self, const model::List* args);
+model::Object* csv_writer_close(model::Object* self, const model::List* args);
+
+}
@@ -85,10 +85,10 @@ model::Object* fast_read(model::Object* self, const model::List* args) {
     auto path_str = dynamic_cast<model::String*>(path);
     assert(path_str != nullptr);
 
-    std::ifstream file(path_str->val, std::ios::binary | std::ios::in);
+    std::ifstream file(path_str->val(), std::ios::binary | std::ios::in);
 
     if (!file.is_open()) {
-        throw NativeFuncError("PathError", "Failed to open file: " + path_str->val);
+        throw NativeFuncError("PathError", "Failed to open file: " + path_str->val());
     }
 
     auto content = std::string(std::istreambuf_iterator(file),
@@ -110,7 +110,7 @@ model::Object* fast_write(model::Object* self, const model::List* args) {
     auto start_idx = dynamic_cast<model::Int*>(args_vec[2]);
     assert(start_idx != nullptr);
 
-    util_write(path_str->val, text_str->val, start_idx->val.to_unsigned_long_long());
+    util_write(path_str->val(), text_str->val(), start_idx->val.to_unsigned_long_long());
 
     return new model::Nil();
 }
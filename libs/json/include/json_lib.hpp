@@ -0,0 +1,13 @@
+#pragma once
+#include "models/models.hpp"
+
+namespace json_lib {
+
+model::Object* init_module(model::Object* self, const model::List* args);
+
+model::Object* loads(model::Object* self, const model::List* args);
+model::Object* dumps(model::Object* self, const model::List* args);
+model::Object* load(model::Object* self, const model::List* args);
+model::Object* dump(model::Object* self, const model::List* args);
+
+}
@@ -0,0 +1,531 @@
+#include "include/json_lib.hpp"
+#include <cstring>
+#include <fstream>
+
+#include "../deps/str_search.hpp"
+#include "builtins/include/builtin_functions.hpp"
+
+namespace json_lib {
+
+// 嵌套层数上限, 防止恶意输入或循环引用耗尽栈
+constexpr size_t max_depth = 1024;
+// dump时输出缓冲区达到该大小即写入文件
+constexpr size_t flush_threshold = 64 * 1024;
+
+// -------------------------- 字符串扫描 --------------------------
+// 从p开始跳过不需要特殊处理的字节, 返回第一个'"' '\\'或控制字符的位置(或end); 按SIMD块比较
+inline const char* skip_plain(const char* p, const char* end) {
+    const size_t i = dep::find_any_of2_or_ctrl(std::string_view(p, end - p), '"', '\\');
+    return i == std::string_view::npos ? end : p + i;
+}
+
+void append_utf8(std::string& out, const uint32_t cp) {
+    if (cp < 0x80) {
+        out += static_cast<char>(cp);
+    } else if (cp < 0x800) {
+        out += static_cast<char>(0xC0 | (cp >> 6));
+        out += static_cast<char>(0x80 | (cp & 0x3F));
+    } else if (cp < 0x10000) {
+        out += static_cast<char>(0xE0 | (cp >> 12));
+        out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (cp & 0x3F));
+    } else {
+        out += static_cast<char>(0xF0 | (cp >> 18));
+        out += static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+        out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (cp & 0x3F));
+    }
+}
+
+// -------------------------- 解析 --------------------------
+// 单遍递归下降: 直接构造kiz对象; 数组与对象的元素先压入共用的暂存栈, 闭合时按确切个数一次建好容器
+class Parser {
+public:
+    Parser(const char* data, const size_t size) : begin_(data), p_(data), end_(data + size) {}
+
+    model::Object* parse_document() {
+        skip_ws();
+        model::Object* result = parse_value();
+        skip_ws();
+        if (p_ != end_) fail("Extra data");
+        return result;
+    }
+
+private:
+    const char* begin_;
+    const char* p_;
+    const char* end_;
+    size_t depth_ = 0;
+    std::vector<model::Object*> elems_;
+    std::vector<model::Dictionary::Pair> pairs_;
+    std::string buf_;
+
+    [[noreturn]] void fail(const std::string& msg) const {
+        size_t line = 1, column = 1;
+        for (const char* q = begin_; q < p_; ++q) {
+            if (*q == '\n') {
+                ++line;
+                column = 1;
+            } else {
+                ++column;
+            }
+        }
+        throw NativeFuncError("JSONDecodeError",
+            msg + " at line " + std::to_string(line) + " column " + std::to_string(column));
+    }
+
+    void skip_ws() {
+        while (p_ < end_ and (*p_ == ' ' or *p_ == '\n' or *p_ == '\r' or *p_ == '\t')) ++p_;
+    }
+
+    void expect_literal(const char* word, const size_t len) {
+        if (static_cast<size_t>(end_ - p_) < len or std::memcmp(p_, word, len) != 0) fail("Expecting value");
+        p_ += len;
+    }
+
+    model::Object* parse_value() {
+        if (p_ == end_) fail("Expecting value");
+        switch (*p_) {
+        case '{': return parse_object();
+        case '[': return parse_array();
+        case '"': return model::create_str(parse_string());
+        case 't': expect_literal("true", 4); return model::load_bool(true);
+        case 'f': expect_literal("false", 5); return model::load_bool(false);
+        case 'n': expect_literal("null", 4); return model::load_nil();
+        default: return parse_number();
+        }
+    }
+
+    void enter() {
+        if (++depth_ > max_depth) fail("Maximum nesting depth exceeded");
+        ++p_;
+        skip_ws();
+    }
+
+    model::Object* parse_array() {
+        enter();
+        if (p_ < end_ and *p_ == ']') {
+            ++p_;
+            --depth_;
+            return model::List::create_empty();
+        }
+        const size_t base = elems_.size();
+        while (true) {
+            elems_.push_back(parse_value());
+            skip_ws();
+            if (p_ < end_ and *p_ == ',') {
+                ++p_;
+                skip_ws();
+                continue;
+            }
+            if (p_ < end_ and *p_ == ']') break;
+            fail("Expecting ',' delimiter");
+        }
+        ++p_;
+        --depth_;
+
+        // 按确切个数建表, 元素同类时转为拆箱存储
+        std::vector<model::Object*> elems(elems_.begin() + static_cast<std::ptrdiff_t>(base), elems_.end());
+        elems_.resize(base);
+        for (const auto e : elems) e->make_ref();
+        const auto list = new model::List(std::move(elems));
+        list->specialize();
+        return list;
+    }
+
+    model::Object* parse_object() {
+        enter();
+        auto dict = new model::Dictionary();
+        if (p_ < end_ and *p_ == '}') {
+            ++p_;
+            --depth_;
+            return dict;
+        }
+        const size_t base = pairs_.size();
+        while (true) {
+            if (p_ == end_ or *p_ != '"') fail("Expecting property name enclosed in double quotes");
+            const auto key = model::create_str(parse_string());
+            skip_ws();
+            if (p_ == end_ or *p_ != ':') fail("Expecting ':' delimiter");
+            ++p_;
+            skip_ws();
+            const auto value = parse_value();
+            pairs_.emplace_back(key, value);
+            skip_ws();
+            if (p_ < end_ and *p_ == ',') {
+                ++p_;
+                skip_ws();
+                continue;
+            }
+            if (p_ < end_ and *p_ == '}') break;
+            fail("Expecting ',' delimiter");
+        }
+        ++p_;
+        --depth_;
+
+        dict->reserve(pairs_.size() - base);
+        for (size_t i = base; i < pairs_.size(); ++i) {
+            const auto& [key, value] = pairs_[i];
+            // 重复的键以最后一次出现为准, 与字典字面量一致
+            if (const auto old = dict->find(key)) {
+                value->make_ref();
+                old->second->del_ref();
+                old->second = value;
+                continue;
+            }
+            key->make_ref();
+            value->make_ref();
+            dict->insert(key, value);
+        }
+        pairs_.resize(base);
+        return dict;
+    }
+
+    uint32_t parse_hex4() {
+        if (end_ - p_ < 4) fail("Invalid \\uXXXX escape");
+        uint32_t cp = 0;
+        for (int i = 0; i < 4; ++i) {
+            const char c = *p_++;
+            cp <<= 4;
+            if (c >= '0' and c <= '9') cp |= c - '0';
+            else if (c >= 'a' and c <= 'f') cp |= c - 'a' + 10;
+            else if (c >= 'A' and c <= 'F') cp |= c - 'A' + 10;
+            else fail("Invalid \\uXXXX escape");
+        }
+        return cp;
+    }
+
+    // 无转义的字符串直接按区间构造; 遇到转义时才逐段拷贝到缓冲区
+    std::string parse_string() {
+        ++p_;
+        const char* start = p_;
+        p_ = skip_plain(p_, end_);
+        if (p_ < end_ and *p_ == '"') return std::string(start, p_++);
+
+        buf_.assign(start, p_);
+        while (true) {
+            if (p_ == end_) fail("Unterminated string");
+            const char c = *p_;
+            if (c == '"') {
+                ++p_;
+                return buf_;
+            }
+            if (static_cast<unsigned char>(c) < 0x20) fail("Invalid control character in string");
+            // c == '\\'
+            if (++p_ == end_) fail("Unterminated string");
+            switch (*p_++) {
+            case '"': buf_ += '"'; break;
+            case '\\': buf_ += '\\'; break;
+            case '/': buf_ += '/'; break;
+            case 'b': buf_ += '\b'; break;
+            case 'f': buf_ += '\f'; break;
+            case 'n': buf_ += '\n'; break;
+            case 'r': buf_ += '\r'; break;
+            case 't': buf_ += '\t'; break;
+            case 'u': {
+                uint32_t cp = parse_hex4();
+                if (cp >= 0xD800 and cp < 0xDC00) {
+                    // 高代理项后须紧跟低代理项
+                    if (end_ - p_ < 2 or p_[0] != '\\' or p_[1] != 'u') fail("Invalid \\uXXXX escape");
+                    p_ += 2;
+                    const uint32_t low = parse_hex4();
+                    if (low < 0xDC00 or low >= 0xE000) fail("Invalid \\uXXXX escape");
+                    cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+                } else if (cp >= 0xDC00 and cp < 0xE000) {
+                    fail("Invalid \\uXXXX escape");
+                }
+                append_utf8(buf_, cp);
+                break;
+            }
+            default:
+                --p_;
+                fail("Invalid \\escape");
+            }
+            const char* run = p_;
+            p_ = skip_plain(p_, end_);
+            buf_.append(run, p_);
+        }
+    }
+
+    model::Object* parse_number() {
+        const char* start = p_;
+        const auto is_digit = [this] { return p_ < end_ and *p_ >= '0' and *p_ <= '9'; };
+
+        const bool negative = p_ < end_ and *p_ == '-';
+        if (negative) ++p_;
+        if (!is_digit()) fail("Expecting value");
+        // 尾数(整数部分与小数部分的全部数字)不超过18位时直接在int64上累加
+        int64_t mantissa = 0;
+        size_t digits = 0;
+        const auto take_digits = [&] {
+            while (is_digit()) {
+                if (digits < 18) mantissa = mantissa * 10 + (*p_ - '0');
+                ++digits;
+                ++p_;
+            }
+        };
+        if (*p_ == '0') {
+            ++p_;
+            ++digits;
+        } else {
+            take_digits();
+        }
+
+        bool integral = true;
+        int frac_digits = 0;
+        if (p_ < end_ and *p_ == '.') {
+            integral = false;
+            ++p_;
+            if (!is_digit()) fail("Expecting digit after '.'");
+            const char* frac = p_;
+            take_digits();
+            frac_digits = static_cast<int>(p_ - frac);
+        }
+        int exponent = 0;
+        bool exponent_fits = true;
+        if (p_ < end_ and (*p_ == 'e' or *p_ == 'E')) {
+            integral = false;
+            ++p_;
+            const bool exp_negative = p_ < end_ and *p_ == '-';
+            if (p_ < end_ and (*p_ == '+' or *p_ == '-')) ++p_;
+            if (!is_digit()) fail("Expecting digit in exponent");
+            while (is_digit()) {
+                if (exponent > 100000) exponent_fits = false;
+                else exponent = exponent * 10 + (*p_ - '0');
+                ++p_;
+            }
+            if (!exponent_fits) fail("Number out of range");
+            if (exp_negative) exponent = -exponent;
+        }
+
+        if (digits <= 18) {
+            if (negative) mantissa = -mantissa;
+            if (integral) return model::create_int(dep::BigInt::from_int64(mantissa));
+            return new model::Decimal(dep::Decimal::from_int64(mantissa, exponent - frac_digits));
+        }
+        const std::string text(start, p_);
+        if (integral) return model::create_int(dep::BigInt(text));
+        return new model::Decimal(dep::Decimal(text));
+    }
+};
+
+// -------------------------- 序列化 --------------------------
+class Writer {
+public:
+    // sink非空时缓冲区满即写出, 用于dump流式写文件
+    Writer(const int64_t indent, std::ofstream* sink) : indent_(indent), sink_(sink) {}
+
+    std::string out;
+
+    void write(model::Object* obj) {
+        if (++depth_ > max_depth) {
+            throw NativeFuncError("ValueError", "Circular reference detected or nesting too deep");
+        }
+        write_value(obj);
+        --depth_;
+        if (sink_ != nullptr and out.size() >= flush_threshold) flush();
+    }
+
+    void flush() {
+        sink_->write(out.data(), static_cast<std::streamsize>(out.size()));
+        if (sink_->fail()) throw NativeFuncError("IOError", "JSON dump write failed");
+        out.clear();
+    }
+
+private:
+    int64_t indent_;
+    std::ofstream* sink_;
+    size_t depth_ = 0;
+
+    void newline(const size_t level) {
+        if (indent_ < 0) return;
+        out += '\n';
+        out.append(level * static_cast<size_t>(indent_), ' ');
+    }
+
+    void write_string(const std::string_view s) {
+        out += '"';
+        const char* p = s.data();
+        const char* end = p + s.size();
+        while (p < end) {
+            const char* run = p;
+            p = skip_plain(p, end);
+            out.append(run, p);
+            if (p == end) break;
+            const auto c = static_cast<unsigned char>(*p++);
+            switch (c) {
+            case '"': out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\n': out += "\\n"; break;
+            case '\r': out += "\\r"; break;
+            case '\t': out += "\\t"; break;
+            case '\b': out += "\\b"; break;
+            case '\f': out += "\\f"; break;
+            default: {
+                constexpr char hex[] = "0123456789abcdef";
+                out += "\\u00";
+                out += hex[c >> 4];
+                out += hex[c & 0xF];
+            }
+            }
+        }
+        out += '"';
+    }
+
+    // 整数值的Dec补上".0", 读回时仍为Dec
+    void write_decimal(const dep::Decimal& val) {
+        const size_t from = out.size();
+        out += val.to_string();
+        if (out.find('.', from) == std::string::npos) out += ".0";
+    }
+
+    // 数组的各元素之间加分隔符, 有缩进时每个元素单独一行
+    template <typename F>
+    void write_array(const size_t n, F&& write_elem) {
+        out += '[';
+        for (size_t i = 0; i < n; ++i) {
+            if (i != 0) out += ',';
+            newline(depth_);
+            write_elem(i);
+        }
+        if (n != 0) newline(depth_ - 1);
+        out += ']';
+    }
+
+    void write_value(model::Object* obj) {
+        switch (obj->get_type()) {
+        case model::Object::ObjectType::OT_Nil: out += "null"; return;
+        case model::Object::ObjectType::OT_Bool:
+            out += dynamic_cast<model::Bool*>(obj)->val ? "true" : "false";
+            return;
+        case model::Object::ObjectType::OT_Int: out += dynamic_cast<model::Int*>(obj)->val.to_string(); return;
+        case model::Object::ObjectType::OT_Decimal: write_decimal(dynamic_cast<model::Decimal*>(obj)->val); return;
+        case model::Object::ObjectType::OT_Float:
+            if (!std::isfinite(dynamic_cast<model::Float*>(obj)->val)) {
+                throw NativeFuncError("ValueError", "Out of range Float values are not JSON compliant");
+            }
+            out += obj->debug_string();
+            return;
+        case model::Object::ObjectType::OT_String: write_string(dynamic_cast<model::String*>(obj)->view()); return;
+        case model::Object::ObjectType::OT_List: {
+            // 拆箱列表直接写出原生值, 不装箱
+            const auto list = dynamic_cast<model::List*>(obj);
+            switch (list->strategy()) {
+            case model::List::Strategy::Int:
+                write_array(list->size(), [&](const size_t i) { out += std::to_string(list->ints()[i]); });
+                return;
+            case model::List::Strategy::Decimal:
+                write_array(list->size(), [&](const size_t i) { write_decimal(list->decimals()[i]); });
+                return;
+            case model::List::Strategy::Str:
+                write_array(list->size(), [&](const size_t i) { write_string(list->strs()[i]); });
+                return;
+            default:
+                write_array(list->size(), [&](const size_t i) { write(list->get(i)); });
+                return;
+            }
+        }
+        case model::Object::ObjectType::OT_Tuple: {
+            const auto tuple = dynamic_cast<model::Tuple*>(obj);
+            write_array(tuple->size(), [&](const size_t i) { write(tuple->get(i)); });
+            return;
+        }
+        case model::Object::ObjectType::OT_Dictionary: {
+            const auto dict = dynamic_cast<model::Dictionary*>(obj);
+            out += '{';
+            bool first = true;
+            dict->for_each([&](const model::Dictionary::Pair& kv_pair) {
+                if (!first) out += ',';
+                first = false;
+                newline(depth_);
+                // JSON的键只能是字符串, Int键按十进制写出
+                if (const auto key_str = dynamic_cast<model::String*>(kv_pair.first)) {
+                    write_string(key_str->view());
+                } else if (const auto key_int = dynamic_cast<model::Int*>(kv_pair.first)) {
+                    out += '"';
+                    out += key_int->val.to_string();
+                    out += '"';
+                } else {
+                    throw NativeFuncError("TypeError", "JSON object keys must be Str or Int, not "
+                        + kv_pair.first->debug_string());
+                }
+                out += indent_ < 0 ? ":" : ": ";
+                write(kv_pair.second);
+            });
+            if (!first) newline(depth_ - 1);
+            out += '}';
+            return;
+        }
+        default:
+            throw NativeFuncError("TypeError", "Object " + obj->debug_string() + " is not JSON serializable");
+        }
+    }
+};
+
+// indent参数: Nil为紧凑输出, 非负Int为每层缩进的空格数
+static int64_t indent_arg(const model::List* args, const size_t pos) {
+    if (args->val.size() <= pos or args->val[pos]->get_type() == model::Object::ObjectType::OT_Nil) return -1;
+    const auto indent = dynamic_cast<model::Int*>(args->val[pos]);
+    int64_t v;
+    if (indent == nullptr or !indent->val.to_int64(v) or v < 0) {
+        throw NativeFuncError("TypeError", "json indent must be a non-negative Int or Nil");
+    }
+    return v;
+}
+
+static const model::String* str_arg(const model::List* args, const size_t pos, const std::string& func) {
+    const auto str = args->val.size() > pos ? dynamic_cast<model::String*>(args->val[pos]) : nullptr;
+    if (str == nullptr) throw NativeFuncError("TypeError", "json." + func + " need a Str argument");
+    return str;
+}
+
+// -------------------------- 模块 --------------------------
+model::Object* init_module(model::Object* self, const model::List* args) {
+    auto mod = new model::Module("json");
+
+    mod->attrs.insert("loads", new model::NativeFunction(loads));
+    mod->attrs.insert("dumps", new model::NativeFunction(dumps));
+    mod->attrs.insert("load", new model::NativeFunction(load));
+    mod->attrs.insert("dump", new model::NativeFunction(dump));
+
+    return mod;
+}
+
+// json.loads(text)
+model::Object* loads(model::Object* self, const model::List* args) {
+    const auto text = str_arg(args, 0, "loads")->view();
+    return Parser(text.data(), text.size()).parse_document();
+}
+
+// json.dumps(obj, indent=Nil)
+model::Object* dumps(model::Object* self, const model::List* args) {
+    Writer writer(indent_arg(args, 1), nullptr);
+    writer.write(builtin::get_one_arg(args));
+    return model::create_str(std::move(writer.out));
+}
+
+// json.load(path): 一次读入整个文件后解析
+model::Object* load(model::Object* self, const model::List* args) {
+    const auto& path = str_arg(args, 0, "load")->val();
+    std::ifstream file(path, std::ios::binary | std::ios::in);
+    if (!file.is_open()) {
+        throw NativeFuncError("PathError", "Failed to open file: " + path);
+    }
+    const auto content = std::string(std::istreambuf_iterator(file), std::istreambuf_iterator<char>());
+    return Parser(content.data(), content.size()).parse_document();
+}
+
+// json.dump(obj, path, indent=Nil): 边序列化边写入文件, 内存占用不随输出大小增长
+model::Object* dump(model::Object* self, const model::List* args) {
+    const auto& path = str_arg(args, 1, "dump")->val();
+    std::ofstream file(path, std::ios::binary | std::ios::out | std::ios::trunc);
+    if (!file.is_open()) {
+        throw NativeFuncError("IOError", "Failed to open/create file: " + path);
+    }
+    Writer writer(indent_arg(args, 2), &file);
+    writer.write(args->val[0]);
+    writer.flush();
+    return model::load_nil();
+}
+
+}
@@ -0,0 +1,18 @@
+#pragma once
+#include "models/models.hpp"
+
+namespace math_lib {
+
+model::Object* init_module(model::Object* self, const model::List* args);
+
+model::Object* gcd(model::Object* self, const model::List* args);
+model::Object* isqrt(model::Object* self, const model::List* args);
+model::Object* pow_mod(model::Object* self, const model::List* args);
+model::Object* factorial(model::Object* self, const model::List* args);
+model::Object* comb(model::Object* self, const model::List* args);
+
+model::Object* sqrt(model::Object* self, const model::List* args);
+model::Object* exp(model::Object* self, const model::List* args);
+model::Object* ln(model::Object* self, const model::List* args);
+
+}
@@ -0,0 +1,77 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "../deps/bigint.hpp"
+
+namespace math_lib {
+
+// 以2^32为基的非负大整数, 仅供math模块内部运算
+// dep::BigInt逐位十进制存储, 除法与取模的代价很高; 这里的算法只在输入输出时与之转换
+class Natural {
+public:
+    std::vector<uint32_t> limbs;  // 低位在前, 无前导零, 0为空
+
+    Natural() = default;
+    explicit Natural(uint64_t val);
+
+    // 取绝对值
+    static Natural from_bigint(const dep::BigInt& n);
+    static Natural pow10(size_t k);
+    [[nodiscard]] dep::BigInt to_bigint(bool negative = false) const;
+    [[nodiscard]] std::string to_string() const;
+
+    [[nodiscard]] bool is_zero() const { return limbs.empty(); }
+    [[nodiscard]] bool is_odd() const { return !limbs.empty() and (limbs[0] & 1); }
+    [[nodiscard]] bool fits_u64() const { return limbs.size() <= 2; }
+    [[nodiscard]] uint64_t to_u64() const;
+    [[nodiscard]] size_t bit_length() const;
+    // 返回 x >> shift 的低64位
+    [[nodiscard]] uint64_t bits_at(size_t shift) const;
+
+    void trim();
+    // *this = *this * m + add
+    void mul_small(uint32_t m, uint32_t add = 0);
+    // 原地除以d, 返回余数
+    uint32_t div_small(uint32_t d);
+
+    static int compare(const Natural& a, const Natural& b);
+    // 商与余数, b不能为0
+    static void divmod(const Natural& a, const Natural& b, Natural& q, Natural& r);
+
+    friend Natural operator+(const Natural& a, const Natural& b);
+    // 要求 a >= b
+    friend Natural operator-(const Natural& a, const Natural& b);
+    friend Natural operator*(const Natural& a, const Natural& b);
+    friend Natural operator/(const Natural& a, const Natural& b);
+    friend Natural operator%(const Natural& a, const Natural& b);
+    friend Natural operator<<(const Natural& a, size_t bits);
+    friend Natural operator>>(const Natural& a, size_t bits);
+
+    friend bool operator==(const Natural& a, const Natural& b) { return a.limbs == b.limbs; }
+    friend bool operator!=(const Natural& a, const Natural& b) { return a.limbs != b.limbs; }
+    friend bool operator<(const Natural& a, const Natural& b) { return compare(a, b) < 0; }
+    friend bool operator>(const Natural& a, const Natural& b) { return compare(a, b) > 0; }
+    friend bool operator<=(const Natural& a, const Natural& b) { return compare(a, b) <= 0; }
+    friend bool operator>=(const Natural& a, const Natural& b) { return compare(a, b) >= 0; }
+};
+
+namespace algo {
+
+// Lehmer算法, 两数都不超过64位后改用二进制gcd
+Natural gcd(Natural a, Natural b);
+// 牛顿迭代求 floor(sqrt(n))
+Natural isqrt(const Natural& n);
+// base^exp mod m, m > 0; 奇数模用Montgomery乘法, 指数按滑动窗口处理
+Natural pow_mod(const Natural& base, const Natural& exp, const Natural& m);
+// a在模m下的逆元, 不存在时返回false
+bool inverse_mod(const Natural& a, const Natural& m, Natural& out);
+// 二分拆分求n!
+Natural factorial(uint32_t n);
+// 组合数C(n, k)
+Natural comb(const Natural& n, const Natural& k);
+
+}
+
+}
@@ -0,0 +1,231 @@
+#include "include/math_lib.hpp"
+#include "include/natural.hpp"
+#include <bit>
+#include <cmath>
+
+#include "builtins/include/builtin_functions.hpp"
+#include "builtins/include/builtin_methods.hpp"
+
+namespace math_lib {
+
+// -------------------------- 参数 --------------------------
+static const dep::BigInt& int_arg(const model::List* args, const size_t pos, const std::string& func) {
+    const auto n = args->val.size() > pos ? dynamic_cast<model::Int*>(args->val[pos]) : nullptr;
+    if (n == nullptr) throw NativeFuncError("TypeError", "math." + func + " need Int arguments");
+    return n->val;
+}
+
+// Int也按Decimal处理
+static dep::Decimal decimal_arg(const model::List* args, const std::string& func) {
+    if (!args->val.empty()) {
+        if (const auto d = dynamic_cast<model::Decimal*>(args->val[0])) return d->val;
+        if (const auto n = dynamic_cast<model::Int*>(args->val[0])) return dep::Decimal(n->val);
+    }
+    throw NativeFuncError("TypeError", "math." + func + " need an Int or Dec argument");
+}
+
+// 结果保留的小数位数
+constexpr size_t default_prec = 28;
+constexpr int64_t max_prec = 100000;
+
+static size_t prec_arg(const model::List* args, const std::string& func) {
+    if (args->val.size() < 2 or args->val[1]->get_type() == model::Object::ObjectType::OT_Nil) return default_prec;
+    int64_t prec;
+    if (!int_arg(args, 1, func).to_int64(prec) or prec < 0 or prec > max_prec) {
+        throw NativeFuncError("ValueError", "math." + func + " precision must be between 0 and " + std::to_string(max_prec));
+    }
+    return static_cast<size_t>(prec);
+}
+
+// -------------------------- 定点数辅助 --------------------------
+// 以2^bits为单位的定点数: 十进制与二进制之间只在入口和出口各转换一次
+
+// floor(|x| · 2^bits)
+static Natural to_fixed(const dep::Decimal& x, const size_t bits) {
+    const Natural m = Natural::from_bigint(x.mantissa());
+    const int e = x.exponent();
+    if (e >= 0) return (m * Natural::pow10(static_cast<size_t>(e))) << bits;
+    return (m << bits) / Natural::pow10(static_cast<size_t>(-e));
+}
+
+// 截断到prec位小数
+static dep::Decimal from_fixed(const Natural& v, const size_t bits, const size_t prec, const bool negative) {
+    const Natural m = (v * Natural::pow10(prec)) >> bits;
+    return dep::Decimal::from_parts(m.to_bigint(negative), -static_cast<int>(prec));
+}
+
+// 十进制位数对应的二进制位数(略多估)
+static size_t digits_to_bits(const size_t digits) {
+    return digits * 3322 / 1000 + 1;
+}
+
+// y ∈ [1, 2]时的ln(y): 先开方s次把y压到1附近, 再用 ln y = 2·atanh((y-1)/(y+1)) 的级数
+static Natural ln_fixed(Natural y, const size_t bits, const size_t s) {
+    const Natural one = Natural(1) << bits;
+    for (size_t i = 0; i < s; ++i) y = algo::isqrt(y << bits);
+
+    const Natural z = ((y - one) << bits) / (y + one);
+    const Natural z2 = (z * z) >> bits;
+    Natural sum = z;
+    Natural term = z;
+    for (uint32_t i = 1;; ++i) {
+        term = (term * z2) >> bits;
+        if (term.is_zero()) break;
+        Natural t = term;
+        t.div_small(2 * i + 1);
+        sum = sum + t;
+    }
+    return sum << (s + 1);
+}
+
+// -------------------------- 模块 --------------------------
+model::Object* init_module(model::Object* self, const model::List* args) {
+    auto mod = new model::Module("math");
+
+    mod->attrs.insert("gcd", new model::NativeFunction(gcd));
+    mod->attrs.insert("isqrt", new model::NativeFunction(isqrt));
+    mod->attrs.insert("pow_mod", new model::NativeFunction(pow_mod));
+    mod->attrs.insert("factorial", new model::NativeFunction(factorial));
+    mod->attrs.insert("comb", new model::NativeFunction(comb));
+    mod->attrs.insert("sqrt", new model::NativeFunction(sqrt));
+    mod->attrs.insert("exp", new model::NativeFunction(exp));
+    mod->attrs.insert("ln", new model::NativeFunction(ln));
+
+    return mod;
+}
+
+// math.gcd(*ints): 结果非负, 无参数时为0
+model::Object* gcd(model::Object* self, const model::List* args) {
+    Natural res;
+    for (size_t i = 0; i < args->val.size(); ++i) {
+        res = algo::gcd(res, Natural::from_bigint(int_arg(args, i, "gcd")));
+    }
+    return model::create_int(res.to_bigint());
+}
+
+model::Object* isqrt(model::Object* self, const model::List* args) {
+    const auto& n = int_arg(args, 0, "isqrt");
+    if (n.is_negative()) throw NativeFuncError("ValueError", "isqrt() argument must be nonnegative");
+    return model::create_int(algo::isqrt(Natural::from_bigint(n)).to_bigint());
+}
+
+// math.pow_mod(base, exp, mod): 结果与mod同号; exp为负时先求base的模逆元
+model::Object* pow_mod(model::Object* self, const model::List* args) {
+    const auto& base = int_arg(args, 0, "pow_mod");
+    const auto& exp = int_arg(args, 1, "pow_mod");
+    const auto& mod = int_arg(args, 2, "pow_mod");
+
+    const Natural m = Natural::from_bigint(mod);
+    if (m.is_zero()) throw NativeFuncError("ValueError", "pow_mod() modulus cannot be zero");
+    Natural b = Natural::from_bigint(base) % m;
+    if (base.is_negative() and !b.is_zero()) b = m - b;
+    if (exp.is_negative() and !algo::inverse_mod(b, m, b)) {
+        throw NativeFuncError("ValueError", "base is not invertible for the given modulus");
+    }
+
+    Natural res = algo::pow_mod(b, Natural::from_bigint(exp), m);
+    if (mod.is_negative() and !res.is_zero()) res = m - res;
+    return model::create_int(res.to_bigint(mod.is_negative()));
+}
+
+model::Object* factorial(model::Object* self, const model::List* args) {
+    const auto& n = int_arg(args, 0, "factorial");
+    if (n.is_negative()) throw NativeFuncError("ValueError", "factorial() not defined for negative values");
+    int64_t v;
+    if (!n.to_int64(v) or v > UINT32_MAX) throw NativeFuncError("ValueError", "factorial() argument is too large");
+    return model::create_int(algo::factorial(static_cast<uint32_t>(v)).to_bigint());
+}
+
+model::Object* comb(model::Object* self, const model::List* args) {
+    const auto& n = int_arg(args, 0, "comb");
+    const auto& k = int_arg(args, 1, "comb");
+    if (n.is_negative() or k.is_negative()) throw NativeFuncError("ValueError", "comb() arguments must be non-negative");
+    return model::create_int(algo::comb(Natural::from_bigint(n), Natural::from_bigint(k)).to_bigint());
+}
+
+// math.sqrt(x, prec=28): floor(sqrt(x · 10^(2·prec))) 即为截断到prec位小数的结果
+model::Object* sqrt(model::Object* self, const model::List* args) {
+    const auto x = decimal_arg(args, "sqrt");
+    const size_t prec = prec_arg(args, "sqrt");
+    if (x.mantissa().is_negative()) throw NativeFuncError("ValueError", "math domain error");
+
+    const Natural m = Natural::from_bigint(x.mantissa());
+    const int64_t shift = x.exponent() + 2 * static_cast<int64_t>(prec);
+    const Natural n = shift >= 0
+        ? m * Natural::pow10(static_cast<size_t>(shift))
+        : m / Natural::pow10(static_cast<size_t>(-shift));
+    return model::create_decimal(dep::Decimal::from_parts(algo::isqrt(n).to_bigint(), -static_cast<int>(prec)));
+}
+
+// math.exp(x, prec=28): e^|x| = (e^(|x|/2^k))^(2^k), 缩小后的参数用泰勒级数
+model::Object* exp(model::Object* self, const model::List* args) {
+    const auto x = decimal_arg(args, "exp");
+    const size_t prec = prec_arg(args, "exp");
+    const bool negative = x.mantissa().is_negative();
+
+    int64_t ip;
+    if (!to_fixed(x, 0).to_bigint().to_int64(ip) or ip > 100000) {
+        if (negative) return model::create_decimal(dep::Decimal());
+        throw NativeFuncError("ValueError", "math.exp argument is too large");
+    }
+    // e^-x 小于 10^-(prec+1) 时截断结果为0
+    if (negative and static_cast<double>(ip) > static_cast<double>(prec + 1) * 2.3026 + 1) {
+        return model::create_decimal(dep::Decimal());
+    }
+
+    // 保护位要覆盖结果的整数位数和k次平方带来的误差放大
+    const size_t int_digits = static_cast<size_t>(static_cast<double>(ip) * 0.4343) + 1;
+    const size_t base_bits = digits_to_bits(prec + int_digits) + 64;
+    const size_t k = std::bit_width(static_cast<uint64_t>(ip)) + static_cast<size_t>(std::sqrt(static_cast<double>(base_bits)));
+    const size_t bits = base_bits + k;
+
+    const Natural one = Natural(1) << bits;
+    const Natural r = to_fixed(x, bits) >> k;
+    Natural sum = one;
+    Natural term = one;
+    for (uint32_t i = 1;; ++i) {
+        term = (term * r) >> bits;
+        term.div_small(i);
+        if (term.is_zero()) break;
+        sum = sum + term;
+    }
+    for (size_t i = 0; i < k; ++i) sum = (sum * sum) >> bits;
+    if (negative) sum = (one << bits) / sum;
+    return model::create_decimal(from_fixed(sum, bits, prec, false));
+}
+
+// math.ln(x, prec=28): x = m·10^e, m = y·2^j (1 <= y < 2), ln x = ln y + j·ln2 + e·ln10
+model::Object* ln(model::Object* self, const model::List* args) {
+    const auto x = decimal_arg(args, "ln");
+    const size_t prec = prec_arg(args, "ln");
+    if (x.mantissa().is_negative() or x.mantissa() == dep::BigInt(0)) {
+        throw NativeFuncError("ValueError", "math domain error");
+    }
+
+    const Natural m = Natural::from_bigint(x.mantissa());
+    const int64_t e = x.exponent();
+    const size_t j = m.bit_length() - 1;
+    const uint64_t abs_e = static_cast<uint64_t>(e < 0 ? -e : e);
+
+    const size_t base_bits = digits_to_bits(prec) + 64;
+    const size_t s = 4 + static_cast<size_t>(std::sqrt(static_cast<double>(base_bits))) / 2;
+    const size_t bits = base_bits + s + std::bit_width(j) + std::bit_width(abs_e) + 4;
+    const Natural one = Natural(1) << bits;
+
+    const Natural y = j <= bits ? m << (bits - j) : m >> (j - bits);
+    Natural pos = ln_fixed(y, bits, s);
+    Natural neg;
+    if (j != 0 or e != 0) {
+        const Natural ln2 = ln_fixed(one << 1, bits, s);
+        pos = pos + ln2 * Natural(j);
+        if (e != 0) {
+            // ln10 = 3·ln2 + ln(5/4)
+            const Natural ln10 = ln2 * Natural(3) + ln_fixed((one * Natural(5)) >> 2, bits, s);
+            (e > 0 ? pos : neg) = (e > 0 ? pos : neg) + ln10 * Natural(abs_e);
+        }
+    }
+    if (pos >= neg) return model::create_decimal(from_fixed(pos - neg, bits, prec, false));
+    return model::create_decimal(from_fixed(neg - pos, bits, prec, true));
+}
+
+}
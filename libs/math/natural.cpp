@@ -0,0 +1,689 @@
+#include "include/natural.hpp"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+namespace math_lib {
+
+// -------------------------- 基本运算 --------------------------
+Natural::Natural(const uint64_t val) {
+    if (val != 0) limbs.push_back(static_cast<uint32_t>(val));
+    if (val >> 32) limbs.push_back(static_cast<uint32_t>(val >> 32));
+}
+
+void Natural::trim() {
+    while (!limbs.empty() and limbs.back() == 0) limbs.pop_back();
+}
+
+uint64_t Natural::to_u64() const {
+    uint64_t v = 0;
+    if (!limbs.empty()) v = limbs[0];
+    if (limbs.size() > 1) v |= static_cast<uint64_t>(limbs[1]) << 32;
+    return v;
+}
+
+size_t Natural::bit_length() const {
+    if (limbs.empty()) return 0;
+    return (limbs.size() - 1) * 32 + (32 - std::countl_zero(limbs.back()));
+}
+
+uint64_t Natural::bits_at(const size_t shift) const {
+    const size_t word = shift / 32;
+    const size_t bit = shift % 32;
+    unsigned __int128 v = 0;
+    for (size_t i = 0; i < 3 and word + i < limbs.size(); ++i) {
+        v |= static_cast<unsigned __int128>(limbs[word + i]) << (32 * i);
+    }
+    return static_cast<uint64_t>(v >> bit);
+}
+
+void Natural::mul_small(const uint32_t m, const uint32_t add) {
+    uint64_t carry = add;
+    for (auto& limb : limbs) {
+        const uint64_t t = static_cast<uint64_t>(limb) * m + carry;
+        limb = static_cast<uint32_t>(t);
+        carry = t >> 32;
+    }
+    if (carry) limbs.push_back(static_cast<uint32_t>(carry));
+    trim();
+}
+
+uint32_t Natural::div_small(const uint32_t d) {
+    uint64_t rem = 0;
+    for (size_t i = limbs.size(); i-- > 0;) {
+        const uint64_t cur = (rem << 32) | limbs[i];
+        limbs[i] = static_cast<uint32_t>(cur / d);
+        rem = cur % d;
+    }
+    trim();
+    return static_cast<uint32_t>(rem);
+}
+
+int Natural::compare(const Natural& a, const Natural& b) {
+    if (a.limbs.size() != b.limbs.size()) return a.limbs.size() < b.limbs.size() ? -1 : 1;
+    for (size_t i = a.limbs.size(); i-- > 0;) {
+        if (a.limbs[i] != b.limbs[i]) return a.limbs[i] < b.limbs[i] ? -1 : 1;
+    }
+    return 0;
+}
+
+Natural operator+(const Natural& a, const Natural& b) {
+    const auto& longer = a.limbs.size() >= b.limbs.size() ? a : b;
+    const auto& shorter = a.limbs.size() >= b.limbs.size() ? b : a;
+    Natural res;
+    res.limbs.resize(longer.limbs.size() + 1);
+    uint64_t carry = 0;
+    for (size_t i = 0; i < longer.limbs.size(); ++i) {
+        carry += longer.limbs[i];
+        if (i < shorter.limbs.size()) carry += shorter.limbs[i];
+        res.limbs[i] = static_cast<uint32_t>(carry);
+        carry >>= 32;
+    }
+    res.limbs.back() = static_cast<uint32_t>(carry);
+    res.trim();
+    return res;
+}
+
+Natural operator-(const Natural& a, const Natural& b) {
+    Natural res;
+    res.limbs.resize(a.limbs.size());
+    int64_t borrow = 0;
+    for (size_t i = 0; i < a.limbs.size(); ++i) {
+        int64_t t = static_cast<int64_t>(a.limbs[i]) - borrow - (i < b.limbs.size() ? b.limbs[i] : 0);
+        borrow = t < 0;
+        if (t < 0) t += static_cast<int64_t>(1) << 32;
+        res.limbs[i] = static_cast<uint32_t>(t);
+    }
+    res.trim();
+    return res;
+}
+
+Natural operator<<(const Natural& a, const size_t bits) {
+    if (a.is_zero()) return a;
+    const size_t words = bits / 32;
+    const size_t shift = bits % 32;
+    Natural res;
+    res.limbs.assign(a.limbs.size() + words + 1, 0);
+    for (size_t i = 0; i < a.limbs.size(); ++i) {
+        const uint64_t v = static_cast<uint64_t>(a.limbs[i]) << shift;
+        res.limbs[i + words] |= static_cast<uint32_t>(v);
+        res.limbs[i + words + 1] |= static_cast<uint32_t>(v >> 32);
+    }
+    res.trim();
+    return res;
+}
+
+Natural operator>>(const Natural& a, const size_t bits) {
+    const size_t words = bits / 32;
+    if (words >= a.limbs.size()) return {};
+    const size_t shift = bits % 32;
+    Natural res;
+    res.limbs.resize(a.limbs.size() - words);
+    for (size_t i = 0; i < res.limbs.size(); ++i) {
+        uint64_t v = a.limbs[i + words];
+        if (i + words + 1 < a.limbs.size()) v |= static_cast<uint64_t>(a.limbs[i + words + 1]) << 32;
+        res.limbs[i] = static_cast<uint32_t>(v >> shift);
+    }
+    res.trim();
+    return res;
+}
+
+// -------------------------- 乘法 --------------------------
+// 短于该长度(以limb计)的乘数直接用竖式乘法
+constexpr size_t karatsuba_threshold = 40;
+
+// out[0, na + nb) += a * b
+static void mul_school(const uint32_t* a, const size_t na, const uint32_t* b, const size_t nb, uint32_t* out) {
+    for (size_t i = 0; i < na; ++i) {
+        uint64_t carry = 0;
+        const uint64_t ai = a[i];
+        for (size_t j = 0; j < nb; ++j) {
+            const uint64_t t = ai * b[j] + out[i + j] + carry;
+            out[i + j] = static_cast<uint32_t>(t);
+            carry = t >> 32;
+        }
+        for (size_t k = i + nb; carry; ++k) {
+            const uint64_t t = static_cast<uint64_t>(out[k]) + carry;
+            out[k] = static_cast<uint32_t>(t);
+            carry = t >> 32;
+        }
+    }
+}
+
+// out += x << (32 * offset), out须足够长
+static void add_at(std::vector<uint32_t>& out, const Natural& x, const size_t offset) {
+    uint64_t carry = 0;
+    size_t i = 0;
+    for (; i < x.limbs.size(); ++i) {
+        carry += static_cast<uint64_t>(out[offset + i]) + x.limbs[i];
+        out[offset + i] = static_cast<uint32_t>(carry);
+        carry >>= 32;
+    }
+    for (size_t k = offset + i; carry; ++k) {
+        carry += out[k];
+        out[k] = static_cast<uint32_t>(carry);
+        carry >>= 32;
+    }
+}
+
+static Natural slice(const Natural& x, const size_t from, const size_t to) {
+    Natural res;
+    if (from < x.limbs.size()) {
+        res.limbs.assign(x.limbs.begin() + static_cast<ptrdiff_t>(from),
+                         x.limbs.begin() + static_cast<ptrdiff_t>(std::min(to, x.limbs.size())));
+    }
+    res.trim();
+    return res;
+}
+
+Natural operator*(const Natural& a, const Natural& b) {
+    if (a.is_zero() or b.is_zero()) return {};
+    const auto& longer = a.limbs.size() >= b.limbs.size() ? a : b;
+    const auto& shorter = a.limbs.size() >= b.limbs.size() ? b : a;
+    const size_t nl = longer.limbs.size();
+    const size_t ns = shorter.limbs.size();
+
+    Natural res;
+    res.limbs.assign(nl + ns + 1, 0);
+    if (ns < karatsuba_threshold) {
+        mul_school(longer.limbs.data(), nl, shorter.limbs.data(), ns, res.limbs.data());
+    } else if (nl >= 2 * ns) {
+        // 长短悬殊时把长的一方按短的长度分块相乘
+        for (size_t from = 0; from < nl; from += ns) {
+            add_at(res.limbs, slice(longer, from, from + ns) * shorter, from);
+        }
+    } else {
+        // Karatsuba: (a1·B + a0)(b1·B + b0) = z2·B² + ((a0 + a1)(b0 + b1) - z2 - z0)·B + z0
+        const size_t half = nl / 2;
+        const Natural a0 = slice(longer, 0, half), a1 = slice(longer, half, nl);
+        const Natural b0 = slice(shorter, 0, half), b1 = slice(shorter, half, ns);
+        const Natural z0 = a0 * b0;
+        const Natural z2 = a1 * b1;
+        const Natural z1 = (a0 + a1) * (b0 + b1) - z0 - z2;
+        add_at(res.limbs, z0, 0);
+        add_at(res.limbs, z1, half);
+        add_at(res.limbs, z2, 2 * half);
+    }
+    res.trim();
+    return res;
+}
+
+// -------------------------- 除法 --------------------------
+// Knuth算法D: 先把除数左移到最高位为1, 每次用前两位估商, 最多修正两次
+void Natural::divmod(const Natural& a, const Natural& b, Natural& q, Natural& r) {
+    if (compare(a, b) < 0) {
+        q = Natural();
+        r = a;
+        return;
+    }
+    if (b.limbs.size() == 1) {
+        q = a;
+        r = Natural(q.div_small(b.limbs[0]));
+        return;
+    }
+
+    const size_t n = b.limbs.size();
+    const size_t m = a.limbs.size() - n;
+    const int s = std::countl_zero(b.limbs.back());
+    const Natural vn = b << s;
+    Natural un = a << s;
+    un.limbs.resize(a.limbs.size() + 1, 0);
+
+    q.limbs.assign(m + 1, 0);
+    constexpr uint64_t base = static_cast<uint64_t>(1) << 32;
+    const uint64_t v1 = vn.limbs[n - 1];
+    const uint64_t v2 = vn.limbs[n - 2];
+    for (size_t j = m + 1; j-- > 0;) {
+        const uint64_t num = (static_cast<uint64_t>(un.limbs[j + n]) << 32) | un.limbs[j + n - 1];
+        uint64_t qhat = num / v1;
+        uint64_t rhat = num % v1;
+        while (qhat >= base or qhat * v2 > ((rhat << 32) | un.limbs[j + n - 2])) {
+            --qhat;
+            rhat += v1;
+            if (rhat >= base) break;
+        }
+
+        int64_t borrow = 0;
+        uint64_t carry = 0;
+        for (size_t i = 0; i < n; ++i) {
+            const uint64_t p = qhat * vn.limbs[i] + carry;
+            carry = p >> 32;
+            const int64_t t = static_cast<int64_t>(un.limbs[i + j]) - borrow - static_cast<int64_t>(p & 0xFFFFFFFF);
+            un.limbs[i + j] = static_cast<uint32_t>(t);
+            borrow = t < 0;
+        }
+        const int64_t t = static_cast<int64_t>(un.limbs[j + n]) - borrow - static_cast<int64_t>(carry);
+        un.limbs[j + n] = static_cast<uint32_t>(t);
+
+        if (t < 0) {
+            // 估商大了1, 加回一个除数
+            --qhat;
+            uint64_t c = 0;
+            for (size_t i = 0; i < n; ++i) {
+                c += static_cast<uint64_t>(un.limbs[i + j]) + vn.limbs[i];
+                un.limbs[i + j] = static_cast<uint32_t>(c);
+                c >>= 32;
+            }
+            un.limbs[j + n] += static_cast<uint32_t>(c);
+        }
+        q.limbs[j] = static_cast<uint32_t>(qhat);
+    }
+    q.trim();
+    un.limbs.resize(n);
+    un.trim();
+    r = un >> s;
+}
+
+Natural operator/(const Natural& a, const Natural& b) {
+    Natural q, r;
+    Natural::divmod(a, b, q, r);
+    return q;
+}
+
+Natural operator%(const Natural& a, const Natural& b) {
+    Natural q, r;
+    Natural::divmod(a, b, q, r);
+    return r;
+}
+
+// -------------------------- 十进制转换 --------------------------
+// 每次处理9位十进制数
+constexpr uint32_t chunk_base = 1000000000;
+constexpr size_t chunk_digits = 9;
+
+Natural Natural::from_bigint(const dep::BigInt& n) {
+    int64_t small;
+    if (n.to_int64(small)) {
+        return Natural(small < 0 ? 0ULL - static_cast<uint64_t>(small) : static_cast<uint64_t>(small));
+    }
+    const std::string digits = n.abs().to_string();
+    Natural res;
+    size_t pos = digits.size() % chunk_digits;
+    if (pos == 0) pos = chunk_digits;
+    res.mul_small(1, static_cast<uint32_t>(std::stoul(digits.substr(0, pos))));
+    for (; pos < digits.size(); pos += chunk_digits) {
+        res.mul_small(chunk_base, static_cast<uint32_t>(std::stoul(digits.substr(pos, chunk_digits))));
+    }
+    return res;
+}
+
+Natural Natural::pow10(size_t k) {
+    Natural res(1);
+    Natural base(10);
+    while (k) {
+        if (k & 1) res = res * base;
+        k >>= 1;
+        if (k) base = base * base;
+    }
+    return res;
+}
+
+std::string Natural::to_string() const {
+    if (is_zero()) return "0";
+    Natural rest = *this;
+    std::vector<uint32_t> chunks;
+    while (!rest.is_zero()) chunks.push_back(rest.div_small(chunk_base));
+
+    std::string res = std::to_string(chunks.back());
+    for (size_t i = chunks.size() - 1; i-- > 0;) {
+        const std::string chunk = std::to_string(chunks[i]);
+        res.append(chunk_digits - chunk.size(), '0');
+        res += chunk;
+    }
+    return res;
+}
+
+dep::BigInt Natural::to_bigint(const bool negative) const {
+    if (fits_u64()) {
+        const uint64_t v = to_u64();
+        if (v <= static_cast<uint64_t>(INT64_MAX)) {
+            return dep::BigInt::from_int64(negative ? -static_cast<int64_t>(v) : static_cast<int64_t>(v));
+        }
+    }
+    const std::string digits = to_string();
+    std::string text;
+    text.reserve(digits.size() + 1);
+    if (negative and !is_zero()) text += '-';
+    text += digits;
+    return dep::BigInt(text);
+}
+
+namespace algo {
+
+// -------------------------- gcd --------------------------
+static uint64_t binary_gcd(uint64_t a, uint64_t b) {
+    if (a == 0) return b;
+    if (b == 0) return a;
+    const int shift = std::countr_zero(a | b);
+    a >>= std::countr_zero(a);
+    while (b != 0) {
+        b >>= std::countr_zero(b);
+        if (a > b) std::swap(a, b);
+        b -= a;
+    }
+    return a << shift;
+}
+
+// cx·x + cy·y, 两个系数异号(或其一为0), 结果保证非负
+static Natural combine(const Natural& x, const int64_t cx, const Natural& y, const int64_t cy) {
+    Natural px = x, py = y;
+    px.mul_small(static_cast<uint32_t>(cx < 0 ? -cx : cx));
+    py.mul_small(static_cast<uint32_t>(cy < 0 ? -cy : cy));
+    return cx > 0 ? px - py : py - px;
+}
+
+Natural gcd(Natural a, Natural b) {
+    if (a < b) std::swap(a, b);
+    while (!b.fits_u64()) {
+        // 用a、b的最高32位模拟若干步欧几里得除法, 累积成2x2矩阵后一次性作用到整数上
+        const size_t shift = a.bit_length() - 32;
+        int64_t ah = static_cast<int64_t>(a.bits_at(shift));
+        int64_t bh = static_cast<int64_t>(b.bits_at(shift));
+        int64_t A = 1, B = 0, C = 0, D = 1;
+        while (bh + C > 0 and bh + D > 0) {
+            const int64_t q = (ah + A) / (bh + C);
+            if (q != (ah + B) / (bh + D)) break;
+            int64_t t = A - q * C; A = C; C = t;
+            t = B - q * D; B = D; D = t;
+            t = ah - q * bh; ah = bh; bh = t;
+        }
+        if (B == 0) {
+            Natural r = a % b;
+            a = std::move(b);
+            b = std::move(r);
+        } else {
+            Natural na = combine(a, A, b, B);
+            Natural nb = combine(a, C, b, D);
+            a = std::move(na);
+            b = std::move(nb);
+        }
+    }
+    if (b.is_zero()) return a;
+    if (!a.fits_u64()) a = a % b;
+    return Natural(binary_gcd(a.to_u64(), b.to_u64()));
+}
+
+// -------------------------- isqrt --------------------------
+Natural isqrt(const Natural& n) {
+    if (n.fits_u64()) {
+        const uint64_t v = n.to_u64();
+        auto r = static_cast<uint64_t>(std::sqrt(static_cast<long double>(v)));
+        while (r > 0 and static_cast<unsigned __int128>(r) * r > v) --r;
+        while (static_cast<unsigned __int128>(r + 1) * (r + 1) <= v) ++r;
+        return Natural(r);
+    }
+    // 从高位开始逐次把精度翻倍的牛顿迭代, 每轮都保持 (a-1)² < n >> 2(c-d) < (a+1)²
+    const size_t c = (n.bit_length() - 1) / 2;
+    Natural a(1);
+    size_t d = 0;
+    for (int s = std::bit_width(c) - 1; s >= 0; --s) {
+        const size_t e = d;
+        d = c >> s;
+        a = (a << (d - e - 1)) + (n >> (2 * c - e - d + 1)) / a;
+    }
+    if (a * a > n) a = a - Natural(1);
+    return a;
+}
+
+// -------------------------- 模幂 --------------------------
+// 按指数长度选滑动窗口宽度
+static size_t window_bits(const size_t exp_bits) {
+    if (exp_bits > 671) return 6;
+    if (exp_bits > 239) return 5;
+    if (exp_bits > 79) return 4;
+    if (exp_bits > 23) return 3;
+    return 2;
+}
+
+// 滑动窗口: 预先算出底数的奇数次幂, 从高位扫描指数, 每个窗口只做一次乘法
+template <typename T, typename Mul>
+static T sliding_window(const T& base, const T& one, const Natural& exp, Mul&& mul) {
+    const size_t bits = exp.bit_length();
+    const size_t w = window_bits(bits);
+    std::vector<T> odd_powers(static_cast<size_t>(1) << (w - 1));
+    odd_powers[0] = base;
+    const T square = mul(base, base);
+    for (size_t i = 1; i < odd_powers.size(); ++i) odd_powers[i] = mul(odd_powers[i - 1], square);
+
+    const auto bit = [&](const size_t i) { return (exp.limbs[i / 32] >> (i % 32)) & 1; };
+    T result = one;
+    size_t i = bits;
+    while (i > 0) {
+        if (!bit(i - 1)) {
+            result = mul(result, result);
+            --i;
+            continue;
+        }
+        // 取以1结尾、不超过w位的最长窗口
+        size_t len = std::min(w, i);
+        while (!bit(i - len)) --len;
+        uint32_t value = 0;
+        for (size_t k = 0; k < len; ++k) value = (value << 1) | bit(i - 1 - k);
+        for (size_t k = 0; k < len; ++k) result = mul(result, result);
+        result = mul(result, odd_powers[value >> 1]);
+        i -= len;
+    }
+    return result;
+}
+
+// Montgomery乘法(CIOS), 数都以模的长度定长存储
+class Montgomery {
+public:
+    explicit Montgomery(const Natural& m) : m_(m.limbs), n_(m.limbs.size()), t_(m.limbs.size() + 2) {
+        // 牛顿迭代求 m[0] 在模2^32下的逆元, 每次迭代正确位数翻倍
+        uint32_t inv = m_[0];
+        for (int i = 0; i < 5; ++i) inv *= 2 - m_[0] * inv;
+        m_inv_ = 0U - inv;
+    }
+
+    [[nodiscard]] std::vector<uint32_t> to_mont(const Natural& x, const Natural& m) const {
+        return pad((x << (32 * n_)) % m);
+    }
+
+    [[nodiscard]] Natural from_mont(const std::vector<uint32_t>& x) {
+        std::vector<uint32_t> one(n_, 0);
+        one[0] = 1;
+        Natural res;
+        res.limbs = mul(x, one);
+        res.trim();
+        return res;
+    }
+
+    [[nodiscard]] std::vector<uint32_t> pad(Natural x) const {
+        x.limbs.resize(n_, 0);
+        return std::move(x.limbs);
+    }
+
+    // a·b·R⁻¹ mod m
+    std::vector<uint32_t> mul(const std::vector<uint32_t>& a, const std::vector<uint32_t>& b) {
+        std::fill(t_.begin(), t_.end(), 0);
+        for (size_t i = 0; i < n_; ++i) {
+            uint64_t c = 0;
+            const uint64_t bi = b[i];
+            for (size_t j = 0; j < n_; ++j) {
+                c += static_cast<uint64_t>(t_[j]) + a[j] * bi;
+                t_[j] = static_cast<uint32_t>(c);
+                c >>= 32;
+            }
+            c += t_[n_];
+            t_[n_] = static_cast<uint32_t>(c);
+            t_[n_ + 1] = static_cast<uint32_t>(c >> 32);
+
+            const uint64_t mq = static_cast<uint32_t>(t_[0] * m_inv_);
+            c = (static_cast<uint64_t>(t_[0]) + mq * m_[0]) >> 32;
+            for (size_t j = 1; j < n_; ++j) {
+                c += static_cast<uint64_t>(t_[j]) + mq * m_[j];
+                t_[j - 1] = static_cast<uint32_t>(c);
+                c >>= 32;
+            }
+            c += t_[n_];
+            t_[n_ - 1] = static_cast<uint32_t>(c);
+            t_[n_] = t_[n_ + 1] + static_cast<uint32_t>(c >> 32);
+        }
+
+        // 结果小于2m, 必要时再减一次m
+        bool ge = t_[n_] != 0;
+        if (!ge) {
+            ge = true;
+            for (size_t j = n_; j-- > 0;) {
+                if (t_[j] != m_[j]) {
+                    ge = t_[j] > m_[j];
+                    break;
+                }
+            }
+        }
+        std::vector<uint32_t> res(t_.begin(), t_.begin() + static_cast<ptrdiff_t>(n_));
+        if (ge) {
+            int64_t borrow = 0;
+            for (size_t j = 0; j < n_; ++j) {
+                int64_t d = static_cast<int64_t>(res[j]) - m_[j] - borrow;
+                borrow = d < 0;
+                if (d < 0) d += static_cast<int64_t>(1) << 32;
+                res[j] = static_cast<uint32_t>(d);
+            }
+        }
+        return res;
+    }
+
+private:
+    std::vector<uint32_t> m_;
+    size_t n_;
+    uint32_t m_inv_ = 0;
+    std::vector<uint32_t> t_;
+};
+
+Natural pow_mod(const Natural& base, const Natural& exp, const Natural& m) {
+    if (m == Natural(1)) return {};
+    const Natural b = base % m;
+    if (exp.is_zero()) return Natural(1);
+    if (b.is_zero()) return {};
+
+    if (m.fits_u64()) {
+        const uint64_t mod = m.to_u64();
+        return Natural(sliding_window<uint64_t>(b.to_u64(), 1, exp, [mod](const uint64_t x, const uint64_t y) {
+            return static_cast<uint64_t>(static_cast<unsigned __int128>(x) * y % mod);
+        }));
+    }
+    if (m.is_odd()) {
+        Montgomery mont(m);
+        const auto result = sliding_window<std::vector<uint32_t>>(
+            mont.to_mont(b, m), mont.to_mont(Natural(1), m), exp,
+            [&mont](const std::vector<uint32_t>& x, const std::vector<uint32_t>& y) { return mont.mul(x, y); });
+        return mont.from_mont(result);
+    }
+    return sliding_window<Natural>(b, Natural(1), exp, [&m](const Natural& x, const Natural& y) { return x * y % m; });
+}
+
+// 扩展欧几里得, a的系数始终取模m下的非负代表
+bool inverse_mod(const Natural& a, const Natural& m, Natural& out) {
+    Natural r0 = m, r1 = a % m;
+    Natural s0, s1(1);
+    while (!r1.is_zero()) {
+        Natural q, r;
+        Natural::divmod(r0, r1, q, r);
+        r0 = std::move(r1);
+        r1 = std::move(r);
+        const Natural t = q * s1 % m;
+        Natural s = s0 >= t ? s0 - t : s0 + m - t;
+        s0 = std::move(s1);
+        s1 = std::move(s);
+    }
+    if (r0 != Natural(1)) return false;
+    out = s0;
+    return true;
+}
+
+// -------------------------- 阶乘与组合数 --------------------------
+// 把因子表二分相乘, 两侧长度相近时乘法效率最高
+static Natural product(const std::vector<Natural>& factors, const size_t from, const size_t to) {
+    if (to - from == 1) return factors[from];
+    const size_t mid = from + (to - from) / 2;
+    return product(factors, from, mid) * product(factors, mid, to);
+}
+
+static Natural product(const std::vector<Natural>& factors) {
+    if (factors.empty()) return Natural(1);
+    return product(factors, 0, factors.size());
+}
+
+// [start, stop)内所有奇数之积
+static Natural odd_product(const uint64_t start, const uint64_t stop) {
+    const uint64_t count = (stop - start) / 2;
+    if (count <= 16) {
+        Natural res(1);
+        for (uint64_t x = start; x < stop; x += 2) res.mul_small(static_cast<uint32_t>(x));
+        return res;
+    }
+    const uint64_t mid = (start + count) | 1;
+    return odd_product(start, mid) * odd_product(mid, stop);
+}
+
+// n! = 2^(n - popcount(n)) · ∏ (n >> (i+1), n >> i] 内奇数之积的 (i+1) 次方
+// 从高位起逐层把内层积乘入外层积, 各奇数区间都用二分拆分相乘
+Natural factorial(const uint32_t n) {
+    Natural inner(1), outer(1);
+    uint64_t upper = 3;
+    for (int i = std::bit_width(n) - 1; i >= 0; --i) {
+        const uint64_t v = n >> i;
+        if (v <= 2) continue;
+        const uint64_t lower = upper;
+        upper = (v + 1) | 1;
+        inner = inner * odd_product(lower, upper);
+        outer = outer * inner;
+    }
+    return outer << (n - std::popcount(n));
+}
+
+// 超过该值时不再筛素数
+constexpr uint64_t comb_sieve_limit = 100000000;
+
+Natural comb(const Natural& n, const Natural& k_in) {
+    if (k_in > n) return {};
+    Natural k = k_in;
+    if (const Natural rest = n - k; rest < k) k = rest;
+    if (k.is_zero()) return Natural(1);
+
+    if (!k.fits_u64() or k.to_u64() >= UINT32_MAX) throw NativeFuncError("ValueError", "comb() result is too large");
+
+    // k很小或n太大时逐项计算 C(n, i+1) = C(n, i) · (n - i) / (i + 1), 每步都能整除
+    if (!n.fits_u64() or n.to_u64() > comb_sieve_limit or k.to_u64() <= 64) {
+        const uint64_t count = k.to_u64();
+        Natural res(1);
+        for (uint64_t i = 0; i < count; ++i) {
+            res = res * (n - Natural(i));
+            res.div_small(static_cast<uint32_t>(i + 1));
+        }
+        return res;
+    }
+
+    // 按Legendre公式求每个素数在C(n, k) = n! / (k! (n-k)!) 中的次数, 再把各素数幂二分相乘
+    const uint64_t nn = n.to_u64();
+    const uint64_t kk = k.to_u64();
+    std::vector<bool> composite(nn + 1, false);
+    std::vector<Natural> factors;
+    uint64_t packed = 1;
+    for (uint64_t p = 2; p <= nn; ++p) {
+        if (composite[p]) continue;
+        for (uint64_t x = p * p; x <= nn; x += p) composite[x] = true;
+
+        uint64_t e = 0;
+        for (uint64_t pk = p; pk <= nn; pk *= p) {
+            e += nn / pk - kk / pk - (nn - kk) / pk;
+            if (pk > nn / p) break;
+        }
+        for (uint64_t i = 0; i < e; ++i) {
+            // 小因子先在机器字内累乘
+            if (packed > UINT64_MAX / p) {
+                factors.emplace_back(packed);
+                packed = 1;
+            }
+            packed *= p;
+        }
+    }
+    if (packed > 1) factors.emplace_back(packed);
+    return product(factors);
+}
+
+}
+
+}
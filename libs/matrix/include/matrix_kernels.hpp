@@ -0,0 +1,26 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+namespace matrix_lib::kernels {
+
+// 工作线程数(含调用线程), 默认为硬件线程数; n为0时恢复默认
+void set_threads(size_t n);
+size_t threads();
+
+// 把[0, tasks)分给各线程执行, 返回时全部完成; fn不能调用VM
+void parallel_for(size_t tasks, const std::function<void(size_t)>& fn);
+
+// C = A·B, A为m×k, B为k×n, 以(行步长, 列步长)访问, 转置视图无需先复制; C为m×n的行连续内存
+// 分块打包后由微内核计算(支持时使用AVX2 FMA), 计算量大时按行块分给各线程; i64按补码回绕
+void gemm(size_t m, size_t n, size_t k,
+          const double* a, size_t a_rs, size_t a_cs,
+          const double* b, size_t b_rs, size_t b_cs,
+          double* c);
+void gemm(size_t m, size_t n, size_t k,
+          const int64_t* a, size_t a_rs, size_t a_cs,
+          const int64_t* b, size_t b_rs, size_t b_cs,
+          int64_t* c);
+
+}
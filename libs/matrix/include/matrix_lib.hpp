@@ -0,0 +1,78 @@
+#pragma once
+#include "array/include/array_lib.hpp"
+
+namespace matrix_lib {
+
+inline auto based_matrix = new model::Object();
+
+using array_lib::Buffer;
+using array_lib::DType;
+
+// 二维i64/f64矩阵, 元素(i, j)位于 offset + (i·row_stride + j·col_stride)·元素大小;
+// 新建的矩阵按行连续存放, 转置视图只交换形状与步长, 与来源共享Buffer
+class Matrix : public model::Object {
+public:
+    DType dtype;
+    std::shared_ptr<Buffer> buffer;
+    size_t offset = 0;  // 在buffer中的字节偏移
+    size_t rows = 0;
+    size_t cols = 0;
+    size_t row_stride = 0;  // 以元素计
+    size_t col_stride = 1;
+
+    // for循环逐行遍历时使用的游标
+    size_t next_index = 0;
+
+    // 新分配的行连续矩阵, 内容未初始化
+    Matrix(DType dtype, size_t rows, size_t cols);
+    Matrix(DType dtype, std::shared_ptr<Buffer> buffer, size_t offset,
+           size_t rows, size_t cols, size_t row_stride, size_t col_stride);
+
+    template <typename T>
+    [[nodiscard]] T* data() const { return reinterpret_cast<T*>(buffer->data() + offset); }
+    template <typename T>
+    [[nodiscard]] T& at(const size_t i, const size_t j) const { return data<T>()[i * row_stride + j * col_stride]; }
+
+    [[nodiscard]] bool contiguous() const { return col_stride == 1 and (row_stride == cols or rows <= 1); }
+
+    [[nodiscard]] std::string debug_string() const override;
+};
+
+model::Object* init_module(model::Object* self, const model::List* args);
+
+// 模块函数
+model::Object* matrix(model::Object* self, const model::List* args);
+model::Object* zeros(model::Object* self, const model::List* args);
+model::Object* full(model::Object* self, const model::List* args);
+model::Object* identity(model::Object* self, const model::List* args);
+model::Object* from_array(model::Object* self, const model::List* args);
+model::Object* matmul(model::Object* self, const model::List* args);
+model::Object* set_threads(model::Object* self, const model::List* args);
+model::Object* threads(model::Object* self, const model::List* args);
+
+// Matrix方法
+model::Object* matrix_add(model::Object* self, const model::List* args);
+model::Object* matrix_sub(model::Object* self, const model::List* args);
+model::Object* matrix_mul(model::Object* self, const model::List* args);
+model::Object* matrix_div(model::Object* self, const model::List* args);
+model::Object* matrix_neg(model::Object* self, const model::List* args);
+model::Object* matrix_eq(model::Object* self, const model::List* args);
+model::Object* matrix_getitem(model::Object* self, const model::List* args);
+model::Object* matrix_setitem(model::Object* self, const model::List* args);
+model::Object* matrix_next(model::Object* self, const model::List* args);
+model::Object* matrix_str(model::Object* self, const model::List* args);
+model::Object* matrix_matmul(model::Object* self, const model::List* args);
+model::Object* matrix_transpose(model::Object* self, const model::List* args);
+model::Object* matrix_shape(model::Object* self, const model::List* args);
+model::Object* matrix_dtype(model::Object* self, const model::List* args);
+model::Object* matrix_col(model::Object* self, const model::List* args);
+model::Object* matrix_sum(model::Object* self, const model::List* args);
+model::Object* matrix_mean(model::Object* self, const model::List* args);
+model::Object* matrix_min(model::Object* self, const model::List* args);
+model::Object* matrix_max(model::Object* self, const model::List* args);
+model::Object* matrix_astype(model::Object* self, const model::List* args);
+model::Object* matrix_copy(model::Object* self, const model::List* args);
+model::Object* matrix_to_list(model::Object* self, const model::List* args);
+model::Object* matrix_to_array(model::Object* self, const model::List* args);
+
+}
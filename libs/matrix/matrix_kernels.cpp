@@ -0,0 +1,344 @@
+#include "include/matrix_kernels.hpp"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "array/include/array_kernels.hpp"
+
+// 微内核的AVX2+FMA版本单独编译, 运行时按CPU选择(同array_kernels)
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define KIZ_MATRIX_X86 1
+#include <immintrin.h>
+#define KIZ_TARGET_AVX2 __attribute__((target("avx2,fma")))
+#endif
+
+namespace matrix_lib::kernels {
+
+// -------------------------- 线程池 --------------------------
+// 常驻的工作线程, 每次run把任务下标分给调用线程与前helpers个工作线程;
+// 池对象不析构, 退出时工作线程仍阻塞在条件变量上, 不影响进程结束
+class ThreadPool {
+public:
+    void run(const size_t tasks, const std::function<void(size_t)>& fn, const size_t workers) {
+        const size_t helpers = tasks == 0 ? 0 : std::min(workers, tasks) - 1;
+        if (helpers == 0) {
+            for (size_t i = 0; i < tasks; ++i) fn(i);
+            return;
+        }
+        {
+            std::lock_guard lock(mutex_);
+            while (threads_.size() < helpers) {
+                const size_t index = threads_.size();
+                threads_.emplace_back([this, index] { worker_loop(index); });
+                threads_.back().detach();
+            }
+            job_ = &fn;
+            tasks_ = tasks;
+            next_.store(0);
+            helpers_ = helpers;
+            active_ = helpers;
+            ++generation_;
+        }
+        wake_.notify_all();
+        drain();
+        std::unique_lock lock(mutex_);
+        done_.wait(lock, [this] { return active_ == 0; });
+        job_ = nullptr;
+    }
+
+private:
+    void drain() {
+        for (size_t i = next_.fetch_add(1); i < tasks_; i = next_.fetch_add(1)) (*job_)(i);
+    }
+
+    void worker_loop(const size_t index) {
+        size_t seen = 0;
+        std::unique_lock lock(mutex_);
+        for (;;) {
+            wake_.wait(lock, [&] { return generation_ != seen; });
+            seen = generation_;
+            if (index >= helpers_) continue;
+            lock.unlock();
+            drain();
+            lock.lock();
+            if (--active_ == 0) done_.notify_one();
+        }
+    }
+
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable done_;
+    std::vector<std::thread> threads_;
+    const std::function<void(size_t)>* job_ = nullptr;
+    size_t tasks_ = 0;
+    std::atomic<size_t> next_{0};
+    size_t helpers_ = 0;
+    size_t active_ = 0;
+    size_t generation_ = 0;
+};
+
+static ThreadPool& pool() {
+    static auto instance = new ThreadPool();
+    return *instance;
+}
+
+static size_t default_threads() {
+    return std::max<size_t>(1, std::thread::hardware_concurrency());
+}
+
+static std::atomic<size_t> thread_count{0};
+
+void set_threads(const size_t n) {
+    thread_count.store(n);
+}
+
+size_t threads() {
+    const size_t n = thread_count.load();
+    return n == 0 ? default_threads() : n;
+}
+
+void parallel_for(const size_t tasks, const std::function<void(size_t)>& fn) {
+    pool().run(tasks, fn, threads());
+}
+
+// -------------------------- GEMM --------------------------
+// 分块参数: A的MC×KC块与B的KC×NR条分别留在L2/L1中, MR×NR为微内核的C块(6×8个f64占12个ymm寄存器)
+constexpr size_t MR = 6;
+constexpr size_t NR = 8;
+constexpr size_t KC = 256;
+constexpr size_t MC = 96;
+constexpr size_t NC = 2048;
+
+// 计算量(乘加次数)低于此值时不打包, 低于parallel_min时不分线程
+constexpr size_t blocked_min = size_t{1} << 12;
+constexpr size_t parallel_min = size_t{1} << 21;
+
+// 整数经无符号类型累加, 溢出时回绕
+template <typename T>
+struct AccType { using type = T; };
+template <>
+struct AccType<int64_t> { using type = uint64_t; };
+template <typename T>
+using Acc = typename AccType<T>::type;
+
+template <typename T>
+static void gemm_naive(const size_t m, const size_t n, const size_t k,
+                       const T* a, const size_t a_rs, const size_t a_cs,
+                       const T* b, const size_t b_rs, const size_t b_cs, T* c) {
+    for (size_t i = 0; i < m; ++i) {
+        for (size_t j = 0; j < n; ++j) {
+            Acc<T> s = 0;
+            for (size_t p = 0; p < k; ++p) {
+                s += static_cast<Acc<T>>(a[i * a_rs + p * a_cs]) * static_cast<Acc<T>>(b[p * b_rs + j * b_cs]);
+            }
+            c[i * n + j] = static_cast<T>(s);
+        }
+    }
+}
+
+// A的rows×kc块打包为MR行一组的条带, 条带内按列存放; 不足MR行补0
+template <typename T>
+static void pack_a(const size_t rows, const size_t kc, const T* a, const size_t rs, const size_t cs, T* out) {
+    for (size_t i = 0; i < rows; i += MR) {
+        const size_t mr = std::min(MR, rows - i);
+        for (size_t p = 0; p < kc; ++p) {
+            for (size_t r = 0; r < MR; ++r) *out++ = r < mr ? a[(i + r) * rs + p * cs] : T{0};
+        }
+    }
+}
+
+// B的kc×cols块打包为NR列一组的条带, 条带内按行存放; 不足NR列补0
+template <typename T>
+static void pack_b(const size_t kc, const size_t cols, const T* b, const size_t rs, const size_t cs, T* out) {
+    for (size_t j = 0; j < cols; j += NR) {
+        const size_t nr = std::min(NR, cols - j);
+        for (size_t p = 0; p < kc; ++p) {
+            for (size_t c = 0; c < NR; ++c) *out++ = c < nr ? b[p * rs + (j + c) * cs] : T{0};
+        }
+    }
+}
+
+// 把MR×NR的结果块写回C的左上mr×nr部分, accumulate时与原值相加
+template <typename T>
+static void store_tile(const Acc<T> (&tile)[MR][NR], T* c, const size_t ldc,
+                       const size_t mr, const size_t nr, const bool accumulate) {
+    for (size_t r = 0; r < mr; ++r) {
+        for (size_t j = 0; j < nr; ++j) {
+            const Acc<T> prev = accumulate ? static_cast<Acc<T>>(c[r * ldc + j]) : 0;
+            c[r * ldc + j] = static_cast<T>(prev + tile[r][j]);
+        }
+    }
+}
+
+template <typename T>
+static void micro_generic(const size_t kc, const T* a, const T* b, T* c, const size_t ldc,
+                          const size_t mr, const size_t nr, const bool accumulate) {
+    Acc<T> tile[MR][NR] = {};
+    for (size_t p = 0; p < kc; ++p) {
+        for (size_t r = 0; r < MR; ++r) {
+            const auto ar = static_cast<Acc<T>>(a[r]);
+            for (size_t j = 0; j < NR; ++j) tile[r][j] += ar * static_cast<Acc<T>>(b[j]);
+        }
+        a += MR;
+        b += NR;
+    }
+    store_tile<T>(tile, c, ldc, mr, nr, accumulate);
+}
+
+#ifdef KIZ_MATRIX_X86
+// 6×8的C块常驻12个ymm寄存器, 每步广播A的一个元素与B的两组4个元素做FMA
+KIZ_TARGET_AVX2 static void micro_avx2(const size_t kc, const double* a, const double* b, double* c,
+                                       const size_t ldc, const size_t mr, const size_t nr, const bool accumulate) {
+    __m256d c00 = _mm256_setzero_pd(), c01 = _mm256_setzero_pd();
+    __m256d c10 = _mm256_setzero_pd(), c11 = _mm256_setzero_pd();
+    __m256d c20 = _mm256_setzero_pd(), c21 = _mm256_setzero_pd();
+    __m256d c30 = _mm256_setzero_pd(), c31 = _mm256_setzero_pd();
+    __m256d c40 = _mm256_setzero_pd(), c41 = _mm256_setzero_pd();
+    __m256d c50 = _mm256_setzero_pd(), c51 = _mm256_setzero_pd();
+    for (size_t p = 0; p < kc; ++p) {
+        const __m256d b0 = _mm256_loadu_pd(b);
+        const __m256d b1 = _mm256_loadu_pd(b + 4);
+        __m256d ar = _mm256_broadcast_sd(a);
+        c00 = _mm256_fmadd_pd(ar, b0, c00);
+        c01 = _mm256_fmadd_pd(ar, b1, c01);
+        ar = _mm256_broadcast_sd(a + 1);
+        c10 = _mm256_fmadd_pd(ar, b0, c10);
+        c11 = _mm256_fmadd_pd(ar, b1, c11);
+        ar = _mm256_broadcast_sd(a + 2);
+        c20 = _mm256_fmadd_pd(ar, b0, c20);
+        c21 = _mm256_fmadd_pd(ar, b1, c21);
+        ar = _mm256_broadcast_sd(a + 3);
+        c30 = _mm256_fmadd_pd(ar, b0, c30);
+        c31 = _mm256_fmadd_pd(ar, b1, c31);
+        ar = _mm256_broadcast_sd(a + 4);
+        c40 = _mm256_fmadd_pd(ar, b0, c40);
+        c41 = _mm256_fmadd_pd(ar, b1, c41);
+        ar = _mm256_broadcast_sd(a + 5);
+        c50 = _mm256_fmadd_pd(ar, b0, c50);
+        c51 = _mm256_fmadd_pd(ar, b1, c51);
+        a += MR;
+        b += NR;
+    }
+
+    const __m256d rows[MR][2] = {{c00, c01}, {c10, c11}, {c20, c21}, {c30, c31}, {c40, c41}, {c50, c51}};
+    if (mr == MR and nr == NR) {
+        for (size_t r = 0; r < MR; ++r) {
+            double* dst = c + r * ldc;
+            __m256d lo = rows[r][0], hi = rows[r][1];
+            if (accumulate) {
+                lo = _mm256_add_pd(lo, _mm256_loadu_pd(dst));
+                hi = _mm256_add_pd(hi, _mm256_loadu_pd(dst + 4));
+            }
+            _mm256_storeu_pd(dst, lo);
+            _mm256_storeu_pd(dst + 4, hi);
+        }
+        return;
+    }
+    double tile[MR][NR];
+    for (size_t r = 0; r < MR; ++r) {
+        _mm256_storeu_pd(tile[r], rows[r][0]);
+        _mm256_storeu_pd(tile[r] + 4, rows[r][1]);
+    }
+    store_tile<double>(tile, c, ldc, mr, nr, accumulate);
+}
+#endif
+
+template <typename T>
+using MicroKernel = void (*)(size_t, const T*, const T*, T*, size_t, size_t, size_t, bool);
+
+template <typename T>
+static MicroKernel<T> select_micro() {
+#ifdef KIZ_MATRIX_X86
+    if constexpr (std::is_same_v<T, double>) {
+        if (array_lib::kernels::has_avx2()) return micro_avx2;
+    }
+#endif
+    return micro_generic<T>;
+}
+
+static size_t ceil_div(const size_t x, const size_t y) {
+    return (x + y - 1) / y;
+}
+
+// 按KC切k, 每段先打包整段A(各行块并行), 再按NC切n打包B; 计算任务为(行块, 列组)对, 行块较少时把列再切成几组
+template <typename T>
+static void gemm_blocked(const size_t m, const size_t n, const size_t k,
+                         const T* a, const size_t a_rs, const size_t a_cs,
+                         const T* b, const size_t b_rs, const size_t b_cs, T* c) {
+    const MicroKernel<T> micro = select_micro<T>();
+    const size_t workers = m * n * k >= parallel_min ? threads() : 1;
+    const size_t row_blocks = ceil_div(m, MC);
+
+    std::vector<T> a_pack(ceil_div(m, MR) * MR * KC);
+    std::vector<T> b_pack(ceil_div(std::min(n, NC), NR) * NR * KC);
+
+    for (size_t pc = 0; pc < k; pc += KC) {
+        const size_t kc = std::min(KC, k - pc);
+        const bool accumulate = pc != 0;
+
+        pool().run(row_blocks, [&](const size_t ib) {
+            const size_t ic = ib * MC;
+            pack_a(std::min(MC, m - ic), kc, a + ic * a_rs + pc * a_cs, a_rs, a_cs, a_pack.data() + ic * kc);
+        }, workers);
+
+        for (size_t jc = 0; jc < n; jc += NC) {
+            const size_t nc = std::min(NC, n - jc);
+            const size_t panels = ceil_div(nc, NR);
+
+            constexpr size_t pack_group = 16;
+            pool().run(ceil_div(panels, pack_group), [&](const size_t g) {
+                const size_t j = g * pack_group * NR;
+                pack_b(kc, std::min(pack_group * NR, nc - j), b + pc * b_rs + (jc + j) * b_cs, b_rs, b_cs,
+                       b_pack.data() + j * kc);
+            }, workers);
+
+            const size_t col_groups = std::min(panels, std::max<size_t>(1, ceil_div(workers * 2, row_blocks)));
+            const size_t panels_per_group = ceil_div(panels, col_groups);
+            pool().run(row_blocks * col_groups, [&](const size_t task) {
+                const size_t ic = task / col_groups * MC;
+                const size_t mc = std::min(MC, m - ic);
+                const size_t first = task % col_groups * panels_per_group;
+                const size_t last = std::min(panels, first + panels_per_group);
+                for (size_t jp = first; jp < last; ++jp) {
+                    const size_t jr = jp * NR;
+                    const size_t nr = std::min(NR, nc - jr);
+                    for (size_t ir = 0; ir < mc; ir += MR) {
+                        micro(kc, a_pack.data() + (ic + ir) * kc, b_pack.data() + jr * kc,
+                              c + (ic + ir) * n + jc + jr, n, std::min(MR, mc - ir), nr, accumulate);
+                    }
+                }
+            }, workers);
+        }
+    }
+}
+
+template <typename T>
+static void gemm_impl(const size_t m, const size_t n, const size_t k,
+                      const T* a, const size_t a_rs, const size_t a_cs,
+                      const T* b, const size_t b_rs, const size_t b_cs, T* c) {
+    if (m == 0 or n == 0) return;
+    if (k == 0) {
+        std::fill_n(c, m * n, T{0});
+        return;
+    }
+    if (m * n * k < blocked_min) return gemm_naive(m, n, k, a, a_rs, a_cs, b, b_rs, b_cs, c);
+    gemm_blocked(m, n, k, a, a_rs, a_cs, b, b_rs, b_cs, c);
+}
+
+void gemm(const size_t m, const size_t n, const size_t k,
+          const double* a, const size_t a_rs, const size_t a_cs,
+          const double* b, const size_t b_rs, const size_t b_cs, double* c) {
+    gemm_impl(m, n, k, a, a_rs, a_cs, b, b_rs, b_cs, c);
+}
+
+void gemm(const size_t m, const size_t n, const size_t k,
+          const int64_t* a, const size_t a_rs, const size_t a_cs,
+          const int64_t* b, const size_t b_rs, const size_t b_cs, int64_t* c) {
+    gemm_impl(m, n, k, a, a_rs, a_cs, b, b_rs, b_cs, c);
+}
+
+}
@@ -0,0 +1,866 @@
+#include "include/matrix_lib.hpp"
+#include "include/matrix_kernels.hpp"
+#include <cstring>
+#include <memory>
+
+#include "array/include/array_kernels.hpp"
+#include "builtins/include/builtin_functions.hpp"
+#include "builtins/include/builtin_methods.hpp"
+
+namespace matrix_lib {
+
+using array_lib::Array;
+using array_lib::elem_size;
+using array_lib::kernels::BinOp;
+
+// -------------------------- Matrix --------------------------
+Matrix::Matrix(const DType dtype, const size_t rows, const size_t cols)
+    : dtype(dtype), buffer(std::make_shared<Buffer>(rows * cols * elem_size(dtype))),
+      rows(rows), cols(cols), row_stride(cols) {
+    attrs.insert("__parent__", based_matrix);
+}
+
+Matrix::Matrix(const DType dtype, std::shared_ptr<Buffer> buffer, const size_t offset,
+               const size_t rows, const size_t cols, const size_t row_stride, const size_t col_stride)
+    : dtype(dtype), buffer(std::move(buffer)), offset(offset),
+      rows(rows), cols(cols), row_stride(row_stride), col_stride(col_stride) {
+    attrs.insert("__parent__", based_matrix);
+}
+
+// 行或列过多时只显示首尾各3个
+std::string Matrix::debug_string() const {
+    constexpr size_t edge = 3;
+    constexpr size_t limit = 20;
+    std::string out = "matrix([";
+    for (size_t i = 0; i < rows; ++i) {
+        if (i != 0) out += ", ";
+        if (rows > limit and i == edge) {
+            out += "..., ";
+            i = rows - edge;
+        }
+        out += '[';
+        for (size_t j = 0; j < cols; ++j) {
+            if (j != 0) out += ", ";
+            if (cols > limit and j == edge) {
+                out += "..., ";
+                j = cols - edge;
+            }
+            if (dtype == DType::F64) out += model::Float::to_string(at<double>(i, j));
+            else out += std::to_string(at<int64_t>(i, j));
+        }
+        out += ']';
+    }
+    out += "], dtype=";
+    out += array_lib::dtype_name(dtype);
+    out += ')';
+    return out;
+}
+
+// -------------------------- 参数与类型转换 --------------------------
+static Matrix* self_matrix(model::Object* self, const std::string& method) {
+    const auto mat = dynamic_cast<Matrix*>(self);
+    if (mat == nullptr) throw NativeFuncError("TypeError", "Matrix." + method + " must be called by Matrix object");
+    return mat;
+}
+
+static model::Object* opt_arg(const model::List* args, const size_t pos) {
+    return args->val.size() > pos and args->val[pos]->get_type() != model::Object::ObjectType::OT_Nil
+        ? args->val[pos] : nullptr;
+}
+
+// 省略或为Nil时返回false; 矩阵只支持i64与f64
+static bool dtype_arg(const model::List* args, const size_t pos, const std::string& func, DType& out) {
+    const auto obj = opt_arg(args, pos);
+    if (obj == nullptr) return false;
+    if (!array_lib::parse_dtype(obj, out) or out == DType::U8) {
+        throw NativeFuncError("TypeError", func + "() dtype must be \"i64\" or \"f64\"");
+    }
+    return true;
+}
+
+static size_t size_arg(const model::List* args, const size_t pos, const std::string& func) {
+    const auto n = args->val.size() > pos ? dynamic_cast<model::Int*>(args->val[pos]) : nullptr;
+    if (n == nullptr) throw NativeFuncError("TypeError", func + "() need Int size arguments");
+    int64_t v;
+    if (!n->val.to_int64(v) or v < 0) throw NativeFuncError("ValueError", func + "() size must be a non-negative i64");
+    return static_cast<size_t>(v);
+}
+
+static size_t index_arg(const model::Object* obj, const size_t len, const std::string& what) {
+    const auto n = dynamic_cast<const model::Int*>(obj);
+    if (n == nullptr) throw NativeFuncError("TypeError", "Matrix " + what + " index must be Int");
+    int64_t v;
+    if (!n->val.to_int64(v)) v = INT64_MIN;
+    if (v < 0) v += static_cast<int64_t>(len);
+    if (v < 0 or static_cast<size_t>(v) >= len) throw NativeFuncError("IndexError", "Matrix " + what + " index out of range");
+    return static_cast<size_t>(v);
+}
+
+static bool is_float_like(const model::Object* obj) {
+    const auto type = obj->get_type();
+    return type == model::Object::ObjectType::OT_Float or type == model::Object::ObjectType::OT_Decimal;
+}
+
+static model::Object* box(const Matrix* mat, const size_t i, const size_t j) {
+    if (mat->dtype == DType::F64) return model::create_float(mat->at<double>(i, j));
+    return model::create_int(dep::BigInt::from_int64(mat->at<int64_t>(i, j)));
+}
+
+template <typename D, typename S>
+static void convert(const S* src, const size_t step, D* dst, const size_t n) {
+    if constexpr (std::is_floating_point_v<S> and !std::is_floating_point_v<D>) {
+        for (size_t i = 0; i < n; ++i) {
+            const S v = src[i * step];
+            if (!(v > -9.2233720368547758e18 and v < 9.2233720368547758e18)) {
+                throw NativeFuncError("ValueError", "cannot convert " + model::Float::to_string(v) + " to integer");
+            }
+            dst[i] = static_cast<D>(static_cast<int64_t>(v));
+        }
+    } else {
+        for (size_t i = 0; i < n; ++i) dst[i] = static_cast<D>(src[i * step]);
+    }
+}
+
+// 第i行按类型T的连续数据: 行连续且类型相同时直接返回矩阵内存, 否则转换到tmp
+template <typename T>
+static const T* row_of(const Matrix* mat, const size_t i, std::vector<T>& tmp) {
+    const bool same = (mat->dtype == DType::F64) == std::is_floating_point_v<T>;
+    if (same and mat->col_stride == 1) return &mat->at<T>(i, 0);
+    tmp.resize(mat->cols);
+    if (mat->dtype == DType::F64) convert(&mat->at<double>(i, 0), mat->col_stride, tmp.data(), mat->cols);
+    else convert(&mat->at<int64_t>(i, 0), mat->col_stride, tmp.data(), mat->cols);
+    return tmp.data();
+}
+
+// 一维数组按类型T的连续数据
+template <typename T>
+static const T* array_data(const Array* arr, std::vector<T>& tmp) {
+    if constexpr (std::is_same_v<T, double>) {
+        if (arr->dtype == DType::F64) return arr->data<double>();
+    } else {
+        if (arr->dtype == DType::I64) return arr->data<int64_t>();
+    }
+    tmp.resize(arr->length);
+    switch (arr->dtype) {
+    case DType::U8: convert(arr->data<uint8_t>(), 1, tmp.data(), arr->length); break;
+    case DType::I64: convert(arr->data<int64_t>(), 1, tmp.data(), arr->length); break;
+    case DType::F64: convert(arr->data<double>(), 1, tmp.data(), arr->length); break;
+    }
+    return tmp.data();
+}
+
+// 按行连续复制到新Buffer(可同时转换类型); 先转换再包装为对象, 出错时不留下半成品
+// (Matrix/Array析构会释放__parent__的引用, 不能直接delete临时对象)
+template <typename T>
+static std::shared_ptr<Buffer> copy_rows(const Matrix* src) {
+    auto buffer = std::make_shared<Buffer>(src->rows * src->cols * sizeof(T));
+    std::vector<T> tmp;
+    for (size_t i = 0; i < src->rows; ++i) {
+        std::memcpy(buffer->data() + i * src->cols * sizeof(T), row_of(src, i, tmp), src->cols * sizeof(T));
+    }
+    return buffer;
+}
+
+static Matrix* astype_copy(const Matrix* src, const DType dtype) {
+    auto buffer = dtype == DType::F64 ? copy_rows<double>(src) : copy_rows<int64_t>(src);
+    return new Matrix(dtype, std::move(buffer), 0, src->rows, src->cols, src->cols, 1);
+}
+
+// 从first(字节偏移)起每隔stride个元素取一个, 共n个: stride为1时为共享内存的视图, 否则复制
+static Array* strided_array(const Matrix* mat, const size_t first, const size_t n, const size_t stride) {
+    if (stride == 1 or n <= 1) return new Array(mat->dtype, mat->buffer, first, n);
+    const auto out = new Array(mat->dtype, n);
+    const char* base = mat->buffer->data() + first;
+    if (mat->dtype == DType::F64) convert(reinterpret_cast<const double*>(base), stride, out->data<double>(), n);
+    else convert(reinterpret_cast<const int64_t*>(base), stride, out->data<int64_t>(), n);
+    return out;
+}
+
+static Array* row_array(const Matrix* mat, const size_t i) {
+    return strided_array(mat, mat->offset + i * mat->row_stride * elem_size(mat->dtype), mat->cols, mat->col_stride);
+}
+
+// -------------------------- 逐元素运算 --------------------------
+// 操作数: Matrix, 一维Array(视为1×n的行), 或标量(视为1×1); 各维长度相同或为1时广播
+struct Operand {
+    const Matrix* mat = nullptr;
+    const Array* arr = nullptr;
+    const model::Object* scalar = nullptr;
+    bool is_float = false;
+    size_t rows = 1;
+    size_t cols = 1;
+};
+
+static Operand operand_of(const model::Object* obj, const std::string& method) {
+    Operand op;
+    if (const auto mat = dynamic_cast<const Matrix*>(obj)) {
+        op.mat = mat;
+        op.is_float = mat->dtype == DType::F64;
+        op.rows = mat->rows;
+        op.cols = mat->cols;
+    } else if (const auto arr = dynamic_cast<const Array*>(obj)) {
+        op.arr = arr;
+        op.is_float = arr->dtype == DType::F64;
+        op.cols = arr->length;
+    } else if (obj->get_type() == model::Object::ObjectType::OT_Int
+        or obj->get_type() == model::Object::ObjectType::OT_Bool or is_float_like(obj)) {
+        op.scalar = obj;
+        op.is_float = is_float_like(obj);
+    } else {
+        throw NativeFuncError("TypeError", "Matrix." + method + " operand must be Matrix, Array, Int, Decimal or Float");
+    }
+    return op;
+}
+
+// 按类型T逐行取操作数, 标量与数组只转换一次
+template <typename T>
+class OperandRows {
+public:
+    explicit OperandRows(const Operand& op) : op_(op) {
+        if (op.arr != nullptr) fixed_ = array_data(op.arr, tmp_);
+        else if (op.scalar != nullptr) {
+            tmp_.assign(1, array_lib::scalar_as<T>(op.scalar));
+            fixed_ = tmp_.data();
+        }
+    }
+    const T* row(const size_t i) {
+        if (fixed_ != nullptr) return fixed_;
+        return row_of(op_.mat, op_.rows == 1 ? 0 : i, tmp_);
+    }
+    [[nodiscard]] size_t step() const { return op_.cols == 1 ? 0 : 1; }
+
+private:
+    const Operand& op_;
+    std::vector<T> tmp_;
+    const T* fixed_ = nullptr;
+};
+
+static size_t broadcast_dim(const size_t x, const size_t y, const Operand& a, const Operand& b) {
+    if (x == y or y == 1) return x;
+    if (x == 1) return y;
+    throw NativeFuncError("ValueError", "operands could not be broadcast together with shapes ("
+        + std::to_string(a.rows) + ", " + std::to_string(a.cols) + ") and ("
+        + std::to_string(b.rows) + ", " + std::to_string(b.cols) + ")");
+}
+
+template <typename T>
+static Matrix* run_binary(const BinOp op, const Operand& a, const Operand& b, const DType dtype,
+                          const size_t rows, const size_t cols) {
+    OperandRows<T> ra(a), rb(b);
+    const auto out = new Matrix(dtype, rows, cols);
+    for (size_t i = 0; i < rows; ++i) {
+        array_lib::kernels::binary(op, ra.row(i), ra.step(), rb.row(i), rb.step(), &out->at<T>(i, 0), cols);
+    }
+    return out;
+}
+
+static model::Object* binary_op(model::Object* self, const model::List* args, const BinOp op, const std::string& method) {
+    const Operand a = operand_of(self_matrix(self, method), method);
+    if (args->val.size() != 1) throw NativeFuncError("TypeError", "Matrix." + method + " need 1 arg");
+    const Operand b = operand_of(args->val[0], method);
+    const size_t rows = broadcast_dim(a.rows, b.rows, a, b);
+    const size_t cols = broadcast_dim(a.cols, b.cols, a, b);
+    // 除法总是得到f64
+    if (op == BinOp::Div or a.is_float or b.is_float) return run_binary<double>(op, a, b, DType::F64, rows, cols);
+    return run_binary<int64_t>(op, a, b, DType::I64, rows, cols);
+}
+
+// -------------------------- 模块 --------------------------
+model::Object* init_module(model::Object* self, const model::List* args) {
+    auto mod = new model::Module("matrix");
+    // 行、列与按轴归约的结果是Array
+    array_lib::register_array_type();
+
+    based_matrix->attrs.insert("__parent__", model::based_obj);
+    based_matrix->attrs.insert("__add__", new model::NativeFunction(matrix_add));
+    based_matrix->attrs.insert("__sub__", new model::NativeFunction(matrix_sub));
+    based_matrix->attrs.insert("__mul__", new model::NativeFunction(matrix_mul));
+    based_matrix->attrs.insert("__div__", new model::NativeFunction(matrix_div));
+    based_matrix->attrs.insert("__neg__", new model::NativeFunction(matrix_neg));
+    based_matrix->attrs.insert("__eq__", new model::NativeFunction(matrix_eq));
+    based_matrix->attrs.insert("__getitem__", new model::NativeFunction(matrix_getitem));
+    based_matrix->attrs.insert("__setitem__", new model::NativeFunction(matrix_setitem));
+    based_matrix->attrs.insert("__next__", new model::NativeFunction(matrix_next));
+    based_matrix->attrs.insert("__str__", new model::NativeFunction(matrix_str));
+    based_matrix->attrs.insert("matmul", new model::NativeFunction(matrix_matmul));
+    based_matrix->attrs.insert("transpose", new model::NativeFunction(matrix_transpose));
+    based_matrix->attrs.insert("shape", new model::NativeFunction(matrix_shape));
+    based_matrix->attrs.insert("dtype", new model::NativeFunction(matrix_dtype));
+    based_matrix->attrs.insert("col", new model::NativeFunction(matrix_col));
+    based_matrix->attrs.insert("sum", new model::NativeFunction(matrix_sum));
+    based_matrix->attrs.insert("mean", new model::NativeFunction(matrix_mean));
+    based_matrix->attrs.insert("min", new model::NativeFunction(matrix_min));
+    based_matrix->attrs.insert("max", new model::NativeFunction(matrix_max));
+    based_matrix->attrs.insert("astype", new model::NativeFunction(matrix_astype));
+    based_matrix->attrs.insert("copy", new model::NativeFunction(matrix_copy));
+    based_matrix->attrs.insert("to_list", new model::NativeFunction(matrix_to_list));
+    based_matrix->attrs.insert("to_array", new model::NativeFunction(matrix_to_array));
+
+    mod->attrs.insert("Matrix", based_matrix);
+    mod->attrs.insert("matrix", new model::NativeFunction(matrix));
+    mod->attrs.insert("zeros", new model::NativeFunction(zeros));
+    mod->attrs.insert("full", new model::NativeFunction(full));
+    mod->attrs.insert("identity", new model::NativeFunction(identity));
+    mod->attrs.insert("from_array", new model::NativeFunction(from_array));
+    mod->attrs.insert("matmul", new model::NativeFunction(matmul));
+    mod->attrs.insert("set_threads", new model::NativeFunction(set_threads));
+    mod->attrs.insert("threads", new model::NativeFunction(threads));
+
+    return mod;
+}
+
+// -------------------------- 构造 --------------------------
+// 行的类型为u8/i64/f64, 推断出的矩阵类型不会低于各行(指定dtype时各行已按dtype转换)
+template <typename T>
+static void fill_row(const array_lib::Elements& row, T* dst) {
+    switch (row.dtype) {
+    case DType::U8: convert(row.data<uint8_t>(), 1, dst, row.length); break;
+    case DType::I64: convert(row.data<int64_t>(), 1, dst, row.length); break;
+    case DType::F64: convert(row.data<double>(), 1, dst, row.length); break;
+    }
+}
+
+// matrix.matrix(rows, dtype=Nil): rows为各行(List/Array/可迭代对象)组成的List或可迭代对象, 或Matrix;
+// 未指定dtype时含f64的行则为f64, 否则为i64
+model::Object* matrix(model::Object* self, const model::List* args) {
+    if (args->val.empty()) throw NativeFuncError("TypeError", "matrix() need 1 arg");
+    const auto src = args->val[0];
+    DType dtype;
+    const bool has_dtype = dtype_arg(args, 1, "matrix", dtype);
+
+    if (const auto src_mat = dynamic_cast<Matrix*>(src)) {
+        return astype_copy(src_mat, has_dtype ? dtype : src_mat->dtype);
+    }
+
+    std::vector<model::Object*> row_objs;
+    const auto list = dynamic_cast<model::List*>(src);
+    if (list != nullptr and list->strategy() == model::List::Strategy::Generic) {
+        row_objs = list->val;
+    } else if (list == nullptr or list->size() != 0) {
+        const auto it = model::make_iterator(src);
+        while (const auto row = model::iterator_step(it)) row_objs.push_back(row);
+    }
+
+    // 各行先转为连续数据(Int/Dec列表直接读取拆箱存储)
+    std::vector<array_lib::Elements> rows;
+    rows.reserve(row_objs.size());
+    for (const auto row_obj : row_objs) {
+        rows.push_back(array_lib::to_elements(row_obj, has_dtype, dtype));
+        if (rows.back().length != rows.front().length) {
+            throw NativeFuncError("ValueError", "matrix() rows must have the same length");
+        }
+    }
+    if (!has_dtype) {
+        dtype = std::any_of(rows.begin(), rows.end(), [](const auto& row) { return row.dtype == DType::F64; })
+            ? DType::F64 : DType::I64;
+    }
+
+    const size_t cols = rows.empty() ? 0 : rows.front().length;
+    const auto buffer = std::make_shared<Buffer>(rows.size() * cols * elem_size(dtype));
+    for (size_t i = 0; i < rows.size(); ++i) {
+        if (dtype == DType::F64) fill_row(rows[i], reinterpret_cast<double*>(buffer->data()) + i * cols);
+        else fill_row(rows[i], reinterpret_cast<int64_t*>(buffer->data()) + i * cols);
+    }
+    return new Matrix(dtype, buffer, 0, rows.size(), cols, cols, 1);
+}
+
+// matrix.zeros(rows, cols, dtype="f64")
+model::Object* zeros(model::Object* self, const model::List* args) {
+    const size_t rows = size_arg(args, 0, "zeros");
+    const size_t cols = size_arg(args, 1, "zeros");
+    DType dtype = DType::F64;
+    dtype_arg(args, 2, "zeros", dtype);
+    const auto out = new Matrix(dtype, rows, cols);
+    std::memset(out->data<char>(), 0, rows * cols * elem_size(dtype));
+    return out;
+}
+
+// matrix.full(rows, cols, value, dtype=Nil): 未指定dtype时由value决定
+model::Object* full(model::Object* self, const model::List* args) {
+    const size_t rows = size_arg(args, 0, "full");
+    const size_t cols = size_arg(args, 1, "full");
+    if (args->val.size() < 3) throw NativeFuncError("TypeError", "full() need 3 args");
+    const auto value = args->val[2];
+    DType dtype;
+    if (!dtype_arg(args, 3, "full", dtype)) dtype = is_float_like(value) ? DType::F64 : DType::I64;
+    const auto out = new Matrix(dtype, rows, cols);
+    if (dtype == DType::F64) std::fill_n(out->data<double>(), rows * cols, array_lib::scalar_as<double>(value));
+    else std::fill_n(out->data<int64_t>(), rows * cols, array_lib::scalar_as<int64_t>(value));
+    return out;
+}
+
+// matrix.identity(n, dtype="f64")
+model::Object* identity(model::Object* self, const model::List* args) {
+    const size_t n = size_arg(args, 0, "identity");
+    DType dtype = DType::F64;
+    dtype_arg(args, 1, "identity", dtype);
+    const auto out = new Matrix(dtype, n, n);
+    std::memset(out->data<char>(), 0, n * n * elem_size(dtype));
+    for (size_t i = 0; i < n; ++i) {
+        if (dtype == DType::F64) out->at<double>(i, i) = 1;
+        else out->at<int64_t>(i, i) = 1;
+    }
+    return out;
+}
+
+// matrix.from_array(arr, rows, cols): 按行排列数组的元素; i64/f64数组不复制, 与数组共享内存
+model::Object* from_array(model::Object* self, const model::List* args) {
+    const auto arr = args->val.empty() ? nullptr : dynamic_cast<Array*>(args->val[0]);
+    if (arr == nullptr) throw NativeFuncError("TypeError", "from_array() need an Array argument");
+    const size_t rows = size_arg(args, 1, "from_array");
+    const size_t cols = size_arg(args, 2, "from_array");
+    if (rows * cols != arr->length) {
+        throw NativeFuncError("ValueError", "cannot reshape Array of length " + std::to_string(arr->length)
+            + " into (" + std::to_string(rows) + ", " + std::to_string(cols) + ")");
+    }
+    if (arr->dtype != DType::U8) return new Matrix(arr->dtype, arr->buffer, arr->offset, rows, cols, cols, 1);
+    const auto out = new Matrix(DType::I64, rows, cols);
+    convert(arr->data<uint8_t>(), 1, out->data<int64_t>(), arr->length);
+    return out;
+}
+
+// 两个操作数均为整数时按i64计算, 否则按f64; 类型不同的操作数先转换为行连续的临时矩阵
+template <typename T>
+struct GemmOperand {
+    const T* data;
+    size_t rs;
+    size_t cs;
+    std::shared_ptr<Buffer> converted;
+};
+
+template <typename T>
+static GemmOperand<T> gemm_operand(const Matrix* mat) {
+    const DType dtype = std::is_floating_point_v<T> ? DType::F64 : DType::I64;
+    if (mat->dtype == dtype) return {mat->data<T>(), mat->row_stride, mat->col_stride, nullptr};
+    auto converted = copy_rows<T>(mat);
+    const T* data = reinterpret_cast<const T*>(converted->data());
+    return {data, mat->cols, 1, std::move(converted)};
+}
+
+template <typename T>
+static Matrix* run_matmul(const Matrix* a, const Matrix* b) {
+    const DType dtype = std::is_floating_point_v<T> ? DType::F64 : DType::I64;
+    const auto ga = gemm_operand<T>(a);
+    const auto gb = gemm_operand<T>(b);
+    const auto out = new Matrix(dtype, a->rows, b->cols);
+    kernels::gemm(a->rows, b->cols, a->cols, ga.data, ga.rs, ga.cs, gb.data, gb.rs, gb.cs, out->data<T>());
+    return out;
+}
+
+template <typename T>
+static Array* run_matvec(const Matrix* a, const Array* v) {
+    const DType dtype = std::is_floating_point_v<T> ? DType::F64 : DType::I64;
+    const auto ga = gemm_operand<T>(a);
+    std::vector<T> tmp;
+    const T* pv = array_data(v, tmp);
+    const auto out = new Array(dtype, a->rows);
+    kernels::gemm(a->rows, 1, a->cols, ga.data, ga.rs, ga.cs, pv, 1, 1, out->data<T>());
+    return out;
+}
+
+static model::Object* do_matmul(const Matrix* a, const model::Object* other) {
+    if (const auto b = dynamic_cast<const Matrix*>(other)) {
+        if (a->cols != b->rows) {
+            throw NativeFuncError("ValueError", "matmul shapes (" + std::to_string(a->rows) + ", " + std::to_string(a->cols)
+                + ") and (" + std::to_string(b->rows) + ", " + std::to_string(b->cols) + ") not aligned");
+        }
+        if (a->dtype == DType::F64 or b->dtype == DType::F64) return run_matmul<double>(a, b);
+        return run_matmul<int64_t>(a, b);
+    }
+    if (const auto v = dynamic_cast<const Array*>(other)) {
+        if (a->cols != v->length) {
+            throw NativeFuncError("ValueError", "matmul shapes (" + std::to_string(a->rows) + ", " + std::to_string(a->cols)
+                + ") and (" + std::to_string(v->length) + ",) not aligned");
+        }
+        if (a->dtype == DType::F64 or v->dtype == DType::F64) return run_matvec<double>(a, v);
+        return run_matvec<int64_t>(a, v);
+    }
+    throw NativeFuncError("TypeError", "matmul operand must be Matrix or Array");
+}
+
+// matrix.matmul(a, b)
+model::Object* matmul(model::Object* self, const model::List* args) {
+    if (args->val.size() != 2) throw NativeFuncError("TypeError", "matmul() need 2 args");
+    const auto a = dynamic_cast<Matrix*>(args->val[0]);
+    if (a == nullptr) throw NativeFuncError("TypeError", "matmul() first arg must be Matrix");
+    return do_matmul(a, args->val[1]);
+}
+
+// matrix.set_threads(n): 矩阵乘法使用的线程数, 0为硬件线程数
+model::Object* set_threads(model::Object* self, const model::List* args) {
+    kernels::set_threads(size_arg(args, 0, "set_threads"));
+    return model::load_nil();
+}
+
+model::Object* threads(model::Object* self, const model::List* args) {
+    return model::create_int(dep::BigInt(kernels::threads()));
+}
+
+// -------------------------- 运算 --------------------------
+model::Object* matrix_add(model::Object* self, const model::List* args) {
+    return binary_op(self, args, BinOp::Add, "__add__");
+}
+
+model::Object* matrix_sub(model::Object* self, const model::List* args) {
+    return binary_op(self, args, BinOp::Sub, "__sub__");
+}
+
+model::Object* matrix_mul(model::Object* self, const model::List* args) {
+    return binary_op(self, args, BinOp::Mul, "__mul__");
+}
+
+model::Object* matrix_div(model::Object* self, const model::List* args) {
+    return binary_op(self, args, BinOp::Div, "__div__");
+}
+
+// 整数取反按补码回绕; f64乘以-1以保留-0.0与nan
+model::Object* matrix_neg(model::Object* self, const model::List* args) {
+    const auto mat = self_matrix(self, "__neg__");
+    const auto out = new Matrix(mat->dtype, mat->rows, mat->cols);
+    for (size_t i = 0; i < mat->rows; ++i) {
+        if (mat->dtype == DType::F64) {
+            constexpr double minus_one = -1;
+            array_lib::kernels::binary(BinOp::Mul, &mat->at<double>(i, 0), mat->col_stride, &minus_one, 0,
+                &out->at<double>(i, 0), mat->cols);
+        } else {
+            constexpr int64_t zero = 0;
+            array_lib::kernels::binary(BinOp::Sub, &zero, 0, &mat->at<int64_t>(i, 0), mat->col_stride,
+                &out->at<int64_t>(i, 0), mat->cols);
+        }
+    }
+    return out;
+}
+
+// 形状相同且各元素相等(按数值比较, nan不等于自身); 与非Matrix比较为false
+model::Object* matrix_eq(model::Object* self, const model::List* args) {
+    const auto a = self_matrix(self, "__eq__");
+    const auto b = args->val.size() == 1 ? dynamic_cast<Matrix*>(args->val[0]) : nullptr;
+    if (b == nullptr or a->rows != b->rows or a->cols != b->cols) return model::load_bool(false);
+    const bool as_float = a->dtype == DType::F64 or b->dtype == DType::F64;
+    for (size_t i = 0; i < a->rows; ++i) {
+        if (as_float) {
+            std::vector<double> ta, tb;
+            const double* ra = row_of(a, i, ta);
+            const double* rb = row_of(b, i, tb);
+            if (!std::equal(ra, ra + a->cols, rb)) return model::load_bool(false);
+        } else {
+            std::vector<int64_t> ta, tb;
+            const int64_t* ra = row_of(a, i, ta);
+            const int64_t* rb = row_of(b, i, tb);
+            if (!std::equal(ra, ra + a->cols, rb)) return model::load_bool(false);
+        }
+    }
+    return model::load_bool(true);
+}
+
+// -------------------------- 下标 --------------------------
+// (i, j)的两个下标: m[i, j] 或 m[(i, j)]
+static bool pair_key(const model::List* args, const size_t key_count, model::Object*& i, model::Object*& j) {
+    if (key_count == 2) {
+        i = args->val[0];
+        j = args->val[1];
+        return true;
+    }
+    if (const auto tuple = dynamic_cast<model::Tuple*>(args->val[0]); tuple != nullptr and tuple->size() == 2) {
+        i = tuple->get(0);
+        j = tuple->get(1);
+        return true;
+    }
+    return false;
+}
+
+// m[i, j]为标量; m[i]为第i行的Array(行连续时共享内存); m[a:b]为行切片, 步长为正时是共享内存的视图
+model::Object* matrix_getitem(model::Object* self, const model::List* args) {
+    const auto mat = self_matrix(self, "__getitem__");
+    if (args->val.empty() or args->val.size() > 2) throw NativeFuncError("TypeError", "Matrix index need 1 or 2 args");
+
+    model::Object* i_obj;
+    model::Object* j_obj;
+    if (pair_key(args, args->val.size(), i_obj, j_obj)) {
+        return box(mat, index_arg(i_obj, mat->rows, "row"), index_arg(j_obj, mat->cols, "column"));
+    }
+
+    if (const auto slice = dynamic_cast<model::Slice*>(args->val[0])) {
+        int64_t start, stop, step;
+        const size_t count = model::resolve_slice(slice, mat->rows, start, stop, step);
+        if (step > 0 or count <= 1) {
+            const size_t first = count == 0 ? 0 : static_cast<size_t>(start);
+            return new Matrix(mat->dtype, mat->buffer, mat->offset + first * mat->row_stride * elem_size(mat->dtype),
+                count, mat->cols, mat->row_stride * static_cast<size_t>(std::max<int64_t>(step, 1)), mat->col_stride);
+        }
+        const auto out = new Matrix(mat->dtype, count, mat->cols);
+        for (size_t r = 0; r < count; ++r) {
+            const auto src = static_cast<size_t>(start + static_cast<int64_t>(r) * step);
+            for (size_t c = 0; c < mat->cols; ++c) {
+                if (mat->dtype == DType::F64) out->at<double>(r, c) = mat->at<double>(src, c);
+                else out->at<int64_t>(r, c) = mat->at<int64_t>(src, c);
+            }
+        }
+        return out;
+    }
+
+    return row_array(mat, index_arg(args->val[0], mat->rows, "row"));
+}
+
+// 行的新值: Array或List(长度为cols或1), 或标量; 转换到新的Buffer, 来源是本矩阵的行视图时也不受影响
+template <typename T>
+static void assign_row(const Matrix* mat, const size_t i, model::Object* value) {
+    if (dynamic_cast<Array*>(value) == nullptr and dynamic_cast<model::List*>(value) == nullptr) {
+        const T v = array_lib::scalar_as<T>(value);
+        for (size_t j = 0; j < mat->cols; ++j) mat->at<T>(i, j) = v;
+        return;
+    }
+    const auto row = array_lib::to_elements(value, true, mat->dtype);
+    if (row.length != mat->cols and row.length != 1) {
+        throw NativeFuncError("ValueError", "cannot assign " + std::to_string(row.length)
+            + " values to a Matrix row of length " + std::to_string(mat->cols));
+    }
+    const T* values = row.data<T>();
+    for (size_t j = 0; j < mat->cols; ++j) mat->at<T>(i, j) = values[row.length == 1 ? 0 : j];
+}
+
+// m[(i, j)] = x 设置单个元素; m[i] = 行(Array/List)或标量
+model::Object* matrix_setitem(model::Object* self, const model::List* args) {
+    const auto mat = self_matrix(self, "__setitem__");
+    if (args->val.size() != 2) throw NativeFuncError("TypeError", "Matrix.__setitem__ need 2 args");
+    const auto value = args->val[1];
+
+    model::Object* i_obj;
+    model::Object* j_obj;
+    if (pair_key(args, 1, i_obj, j_obj)) {
+        const size_t i = index_arg(i_obj, mat->rows, "row");
+        const size_t j = index_arg(j_obj, mat->cols, "column");
+        if (mat->dtype == DType::F64) mat->at<double>(i, j) = array_lib::scalar_as<double>(value);
+        else mat->at<int64_t>(i, j) = array_lib::scalar_as<int64_t>(value);
+        return model::load_nil();
+    }
+
+    const size_t i = index_arg(args->val[0], mat->rows, "row");
+    if (mat->dtype == DType::F64) assign_row<double>(mat, i, value);
+    else assign_row<int64_t>(mat, i, value);
+    return model::load_nil();
+}
+
+// for循环逐行遍历, 每行为Array
+model::Object* matrix_next(model::Object* self, const model::List* args) {
+    const auto mat = self_matrix(self, "__next__");
+    if (mat->next_index < mat->rows) return row_array(mat, mat->next_index++);
+    mat->next_index = 0;
+    return model::load_stop_iter();
+}
+
+model::Object* matrix_str(model::Object* self, const model::List* args) {
+    return model::create_str(self_matrix(self, "__str__")->debug_string());
+}
+
+model::Object* matrix_matmul(model::Object* self, const model::List* args) {
+    const auto mat = self_matrix(self, "matmul");
+    return do_matmul(mat, builtin::get_one_arg(args));
+}
+
+// 转置视图: 交换形状与步长, 不复制数据
+model::Object* matrix_transpose(model::Object* self, const model::List* args) {
+    const auto mat = self_matrix(self, "transpose");
+    return new Matrix(mat->dtype, mat->buffer, mat->offset, mat->cols, mat->rows, mat->col_stride, mat->row_stride);
+}
+
+model::Object* matrix_shape(model::Object* self, const model::List* args) {
+    const auto mat = self_matrix(self, "shape");
+    return model::Tuple::create({
+        model::create_int(dep::BigInt(mat->rows)),
+        model::create_int(dep::BigInt(mat->cols)),
+    });
+}
+
+model::Object* matrix_dtype(model::Object* self, const model::List* args) {
+    return model::create_str(array_lib::dtype_name(self_matrix(self, "dtype")->dtype));
+}
+
+// 第j列: 列连续(如转置视图)时共享内存, 否则复制
+model::Object* matrix_col(model::Object* self, const model::List* args) {
+    const auto mat = self_matrix(self, "col");
+    const size_t j = index_arg(builtin::get_one_arg(args), mat->cols, "column");
+    return strided_array(mat, mat->offset + j * mat->col_stride * elem_size(mat->dtype), mat->rows, mat->row_stride);
+}
+
+// -------------------------- 归约 --------------------------
+// axis省略或为Nil时归约全部元素; 0为对每列归约(结果长度为cols), 1为对每行归约(结果长度为rows)
+static int axis_arg(const model::List* args, const std::string& method) {
+    const auto obj = opt_arg(args, 0);
+    if (obj == nullptr) return -1;
+    const auto n = dynamic_cast<const model::Int*>(obj);
+    int64_t axis;
+    if (n == nullptr or !n->val.to_int64(axis) or (axis != 0 and axis != 1)) {
+        throw NativeFuncError("ValueError", "Matrix." + method + "() axis must be 0, 1 or Nil");
+    }
+    return static_cast<int>(axis);
+}
+
+static __int128 exact_row_sum(const int64_t* row, const size_t n) {
+    int64_t high;
+    uint64_t low;
+    array_lib::kernels::sum(row, n, high, low);
+    return static_cast<__int128>(high) * (int64_t{1} << 32) + low;
+}
+
+// 按轴求和, 结果与矩阵同类型(i64按补码回绕)
+template <typename T>
+static Array* axis_sum(const Matrix* mat, const int axis) {
+    const DType dtype = std::is_floating_point_v<T> ? DType::F64 : DType::I64;
+    std::vector<T> tmp;
+    if (axis == 1) {
+        const auto out = new Array(dtype, mat->rows);
+        for (size_t i = 0; i < mat->rows; ++i) {
+            const T* row = row_of(mat, i, tmp);
+            if constexpr (std::is_floating_point_v<T>) out->data<T>()[i] = array_lib::kernels::sum(row, mat->cols);
+            else out->data<T>()[i] = static_cast<T>(static_cast<uint64_t>(exact_row_sum(row, mat->cols)));
+        }
+        return out;
+    }
+    const auto out = new Array(dtype, mat->cols);
+    T* acc = out->data<T>();
+    std::fill_n(acc, mat->cols, T{0});
+    for (size_t i = 0; i < mat->rows; ++i) {
+        array_lib::kernels::binary(BinOp::Add, acc, 1, row_of(mat, i, tmp), 1, acc, mat->cols);
+    }
+    return out;
+}
+
+// 全部元素之和: i64为精确的Int, f64为Float
+model::Object* matrix_sum(model::Object* self, const model::List* args) {
+    const auto mat = self_matrix(self, "sum");
+    const int axis = axis_arg(args, "sum");
+    if (axis >= 0) return mat->dtype == DType::F64 ? axis_sum<double>(mat, axis) : axis_sum<int64_t>(mat, axis);
+
+    if (mat->dtype == DType::F64) {
+        std::vector<double> tmp;
+        double total = 0;
+        for (size_t i = 0; i < mat->rows; ++i) total += array_lib::kernels::sum(row_of(mat, i, tmp), mat->cols);
+        return model::create_float(total);
+    }
+    std::vector<int64_t> tmp;
+    __int128 total = 0;
+    for (size_t i = 0; i < mat->rows; ++i) total += exact_row_sum(row_of(mat, i, tmp), mat->cols);
+    return model::create_int(array_lib::int128_to_bigint(total));
+}
+
+// 均值为f64, 元素个数为0时为nan
+model::Object* matrix_mean(model::Object* self, const model::List* args) {
+    const auto mat = self_matrix(self, "mean");
+    const int axis = axis_arg(args, "mean");
+    if (axis < 0) {
+        const size_t count = mat->rows * mat->cols;
+        if (count == 0) return model::create_float(std::numeric_limits<double>::quiet_NaN());
+        double total = 0;
+        if (mat->dtype == DType::F64) {
+            std::vector<double> tmp;
+            for (size_t i = 0; i < mat->rows; ++i) total += array_lib::kernels::sum(row_of(mat, i, tmp), mat->cols);
+        } else {
+            std::vector<int64_t> tmp;
+            __int128 exact = 0;
+            for (size_t i = 0; i < mat->rows; ++i) exact += exact_row_sum(row_of(mat, i, tmp), mat->cols);
+            total = static_cast<double>(exact);
+        }
+        return model::create_float(total / static_cast<double>(count));
+    }
+
+    const auto out = axis_sum<double>(mat, axis);
+    const double divisor = static_cast<double>(axis == 0 ? mat->rows : mat->cols);
+    array_lib::kernels::binary(BinOp::Div, out->data<double>(), 1, &divisor, 0, out->data<double>(), out->length);
+    return out;
+}
+
+// f64含nan时结果为nan(同Array.min/max)
+template <typename T>
+static T pick(const T acc, const T x, const bool want_max) {
+    if constexpr (std::is_floating_point_v<T>) {
+        if (std::isnan(acc)) return acc;
+        if (std::isnan(x)) return x;
+    }
+    return want_max ? std::max(acc, x) : std::min(acc, x);
+}
+
+template <typename T>
+static model::Object* extreme_of(const Matrix* mat, const int axis, const bool want_max) {
+    const DType dtype = std::is_floating_point_v<T> ? DType::F64 : DType::I64;
+    std::vector<T> tmp;
+    if (axis == 1) {
+        const auto out = new Array(dtype, mat->rows);
+        for (size_t i = 0; i < mat->rows; ++i) {
+            out->data<T>()[i] = array_lib::kernels::extreme(row_of(mat, i, tmp), mat->cols, want_max);
+        }
+        return out;
+    }
+    const T* first = row_of(mat, 0, tmp);
+    std::vector<T> acc(first, first + mat->cols);
+    for (size_t i = 1; i < mat->rows; ++i) {
+        const T* row = row_of(mat, i, tmp);
+        for (size_t j = 0; j < mat->cols; ++j) acc[j] = pick(acc[j], row[j], want_max);
+    }
+    if (axis == 0) {
+        const auto out = new Array(dtype, mat->cols);
+        std::copy(acc.begin(), acc.end(), out->data<T>());
+        return out;
+    }
+
+    const T total = array_lib::kernels::extreme(acc.data(), mat->cols, want_max);
+    if constexpr (std::is_floating_point_v<T>) return model::create_float(total);
+    else return model::create_int(dep::BigInt::from_int64(total));
+}
+
+static model::Object* extreme(model::Object* self, const model::List* args, const std::string& method, const bool want_max) {
+    const auto mat = self_matrix(self, method);
+    const int axis = axis_arg(args, method);
+    if (mat->rows == 0 or mat->cols == 0) throw NativeFuncError("ValueError", "Matrix." + method + "() of an empty Matrix");
+    if (mat->dtype == DType::F64) return extreme_of<double>(mat, axis, want_max);
+    return extreme_of<int64_t>(mat, axis, want_max);
+}
+
+model::Object* matrix_min(model::Object* self, const model::List* args) {
+    return extreme(self, args, "min", false);
+}
+
+model::Object* matrix_max(model::Object* self, const model::List* args) {
+    return extreme(self, args, "max", true);
+}
+
+// -------------------------- 转换 --------------------------
+model::Object* matrix_astype(model::Object* self, const model::List* args) {
+    const auto mat = self_matrix(self, "astype");
+    DType dtype;
+    if (!dtype_arg(args, 0, "astype", dtype)) throw NativeFuncError("TypeError", "astype() need a dtype");
+    return astype_copy(mat, dtype);
+}
+
+// 行连续的副本(转置视图复制后不再与来源共享内存)
+model::Object* matrix_copy(model::Object* self, const model::List* args) {
+    const auto mat = self_matrix(self, "copy");
+    return astype_copy(mat, mat->dtype);
+}
+
+// 各行组成的List; i64的行为拆箱的Int列表
+model::Object* matrix_to_list(model::Object* self, const model::List* args) {
+    const auto mat = self_matrix(self, "to_list");
+    std::vector<model::Object*> rows(mat->rows);
+    for (size_t i = 0; i < mat->rows; ++i) {
+        if (mat->dtype == DType::I64) {
+            std::vector<int64_t> tmp;
+            const int64_t* row = row_of(mat, i, tmp);
+            rows[i] = model::List::from_ints(std::vector(row, row + mat->cols));
+        } else {
+            std::vector<model::Object*> elems(mat->cols);
+            for (size_t j = 0; j < mat->cols; ++j) elems[j] = model::create_float(mat->at<double>(i, j));
+            rows[i] = new model::List(std::move(elems));
+        }
+    }
+    return new model::List(std::move(rows));
+}
+
+// 按行展开为一维数组(复制)
+model::Object* matrix_to_array(model::Object* self, const model::List* args) {
+    const auto mat = self_matrix(self, "to_array");
+    auto buffer = mat->dtype == DType::F64 ? copy_rows<double>(mat) : copy_rows<int64_t>(mat);
+    return new Array(mat->dtype, std::move(buffer), 0, mat->rows * mat->cols);
+}
+
+}
@@ -0,0 +1,111 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+namespace random_lib::kernels {
+
+using uint128 = unsigned __int128;
+
+// 由一个64位种子展开出若干状态字(每次调用推进x)
+inline uint64_t splitmix64(uint64_t& x) {
+    uint64_t z = (x += 0x9e3779b97f4a7c15ULL);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+// xoshiro256**: 256位状态, 周期2^256-1; jump()前进2^128步, 用于划分互不重叠的子序列
+class Xoshiro256 {
+public:
+    Xoshiro256() = default;
+    explicit Xoshiro256(uint64_t seed);
+
+    uint64_t next() {
+        const uint64_t result = rotl(s_[1] * 5, 7) * 9;
+        const uint64_t t = s_[1] << 17;
+        s_[2] ^= s_[0];
+        s_[3] ^= s_[1];
+        s_[1] ^= s_[2];
+        s_[0] ^= s_[3];
+        s_[2] ^= t;
+        s_[3] = rotl(s_[3], 45);
+        return result;
+    }
+
+    void jump();
+
+private:
+    static uint64_t rotl(const uint64_t x, const int k) { return (x << k) | (x >> (64 - k)); }
+
+    uint64_t s_[4] = {1, 0, 0, 0};
+};
+
+// PCG64 DXSM: 128位LCG配合DXSM输出函数, 周期2^128; stream选择LCG的增量(各流互相独立),
+// jump()前进2^96步
+class Pcg64 {
+public:
+    Pcg64() = default;
+    Pcg64(uint64_t seed, uint64_t stream);
+
+    uint64_t next() {
+        uint64_t hi = static_cast<uint64_t>(state_ >> 64);
+        const uint64_t lo = static_cast<uint64_t>(state_) | 1;
+        state_ = state_ * multiplier + inc_;
+        hi ^= hi >> 32;
+        hi *= multiplier;
+        hi ^= hi >> 48;
+        hi *= lo;
+        return hi;
+    }
+
+    // 前进delta步, O(log delta)
+    void advance(uint128 delta);
+    void jump() { advance(uint128{1} << 96); }
+
+private:
+    static constexpr uint64_t multiplier = 0xda942042e4dd58b5ULL;
+
+    uint128 state_ = 0;
+    uint128 inc_ = 1;
+};
+
+// [0, 1)内的双精度数, 取高53位
+inline double to_unit(const uint64_t x) {
+    return static_cast<double>(x >> 11) * 0x1.0p-53;
+}
+
+// [0, range)内无偏的整数(Lemire乘法取高位, 仅在低位落入偏差区时重抽), range > 0
+template <typename Engine>
+uint64_t bounded(Engine& engine, const uint64_t range) {
+    uint128 m = static_cast<uint128>(engine.next()) * range;
+    if (static_cast<uint64_t>(m) < range) {
+        const uint64_t threshold = -range % range;
+        while (static_cast<uint64_t>(m) < threshold) {
+            m = static_cast<uint128>(engine.next()) * range;
+        }
+    }
+    return static_cast<uint64_t>(m >> 64);
+}
+
+// [lo, lo + span]内的整数, span为上下界之差(按无符号计, 为2^64-1时即全部i64)
+template <typename Engine>
+int64_t in_range(Engine& engine, const int64_t lo, const uint64_t span) {
+    const uint64_t offset = span == UINT64_MAX ? engine.next() : bounded(engine, span + 1);
+    return static_cast<int64_t>(static_cast<uint64_t>(lo) + offset);
+}
+
+// 一次产出两个独立的标准正态数
+template <typename Engine>
+void normal_pair(Engine& engine, double& a, double& b);
+
+// 批量生成, 整段循环在原生代码中完成
+template <typename Engine>
+void fill_ints(Engine& engine, int64_t lo, uint64_t span, int64_t* out, size_t n);
+template <typename Engine>
+void fill_bytes(Engine& engine, uint8_t* out, size_t n);
+template <typename Engine>
+void fill_uniform(Engine& engine, double lo, double hi, double* out, size_t n);
+template <typename Engine>
+void fill_normal(Engine& engine, double mu, double sigma, double* out, size_t n);
+
+}
@@ -0,0 +1,63 @@
+#pragma once
+#include "models/models.hpp"
+#include "random_kernels.hpp"
+
+namespace random_lib {
+
+inline auto based_generator = new model::Object();
+
+// 可设种子的伪随机数生成器; 各生成器状态独立, 并行任务各用一个(由spawn/jump划分)即可互不重叠
+class Generator : public model::Object {
+public:
+    enum class Kind : uint8_t { Xoshiro, Pcg };
+
+    Kind kind;
+    kernels::Xoshiro256 xoshiro;
+    kernels::Pcg64 pcg;
+    uint64_t stream = 0;  // pcg的流编号, 重设种子时沿用
+
+    explicit Generator(const kernels::Xoshiro256& engine) : kind(Kind::Xoshiro), xoshiro(engine) {
+        attrs.insert("__parent__", based_generator);
+    }
+    Generator(const kernels::Pcg64& engine, const uint64_t stream) : kind(Kind::Pcg), pcg(engine), stream(stream) {
+        attrs.insert("__parent__", based_generator);
+    }
+
+    // 以具体的引擎类型调用fn, 批量方法在fn内整段循环, 只分派一次
+    template <typename F>
+    decltype(auto) visit(F&& fn) {
+        if (kind == Kind::Xoshiro) return fn(xoshiro);
+        return fn(pcg);
+    }
+
+    [[nodiscard]] std::string debug_string() const override {
+        return kind == Kind::Xoshiro ? "<Generator xoshiro256**>" : "<Generator pcg64>";
+    }
+};
+
+model::Object* init_module(model::Object* self, const model::List* args);
+
+// 模块函数; rand_int等同名函数使用模块的默认生成器
+model::Object* xoshiro(model::Object* self, const model::List* args);
+model::Object* pcg(model::Object* self, const model::List* args);
+
+// Generator方法
+model::Object* gen_str(model::Object* self, const model::List* args);
+model::Object* gen_seed(model::Object* self, const model::List* args);
+model::Object* gen_random(model::Object* self, const model::List* args);
+model::Object* gen_rand_int(model::Object* self, const model::List* args);
+model::Object* gen_uniform(model::Object* self, const model::List* args);
+model::Object* gen_normal(model::Object* self, const model::List* args);
+model::Object* gen_choice(model::Object* self, const model::List* args);
+model::Object* gen_shuffle(model::Object* self, const model::List* args);
+model::Object* gen_sample(model::Object* self, const model::List* args);
+model::Object* gen_ints(model::Object* self, const model::List* args);
+model::Object* gen_bytes(model::Object* self, const model::List* args);
+model::Object* gen_floats(model::Object* self, const model::List* args);
+model::Object* gen_normals(model::Object* self, const model::List* args);
+model::Object* gen_int_list(model::Object* self, const model::List* args);
+model::Object* gen_float_list(model::Object* self, const model::List* args);
+model::Object* gen_jump(model::Object* self, const model::List* args);
+model::Object* gen_spawn(model::Object* self, const model::List* args);
+
+}
@@ -0,0 +1,156 @@
+#include "include/random_kernels.hpp"
+#include <cmath>
+#include <cstring>
+
+namespace random_lib::kernels {
+
+// -------------------------- xoshiro256** --------------------------
+Xoshiro256::Xoshiro256(uint64_t seed) {
+    for (auto& word : s_) word = splitmix64(seed);
+    // 全零状态不会再变化, splitmix64连续四次输出全为0实际不会发生, 仍作保护
+    if ((s_[0] | s_[1] | s_[2] | s_[3]) == 0) s_[0] = 1;
+}
+
+void Xoshiro256::jump() {
+    static constexpr uint64_t table[] = {
+        0x180ec6d33cfd0abaULL, 0xd5a61266f0c9392cULL, 0xa9582618e03fc9aaULL, 0x39abdc4529b1661cULL
+    };
+    uint64_t t[4] = {0, 0, 0, 0};
+    for (const uint64_t word : table) {
+        for (int b = 0; b < 64; ++b) {
+            if (word & (uint64_t{1} << b)) {
+                for (int i = 0; i < 4; ++i) t[i] ^= s_[i];
+            }
+            next();
+        }
+    }
+    for (int i = 0; i < 4; ++i) s_[i] = t[i];
+}
+
+// -------------------------- PCG64 DXSM --------------------------
+static uint128 join(const uint64_t hi, const uint64_t lo) {
+    return (static_cast<uint128>(hi) << 64) | lo;
+}
+
+// 初始化方式同PCG参考实现: 状态由种子展开, 增量由流编号展开(编号相邻的流增量也相差很远)
+Pcg64::Pcg64(uint64_t seed, uint64_t stream) {
+    stream ^= 0x5851f42d4c957f2dULL;
+    const uint64_t inc_hi = splitmix64(stream);
+    inc_ = (join(inc_hi, splitmix64(stream)) << 1) | 1;
+    const uint64_t state_hi = splitmix64(seed);
+    const uint128 init = join(state_hi, splitmix64(seed));
+    state_ = 0;
+    next();
+    state_ += init;
+    next();
+}
+
+// LCG跳跃: 按delta的二进制位累积 x -> mult·x + plus 的复合(Brown的方法)
+void Pcg64::advance(uint128 delta) {
+    uint128 mult = multiplier;
+    uint128 plus = inc_;
+    uint128 acc_mult = 1;
+    uint128 acc_plus = 0;
+    while (delta > 0) {
+        if (delta & 1) {
+            acc_mult *= mult;
+            acc_plus = acc_plus * mult + plus;
+        }
+        plus = (mult + 1) * plus;
+        mult *= mult;
+        delta >>= 1;
+    }
+    state_ = acc_mult * state_ + acc_plus;
+}
+
+// -------------------------- 分布与批量生成 --------------------------
+// Marsaglia极坐标法: 在单位圆内取点, 比Box-Muller省去三角函数, 平均每对约抽1.27次
+template <typename Engine>
+void normal_pair(Engine& engine, double& a, double& b) {
+    double x, y, s;
+    do {
+        x = 2.0 * to_unit(engine.next()) - 1.0;
+        y = 2.0 * to_unit(engine.next()) - 1.0;
+        s = x * x + y * y;
+    } while (s >= 1.0 or s == 0.0);
+    const double f = std::sqrt(-2.0 * std::log(s) / s);
+    a = x * f;
+    b = y * f;
+}
+
+// 批量循环在引擎的局部副本上进行, 结束后写回: 输出与状态同为64位整数, 否则每次写出都可能
+// 与状态别名, 迫使编译器反复读写内存中的状态
+template <typename Engine>
+void fill_ints(Engine& engine, const int64_t lo, const uint64_t span, int64_t* out, const size_t n) {
+    Engine local = engine;
+    const auto base = static_cast<uint64_t>(lo);
+    if (span == UINT64_MAX) {
+        for (size_t i = 0; i < n; ++i) out[i] = static_cast<int64_t>(local.next());
+    } else {
+        // 拒绝阈值只算一次, 循环内只有一次乘法
+        const uint64_t range = span + 1;
+        const uint64_t threshold = -range % range;
+        for (size_t i = 0; i < n; ++i) {
+            uint128 m = static_cast<uint128>(local.next()) * range;
+            while (static_cast<uint64_t>(m) < threshold) {
+                m = static_cast<uint128>(local.next()) * range;
+            }
+            out[i] = static_cast<int64_t>(base + static_cast<uint64_t>(m >> 64));
+        }
+    }
+    engine = local;
+}
+
+template <typename Engine>
+void fill_bytes(Engine& engine, uint8_t* out, const size_t n) {
+    Engine local = engine;
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        const uint64_t x = local.next();
+        std::memcpy(out + i, &x, 8);
+    }
+    if (i < n) {
+        uint64_t x = local.next();
+        for (; i < n; ++i, x >>= 8) out[i] = static_cast<uint8_t>(x);
+    }
+    engine = local;
+}
+
+template <typename Engine>
+void fill_uniform(Engine& engine, const double lo, const double hi, double* out, const size_t n) {
+    Engine local = engine;
+    const double width = hi - lo;
+    for (size_t i = 0; i < n; ++i) out[i] = lo + width * to_unit(local.next());
+    engine = local;
+}
+
+template <typename Engine>
+void fill_normal(Engine& engine, const double mu, const double sigma, double* out, const size_t n) {
+    Engine local = engine;
+    size_t i = 0;
+    double a, b;
+    for (; i + 2 <= n; i += 2) {
+        normal_pair(local, a, b);
+        out[i] = mu + sigma * a;
+        out[i + 1] = mu + sigma * b;
+    }
+    if (i < n) {
+        normal_pair(local, a, b);
+        out[i] = mu + sigma * a;
+    }
+    engine = local;
+}
+
+#define KIZ_RANDOM_INSTANTIATE(Engine) \
+    template void normal_pair(Engine&, double&, double&); \
+    template void fill_ints(Engine&, int64_t, uint64_t, int64_t*, size_t); \
+    template void fill_bytes(Engine&, uint8_t*, size_t); \
+    template void fill_uniform(Engine&, double, double, double*, size_t); \
+    template void fill_normal(Engine&, double, double, double*, size_t);
+
+KIZ_RANDOM_INSTANTIATE(Xoshiro256)
+KIZ_RANDOM_INSTANTIATE(Pcg64)
+
+#undef KIZ_RANDOM_INSTANTIATE
+
+}
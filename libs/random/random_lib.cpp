@@ -0,0 +1,466 @@
+#include "include/random_lib.hpp"
+#include <chrono>
+#include <numeric>
+#include <random>
+#include <unordered_set>
+
+#include "array/include/array_lib.hpp"
+#include "builtins/include/builtin_functions.hpp"
+
+namespace random_lib {
+
+using array_lib::Array;
+using array_lib::DType;
+
+// -------------------------- 参数与类型转换 --------------------------
+static Generator* self_generator(model::Object* self, const std::string& method) {
+    const auto gen = dynamic_cast<Generator*>(self);
+    if (gen == nullptr) throw NativeFuncError("TypeError", "Generator." + method + " must be called by Generator object");
+    return gen;
+}
+
+static model::Object* opt_arg(const model::List* args, const size_t pos) {
+    return args->val.size() > pos and args->val[pos]->get_type() != model::Object::ObjectType::OT_Nil
+        ? args->val[pos] : nullptr;
+}
+
+static int64_t int_arg(const model::List* args, const size_t pos, const std::string& func) {
+    const auto n = args->val.size() > pos ? dynamic_cast<model::Int*>(args->val[pos]) : nullptr;
+    if (n == nullptr) throw NativeFuncError("TypeError", func + "() need Int arguments");
+    int64_t v;
+    if (!n->val.to_int64(v)) throw NativeFuncError("ValueError", func + "() bounds must fit in i64");
+    return v;
+}
+
+static size_t size_arg(const model::List* args, const size_t pos, const std::string& func) {
+    const auto n = args->val.size() > pos ? dynamic_cast<model::Int*>(args->val[pos]) : nullptr;
+    if (n == nullptr) throw NativeFuncError("TypeError", func + "() need Int size arguments");
+    int64_t v;
+    if (!n->val.to_int64(v) or v < 0) throw NativeFuncError("ValueError", func + "() size must be a non-negative i64");
+    return static_cast<size_t>(v);
+}
+
+// 省略或为Nil时取默认值
+static double float_arg(const model::List* args, const size_t pos, const std::string& func, const double fallback) {
+    const auto obj = opt_arg(args, pos);
+    if (obj == nullptr) return fallback;
+    double v;
+    if (!model::as_double(obj, v)) throw NativeFuncError("TypeError", func + "() need Int, Decimal or Float arguments");
+    return v;
+}
+
+// [lo, hi]的上下界之差, 按无符号计
+static uint64_t span_of(const int64_t lo, const int64_t hi, const std::string& func) {
+    if (lo > hi) throw NativeFuncError("ValueError", func + "() empty range: a > b");
+    return static_cast<uint64_t>(hi) - static_cast<uint64_t>(lo);
+}
+
+// 操作系统熵源与时钟混合, 用于未指定种子的生成器
+static uint64_t entropy_seed() {
+    std::random_device device;
+    const uint64_t bits = (static_cast<uint64_t>(device()) << 32) ^ device();
+    return bits ^ static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+}
+
+// 种子为Int(超出i64时取其十进制表示的哈希)或Nil(取熵源)
+static uint64_t seed_arg(const model::List* args, const size_t pos, const std::string& func) {
+    const auto obj = opt_arg(args, pos);
+    if (obj == nullptr) return entropy_seed();
+    const auto n = dynamic_cast<const model::Int*>(obj);
+    if (n == nullptr) throw NativeFuncError("TypeError", func + "() seed must be Int or Nil");
+    int64_t v;
+    if (n->val.to_int64(v)) return static_cast<uint64_t>(v);
+    return std::hash<std::string>{}(n->val.to_string());
+}
+
+static model::Object* box(const Array* arr, const size_t i) {
+    switch (arr->dtype) {
+    case DType::U8: return model::create_int(dep::BigInt::from_int64(arr->data<uint8_t>()[i]));
+    case DType::I64: return model::create_int(dep::BigInt::from_int64(arr->data<int64_t>()[i]));
+    case DType::F64: return model::create_float(arr->data<double>()[i]);
+    }
+    return model::load_nil();
+}
+
+// 各字符的起始字节偏移, 末尾附总字节数; 纯ASCII的字符串无需构造
+static std::vector<size_t> char_offsets(const std::string_view text) {
+    std::vector<size_t> offsets;
+    for (size_t i = 0; i < text.size(); ++i) {
+        if ((static_cast<unsigned char>(text[i]) & 0xC0) != 0x80) offsets.push_back(i);
+    }
+    offsets.push_back(text.size());
+    return offsets;
+}
+
+// 可按下标随机访问的序列长度, 其他类型报错
+static size_t sequence_size(const model::Object* seq, const std::string& func) {
+    if (const auto list = dynamic_cast<const model::List*>(seq)) return list->size();
+    if (const auto tuple = dynamic_cast<const model::Tuple*>(seq)) return tuple->size();
+    if (const auto str = dynamic_cast<const model::String*>(seq)) return str->char_size();
+    if (const auto arr = dynamic_cast<const Array*>(seq)) return arr->length;
+    throw NativeFuncError("TypeError", func + "() need a List, Tuple, Str or Array");
+}
+
+// -------------------------- 抽样 --------------------------
+template <typename Engine, typename T>
+static void fisher_yates(Engine& engine, T* data, const size_t n) {
+    for (size_t i = n; i > 1; --i) {
+        const size_t j = kernels::bounded(engine, i);
+        std::swap(data[i - 1], data[j]);
+    }
+}
+
+// 从[0, n)中不放回地取k个下标, 结果为随机顺序: k相对n较大时部分洗牌, 否则拒绝重复(只占O(k)内存)
+template <typename Engine>
+static std::vector<size_t> pick_indices(Engine& engine, const size_t n, const size_t k) {
+    std::vector<size_t> out;
+    if (k >= n / 4) {
+        out.resize(n);
+        std::iota(out.begin(), out.end(), size_t{0});
+        for (size_t i = 0; i < k; ++i) {
+            std::swap(out[i], out[i + kernels::bounded(engine, n - i)]);
+        }
+        out.resize(k);
+        return out;
+    }
+    out.reserve(k);
+    std::unordered_set<size_t> seen;
+    seen.reserve(k * 2);
+    while (out.size() < k) {
+        const size_t x = kernels::bounded(engine, n);
+        if (seen.insert(x).second) out.push_back(x);
+    }
+    return out;
+}
+
+// 按下标从List取元素组成新列表, 保持拆箱存储
+static model::List* gather(const model::List* list, const std::vector<size_t>& indices) {
+    if (list->strategy() == model::List::Strategy::Int) {
+        std::vector<int64_t> ints;
+        ints.reserve(indices.size());
+        for (const size_t i : indices) ints.push_back(list->ints()[i]);
+        return model::List::from_ints(std::move(ints));
+    }
+    if (list->strategy() == model::List::Strategy::Str) {
+        std::vector<std::string> strs;
+        strs.reserve(indices.size());
+        for (const size_t i : indices) strs.push_back(list->strs()[i]);
+        return model::List::from_strs(std::move(strs));
+    }
+    // 同List.slice: 元素各持有一次引用, 同类时再转为拆箱存储
+    std::vector<model::Object*> elems;
+    elems.reserve(indices.size());
+    for (const size_t i : indices) {
+        const auto elem = list->get(i);
+        elem->make_ref();
+        elems.push_back(elem);
+    }
+    const auto out = new model::List(std::move(elems));
+    out->specialize();
+    return out;
+}
+
+template <typename T>
+static void gather(const T* src, const std::vector<size_t>& indices, T* dst) {
+    for (size_t k = 0; k < indices.size(); ++k) dst[k] = src[indices[k]];
+}
+
+// -------------------------- 模块 --------------------------
+using Method = model::Object* (*)(model::Object*, const model::List*);
+
+// Generator的方法; 模块中同名的函数作用于默认生成器
+static const std::pair<const char*, Method> generator_methods[] = {
+    {"seed", gen_seed}, {"random", gen_random}, {"rand_int", gen_rand_int}, {"uniform", gen_uniform},
+    {"normal", gen_normal}, {"choice", gen_choice}, {"shuffle", gen_shuffle}, {"sample", gen_sample},
+    {"ints", gen_ints}, {"bytes", gen_bytes}, {"floats", gen_floats}, {"normals", gen_normals},
+    {"int_list", gen_int_list}, {"float_list", gen_float_list}, {"jump", gen_jump}, {"spawn", gen_spawn},
+};
+
+model::Object* init_module(model::Object* self, const model::List* args) {
+    auto mod = new model::Module("random");
+    // ints/floats等批量方法返回Array
+    array_lib::register_array_type();
+
+    // 以熵源播种的默认生成器, 由模块常驻持有
+    const auto fallback = new Generator(kernels::Xoshiro256(entropy_seed()));
+    fallback->make_ref();
+
+    based_generator->attrs.insert("__parent__", model::based_obj);
+    based_generator->attrs.insert("__str__", new model::NativeFunction(gen_str));
+    for (const auto& [name, method] : generator_methods) {
+        based_generator->attrs.insert(name, new model::NativeFunction(method));
+        if (std::string_view(name) == "jump" or std::string_view(name) == "spawn") continue;
+        mod->attrs.insert(name, new model::NativeFunction([fallback, method](model::Object*, model::List* call_args) {
+            return method(fallback, call_args);
+        }));
+    }
+
+    mod->attrs.insert("Generator", based_generator);
+    mod->attrs.insert("default", fallback);
+    mod->attrs.insert("xoshiro", new model::NativeFunction(xoshiro));
+    mod->attrs.insert("pcg", new model::NativeFunction(pcg));
+
+    return mod;
+}
+
+// random.xoshiro(seed=Nil): xoshiro256**生成器, 未给种子时取熵源
+model::Object* xoshiro(model::Object* self, const model::List* args) {
+    return new Generator(kernels::Xoshiro256(seed_arg(args, 0, "xoshiro")));
+}
+
+// random.pcg(seed=Nil, stream=0): PCG64 DXSM生成器; 种子相同、流编号不同的生成器互相独立
+model::Object* pcg(model::Object* self, const model::List* args) {
+    const uint64_t seed = seed_arg(args, 0, "pcg");
+    const auto stream = opt_arg(args, 1) == nullptr ? 0 : static_cast<uint64_t>(int_arg(args, 1, "pcg"));
+    return new Generator(kernels::Pcg64(seed, stream), stream);
+}
+
+model::Object* gen_str(model::Object* self, const model::List* args) {
+    return model::create_str(self_generator(self, "__str__")->debug_string());
+}
+
+// -------------------------- 单个取值 --------------------------
+// g.seed(seed=Nil, stream=Nil): 原地重设种子, pcg未给stream时沿用原流编号
+model::Object* gen_seed(model::Object* self, const model::List* args) {
+    const auto gen = self_generator(self, "seed");
+    const uint64_t seed = seed_arg(args, 0, "seed");
+    if (gen->kind == Generator::Kind::Xoshiro) {
+        gen->xoshiro = kernels::Xoshiro256(seed);
+    } else {
+        if (opt_arg(args, 1) != nullptr) gen->stream = static_cast<uint64_t>(int_arg(args, 1, "seed"));
+        gen->pcg = kernels::Pcg64(seed, gen->stream);
+    }
+    return model::load_nil();
+}
+
+// g.random(): [0, 1)内的Float
+model::Object* gen_random(model::Object* self, const model::List* args) {
+    const auto gen = self_generator(self, "random");
+    return model::create_float(gen->visit([](auto& e) { return kernels::to_unit(e.next()); }));
+}
+
+// g.rand_int(a, b): [a, b]内均匀分布的Int(含两端)
+model::Object* gen_rand_int(model::Object* self, const model::List* args) {
+    const auto gen = self_generator(self, "rand_int");
+    const int64_t lo = int_arg(args, 0, "rand_int");
+    const uint64_t span = span_of(lo, int_arg(args, 1, "rand_int"), "rand_int");
+    const int64_t v = gen->visit([&](auto& e) { return kernels::in_range(e, lo, span); });
+    return model::create_int(dep::BigInt::from_int64(v));
+}
+
+// g.uniform(a=0, b=1): [a, b)内的Float
+model::Object* gen_uniform(model::Object* self, const model::List* args) {
+    const auto gen = self_generator(self, "uniform");
+    const double lo = float_arg(args, 0, "uniform", 0.0);
+    const double hi = float_arg(args, 1, "uniform", 1.0);
+    const double u = gen->visit([](auto& e) { return kernels::to_unit(e.next()); });
+    return model::create_float(lo + (hi - lo) * u);
+}
+
+// g.normal(mu=0, sigma=1): 正态分布的Float
+model::Object* gen_normal(model::Object* self, const model::List* args) {
+    const auto gen = self_generator(self, "normal");
+    const double mu = float_arg(args, 0, "normal", 0.0);
+    const double sigma = float_arg(args, 1, "normal", 1.0);
+    if (sigma < 0) throw NativeFuncError("ValueError", "normal() sigma must be non-negative");
+    double a, b;
+    gen->visit([&](auto& e) { kernels::normal_pair(e, a, b); });
+    return model::create_float(mu + sigma * a);
+}
+
+// g.choice(seq): 随机取List/Tuple/Str/Array的一个元素(Str为一个字符)
+model::Object* gen_choice(model::Object* self, const model::List* args) {
+    const auto gen = self_generator(self, "choice");
+    const auto seq = builtin::get_one_arg(args);
+    const size_t n = sequence_size(seq, "choice");
+    if (n == 0) throw NativeFuncError("IndexError", "choice() from empty sequence");
+    const size_t i = gen->visit([n](auto& e) { return static_cast<size_t>(kernels::bounded(e, n)); });
+
+    if (const auto list = dynamic_cast<model::List*>(seq)) return list->get(i);
+    if (const auto tuple = dynamic_cast<model::Tuple*>(seq)) return tuple->get(i);
+    if (const auto arr = dynamic_cast<Array*>(seq)) return box(arr, i);
+    const auto str = dynamic_cast<model::String*>(seq);
+    if (str->char_size() == str->byte_size()) return model::String::slice(str, i, i + 1);
+    const auto offsets = char_offsets(str->view());
+    return model::String::slice(str, offsets[i], offsets[i + 1]);
+}
+
+// g.shuffle(seq): 原地打乱List或Array(Array视图会打乱共享的内存)
+model::Object* gen_shuffle(model::Object* self, const model::List* args) {
+    const auto gen = self_generator(self, "shuffle");
+    const auto seq = builtin::get_one_arg(args);
+    gen->visit([seq](auto& e) {
+        if (const auto list = dynamic_cast<model::List*>(seq)) {
+            switch (list->strategy()) {
+            case model::List::Strategy::Int: fisher_yates(e, list->ints().data(), list->ints().size()); break;
+            case model::List::Strategy::Decimal: fisher_yates(e, list->decimals().data(), list->decimals().size()); break;
+            case model::List::Strategy::Str: fisher_yates(e, list->strs().data(), list->strs().size()); break;
+            default: fisher_yates(e, list->val.data(), list->val.size()); break;
+            }
+        } else if (const auto arr = dynamic_cast<Array*>(seq)) {
+            switch (arr->dtype) {
+            case DType::U8: fisher_yates(e, arr->data<uint8_t>(), arr->length); break;
+            case DType::I64: fisher_yates(e, arr->data<int64_t>(), arr->length); break;
+            case DType::F64: fisher_yates(e, arr->data<double>(), arr->length); break;
+            }
+        } else {
+            throw NativeFuncError("TypeError", "shuffle() need a List or Array");
+        }
+    });
+    return model::load_nil();
+}
+
+// g.sample(population, k): 不放回地随机取k个元素, 顺序随机; population为Int n时取[0, n)中的k个整数;
+// Array得到同类型的Array, 其他得到List(Str为字符组成的List)
+model::Object* gen_sample(model::Object* self, const model::List* args) {
+    const auto gen = self_generator(self, "sample");
+    if (args->val.size() < 2) throw NativeFuncError("TypeError", "sample() need 2 args");
+    const auto population = args->val[0];
+    const size_t k = size_arg(args, 1, "sample");
+
+    if (const auto count = dynamic_cast<const model::Int*>(population)) {
+        int64_t n;
+        if (!count->val.to_int64(n) or n < 0) throw NativeFuncError("ValueError", "sample() population size must be a non-negative i64");
+        if (k > static_cast<size_t>(n)) throw NativeFuncError("ValueError", "sample() larger than population");
+        const auto indices = gen->visit([&](auto& e) { return pick_indices(e, static_cast<size_t>(n), k); });
+        return model::List::from_ints(std::vector<int64_t>(indices.begin(), indices.end()));
+    }
+
+    const size_t n = sequence_size(population, "sample");
+    if (k > n) throw NativeFuncError("ValueError", "sample() larger than population");
+    const auto indices = gen->visit([&](auto& e) { return pick_indices(e, n, k); });
+
+    if (const auto list = dynamic_cast<const model::List*>(population)) return gather(list, indices);
+    if (const auto arr = dynamic_cast<const Array*>(population)) {
+        const auto out = new Array(arr->dtype, k);
+        switch (arr->dtype) {
+        case DType::U8: gather(arr->data<uint8_t>(), indices, out->data<uint8_t>()); break;
+        case DType::I64: gather(arr->data<int64_t>(), indices, out->data<int64_t>()); break;
+        case DType::F64: gather(arr->data<double>(), indices, out->data<double>()); break;
+        }
+        return out;
+    }
+    if (const auto tuple = dynamic_cast<const model::Tuple*>(population)) {
+        std::vector<model::Object*> elems;
+        elems.reserve(k);
+        for (const size_t i : indices) {
+            tuple->get(i)->make_ref();
+            elems.push_back(tuple->get(i));
+        }
+        const auto out = new model::List(std::move(elems));
+        out->specialize();
+        return out;
+    }
+    const auto str = dynamic_cast<const model::String*>(population);
+    const auto text = str->view();
+    std::vector<std::string> chars;
+    chars.reserve(k);
+    if (str->char_size() == str->byte_size()) {
+        for (const size_t i : indices) chars.emplace_back(1, text[i]);
+    } else {
+        const auto offsets = char_offsets(text);
+        for (const size_t i : indices) chars.emplace_back(text.substr(offsets[i], offsets[i + 1] - offsets[i]));
+    }
+    return model::List::from_strs(std::move(chars));
+}
+
+// -------------------------- 批量生成 --------------------------
+// g.ints(n, a, b): n个[a, b]内的整数组成的i64 Array
+model::Object* gen_ints(model::Object* self, const model::List* args) {
+    const auto gen = self_generator(self, "ints");
+    const size_t n = size_arg(args, 0, "ints");
+    const int64_t lo = int_arg(args, 1, "ints");
+    const uint64_t span = span_of(lo, int_arg(args, 2, "ints"), "ints");
+    const auto out = new Array(DType::I64, n);
+    gen->visit([&](auto& e) { kernels::fill_ints(e, lo, span, out->data<int64_t>(), n); });
+    return out;
+}
+
+// g.bytes(n): n个随机字节组成的u8 Array
+model::Object* gen_bytes(model::Object* self, const model::List* args) {
+    const auto gen = self_generator(self, "bytes");
+    const size_t n = size_arg(args, 0, "bytes");
+    const auto out = new Array(DType::U8, n);
+    gen->visit([&](auto& e) { kernels::fill_bytes(e, out->data<uint8_t>(), n); });
+    return out;
+}
+
+// g.floats(n, a=0, b=1): n个[a, b)内的数组成的f64 Array
+model::Object* gen_floats(model::Object* self, const model::List* args) {
+    const auto gen = self_generator(self, "floats");
+    const size_t n = size_arg(args, 0, "floats");
+    const double lo = float_arg(args, 1, "floats", 0.0);
+    const double hi = float_arg(args, 2, "floats", 1.0);
+    const auto out = new Array(DType::F64, n);
+    gen->visit([&](auto& e) { kernels::fill_uniform(e, lo, hi, out->data<double>(), n); });
+    return out;
+}
+
+// g.normals(n, mu=0, sigma=1): n个正态分布的数组成的f64 Array
+model::Object* gen_normals(model::Object* self, const model::List* args) {
+    const auto gen = self_generator(self, "normals");
+    const size_t n = size_arg(args, 0, "normals");
+    const double mu = float_arg(args, 1, "normals", 0.0);
+    const double sigma = float_arg(args, 2, "normals", 1.0);
+    if (sigma < 0) throw NativeFuncError("ValueError", "normals() sigma must be non-negative");
+    const auto out = new Array(DType::F64, n);
+    gen->visit([&](auto& e) { kernels::fill_normal(e, mu, sigma, out->data<double>(), n); });
+    return out;
+}
+
+// g.int_list(n, a, b): 同ints, 结果为List(拆箱存储)
+model::Object* gen_int_list(model::Object* self, const model::List* args) {
+    const auto gen = self_generator(self, "int_list");
+    const size_t n = size_arg(args, 0, "int_list");
+    const int64_t lo = int_arg(args, 1, "int_list");
+    const uint64_t span = span_of(lo, int_arg(args, 2, "int_list"), "int_list");
+    std::vector<int64_t> ints(n);
+    gen->visit([&](auto& e) { kernels::fill_ints(e, lo, span, ints.data(), n); });
+    return model::List::from_ints(std::move(ints));
+}
+
+// g.float_list(n, a=0, b=1): 同floats, 结果为Float组成的List
+model::Object* gen_float_list(model::Object* self, const model::List* args) {
+    const auto gen = self_generator(self, "float_list");
+    const size_t n = size_arg(args, 0, "float_list");
+    const double lo = float_arg(args, 1, "float_list", 0.0);
+    const double hi = float_arg(args, 2, "float_list", 1.0);
+    std::vector<double> values(n);
+    gen->visit([&](auto& e) { kernels::fill_uniform(e, lo, hi, values.data(), n); });
+    std::vector<model::Object*> elems;
+    elems.reserve(n);
+    for (const double v : values) {
+        const auto elem = model::create_float(v);
+        elem->make_ref();
+        elems.push_back(elem);
+    }
+    return new model::List(std::move(elems));
+}
+
+// -------------------------- 独立的流 --------------------------
+// g.jump(): 原地跳过一大段序列(xoshiro为2^128个数, pcg为2^96个数)
+model::Object* gen_jump(model::Object* self, const model::List* args) {
+    const auto gen = self_generator(self, "jump");
+    gen->visit([](auto& e) { e.jump(); });
+    return model::load_nil();
+}
+
+// g.spawn(n): n个新生成器, 依次取g当前位置后再跳跃, 各自占用一段互不重叠的序列;
+// 返回后g也已越过这些段, 可继续独立使用
+model::Object* gen_spawn(model::Object* self, const model::List* args) {
+    const auto gen = self_generator(self, "spawn");
+    const size_t n = size_arg(args, 0, "spawn");
+    std::vector<model::Object*> children;
+    children.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+        model::Object* child;
+        if (gen->kind == Generator::Kind::Xoshiro) child = new Generator(gen->xoshiro);
+        else child = new Generator(gen->pcg, gen->stream);
+        gen->visit([](auto& e) { e.jump(); });
+        child->make_ref();
+        children.push_back(child);
+    }
+    return new model::List(std::move(children));
+}
+
+}
@@ -0,0 +1,149 @@
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace re_lib {
+
+// 字节级指令: 模式中的非ASCII字符与字符类都展开为UTF-8字节序列
+enum class Op : uint8_t {
+    ByteRange,       // 当前字节在[lo, hi]内则读入并走x
+    Split,           // 优先走x, 其次走y
+    Jmp,
+    Save,            // 把当前位置记到捕获槽y, 然后走x
+    Match,
+    AssertBegin,     // ^ \A: 文本开头
+    AssertEnd,       // $: 文本末尾或末尾换行符之前
+    AssertTextEnd,   // \Z: 文本末尾
+    WordBoundary,    // \b
+    NotWordBoundary, // \B
+    Backref,         // \n: 与第y组已匹配的内容相同则读入并走x
+};
+
+struct Inst {
+    Op op;
+    uint8_t lo = 0;
+    uint8_t hi = 0;
+    uint32_t x = 0;
+    uint32_t y = 0;
+};
+
+struct Program {
+    std::vector<Inst> insts;
+    uint32_t start = 0;
+};
+
+// 空宽断言所需的上下文: 左侧/右侧字符的情况
+struct Context {
+    bool begin = false;       // 左侧是文本开头
+    bool left_word = false;
+    bool right_word = false;
+    bool dollar = false;      // 右侧是文本末尾或末尾的换行符
+    bool text_end = false;    // 右侧是文本末尾
+};
+
+// 惰性DFA: 状态是NFA线程的有序列表, 转移在第一次用到时计算并缓存
+// 正向以最左优先语义求匹配终点, 反向以最长语义求匹配起点
+class Dfa {
+public:
+    static constexpr size_t max_states = 10000;
+    static constexpr int32_t unknown = -1;
+    static constexpr int32_t overflow = -2;
+
+    Dfa(const Program& prog, const std::vector<uint8_t>& byte_class, size_t class_count, bool reverse, bool longest);
+
+    // 从from开始正向扫描, 返回最左优先匹配的终点; 无匹配返回-1, 状态数超限返回-2
+    // prefix非空时, 在起始状态下用子串查找直接跳到下一个候选位置
+    int64_t scan_forward(std::string_view text, size_t from, std::string_view prefix);
+    // 从end向前扫描到from, 返回可匹配到end的最小起点
+    int64_t scan_reverse(std::string_view text, size_t from, size_t end);
+
+private:
+    struct State {
+        std::vector<uint32_t> insts;  // 读入字节之后、求闭包之前的线程
+        uint8_t flags;
+        bool match;       // 读入上一个字节之前的位置上有匹配结束
+        bool start = false;
+    };
+
+    static constexpr uint8_t flag_word = 1;     // 正向: 左侧是单词字符; 反向: 右侧是单词字符
+    static constexpr uint8_t flag_begin = 2;    // 正向: 位于文本开头
+    static constexpr uint8_t flag_dollar = 4;   // 反向: 右侧满足$
+    static constexpr uint8_t flag_text_end = 8; // 反向: 右侧是文本末尾
+
+    const Program& prog_;
+    const std::vector<uint8_t>& byte_class_;
+    size_t stride_;
+    bool reverse_;
+    bool longest_;
+    bool has_dollar_ = false;
+
+    std::vector<State> states_;
+    std::vector<int32_t> trans_;
+    std::unordered_map<std::string, int32_t> index_;
+
+    // 求闭包时的访问标记与工作栈
+    std::vector<uint32_t> mark_;
+    uint32_t generation_ = 0;
+    std::vector<uint32_t> stack_;
+    std::vector<uint32_t> closure_;
+    std::vector<uint32_t> next_;
+
+    int32_t intern(const std::vector<uint32_t>& insts, uint8_t flags, bool match);
+    int32_t start_state(uint8_t flags);
+    // 在状态s上读入字节c(256表示文本边界); special为真时结果不写入缓存
+    int32_t step(int32_t s, int c, bool special);
+    int32_t transition(const int32_t s, const int c) {
+        const size_t slot = static_cast<size_t>(s) * stride_ + (c == 256 ? stride_ - 1 : byte_class_[c]);
+        const int32_t t = trans_[slot];
+        return t != unknown ? t : step(s, c, false);
+    }
+};
+
+// 编译后的正则表达式
+class Regex {
+public:
+    // full为真时要求匹配到文本末尾(fullmatch); 语法错误抛出ReError
+    explicit Regex(std::string_view pattern, bool full = false);
+
+    [[nodiscard]] size_t groups() const { return group_count_; }
+    [[nodiscard]] const std::unordered_map<std::string, size_t>& group_names() const { return group_names_; }
+
+    // 从from开始查找(anchored时只尝试from), 找到时caps为各组的字节起止(未参与的组为-1)
+    // need_groups为假时只填第0组
+    bool search(std::string_view text, size_t from, bool anchored, std::vector<int64_t>& caps, bool need_groups);
+    // 只在from处尝试且不接受空匹配(空匹配之后的下一次查找), 找到时caps含各组
+    bool match_nonempty(std::string_view text, size_t from, std::vector<int64_t>& caps);
+
+private:
+    size_t group_count_ = 0;
+    std::unordered_map<std::string, size_t> group_names_;
+    bool has_backref_ = false;
+    bool dfa_ok_ = true;
+    bool begin_anchored_ = false;
+    std::string prefix_;
+
+    Program forward_;     // 带捕获, 锚定
+    Program unanchored_;  // 前面加上非贪婪的任意字节循环
+    Program reverse_;     // 逆序, 无捕获
+
+    std::vector<uint8_t> byte_class_;
+    size_t class_count_ = 0;
+    std::unique_ptr<Dfa> dfa_forward_;
+    std::unique_ptr<Dfa> dfa_unanchored_;
+    std::unique_ptr<Dfa> dfa_reverse_;
+
+    // 回溯匹配: 无反向引用时用(pc, pos)访问表去重, 总代价为线性
+    bool backtrack(std::string_view text, size_t from, bool anchored, std::vector<int64_t>& caps);
+    // not_empty为真时在pos处结束的匹配视为失败
+    bool backtrack_at(std::string_view text, size_t pos, std::vector<int64_t>& caps,
+                      std::unordered_set<uint64_t>& visited, size_t& steps, bool not_empty = false);
+};
+
+bool is_word_byte(unsigned char c);
+
+}
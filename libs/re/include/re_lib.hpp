@@ -0,0 +1,81 @@
+#pragma once
+#include "models/models.hpp"
+#include "re_engine.hpp"
+
+namespace re_lib {
+
+inline auto based_re_pattern = new model::Object();
+inline auto based_re_match = new model::Object();
+
+// re.compile的结果; fullmatch所用的程序在第一次调用时才编译
+class Pattern : public model::Object {
+public:
+    std::string source;
+    Regex regex;
+    std::unique_ptr<Regex> full;
+
+    explicit Pattern(std::string source) : source(std::move(source)), regex(this->source) {
+        attrs.insert("__parent__", based_re_pattern);
+    }
+
+    [[nodiscard]] std::string debug_string() const override {
+        return "re.compile(\"" + source + "\")";
+    }
+};
+
+// 一次匹配的结果: 持有原文本, 各组位置以字节偏移保存
+class Match : public model::Object {
+public:
+    Pattern* pattern;
+    model::String* text;
+    std::vector<int64_t> caps;
+
+    Match(Pattern* pattern, model::String* text, std::vector<int64_t> caps)
+        : pattern(pattern), text(text), caps(std::move(caps)) {
+        attrs.insert("__parent__", based_re_match);
+        pattern->make_ref();
+        text->make_ref();
+    }
+
+    ~Match() override {
+        pattern->del_ref();
+        text->del_ref();
+    }
+
+    [[nodiscard]] std::string_view group_view(const size_t i) const {
+        return text->view().substr(static_cast<size_t>(caps[i * 2]), static_cast<size_t>(caps[i * 2 + 1] - caps[i * 2]));
+    }
+
+    [[nodiscard]] std::string debug_string() const override {
+        return "<re.Match at " + model::ptr_to_string(this) + ">";
+    }
+};
+
+model::Object* init_module(model::Object* self, const model::List* args);
+
+model::Object* re_compile(model::Object* self, const model::List* args);
+model::Object* re_match(model::Object* self, const model::List* args);
+model::Object* re_search(model::Object* self, const model::List* args);
+model::Object* re_fullmatch(model::Object* self, const model::List* args);
+model::Object* re_findall(model::Object* self, const model::List* args);
+model::Object* re_split(model::Object* self, const model::List* args);
+model::Object* re_sub(model::Object* self, const model::List* args);
+model::Object* re_escape(model::Object* self, const model::List* args);
+
+model::Object* pattern_match(model::Object* self, const model::List* args);
+model::Object* pattern_search(model::Object* self, const model::List* args);
+model::Object* pattern_fullmatch(model::Object* self, const model::List* args);
+model::Object* pattern_findall(model::Object* self, const model::List* args);
+model::Object* pattern_split(model::Object* self, const model::List* args);
+model::Object* pattern_sub(model::Object* self, const model::List* args);
+model::Object* pattern_groups(model::Object* self, const model::List* args);
+model::Object* pattern_str(model::Object* self, const model::List* args);
+
+model::Object* match_group(model::Object* self, const model::List* args);
+model::Object* match_groups(model::Object* self, const model::List* args);
+model::Object* match_start(model::Object* self, const model::List* args);
+model::Object* match_end(model::Object* self, const model::List* args);
+model::Object* match_span(model::Object* self, const model::List* args);
+model::Object* match_str(model::Object* self, const model::List* args);
+
+}
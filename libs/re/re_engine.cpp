@@ -0,0 +1,1049 @@
+#include "include/re_engine.hpp"
+#include "../deps/str_search.hpp"
+
+#include <algorithm>
+#include <cctype>
+
+#include "models/models.hpp"
+
+namespace re_lib {
+
+constexpr uint32_t max_codepoint = 0x10FFFF;
+constexpr size_t max_insts = 200000;
+constexpr int max_repeat = 1000;
+// 含反向引用时无法去重, 以步数上限防止指数级回溯
+constexpr size_t max_backtrack_steps = 50000000;
+
+bool is_word_byte(const unsigned char c) {
+    return (c >= '0' and c <= '9') or (c >= 'A' and c <= 'Z') or (c >= 'a' and c <= 'z') or c == '_';
+}
+
+[[noreturn]] static void syntax_error(const std::string& msg, const size_t pos) {
+    throw NativeFuncError("ReError", msg + " at position " + std::to_string(pos));
+}
+
+// -------------------------- 语法树 --------------------------
+using Ranges = std::vector<std::pair<uint32_t, uint32_t>>;
+
+struct Node {
+    enum class Kind { Empty, Literal, Class, Concat, Alternate, Repeat, Capture, Assert, Backref };
+
+    Kind kind;
+    std::string bytes;                          // Literal: UTF-8字节
+    Ranges ranges;                              // Class: 码点区间
+    std::vector<std::unique_ptr<Node>> children;
+    int min = 0;                                // Repeat
+    int max = -1;                               // Repeat: -1表示无上限
+    bool greedy = true;
+    size_t index = 0;                           // Capture/Backref: 组号
+    Op assertion = Op::AssertBegin;             // Assert
+
+    explicit Node(const Kind kind) : kind(kind) {}
+};
+
+using NodePtr = std::unique_ptr<Node>;
+
+static void append_utf8(std::string& out, const uint32_t cp) {
+    if (cp < 0x80) {
+        out += static_cast<char>(cp);
+    } else if (cp < 0x800) {
+        out += static_cast<char>(0xC0 | (cp >> 6));
+        out += static_cast<char>(0x80 | (cp & 0x3F));
+    } else if (cp < 0x10000) {
+        out += static_cast<char>(0xE0 | (cp >> 12));
+        out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (cp & 0x3F));
+    } else {
+        out += static_cast<char>(0xF0 | (cp >> 18));
+        out += static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+        out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (cp & 0x3F));
+    }
+}
+
+static void normalize(Ranges& ranges) {
+    std::sort(ranges.begin(), ranges.end());
+    Ranges merged;
+    for (const auto& r : ranges) {
+        if (!merged.empty() and r.first <= merged.back().second + 1) {
+            merged.back().second = std::max(merged.back().second, r.second);
+        } else {
+            merged.push_back(r);
+        }
+    }
+    ranges = std::move(merged);
+}
+
+static Ranges complement(const Ranges& ranges) {
+    Ranges result;
+    uint32_t next = 0;
+    for (const auto& [lo, hi] : ranges) {
+        if (lo > next) result.emplace_back(next, lo - 1);
+        next = hi + 1;
+    }
+    if (next <= max_codepoint) result.emplace_back(next, max_codepoint);
+    return result;
+}
+
+// 忽略大小写时补上ASCII字母的另一种大小写
+static void add_case_variants(Ranges& ranges) {
+    const Ranges original = ranges;
+    for (const auto& [lo, hi] : original) {
+        const uint32_t lower_lo = std::max<uint32_t>(lo, 'a'), lower_hi = std::min<uint32_t>(hi, 'z');
+        if (lower_lo <= lower_hi) ranges.emplace_back(lower_lo - 32, lower_hi - 32);
+        const uint32_t upper_lo = std::max<uint32_t>(lo, 'A'), upper_hi = std::min<uint32_t>(hi, 'Z');
+        if (upper_lo <= upper_hi) ranges.emplace_back(upper_lo + 32, upper_hi + 32);
+    }
+    normalize(ranges);
+}
+
+static Ranges digit_ranges() { return {{'0', '9'}}; }
+static Ranges word_ranges() { return {{'0', '9'}, {'A', 'Z'}, {'_', '_'}, {'a', 'z'}}; }
+static Ranges space_ranges() { return {{'\t', '\r'}, {' ', ' '}}; }
+
+// -------------------------- 解析 --------------------------
+class Parser {
+public:
+    explicit Parser(const std::string_view pattern) : p_(pattern) {}
+
+    size_t group_count = 0;
+    std::unordered_map<std::string, size_t> group_names;
+    bool has_backref = false;
+
+    NodePtr parse() {
+        parse_global_flags();
+        auto node = parse_alternate();
+        if (pos_ < p_.size()) syntax_error("unbalanced parenthesis", pos_);
+        return node;
+    }
+
+private:
+    std::string_view p_;
+    size_t pos_ = 0;
+    bool ignore_case_ = false;
+    bool dot_all_ = false;
+    // 已经闭合的组, 反向引用只能引用这些组
+    std::vector<bool> closed_;
+
+    [[nodiscard]] bool at_end() const { return pos_ >= p_.size(); }
+    [[nodiscard]] char peek() const { return p_[pos_]; }
+
+    // 只支持写在模式开头的(?i)(?s)
+    void parse_global_flags() {
+        while (p_.substr(pos_, 2) == "(?") {
+            size_t i = pos_ + 2;
+            bool i_flag = false, s_flag = false;
+            while (i < p_.size() and (p_[i] == 'i' or p_[i] == 's')) {
+                (p_[i] == 'i' ? i_flag : s_flag) = true;
+                ++i;
+            }
+            if (i == pos_ + 2 or i >= p_.size() or p_[i] != ')') return;
+            ignore_case_ |= i_flag;
+            dot_all_ |= s_flag;
+            pos_ = i + 1;
+        }
+    }
+
+    uint32_t next_codepoint() {
+        const auto c = static_cast<unsigned char>(p_[pos_++]);
+        if (c < 0x80) return c;
+        int extra = c >= 0xF0 ? 3 : c >= 0xE0 ? 2 : 1;
+        uint32_t cp = c & (0x3F >> extra);
+        while (extra-- > 0 and !at_end()) cp = (cp << 6) | (static_cast<unsigned char>(p_[pos_++]) & 0x3F);
+        return cp;
+    }
+
+    NodePtr literal(const uint32_t cp) const {
+        if (ignore_case_ and cp < 0x80 and std::isalpha(static_cast<int>(cp))) {
+            auto node = std::make_unique<Node>(Node::Kind::Class);
+            node->ranges = {{cp, cp}};
+            add_case_variants(node->ranges);
+            return node;
+        }
+        auto node = std::make_unique<Node>(Node::Kind::Literal);
+        append_utf8(node->bytes, cp);
+        return node;
+    }
+
+    NodePtr make_class(Ranges ranges, const bool negate) const {
+        normalize(ranges);
+        if (ignore_case_) add_case_variants(ranges);
+        auto node = std::make_unique<Node>(Node::Kind::Class);
+        node->ranges = negate ? complement(ranges) : std::move(ranges);
+        return node;
+    }
+
+    NodePtr make_assert(const Op op) const {
+        auto node = std::make_unique<Node>(Node::Kind::Assert);
+        node->assertion = op;
+        return node;
+    }
+
+    NodePtr parse_alternate() {
+        std::vector<NodePtr> branches;
+        branches.push_back(parse_concat());
+        while (!at_end() and peek() == '|') {
+            ++pos_;
+            branches.push_back(parse_concat());
+        }
+        if (branches.size() == 1) return std::move(branches[0]);
+        auto node = std::make_unique<Node>(Node::Kind::Alternate);
+        node->children = std::move(branches);
+        return node;
+    }
+
+    NodePtr parse_concat() {
+        auto node = std::make_unique<Node>(Node::Kind::Concat);
+        while (!at_end() and peek() != '|' and peek() != ')') {
+            auto atom = parse_atom();
+            if (atom == nullptr) continue;
+            atom = parse_quantifier(std::move(atom));
+            // 相邻的字面量合并, 便于提取前缀
+            if (atom->kind == Node::Kind::Literal and !node->children.empty()
+                and node->children.back()->kind == Node::Kind::Literal) {
+                node->children.back()->bytes += atom->bytes;
+                continue;
+            }
+            node->children.push_back(std::move(atom));
+        }
+        if (node->children.empty()) return std::make_unique<Node>(Node::Kind::Empty);
+        if (node->children.size() == 1) return std::move(node->children[0]);
+        return node;
+    }
+
+    // 解析{m}、{m,}、{,n}、{m,n}; 不是合法量词时返回false, '{'按字面量处理
+    bool parse_braces(int& min, int& max) {
+        size_t i = pos_ + 1;
+        const auto read_int = [&](int& out) {
+            const size_t begin = i;
+            long long v = 0;
+            while (i < p_.size() and std::isdigit(static_cast<unsigned char>(p_[i]))) {
+                v = std::min<long long>(v * 10 + (p_[i] - '0'), max_repeat + 1);
+                ++i;
+            }
+            out = static_cast<int>(v);
+            return i > begin;
+        };
+        const bool has_min = read_int(min);
+        if (!has_min) min = 0;
+        if (i < p_.size() and p_[i] == '}') {
+            if (!has_min) return false;
+            max = min;
+        } else if (i < p_.size() and p_[i] == ',') {
+            ++i;
+            if (!read_int(max)) max = -1;
+            if (i >= p_.size() or p_[i] != '}') return false;
+        } else {
+            return false;
+        }
+        if (min > max_repeat or max > max_repeat) syntax_error("the repetition number is too large", pos_);
+        if (max != -1 and min > max) syntax_error("min repeat greater than max repeat", pos_);
+        pos_ = i + 1;
+        return true;
+    }
+
+    NodePtr parse_quantifier(NodePtr atom) {
+        if (at_end()) return atom;
+        int min, max;
+        const size_t start = pos_;
+        switch (peek()) {
+        case '*': min = 0; max = -1; ++pos_; break;
+        case '+': min = 1; max = -1; ++pos_; break;
+        case '?': min = 0; max = 1; ++pos_; break;
+        case '{':
+            if (!parse_braces(min, max)) return atom;
+            break;
+        default: return atom;
+        }
+        if (atom->kind == Node::Kind::Assert) syntax_error("nothing to repeat", start);
+        auto node = std::make_unique<Node>(Node::Kind::Repeat);
+        node->min = min;
+        node->max = max;
+        if (!at_end() and peek() == '?') {
+            node->greedy = false;
+            ++pos_;
+        }
+        if (!at_end() and (peek() == '*' or peek() == '+' or peek() == '?' or peek() == '{')) {
+            int m1, m2;
+            const size_t save = pos_;
+            if (peek() != '{' or parse_braces(m1, m2)) syntax_error("multiple repeat", save);
+        }
+        node->children.push_back(std::move(atom));
+        return node;
+    }
+
+    NodePtr parse_group() {
+        const size_t start = pos_;
+        ++pos_;  // '('
+        size_t index = 0;
+        if (p_.substr(pos_, 1) == "?") {
+            const auto rest = p_.substr(pos_);
+            if (rest.starts_with("?:")) {
+                pos_ += 2;
+            } else if (rest.starts_with("?P<")) {
+                const size_t close = p_.find('>', pos_ + 3);
+                if (close == std::string_view::npos) syntax_error("missing >, unterminated name", pos_);
+                const std::string name(p_.substr(pos_ + 3, close - pos_ - 3));
+                if (name.empty() or std::isdigit(static_cast<unsigned char>(name[0]))) {
+                    syntax_error("bad character in group name '" + name + "'", pos_);
+                }
+                if (group_names.contains(name)) syntax_error("redefinition of group name '" + name + "'", pos_);
+                pos_ = close + 1;
+                index = ++group_count;
+                group_names[name] = index;
+            } else if (rest.starts_with("?P=")) {
+                const size_t close = p_.find(')', pos_ + 3);
+                if (close == std::string_view::npos) syntax_error("missing ), unterminated name", pos_);
+                const std::string name(p_.substr(pos_ + 3, close - pos_ - 3));
+                const auto it = group_names.find(name);
+                if (it == group_names.end()) syntax_error("unknown group name '" + name + "'", pos_);
+                pos_ = close + 1;
+                return make_backref(it->second, start);
+            } else if (rest.starts_with("?#")) {
+                const size_t close = p_.find(')', pos_);
+                if (close == std::string_view::npos) syntax_error("missing ), unterminated comment", pos_);
+                pos_ = close + 1;
+                return nullptr;
+            } else if (rest.starts_with("?=") or rest.starts_with("?!") or rest.starts_with("?<")) {
+                syntax_error("lookaround assertions are not supported", start);
+            } else {
+                syntax_error("unknown extension or misplaced flags", start);
+            }
+        } else {
+            index = ++group_count;
+        }
+
+        auto child = parse_alternate();
+        if (at_end() or peek() != ')') syntax_error("missing ), unterminated subpattern", start);
+        ++pos_;
+        if (index == 0) return child;
+
+        if (closed_.size() <= index) closed_.resize(index + 1, false);
+        closed_[index] = true;
+        auto node = std::make_unique<Node>(Node::Kind::Capture);
+        node->index = index;
+        node->children.push_back(std::move(child));
+        return node;
+    }
+
+    NodePtr make_backref(const size_t group, const size_t at) {
+        if (group >= closed_.size() or !closed_[group]) syntax_error("invalid group reference " + std::to_string(group), at);
+        has_backref = true;
+        auto node = std::make_unique<Node>(Node::Kind::Backref);
+        node->index = group;
+        return node;
+    }
+
+    uint32_t parse_hex(const size_t digits) {
+        if (pos_ + digits > p_.size()) syntax_error("incomplete escape", pos_);
+        uint32_t cp = 0;
+        for (size_t i = 0; i < digits; ++i) {
+            const char c = p_[pos_++];
+            cp <<= 4;
+            if (c >= '0' and c <= '9') cp |= c - '0';
+            else if (c >= 'a' and c <= 'f') cp |= c - 'a' + 10;
+            else if (c >= 'A' and c <= 'F') cp |= c - 'A' + 10;
+            else syntax_error("incomplete escape", pos_);
+        }
+        if (cp > max_codepoint) syntax_error("bad escape", pos_);
+        return cp;
+    }
+
+    // 转义为单个字符时返回true并写出码点; 字符类转义写出区间
+    bool parse_escape_char(uint32_t& cp, Ranges& ranges, bool& is_class) {
+        if (at_end()) syntax_error("bad escape (end of pattern)", pos_);
+        is_class = false;
+        const char c = p_[pos_++];
+        switch (c) {
+        case 'd': ranges = digit_ranges(); is_class = true; return false;
+        case 'D': ranges = complement(digit_ranges()); is_class = true; return false;
+        case 'w': ranges = word_ranges(); is_class = true; return false;
+        case 'W': ranges = complement(word_ranges()); is_class = true; return false;
+        case 's': ranges = space_ranges(); is_class = true; return false;
+        case 'S': ranges = complement(space_ranges()); is_class = true; return false;
+        case 'n': cp = '\n'; return true;
+        case 't': cp = '\t'; return true;
+        case 'r': cp = '\r'; return true;
+        case 'f': cp = '\f'; return true;
+        case 'v': cp = '\v'; return true;
+        case 'a': cp = '\a'; return true;
+        case '0': cp = 0; return true;
+        case 'x': cp = parse_hex(2); return true;
+        case 'u': cp = parse_hex(4); return true;
+        case 'U': cp = parse_hex(8); return true;
+        default:
+            if (std::isalnum(static_cast<unsigned char>(c))) {
+                --pos_;
+                return false;
+            }
+            --pos_;
+            cp = next_codepoint();
+            return true;
+        }
+    }
+
+    NodePtr parse_escape() {
+        const size_t start = pos_;
+        ++pos_;  // '\\'
+        if (at_end()) syntax_error("bad escape (end of pattern)", start);
+        const char c = peek();
+        switch (c) {
+        case 'b': ++pos_; return make_assert(Op::WordBoundary);
+        case 'B': ++pos_; return make_assert(Op::NotWordBoundary);
+        case 'A': ++pos_; return make_assert(Op::AssertBegin);
+        case 'Z': ++pos_; return make_assert(Op::AssertTextEnd);
+        default: break;
+        }
+        if (c >= '1' and c <= '9') {
+            size_t group = 0;
+            while (!at_end() and std::isdigit(static_cast<unsigned char>(peek())) and group < 10) {
+                group = group * 10 + (p_[pos_++] - '0');
+            }
+            return make_backref(group, start);
+        }
+        uint32_t cp;
+        Ranges ranges;
+        bool is_class;
+        if (parse_escape_char(cp, ranges, is_class)) return literal(cp);
+        if (is_class) return make_class(std::move(ranges), false);
+        syntax_error(std::string("bad escape \\") + c, start);
+    }
+
+    NodePtr parse_class() {
+        const size_t start = pos_;
+        ++pos_;  // '['
+        bool negate = false;
+        if (!at_end() and peek() == '^') {
+            negate = true;
+            ++pos_;
+        }
+        Ranges ranges;
+        bool first = true;
+        while (true) {
+            if (at_end()) syntax_error("unterminated character set", start);
+            if (peek() == ']' and !first) {
+                ++pos_;
+                break;
+            }
+            first = false;
+
+            uint32_t lo;
+            if (peek() == '\\') {
+                ++pos_;
+                Ranges escaped;
+                bool is_class;
+                if (!parse_escape_char(lo, escaped, is_class)) {
+                    if (!is_class) syntax_error(std::string("bad escape \\") + peek(), pos_ - 1);
+                    ranges.insert(ranges.end(), escaped.begin(), escaped.end());
+                    continue;
+                }
+            } else {
+                lo = next_codepoint();
+            }
+
+            // a-b区间; '-'在末尾时按字面量处理
+            if (pos_ + 1 < p_.size() and peek() == '-' and p_[pos_ + 1] != ']') {
+                ++pos_;
+                uint32_t hi;
+                if (peek() == '\\') {
+                    ++pos_;
+                    Ranges escaped;
+                    bool is_class;
+                    if (!parse_escape_char(hi, escaped, is_class)) syntax_error("bad character range", pos_);
+                } else {
+                    hi = next_codepoint();
+                }
+                if (hi < lo) syntax_error("bad character range", pos_);
+                ranges.emplace_back(lo, hi);
+            } else {
+                ranges.emplace_back(lo, lo);
+            }
+        }
+        return make_class(std::move(ranges), negate);
+    }
+
+    NodePtr parse_atom() {
+        const size_t start = pos_;
+        switch (peek()) {
+        case '(': return parse_group();
+        case '[': return parse_class();
+        case '\\': return parse_escape();
+        case '.': {
+            ++pos_;
+            Ranges ranges{{0, max_codepoint}};
+            if (!dot_all_) ranges = {{0, '\n' - 1}, {'\n' + 1, max_codepoint}};
+            auto node = std::make_unique<Node>(Node::Kind::Class);
+            node->ranges = std::move(ranges);
+            return node;
+        }
+        case '^': ++pos_; return make_assert(Op::AssertBegin);
+        case '$': ++pos_; return make_assert(Op::AssertEnd);
+        case '*': case '+': case '?':
+            syntax_error("nothing to repeat", start);
+        case '{': {
+            int min, max;
+            const size_t save = pos_;
+            if (parse_braces(min, max)) syntax_error("nothing to repeat", save);
+            ++pos_;
+            return literal('{');
+        }
+        default:
+            return literal(next_codepoint());
+        }
+    }
+};
+
+// -------------------------- 编译 --------------------------
+// 把码点区间拆成若干UTF-8字节序列, 每个序列逐字节给出取值区间
+static void utf8_sequences(const uint32_t lo, const uint32_t hi, std::vector<std::vector<std::pair<uint8_t, uint8_t>>>& out) {
+    // 先按编码长度切分
+    for (const uint32_t limit : {0x7Fu, 0x7FFu, 0xFFFFu}) {
+        if (lo <= limit and hi > limit) {
+            utf8_sequences(lo, limit, out);
+            utf8_sequences(limit + 1, hi, out);
+            return;
+        }
+    }
+    if (hi <= 0x7F) {
+        out.push_back({{static_cast<uint8_t>(lo), static_cast<uint8_t>(hi)}});
+        return;
+    }
+    // 再切分到每个后续字节都覆盖完整或相同的区间
+    for (int i = 1; i < 4; ++i) {
+        const uint32_t m = (1u << (6 * i)) - 1;
+        if ((lo & ~m) != (hi & ~m)) {
+            if ((lo & m) != 0) {
+                utf8_sequences(lo, lo | m, out);
+                utf8_sequences((lo | m) + 1, hi, out);
+                return;
+            }
+            if ((hi & m) != m) {
+                utf8_sequences(lo, (hi & ~m) - 1, out);
+                utf8_sequences(hi & ~m, hi, out);
+                return;
+            }
+        }
+    }
+    std::string a, b;
+    append_utf8(a, lo);
+    append_utf8(b, hi);
+    std::vector<std::pair<uint8_t, uint8_t>> seq;
+    for (size_t i = 0; i < a.size(); ++i) seq.emplace_back(a[i], b[i]);
+    out.push_back(std::move(seq));
+}
+
+// 以后继续接的方式自后向前生成: emit(node, next)返回node的入口
+class Compiler {
+public:
+    Compiler(Program& prog, const bool reverse) : prog_(prog), reverse_(reverse) {}
+
+    uint32_t add(const Inst& inst) {
+        if (prog_.insts.size() >= max_insts) throw NativeFuncError("ReError", "pattern too large");
+        prog_.insts.push_back(inst);
+        return static_cast<uint32_t>(prog_.insts.size() - 1);
+    }
+
+    uint32_t emit(const Node& node, uint32_t next) {
+        switch (node.kind) {
+        case Node::Kind::Empty: return next;
+        case Node::Kind::Literal: return emit_bytes(node.bytes, next);
+        case Node::Kind::Class: return emit_class(node.ranges, next);
+        case Node::Kind::Concat:
+            if (reverse_) {
+                for (const auto& child : node.children) next = emit(*child, next);
+            } else {
+                for (auto it = node.children.rbegin(); it != node.children.rend(); ++it) next = emit(**it, next);
+            }
+            return next;
+        case Node::Kind::Alternate: {
+            std::vector<uint32_t> entries;
+            for (const auto& child : node.children) entries.push_back(emit(*child, next));
+            uint32_t entry = entries.back();
+            for (size_t i = entries.size() - 1; i-- > 0;) entry = add({Op::Split, 0, 0, entries[i], entry});
+            return entry;
+        }
+        case Node::Kind::Repeat: return emit_repeat(node, next);
+        case Node::Kind::Capture: {
+            // 逆序程序只求匹配起点, 不记录捕获
+            if (reverse_) return emit(*node.children[0], next);
+            const auto slot = static_cast<uint32_t>(node.index * 2);
+            const uint32_t end = add({Op::Save, 0, 0, next, slot + 1});
+            return add({Op::Save, 0, 0, emit(*node.children[0], end), slot});
+        }
+        case Node::Kind::Assert: return add({node.assertion, 0, 0, next, 0});
+        case Node::Kind::Backref: return add({Op::Backref, 0, 0, next, static_cast<uint32_t>(node.index)});
+        }
+        return next;
+    }
+
+private:
+    Program& prog_;
+    bool reverse_;
+
+    uint32_t emit_bytes(const std::string& bytes, uint32_t next) {
+        const auto emit_byte = [&](const char b) {
+            const auto v = static_cast<uint8_t>(b);
+            next = add({Op::ByteRange, v, v, next, 0});
+        };
+        if (reverse_) std::for_each(bytes.begin(), bytes.end(), emit_byte);
+        else std::for_each(bytes.rbegin(), bytes.rend(), emit_byte);
+        return next;
+    }
+
+    uint32_t emit_class(const Ranges& ranges, const uint32_t next) {
+        std::vector<std::vector<std::pair<uint8_t, uint8_t>>> seqs;
+        for (const auto& [lo, hi] : ranges) utf8_sequences(lo, hi, seqs);
+        // 空字符类永远不匹配
+        if (seqs.empty()) return add({Op::ByteRange, 1, 0, next, 0});
+
+        std::vector<uint32_t> entries;
+        for (const auto& seq : seqs) {
+            uint32_t entry = next;
+            const auto emit_range = [&](const std::pair<uint8_t, uint8_t>& r) {
+                entry = add({Op::ByteRange, r.first, r.second, entry, 0});
+            };
+            if (reverse_) std::for_each(seq.begin(), seq.end(), emit_range);
+            else std::for_each(seq.rbegin(), seq.rend(), emit_range);
+            entries.push_back(entry);
+        }
+        uint32_t entry = entries.back();
+        for (size_t i = entries.size() - 1; i-- > 0;) entry = add({Op::Split, 0, 0, entries[i], entry});
+        return entry;
+    }
+
+    // 循环体结束后经again回到loop; 本轮是空匹配时loop已访问过, 由again退出循环,
+    // 优先级与re模块一致(如 (a??)* 在"ab"开头匹配空串)
+    uint32_t emit_star(const Node& body, const bool greedy, const uint32_t next) {
+        const uint32_t loop = add({Op::Split});
+        const uint32_t again = add(greedy ? Inst{Op::Split, 0, 0, loop, next} : Inst{Op::Split, 0, 0, next, loop});
+        const uint32_t entry = emit(body, again);
+        prog_.insts[loop].x = greedy ? entry : next;
+        prog_.insts[loop].y = greedy ? next : entry;
+        return loop;
+    }
+
+    uint32_t emit_optional(const Node& body, const bool greedy, const uint32_t rest, const uint32_t exit) {
+        const uint32_t entry = emit(body, rest);
+        return greedy ? add({Op::Split, 0, 0, entry, exit}) : add({Op::Split, 0, 0, exit, entry});
+    }
+
+    // x{m,n}: m个必需的x之后接嵌套的可选部分(x(x(x)?)?)?
+    uint32_t emit_repeat(const Node& node, const uint32_t next) {
+        const Node& body = *node.children[0];
+        uint32_t tail = next;
+        if (node.max == -1) {
+            tail = emit_star(body, node.greedy, next);
+        } else {
+            for (int i = node.min; i < node.max; ++i) tail = emit_optional(body, node.greedy, tail, next);
+        }
+        for (int i = 0; i < node.min; ++i) tail = emit(body, tail);
+        return tail;
+    }
+};
+
+// -------------------------- DFA --------------------------
+Dfa::Dfa(const Program& prog, const std::vector<uint8_t>& byte_class, const size_t class_count,
+         const bool reverse, const bool longest)
+    : prog_(prog), byte_class_(byte_class), stride_(class_count + 1), reverse_(reverse), longest_(longest) {
+    mark_.assign(prog.insts.size(), 0);
+    for (const auto& inst : prog.insts) {
+        if (inst.op == Op::AssertEnd) has_dollar_ = true;
+    }
+}
+
+int32_t Dfa::intern(const std::vector<uint32_t>& insts, const uint8_t flags, const bool match) {
+    std::string key;
+    key.reserve(2 + insts.size() * sizeof(uint32_t));
+    key += static_cast<char>(flags);
+    key += static_cast<char>(match);
+    key.append(reinterpret_cast<const char*>(insts.data()), insts.size() * sizeof(uint32_t));
+    if (const auto it = index_.find(key); it != index_.end()) return it->second;
+
+    if (states_.size() >= max_states) return overflow;
+    const auto id = static_cast<int32_t>(states_.size());
+    states_.push_back(State{insts, flags, match});
+    trans_.resize(states_.size() * stride_, unknown);
+    index_.emplace(std::move(key), id);
+    return id;
+}
+
+int32_t Dfa::start_state(const uint8_t flags) {
+    const int32_t s = intern({prog_.start}, flags, false);
+    if (s >= 0) states_[s].start = true;
+    return s;
+}
+
+int32_t Dfa::step(const int32_t s, const int c, const bool special) {
+    const uint8_t flags = states_[s].flags;
+    const bool boundary = c == 256;
+    const bool c_word = !boundary and is_word_byte(static_cast<unsigned char>(c));
+
+    Context ctx;
+    if (!reverse_) {
+        ctx.begin = flags & flag_begin;
+        ctx.left_word = flags & flag_word;
+        ctx.right_word = c_word;
+        ctx.dollar = boundary or special;
+        ctx.text_end = boundary;
+    } else {
+        ctx.begin = boundary;
+        ctx.left_word = c_word;
+        ctx.right_word = flags & flag_word;
+        ctx.dollar = flags & flag_dollar;
+        ctx.text_end = flags & flag_text_end;
+    }
+
+    // 按优先级顺序求闭包; 最左优先时遇到Match即舍弃其后优先级更低的线程
+    closure_.clear();
+    bool matched = false;
+    ++generation_;
+    for (const uint32_t root : states_[s].insts) {
+        stack_.push_back(root);
+        while (!stack_.empty()) {
+            const uint32_t pc = stack_.back();
+            stack_.pop_back();
+            if (mark_[pc] == generation_) continue;
+            mark_[pc] = generation_;
+            const Inst& inst = prog_.insts[pc];
+            switch (inst.op) {
+            case Op::ByteRange: closure_.push_back(pc); break;
+            case Op::Match:
+                matched = true;
+                if (!longest_) {
+                    stack_.clear();
+                    goto done;
+                }
+                break;
+            case Op::Split:
+                stack_.push_back(inst.y);
+                stack_.push_back(inst.x);
+                break;
+            case Op::Jmp:
+            case Op::Save: stack_.push_back(inst.x); break;
+            case Op::AssertBegin: if (ctx.begin) stack_.push_back(inst.x); break;
+            case Op::AssertEnd: if (ctx.dollar) stack_.push_back(inst.x); break;
+            case Op::AssertTextEnd: if (ctx.text_end) stack_.push_back(inst.x); break;
+            case Op::WordBoundary: if (ctx.left_word != ctx.right_word) stack_.push_back(inst.x); break;
+            case Op::NotWordBoundary: if (ctx.left_word == ctx.right_word) stack_.push_back(inst.x); break;
+            case Op::Backref: break;
+            }
+        }
+    }
+done:
+
+    next_.clear();
+    if (!boundary) {
+        ++generation_;
+        const auto byte = static_cast<uint8_t>(c);
+        for (const uint32_t pc : closure_) {
+            const Inst& inst = prog_.insts[pc];
+            if (inst.lo <= byte and byte <= inst.hi and mark_[inst.x] != generation_) {
+                mark_[inst.x] = generation_;
+                next_.push_back(inst.x);
+            }
+        }
+    }
+
+    const int32_t t = intern(next_, c_word ? flag_word : 0, matched);
+    if (!special and t >= 0) {
+        trans_[static_cast<size_t>(s) * stride_ + (boundary ? stride_ - 1 : byte_class_[c])] = t;
+    }
+    return t;
+}
+
+int64_t Dfa::scan_forward(const std::string_view text, const size_t from, const std::string_view prefix) {
+    const size_t n = text.size();
+    const auto flags_at = [&](const size_t p) -> uint8_t {
+        if (p == 0) return flag_begin;
+        return is_word_byte(static_cast<unsigned char>(text[p - 1])) ? flag_word : 0;
+    };
+
+    int32_t s = start_state(flags_at(from));
+    if (s < 0) return overflow;
+    int64_t end = -1;
+    for (size_t p = from; p < n; ++p) {
+        // 起始状态下没有进行中的线程, 匹配必然从前缀的下一次出现处开始
+        if (!prefix.empty() and states_[s].start) {
+            const size_t next = dep::str_find(text, prefix, p);
+            if (next == std::string_view::npos) return end;
+            if (next != p) {
+                p = next;
+                s = start_state(flags_at(p));
+                if (s < 0) return overflow;
+            }
+        }
+        const auto c = static_cast<unsigned char>(text[p]);
+        const int32_t t = has_dollar_ and c == '\n' and p == n - 1 ? step(s, c, true) : transition(s, c);
+        if (t < 0) return overflow;
+        if (states_[t].match) end = static_cast<int64_t>(p);
+        if (states_[t].insts.empty()) return end;
+        s = t;
+    }
+    const int32_t t = transition(s, 256);
+    if (t < 0) return overflow;
+    if (states_[t].match) end = static_cast<int64_t>(n);
+    return end;
+}
+
+int64_t Dfa::scan_reverse(const std::string_view text, const size_t from, const size_t end) {
+    const size_t n = text.size();
+    uint8_t flags = 0;
+    if (end < n and is_word_byte(static_cast<unsigned char>(text[end]))) flags |= flag_word;
+    if (end == n or (end == n - 1 and text[end] == '\n')) flags |= flag_dollar;
+    if (end == n) flags |= flag_text_end;
+
+    int32_t s = start_state(flags);
+    if (s < 0) return overflow;
+    int64_t start = -1;
+    for (size_t p = end; p > from; --p) {
+        const int32_t t = transition(s, static_cast<unsigned char>(text[p - 1]));
+        if (t < 0) return overflow;
+        if (states_[t].match) start = static_cast<int64_t>(p);
+        if (states_[t].insts.empty()) return start;
+        s = t;
+    }
+    // 在from处以左侧字符(或文本开头)求最后一次闭包
+    const int32_t t = transition(s, from == 0 ? 256 : static_cast<unsigned char>(text[from - 1]));
+    if (t < 0) return overflow;
+    if (states_[t].match) start = static_cast<int64_t>(from);
+    return start;
+}
+
+// -------------------------- Regex --------------------------
+// 断言后若还能读入字节, 则其真假依赖更远的上下文, DFA无法按单个字节缓存
+static bool end_assertions_are_final(const Program& prog) {
+    std::vector<uint8_t> seen(prog.insts.size());
+    std::vector<uint32_t> stack;
+    for (const auto& inst : prog.insts) {
+        if (inst.op != Op::AssertEnd and inst.op != Op::AssertTextEnd) continue;
+        std::fill(seen.begin(), seen.end(), 0);
+        stack.assign(1, inst.x);
+        while (!stack.empty()) {
+            const uint32_t pc = stack.back();
+            stack.pop_back();
+            if (seen[pc]) continue;
+            seen[pc] = 1;
+            const Inst& next = prog.insts[pc];
+            switch (next.op) {
+            case Op::ByteRange:
+            case Op::Backref: return false;
+            case Op::Match: break;
+            case Op::Split:
+                stack.push_back(next.x);
+                stack.push_back(next.y);
+                break;
+            default: stack.push_back(next.x);
+            }
+        }
+    }
+    return true;
+}
+
+Regex::Regex(const std::string_view pattern, const bool full) {
+    Parser parser(pattern);
+    auto root = parser.parse();
+    group_count_ = parser.group_count;
+    group_names_ = std::move(parser.group_names);
+    has_backref_ = parser.has_backref;
+
+    if (full) {
+        auto concat = std::make_unique<Node>(Node::Kind::Concat);
+        concat->children.push_back(std::move(root));
+        auto text_end = std::make_unique<Node>(Node::Kind::Assert);
+        text_end->assertion = Op::AssertTextEnd;
+        concat->children.push_back(std::move(text_end));
+        root = std::move(concat);
+    }
+
+    // 开头的字面量用于快速定位候选位置, 开头的^说明只能在文本开头匹配
+    const Node* first = root.get();
+    if (first->kind == Node::Kind::Concat) first = first->children[0].get();
+    if (first->kind == Node::Kind::Literal) prefix_ = first->bytes;
+    begin_anchored_ = first->kind == Node::Kind::Assert and first->assertion == Op::AssertBegin;
+
+    // 第0组即整个匹配
+    {
+        Compiler compiler(forward_, false);
+        const uint32_t match = compiler.add({Op::Match});
+        const uint32_t save_end = compiler.add({Op::Save, 0, 0, match, 1});
+        const uint32_t body = compiler.emit(*root, save_end);
+        forward_.start = compiler.add({Op::Save, 0, 0, body, 0});
+    }
+
+    dfa_ok_ = !has_backref_ and end_assertions_are_final(forward_);
+    if (!dfa_ok_) return;
+
+    unanchored_ = forward_;
+    {
+        Compiler compiler(unanchored_, false);
+        const uint32_t loop = compiler.add({Op::Split});
+        const uint32_t any = compiler.add({Op::ByteRange, 0, 255, loop, 0});
+        unanchored_.insts[loop].x = forward_.start;
+        unanchored_.insts[loop].y = any;
+        unanchored_.start = loop;
+    }
+    {
+        Compiler compiler(reverse_, true);
+        const uint32_t match = compiler.add({Op::Match});
+        reverse_.start = compiler.emit(*root, match);
+    }
+
+    // 把取值区间边界相同的字节归为一类, 缩小转移表; 单词字符与换行影响断言, 也须单独成类
+    std::vector<bool> boundary(257, false);
+    const auto mark_range = [&](const unsigned lo, const unsigned hi) {
+        boundary[lo] = true;
+        boundary[hi + 1] = true;
+    };
+    for (const auto& inst : forward_.insts) {
+        if (inst.op == Op::ByteRange and inst.lo <= inst.hi) mark_range(inst.lo, inst.hi);
+    }
+    mark_range('0', '9');
+    mark_range('A', 'Z');
+    mark_range('_', '_');
+    mark_range('a', 'z');
+    mark_range('\n', '\n');
+    byte_class_.assign(256, 0);
+    size_t cls = 0;
+    for (size_t c = 0; c < 256; ++c) {
+        if (c > 0 and boundary[c]) ++cls;
+        byte_class_[c] = static_cast<uint8_t>(cls);
+    }
+    class_count_ = cls + 1;
+}
+
+bool Regex::search(const std::string_view text, const size_t from, bool anchored,
+                   std::vector<int64_t>& caps, const bool need_groups) {
+    caps.assign((group_count_ + 1) * 2, -1);
+    if (from > text.size()) return false;
+    if (begin_anchored_) {
+        if (from > 0) return false;
+        anchored = true;
+    }
+    if (!dfa_ok_) return backtrack(text, from, anchored, caps);
+
+    // 先用正向DFA求终点, 再用逆向DFA从终点往回求起点
+    auto& dfa = anchored ? dfa_forward_ : dfa_unanchored_;
+    if (dfa == nullptr) {
+        dfa = std::make_unique<Dfa>(anchored ? forward_ : unanchored_, byte_class_, class_count_, false, false);
+    }
+    const int64_t end = dfa->scan_forward(text, from, anchored ? std::string_view() : std::string_view(prefix_));
+    if (end == Dfa::overflow) return backtrack(text, from, anchored, caps);
+    if (end < 0) return false;
+
+    int64_t start = static_cast<int64_t>(from);
+    if (!anchored) {
+        if (dfa_reverse_ == nullptr) {
+            dfa_reverse_ = std::make_unique<Dfa>(reverse_, byte_class_, class_count_, true, true);
+        }
+        start = dfa_reverse_->scan_reverse(text, from, static_cast<size_t>(end));
+        if (start == Dfa::overflow) return backtrack(text, from, anchored, caps);
+    }
+    if (need_groups and group_count_ > 0) {
+        // 起点已知, 在该处回溯一次求出各组位置
+        return backtrack(text, static_cast<size_t>(start), true, caps);
+    }
+    caps[0] = start;
+    caps[1] = end;
+    return true;
+}
+
+bool Regex::match_nonempty(const std::string_view text, const size_t from, std::vector<int64_t>& caps) {
+    caps.assign((group_count_ + 1) * 2, -1);
+    if (from > text.size() or (begin_anchored_ and from > 0)) return false;
+    std::unordered_set<uint64_t> visited;
+    size_t steps = 0;
+    return backtrack_at(text, from, caps, visited, steps, true);
+}
+
+bool Regex::backtrack(const std::string_view text, size_t from, const bool anchored, std::vector<int64_t>& caps) {
+    // 无反向引用时(pc, pos)失败与否与捕获无关, 访问表可在各起点间共享
+    std::unordered_set<uint64_t> visited;
+    size_t steps = 0;
+    for (size_t pos = from; pos <= text.size(); ++pos) {
+        if (!anchored and !prefix_.empty()) {
+            pos = dep::str_find(text, prefix_, pos);
+            if (pos == std::string_view::npos) return false;
+        }
+        if (backtrack_at(text, pos, caps, visited, steps)) return true;
+        if (anchored) break;
+    }
+    return false;
+}
+
+bool Regex::backtrack_at(const std::string_view text, const size_t pos, std::vector<int64_t>& caps,
+                         std::unordered_set<uint64_t>& visited, size_t& steps, const bool not_empty) {
+    struct Job {
+        uint32_t pc;
+        size_t pos;
+        int64_t slot;   // 非负时表示回退时恢复该捕获槽
+        int64_t old;
+    };
+    const size_t n = text.size();
+    const bool memo = !has_backref_;
+    std::vector<Job> stack{{forward_.start, pos, -1, 0}};
+
+    while (!stack.empty()) {
+        const Job job = stack.back();
+        stack.pop_back();
+        if (job.slot >= 0) {
+            caps[job.slot] = job.old;
+            continue;
+        }
+        uint32_t pc = job.pc;
+        size_t p = job.pos;
+        while (true) {
+            if (memo) {
+                if (!visited.insert(static_cast<uint64_t>(pc) * (n + 1) + p).second) break;
+            } else if (++steps > max_backtrack_steps) {
+                throw NativeFuncError("ReError", "backtracking limit exceeded");
+            }
+            const Inst& inst = forward_.insts[pc];
+            bool ok = true;
+            switch (inst.op) {
+            case Op::ByteRange: {
+                ok = p < n and inst.lo <= static_cast<uint8_t>(text[p]) and static_cast<uint8_t>(text[p]) <= inst.hi;
+                if (ok) ++p;
+                break;
+            }
+            case Op::Split:
+                stack.push_back({inst.y, p, -1, 0});
+                break;
+            case Op::Jmp: break;
+            case Op::Save:
+                stack.push_back({0, 0, inst.y, caps[inst.y]});
+                caps[inst.y] = static_cast<int64_t>(p);
+                break;
+            case Op::Match:
+                if (!not_empty or p != pos) return true;
+                ok = false;
+                break;
+            case Op::AssertBegin: ok = p == 0; break;
+            case Op::AssertEnd: ok = p == n or (p == n - 1 and text[p] == '\n'); break;
+            case Op::AssertTextEnd: ok = p == n; break;
+            case Op::WordBoundary:
+            case Op::NotWordBoundary: {
+                const bool left = p > 0 and is_word_byte(static_cast<unsigned char>(text[p - 1]));
+                const bool right = p < n and is_word_byte(static_cast<unsigned char>(text[p]));
+                ok = (left != right) == (inst.op == Op::WordBoundary);
+                break;
+            }
+            case Op::Backref: {
+                // 引用未参与匹配的组时失败
+                const int64_t b = caps[inst.y * 2], e = caps[inst.y * 2 + 1];
+                ok = b >= 0 and e >= 0;
+                if (ok) {
+                    const auto len = static_cast<size_t>(e - b);
+                    ok = text.substr(p, len) == text.substr(static_cast<size_t>(b), len) and p + len <= n;
+                    if (ok) p += len;
+                }
+                break;
+            }
+            }
+            if (!ok) break;
+            pc = inst.x;
+        }
+    }
+    return false;
+}
+
+}
@@ -0,0 +1,453 @@
+#include "include/re_lib.hpp"
+#include <list>
+
+#include "builtins/include/builtin_functions.hpp"
+#include "builtins/include/builtin_methods.hpp"
+
+namespace re_lib {
+
+// -------------------------- 模式缓存 --------------------------
+// 按模式串缓存编译结果, 超出容量时淘汰最久未使用的
+constexpr size_t cache_capacity = 128;
+static std::list<Pattern*> lru_;
+static std::unordered_map<std::string, std::list<Pattern*>::iterator> cache_;
+
+static Pattern* get_pattern(model::Object* obj) {
+    if (const auto pattern = dynamic_cast<Pattern*>(obj)) return pattern;
+    const auto source = dynamic_cast<model::String*>(obj);
+    if (source == nullptr) throw NativeFuncError("TypeError", "re pattern must be Str or Pattern");
+
+    const auto& key = source->val();
+    if (const auto it = cache_.find(key); it != cache_.end()) {
+        lru_.splice(lru_.begin(), lru_, it->second);
+        return *it->second;
+    }
+    const auto pattern = new Pattern(key);
+    pattern->make_ref();
+    lru_.push_front(pattern);
+    cache_[key] = lru_.begin();
+    if (lru_.size() > cache_capacity) {
+        const auto oldest = lru_.back();
+        cache_.erase(oldest->source);
+        lru_.pop_back();
+        oldest->del_ref();
+    }
+    return pattern;
+}
+
+// -------------------------- 辅助函数 --------------------------
+static model::String* str_arg(const model::List* args, const size_t pos, const std::string& func) {
+    const auto str = args->val.size() > pos ? dynamic_cast<model::String*>(args->val[pos]) : nullptr;
+    if (str == nullptr) throw NativeFuncError("TypeError", "re." + func + " need a Str argument");
+    return str;
+}
+
+static size_t count_arg(const model::List* args, const size_t pos, const std::string& func) {
+    if (args->val.size() <= pos) return 0;
+    const auto count = dynamic_cast<model::Int*>(args->val[pos]);
+    int64_t v;
+    if (count == nullptr or !count->val.to_int64(v)) {
+        throw NativeFuncError("TypeError", "re." + func + " count must be an Int");
+    }
+    return v > 0 ? static_cast<size_t>(v) : 0;
+}
+
+static Pattern* self_pattern(model::Object* self, const std::string& method) {
+    const auto pattern = dynamic_cast<Pattern*>(self);
+    if (pattern == nullptr) {
+        throw NativeFuncError("TypeError", "Pattern." + method + " must be called by Pattern object");
+    }
+    return pattern;
+}
+
+static Match* self_match(model::Object* self, const std::string& method) {
+    const auto match = dynamic_cast<Match*>(self);
+    if (match == nullptr) {
+        throw NativeFuncError("TypeError", "Match." + method + " must be called by Match object");
+    }
+    return match;
+}
+
+// 字节偏移转为字符下标
+static int64_t char_index(const std::string_view text, const int64_t offset) {
+    if (offset < 0) return -1;
+    int64_t count = 0;
+    for (size_t i = 0; i < static_cast<size_t>(offset); ++i) {
+        count += (static_cast<unsigned char>(text[i]) & 0xC0) != 0x80;
+    }
+    return count;
+}
+
+static size_t next_char(const std::string_view text, size_t pos) {
+    ++pos;
+    while (pos < text.size() and (static_cast<unsigned char>(text[pos]) & 0xC0) == 0x80) ++pos;
+    return pos;
+}
+
+// 依次找出不重叠的匹配; 紧跟在空匹配之后的查找先在同一位置找非空匹配, 没有时从下一个字符开始
+// (同Python 3.7起的re: findall("a??", "abca")为['', 'a', '', '', '', 'a', ''])
+template <typename F>
+static void for_each_match(Regex& regex, const std::string_view text, const bool need_groups, const size_t limit, F&& f) {
+    std::vector<int64_t> caps;
+    size_t pos = 0;
+    size_t count = 0;
+    bool must_advance = false;
+    while (pos <= text.size() and (limit == 0 or count < limit)) {
+        if (must_advance) {
+            if (!regex.match_nonempty(text, pos, caps)) {
+                if (pos >= text.size()) return;
+                if (!regex.search(text, next_char(text, pos), false, caps, need_groups)) return;
+            }
+        } else if (!regex.search(text, pos, false, caps, need_groups)) {
+            return;
+        }
+        f(caps);
+        ++count;
+        must_advance = caps[0] == caps[1];
+        pos = static_cast<size_t>(caps[1]);
+    }
+}
+
+static std::string group_str(const std::string_view text, const std::vector<int64_t>& caps, const size_t i) {
+    if (caps[i * 2] < 0) return {};
+    return std::string(text.substr(static_cast<size_t>(caps[i * 2]), static_cast<size_t>(caps[i * 2 + 1] - caps[i * 2])));
+}
+
+// 组号参数: 缺省为0, 可用Int或组名
+static size_t group_arg(const Match* match, const model::List* args) {
+    if (args->val.empty()) return 0;
+    if (const auto name = dynamic_cast<model::String*>(args->val[0])) {
+        const auto& names = match->pattern->regex.group_names();
+        const auto it = names.find(name->val());
+        if (it == names.end()) throw NativeFuncError("IndexError", "no such group '" + name->val() + "'");
+        return it->second;
+    }
+    const auto index = dynamic_cast<model::Int*>(args->val[0]);
+    int64_t v;
+    if (index == nullptr or !index->val.to_int64(v) or v < 0 or static_cast<size_t>(v) > match->pattern->regex.groups()) {
+        throw NativeFuncError("IndexError", "no such group");
+    }
+    return static_cast<size_t>(v);
+}
+
+// -------------------------- 查找 --------------------------
+static model::Object* do_match(Pattern* pattern, model::String* text, const bool anchored, const bool full) {
+    Regex* regex = &pattern->regex;
+    if (full) {
+        if (pattern->full == nullptr) pattern->full = std::make_unique<Regex>(pattern->source, true);
+        regex = pattern->full.get();
+    }
+    std::vector<int64_t> caps;
+    if (!regex->search(text->view(), 0, anchored, caps, true)) return model::load_nil();
+    return new Match(pattern, text, std::move(caps));
+}
+
+// 无组时返回整个匹配, 一个组时返回该组, 多个组时返回各组组成的元组
+static model::Object* do_findall(Pattern* pattern, const model::String* text) {
+    const auto view = text->view();
+    const size_t groups = pattern->regex.groups();
+    if (groups <= 1) {
+        std::vector<std::string> result;
+        for_each_match(pattern->regex, view, groups == 1, 0, [&](const std::vector<int64_t>& caps) {
+            result.push_back(group_str(view, caps, groups));
+        });
+        return model::List::from_strs(std::move(result));
+    }
+    std::vector<model::Object*> result;
+    for_each_match(pattern->regex, view, true, 0, [&](const std::vector<int64_t>& caps) {
+        std::vector<model::Object*> elems;
+        for (size_t i = 1; i <= groups; ++i) elems.push_back(model::create_str(group_str(view, caps, i)));
+        const auto tuple = model::Tuple::create(elems);
+        tuple->make_ref();
+        result.push_back(tuple);
+    });
+    return new model::List(std::move(result));
+}
+
+// 模式中有组时, 各组内容(未参与为Nil)也插入结果
+static model::Object* do_split(Pattern* pattern, const model::String* text, const size_t maxsplit) {
+    const auto view = text->view();
+    const size_t groups = pattern->regex.groups();
+    size_t last = 0;
+    if (groups == 0) {
+        std::vector<std::string> result;
+        for_each_match(pattern->regex, view, false, maxsplit, [&](const std::vector<int64_t>& caps) {
+            result.emplace_back(view.substr(last, static_cast<size_t>(caps[0]) - last));
+            last = static_cast<size_t>(caps[1]);
+        });
+        result.emplace_back(view.substr(last));
+        return model::List::from_strs(std::move(result));
+    }
+
+    std::vector<model::Object*> result;
+    const auto push = [&](model::Object* elem) {
+        elem->make_ref();
+        result.push_back(elem);
+    };
+    for_each_match(pattern->regex, view, true, maxsplit, [&](const std::vector<int64_t>& caps) {
+        push(model::create_str(std::string(view.substr(last, static_cast<size_t>(caps[0]) - last))));
+        for (size_t i = 1; i <= groups; ++i) {
+            push(caps[i * 2] < 0 ? static_cast<model::Object*>(model::load_nil()) : model::create_str(group_str(view, caps, i)));
+        }
+        last = static_cast<size_t>(caps[1]);
+    });
+    push(model::create_str(std::string(view.substr(last))));
+    const auto list = new model::List(std::move(result));
+    list->specialize();
+    return list;
+}
+
+// 替换模板预先拆成字面量片段与组引用: \1 \g<1> \g<name>, 以及\n \t \\等转义
+struct TemplatePart {
+    std::string text;
+    int64_t group = -1;
+};
+
+static std::vector<TemplatePart> parse_template(const std::string_view repl, const Pattern* pattern) {
+    std::vector<TemplatePart> parts(1);
+    const auto add_group = [&](const size_t group) {
+        if (group > pattern->regex.groups()) throw NativeFuncError("ReError", "invalid group reference " + std::to_string(group));
+        parts.push_back(TemplatePart{{}, static_cast<int64_t>(group)});
+        parts.emplace_back();
+    };
+    for (size_t i = 0; i < repl.size(); ++i) {
+        const char c = repl[i];
+        if (c != '\\' or i + 1 == repl.size()) {
+            parts.back().text += c;
+            continue;
+        }
+        const char e = repl[++i];
+        if (std::isdigit(static_cast<unsigned char>(e))) {
+            size_t group = e - '0';
+            if (i + 1 < repl.size() and std::isdigit(static_cast<unsigned char>(repl[i + 1]))) group = group * 10 + (repl[++i] - '0');
+            add_group(group);
+        } else if (e == 'g' and i + 1 < repl.size() and repl[i + 1] == '<') {
+            const size_t close = repl.find('>', i);
+            if (close == std::string_view::npos) throw NativeFuncError("ReError", "missing >, unterminated name");
+            const std::string name(repl.substr(i + 2, close - i - 2));
+            const auto& names = pattern->regex.group_names();
+            if (const auto it = names.find(name); it != names.end()) {
+                add_group(it->second);
+            } else if (!name.empty() and std::all_of(name.begin(), name.end(), [](const char ch) { return std::isdigit(static_cast<unsigned char>(ch)); })) {
+                add_group(std::stoul(name));
+            } else {
+                throw NativeFuncError("IndexError", "unknown group name '" + name + "'");
+            }
+            i = close;
+        } else {
+            switch (e) {
+            case 'n': parts.back().text += '\n'; break;
+            case 't': parts.back().text += '\t'; break;
+            case 'r': parts.back().text += '\r'; break;
+            case '\\': parts.back().text += '\\'; break;
+            default:
+                parts.back().text += '\\';
+                parts.back().text += e;
+            }
+        }
+    }
+    return parts;
+}
+
+// repl为Str时按模板替换, 为函数时以Match调用并用其返回的Str替换
+static model::Object* do_sub(Pattern* pattern, model::Object* repl, model::String* text, const size_t count) {
+    const auto view = text->view();
+    std::string result;
+    size_t last = 0;
+
+    if (const auto repl_str = dynamic_cast<model::String*>(repl)) {
+        const auto parts = parse_template(repl_str->view(), pattern);
+        const bool need_groups = parts.size() > 1;
+        for_each_match(pattern->regex, view, need_groups, count, [&](const std::vector<int64_t>& caps) {
+            result.append(view.substr(last, static_cast<size_t>(caps[0]) - last));
+            for (const auto& part : parts) {
+                if (part.group < 0) {
+                    result += part.text;
+                } else if (caps[part.group * 2] >= 0) {
+                    result.append(view.substr(static_cast<size_t>(caps[part.group * 2]),
+                        static_cast<size_t>(caps[part.group * 2 + 1] - caps[part.group * 2])));
+                }
+            }
+            last = static_cast<size_t>(caps[1]);
+        });
+    } else {
+        for_each_match(pattern->regex, view, true, count, [&](const std::vector<int64_t>& caps) {
+            result.append(view.substr(last, static_cast<size_t>(caps[0]) - last));
+            kiz::Vm::call_function(repl, new model::List({new Match(pattern, text, caps)}), nullptr);
+            const auto replaced = dynamic_cast<model::String*>(kiz::Vm::fetch_one_from_stack_top());
+            if (replaced == nullptr) throw NativeFuncError("TypeError", "re.sub repl function must return Str");
+            result += replaced->view();
+            last = static_cast<size_t>(caps[1]);
+        });
+    }
+    result.append(view.substr(last));
+    return model::create_str(std::move(result));
+}
+
+// -------------------------- 模块 --------------------------
+model::Object* init_module(model::Object* self, const model::List* args) {
+    auto mod = new model::Module("re");
+
+    based_re_pattern->attrs.insert("__parent__", model::based_obj);
+    based_re_pattern->attrs.insert("__str__", new model::NativeFunction(pattern_str));
+    based_re_pattern->attrs.insert("match", new model::NativeFunction(pattern_match));
+    based_re_pattern->attrs.insert("search", new model::NativeFunction(pattern_search));
+    based_re_pattern->attrs.insert("fullmatch", new model::NativeFunction(pattern_fullmatch));
+    based_re_pattern->attrs.insert("findall", new model::NativeFunction(pattern_findall));
+    based_re_pattern->attrs.insert("split", new model::NativeFunction(pattern_split));
+    based_re_pattern->attrs.insert("sub", new model::NativeFunction(pattern_sub));
+    based_re_pattern->attrs.insert("groups", new model::NativeFunction(pattern_groups));
+
+    based_re_match->attrs.insert("__parent__", model::based_obj);
+    based_re_match->attrs.insert("__str__", new model::NativeFunction(match_str));
+    based_re_match->attrs.insert("group", new model::NativeFunction(match_group));
+    based_re_match->attrs.insert("groups", new model::NativeFunction(match_groups));
+    based_re_match->attrs.insert("start", new model::NativeFunction(match_start));
+    based_re_match->attrs.insert("end", new model::NativeFunction(match_end));
+    based_re_match->attrs.insert("span", new model::NativeFunction(match_span));
+
+    mod->attrs.insert("compile", new model::NativeFunction(re_compile));
+    mod->attrs.insert("match", new model::NativeFunction(re_match));
+    mod->attrs.insert("search", new model::NativeFunction(re_search));
+    mod->attrs.insert("fullmatch", new model::NativeFunction(re_fullmatch));
+    mod->attrs.insert("findall", new model::NativeFunction(re_findall));
+    mod->attrs.insert("split", new model::NativeFunction(re_split));
+    mod->attrs.insert("sub", new model::NativeFunction(re_sub));
+    mod->attrs.insert("escape", new model::NativeFunction(re_escape));
+
+    return mod;
+}
+
+// re.compile(pattern)
+model::Object* re_compile(model::Object* self, const model::List* args) {
+    if (args->val.empty()) throw NativeFuncError("TypeError", "re.compile need a Str argument");
+    return get_pattern(args->val[0]);
+}
+
+// re.match(pattern, text): 只在开头匹配
+model::Object* re_match(model::Object* self, const model::List* args) {
+    if (args->val.empty()) throw NativeFuncError("TypeError", "re.match need a pattern");
+    return do_match(get_pattern(args->val[0]), str_arg(args, 1, "match"), true, false);
+}
+
+model::Object* re_search(model::Object* self, const model::List* args) {
+    if (args->val.empty()) throw NativeFuncError("TypeError", "re.search need a pattern");
+    return do_match(get_pattern(args->val[0]), str_arg(args, 1, "search"), false, false);
+}
+
+model::Object* re_fullmatch(model::Object* self, const model::List* args) {
+    if (args->val.empty()) throw NativeFuncError("TypeError", "re.fullmatch need a pattern");
+    return do_match(get_pattern(args->val[0]), str_arg(args, 1, "fullmatch"), true, true);
+}
+
+model::Object* re_findall(model::Object* self, const model::List* args) {
+    if (args->val.empty()) throw NativeFuncError("TypeError", "re.findall need a pattern");
+    return do_findall(get_pattern(args->val[0]), str_arg(args, 1, "findall"));
+}
+
+// re.split(pattern, text, maxsplit=0)
+model::Object* re_split(model::Object* self, const model::List* args) {
+    if (args->val.empty()) throw NativeFuncError("TypeError", "re.split need a pattern");
+    return do_split(get_pattern(args->val[0]), str_arg(args, 1, "split"), count_arg(args, 2, "split"));
+}
+
+// re.sub(pattern, repl, text, count=0)
+model::Object* re_sub(model::Object* self, const model::List* args) {
+    if (args->val.size() < 2) throw NativeFuncError("TypeError", "re.sub need a pattern and a repl");
+    return do_sub(get_pattern(args->val[0]), args->val[1], str_arg(args, 2, "sub"), count_arg(args, 3, "sub"));
+}
+
+// re.escape(text): 转义正则中的特殊字符
+model::Object* re_escape(model::Object* self, const model::List* args) {
+    const auto text = str_arg(args, 0, "escape")->view();
+    static constexpr std::string_view special = "()[]{}?*+-|^$\\.&~# \t\n\r\v\f";
+    std::string result;
+    result.reserve(text.size());
+    for (const char c : text) {
+        if (special.find(c) != std::string_view::npos) result += '\\';
+        result += c;
+    }
+    return model::create_str(std::move(result));
+}
+
+model::Object* pattern_match(model::Object* self, const model::List* args) {
+    return do_match(self_pattern(self, "match"), str_arg(args, 0, "match"), true, false);
+}
+
+model::Object* pattern_search(model::Object* self, const model::List* args) {
+    return do_match(self_pattern(self, "search"), str_arg(args, 0, "search"), false, false);
+}
+
+model::Object* pattern_fullmatch(model::Object* self, const model::List* args) {
+    return do_match(self_pattern(self, "fullmatch"), str_arg(args, 0, "fullmatch"), true, true);
+}
+
+model::Object* pattern_findall(model::Object* self, const model::List* args) {
+    return do_findall(self_pattern(self, "findall"), str_arg(args, 0, "findall"));
+}
+
+model::Object* pattern_split(model::Object* self, const model::List* args) {
+    return do_split(self_pattern(self, "split"), str_arg(args, 0, "split"), count_arg(args, 1, "split"));
+}
+
+model::Object* pattern_sub(model::Object* self, const model::List* args) {
+    if (args->val.empty()) throw NativeFuncError("TypeError", "Pattern.sub need a repl");
+    return do_sub(self_pattern(self, "sub"), args->val[0], str_arg(args, 1, "sub"), count_arg(args, 2, "sub"));
+}
+
+model::Object* pattern_groups(model::Object* self, const model::List* args) {
+    return model::create_int(dep::BigInt(self_pattern(self, "groups")->regex.groups()));
+}
+
+model::Object* pattern_str(model::Object* self, const model::List* args) {
+    return model::create_str(self_pattern(self, "__str__")->debug_string());
+}
+
+// Match.group(n=0): 组未参与匹配时返回Nil
+model::Object* match_group(model::Object* self, const model::List* args) {
+    const auto match = self_match(self, "group");
+    const size_t group = group_arg(match, args);
+    if (match->caps[group * 2] < 0) return model::load_nil();
+    return model::create_str(std::string(match->group_view(group)));
+}
+
+model::Object* match_groups(model::Object* self, const model::List* args) {
+    const auto match = self_match(self, "groups");
+    std::vector<model::Object*> elems;
+    for (size_t i = 1; i <= match->pattern->regex.groups(); ++i) {
+        elems.push_back(match->caps[i * 2] < 0 ? static_cast<model::Object*>(model::load_nil()) : model::create_str(std::string(match->group_view(i))));
+    }
+    return model::Tuple::create(elems);
+}
+
+// start/end/span以字符为单位, 组未参与匹配时为-1
+model::Object* match_start(model::Object* self, const model::List* args) {
+    const auto match = self_match(self, "start");
+    const size_t group = group_arg(match, args);
+    return model::create_int(dep::BigInt::from_int64(char_index(match->text->view(), match->caps[group * 2])));
+}
+
+model::Object* match_end(model::Object* self, const model::List* args) {
+    const auto match = self_match(self, "end");
+    const size_t group = group_arg(match, args);
+    return model::create_int(dep::BigInt::from_int64(char_index(match->text->view(), match->caps[group * 2 + 1])));
+}
+
+model::Object* match_span(model::Object* self, const model::List* args) {
+    const auto match = self_match(self, "span");
+    const size_t group = group_arg(match, args);
+    const auto view = match->text->view();
+    return model::Tuple::create({
+        model::create_int(dep::BigInt::from_int64(char_index(view, match->caps[group * 2]))),
+        model::create_int(dep::BigInt::from_int64(char_index(view, match->caps[group * 2 + 1]))),
+    });
+}
+
+model::Object* match_str(model::Object* self, const model::List* args) {
+    const auto match = self_match(self, "__str__");
+    const auto view = match->text->view();
+    return model::create_str("<re.Match span=(" + std::to_string(char_index(view, match->caps[0])) + ", "
+        + std::to_string(char_index(view, match->caps[1])) + "), match=\"" + std::string(match->group_view(0)) + "\">");
+}
+
+}
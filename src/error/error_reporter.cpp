@@ -14,6 +14,7 @@
 
 #include "../kiz.hpp"
 #include "../repl/color.hpp"
+#include "../vm/vm.hpp"
 
 namespace err {
 
@@ -30,6 +31,9 @@ void context_printer(
     const std::string& src_path,
     const PositionInfo& pos
 ) {
+    // 先输出脚本已缓冲的内容, 保证报错位于其后
+    kiz::Vm::flush_stdout();
+
     size_t src_line_start = pos.lno_start;
     size_t src_line_end = pos.lno_end;
     size_t src_col_start = pos.col_start;
@@ -41,6 +41,16 @@ void IRGenerator::gen_expr(Expr* expr) {
             );
             break;
         }
+        case AstType::FloatExpr: {
+            auto const_obj = make_float_obj(dynamic_cast<FloatExpr*>(expr));
+            size_t const_idx = get_or_add_const(curr_consts, const_obj);
+            curr_code_list.emplace_back(
+                Opcode::LOAD_CONST,
+                std::vector{const_idx},
+                expr->pos
+            );
+            break;
+        }
         case AstType::IdentifierExpr: {
             // 标识符：生成LOAD_VAR指令（加载变量值）
             const auto* ident = dynamic_cast<IdentifierExpr*>(expr);
@@ -117,14 +127,76 @@ void IRGenerator::gen_expr(Expr* expr) {
             for (const auto& e: list_expr->elements) {
                 gen_expr(e.get());
             }
-            // 生成 OP_MAKE_LIST 指令
+            // 生成 OP_MAKE_LIST 指令, 第二个操作数为1表示用户列表(可拆箱存储)
             curr_code_list.emplace_back(
                 Opcode::MAKE_LIST,
-                std::vector{list_expr->elements.size()},
+                std::vector<size_t>{list_expr->elements.size(), 1},
                 expr->pos
            );
             break;
         }
+        case AstType::TupleExpr: {
+            auto tuple_expr = dynamic_cast<TupleExpr*>(expr);
+            for (const auto& e: tuple_expr->elements) {
+                gen_expr(e.get());
+            }
+            curr_code_list.emplace_back(
+                Opcode::MAKE_TUPLE,
+                std::vector<size_t>{tuple_expr->elements.size()},
+                expr->pos
+            );
+            break;
+        }
+        case AstType::SetExpr: {
+            auto set_expr = dynamic_cast<SetExpr*>(expr);
+            for (const auto& e: set_expr->elements) {
+                gen_expr(e.get());
+            }
+            curr_code_list.emplace_back(
+                Opcode::MAKE_SET,
+                std::vector<size_t>{set_expr->elements.size()},
+                expr->pos
+            );
+            break;
+        }
+        case AstType::ListCompExpr:
+            gen_list_comp(dynamic_cast<ListCompExpr*>(expr));
+            break;
+        case AstType::SliceExpr: {
+            // 依次压入start/stop/step(省略的部分为Nil), 由 MAKE_SLICE 打包
+            auto slice_expr = dynamic_cast<SliceExpr*>(expr);
+            for (const auto part : {slice_expr->start.get(), slice_expr->stop.get(), slice_expr->step.get()}) {
+                if (part != nullptr) {
+                    gen_expr(part);
+                    continue;
+                }
+                const size_t nil_idx = get_or_add_const(curr_consts, new model::Nil());
+                curr_code_list.emplace_back(
+                    Opcode::LOAD_CONST,
+                    std::vector<size_t>{nil_idx},
+                    expr->pos
+                );
+            }
+            curr_code_list.emplace_back(
+                Opcode::MAKE_SLICE,
+                std::vector<size_t>{},
+                expr->pos
+            );
+            break;
+        }
+        case AstType::TemplateExpr: {
+            // 模板字符串：依次生成各片段, 由 BUILD_STRING 一次性拼接
+            auto template_expr = dynamic_cast<TemplateExpr*>(expr);
+            for (const auto& part : template_expr->parts) {
+                gen_expr(part.get());
+            }
+            curr_code_list.emplace_back(
+                Opcode::BUILD_STRING,
+                std::vector{template_expr->parts.size()},
+                expr->pos
+            );
+            break;
+        }
         case AstType::GetMemberExpr: {
             // 获取成员：生成对象表达式 -> 加载属性名 -> GET_ATTR指令
             auto* get_mem = dynamic_cast<GetMemberExpr*>(expr);
@@ -307,4 +379,59 @@ void IRGenerator::gen_dict(DictExpr* expr) {
     );
 }
 
+void IRGenerator::gen_list_comp(ListCompExpr* expr) {
+    assert(expr != nullptr);
+    // 与for语句相同: 迭代对象只求值一次, 迭代器存入按嵌套深度编号的槽位
+    gen_expr(expr->iter.get());
+    const size_t iter_slot = block_stack.size();
+    curr_code_list.emplace_back(
+        Opcode::GET_ITER,
+        std::vector{iter_slot},
+        expr->pos
+    );
+
+    // 结果列表留在栈顶, 循环体内栈保持平衡
+    curr_code_list.emplace_back(
+        Opcode::MAKE_LIST,
+        std::vector<size_t>{0, 1},
+        expr->pos
+    );
+
+    const size_t loop_entry_idx = curr_code_list.size();
+    const size_t var_name_idx = get_or_add_name(curr_names, expr->item_var_name);
+    curr_code_list.emplace_back(
+        Opcode::FOR_ITER,
+        std::vector<size_t>{iter_slot, var_name_idx, 0},
+        expr->pos
+    );
+
+    // 占一层循环深度, 使元素表达式中嵌套的推导式使用不同的槽位
+    block_stack.emplace(LoopInfo{{}, {}});
+
+    if (expr->cond) {
+        gen_expr(expr->cond.get());
+        curr_code_list.emplace_back(
+            Opcode::JUMP_IF_FALSE,
+            std::vector<size_t>{loop_entry_idx},
+            expr->pos
+        );
+    }
+
+    // LIST_APPEND 直接写入栈顶的结果列表, 操作数为迭代器槽位(用于预分配)
+    gen_expr(expr->elem.get());
+    curr_code_list.emplace_back(
+        Opcode::LIST_APPEND,
+        std::vector{iter_slot},
+        expr->pos
+    );
+    curr_code_list.emplace_back(
+        Opcode::JUMP,
+        std::vector<size_t>{loop_entry_idx},
+        expr->pos
+    );
+
+    block_stack.pop();
+    curr_code_list[loop_entry_idx].opn_list[2] = curr_code_list.size();
+}
+
 }
@@ -52,6 +52,24 @@ void IRGenerator::gen_block(const BlockStmt* block) {
                 );
                 break;
             }
+            case AstType::UnpackAssignStmt: {
+                // UNPACK_SEQUENCE 按逆序压入各元素, 随后依次存入变量
+                const auto* unpack = dynamic_cast<UnpackAssignStmt*>(stmt.get());
+                gen_expr(unpack->expr.get());
+                curr_code_list.emplace_back(
+                    Opcode::UNPACK_SEQUENCE,
+                    std::vector<size_t>{unpack->names.size()},
+                    stmt->pos
+                );
+                for (const auto& name : unpack->names) {
+                    curr_code_list.emplace_back(
+                        Opcode::SET_LOCAL,
+                        std::vector{get_or_add_name(curr_names, name)},
+                        stmt->pos
+                    );
+                }
+                break;
+            }
             case AstType::NonlocalAssignStmt: {
                 // 变量声明：生成初始化表达式IR + 存储变量指令
                 const auto* var_decl = dynamic_cast<NonlocalAssignStmt*>(stmt.get());
@@ -335,46 +353,47 @@ void IRGenerator::gen_while(WhileStmt* while_stmt) {
 
 void IRGenerator::gen_for(ForStmt* for_stmt) {
     assert(for_stmt);
-    // 记录循环入口（条件判断开始位置）→ continue跳这里
-    size_t loop_entry_idx = curr_code_list.size();
-
-    curr_code_list.emplace_back(
-        Opcode::MAKE_LIST,
-        std::vector<size_t>{0},
-        for_stmt->pos
-    );
-
-    // 生成循环条件IR
+    // 迭代对象只求值一次, 包装为迭代器后存入调用帧中按嵌套深度编号的槽位(不占用变量名)
     gen_expr(for_stmt->iter.get());
-
-    size_t name_idx = get_or_add_name(curr_names, "__next__");
-
-    curr_code_list.emplace_back(
-        Opcode::CALL_METHOD,
-        std::vector{name_idx},
-        for_stmt->pos
-    );
-
-    size_t var_name_idx = get_or_add_name(curr_names, for_stmt->item_var_name);
+    const size_t iter_slot = block_stack.size();
     curr_code_list.emplace_back(
-        Opcode::SET_LOCAL,
-        std::vector{var_name_idx},
+        Opcode::GET_ITER,
+        std::vector{iter_slot},
         for_stmt->pos
     );
 
-    curr_code_list.emplace_back(
-        Opcode::LOAD_VAR,
-        std::vector{var_name_idx},
-        for_stmt->pos
-    );
+    // 记录循环入口（取下一个元素）→ continue跳这里
+    size_t loop_entry_idx = curr_code_list.size();
 
-    // 生成JUMP_IF_FALSE指令（目标：循环结束位置，先占位）
-    const size_t jump_if_false_idx = curr_code_list.size();
-    curr_code_list.emplace_back(
-        Opcode::JUMP_IF_FALSE,
-        std::vector<size_t>{0}, // 占位，后续填充为循环结束位置
-        for_stmt->pos
-    );
+    // 生成FOR_ITER指令: 取下一个元素存入循环变量, 耗尽时跳到循环结束位置（先占位）
+    // 需要解包时元素留在栈顶, 再同解包赋值一样逐个存入各变量
+    const bool unpack = !for_stmt->unpack_names.empty();
+    const size_t for_iter_idx = curr_code_list.size();
+    if (unpack) {
+        curr_code_list.emplace_back(
+            Opcode::FOR_ITER,
+            std::vector<size_t>{iter_slot, 0},
+            for_stmt->pos
+        );
+        curr_code_list.emplace_back(
+            Opcode::UNPACK_SEQUENCE,
+            std::vector<size_t>{for_stmt->unpack_names.size()},
+            for_stmt->pos
+        );
+        for (const auto& name : for_stmt->unpack_names) {
+            curr_code_list.emplace_back(
+                Opcode::SET_LOCAL,
+                std::vector{get_or_add_name(curr_names, name)},
+                for_stmt->pos
+            );
+        }
+    } else {
+        curr_code_list.emplace_back(
+            Opcode::FOR_ITER,
+            std::vector<size_t>{iter_slot, get_or_add_name(curr_names, for_stmt->item_var_name), 0},
+            for_stmt->pos
+        );
+    }
 
     auto loop_info = LoopInfo{{}, {}};
     block_stack.emplace(loop_info);
@@ -389,9 +408,9 @@ void IRGenerator::gen_for(ForStmt* for_stmt) {
         for_stmt->pos
     );
 
-    // 填充JUMP_IF_FALSE的目标（循环结束位置 = 当前代码列表长度）
+    // 填充FOR_ITER的目标（循环结束位置 = 当前代码列表长度）
     size_t loop_exit_idx = curr_code_list.size();
-    curr_code_list[jump_if_false_idx].opn_list[0] = loop_exit_idx;
+    curr_code_list[for_iter_idx].opn_list.back() = loop_exit_idx;
 
     for (const auto break_pos : block_stack.top().break_pos) {
         curr_code_list[break_pos].opn_list[0] = loop_exit_idx;
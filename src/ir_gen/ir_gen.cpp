@@ -106,6 +106,13 @@ model::Decimal* IRGenerator::make_decimal_obj(const DecimalExpr* dec_expr) {
     return decimal_obj;
 }
 
+model::Float* IRGenerator::make_float_obj(const FloatExpr* float_expr) {
+    DEBUG_OUTPUT("making float object...");
+    assert(float_expr && "make_float_obj: 浮点数节点为空");
+    auto float_obj = new model::Float(std::strtod(float_expr->value.c_str(), nullptr));
+    return float_obj;
+}
+
 model::String* IRGenerator::make_string_obj(const StringExpr* str_expr) {
     DEBUG_OUTPUT("making string object...");
     assert(str_expr && "make_string_obj: 字符串节点为空");
@@ -47,6 +47,7 @@ public:
 
     void gen_fn_call(CallExpr* expr);
     void gen_dict(DictExpr* expr);
+    void gen_list_comp(ListCompExpr* expr);
     void gen_expr(Expr* expr);
 
     void gen_if(IfStmt* if_stmt);
@@ -56,6 +57,7 @@ protected:
     [[nodiscard]] model::CodeObject* make_code_obj() const;
     static model::Int* make_int_obj(const NumberExpr* num_expr);
     static model::Decimal* make_decimal_obj(const DecimalExpr* dec_expr);
+    static model::Float* make_float_obj(const FloatExpr* float_expr);
     static model::String* make_string_obj(const StringExpr* str_expr);
 };
 
@@ -99,6 +99,24 @@ void Lexer::emit_token(TokenType type, size_t start_cp, size_t end_cp,
     tokens_.emplace_back(type, text, start_lno, end_lno, start_col, end_col);
 }
 
+// 模板字符串中的表达式：用独立的Lexer分析, 并把列号平移到源文件中的位置
+void Lexer::emit_template_expr(const std::string& expr_src, size_t lno, size_t col) {
+    Lexer sub_lexer(file_path_);
+    auto sub_tokens = sub_lexer.tokenize(expr_src, lno);
+    sub_tokens.pop_back(); // 去掉EOF
+
+    if (sub_tokens.empty()) {
+        err::error_reporter(file_path_, {lno, lno, col, col},
+                          "SyntaxError", "Empty expression in template string");
+    }
+
+    for (auto& tok : sub_tokens) {
+        tok.pos.col_start += col - 1;
+        tok.pos.col_end += col - 1;
+        tokens_.push_back(std::move(tok));
+    }
+}
+
 // 快速生成单码点Token
 void Lexer::emit_single_cp_token(TokenType type, size_t cp_index) {
     // 注意：cp_index应该是消费前的索引
@@ -143,6 +161,10 @@ std::vector<Token> Lexer::tokenize(const std::string& src, size_t lineno_start)
                 // 跨行字符串 M"/m"
                 curr_state_ = LexState::MultilineString;
                      }
+            else if (current_char == CHAR_f && cp_pos_ + 1 < total_cp_ && peek() == CHAR_QUOTE) {
+                // 模板字符串 f"
+                curr_state_ = LexState::TemplateString;
+            }
             else if (is_alpha_under(current_char)) {
                 curr_state_ = LexState::Identifier;
             }
@@ -320,6 +342,132 @@ std::vector<Token> Lexer::tokenize(const std::string& src, size_t lineno_start)
             break;
         }
 
+        // ======================================
+        // 模板字符串状态 f"...{expr}..."
+        // 生成 TemplateBegin 片段, 片段, ... TemplateEnd, 片段之间以逗号分隔
+        // ======================================
+        case LexState::TemplateString: {
+            size_t start_lno = lineno_;
+            size_t start_col = col_;
+
+            next(); // 跳过f
+            next(); // 跳过开头的双引号"
+            tokens_.emplace_back(TokenType::TemplateBegin, "f\"", start_lno, start_col);
+
+            bool unclosed = true;
+            bool has_part = false;
+            dep::UTF8String raw_str;
+            size_t part_lno = lineno_;
+            size_t part_col = col_;
+
+            // 把已收集的字面量片段作为String Token输出
+            auto flush_literal = [&] {
+                if (raw_str.size() == 0) return;
+                if (has_part) tokens_.emplace_back(TokenType::Comma, ",", part_lno, part_col);
+                tokens_.emplace_back(TokenType::String, handle_escape(raw_str.to_string()),
+                                     part_lno, lineno_, part_col, col_ - 1);
+                raw_str = dep::UTF8String();
+                has_part = true;
+            };
+
+            while (cp_pos_ < total_cp_) {
+                dep::UTF8Char c = src_[cp_pos_];
+
+                if (is_newline(c)) {
+                    break; // 模板字符串不允许跨行
+                }
+
+                if (c == CHAR_BACKSLASH && cp_pos_ + 1 < total_cp_) {
+                    raw_str += c;
+                    next();
+                    raw_str += src_[cp_pos_];
+                    next();
+                    continue;
+                }
+
+                if (c == CHAR_QUOTE) {
+                    unclosed = false;
+                    next(); // 跳过闭合引号
+                    break;
+                }
+
+                // {{ 与 }} 表示字面量花括号
+                if ((c == CHAR_LBRACE || c == CHAR_RBRACE) && peek() == c) {
+                    raw_str += c;
+                    next();
+                    next();
+                    continue;
+                }
+
+                if (c == CHAR_LBRACE) {
+                    flush_literal();
+                    next(); // 跳过{
+                    const size_t expr_lno = lineno_;
+                    const size_t expr_col = col_;
+
+                    // 收集表达式源码直到匹配的 }，跳过其中的字符串字面量
+                    dep::UTF8String expr_str;
+                    size_t depth = 1;
+                    while (cp_pos_ < total_cp_ && !is_newline(src_[cp_pos_])) {
+                        dep::UTF8Char ec = src_[cp_pos_];
+                        if (ec == CHAR_QUOTE || ec == CHAR_SQUOTE) {
+                            expr_str += ec;
+                            next();
+                            while (cp_pos_ < total_cp_ && !is_newline(src_[cp_pos_]) && src_[cp_pos_] != ec) {
+                                if (src_[cp_pos_] == CHAR_BACKSLASH && cp_pos_ + 1 < total_cp_) {
+                                    expr_str += src_[cp_pos_];
+                                    next();
+                                }
+                                expr_str += src_[cp_pos_];
+                                next();
+                            }
+                            if (cp_pos_ < total_cp_ && src_[cp_pos_] == ec) {
+                                expr_str += ec;
+                                next();
+                            }
+                            continue;
+                        }
+                        if (ec == CHAR_LBRACE) ++depth;
+                        else if (ec == CHAR_RBRACE && --depth == 0) break;
+                        expr_str += ec;
+                        next();
+                    }
+
+                    if (depth != 0) {
+                        err::error_reporter(file_path_, {start_lno, lineno_, start_col, col_},
+                                          "SyntaxError", "Unclosed '{' in template string");
+                    }
+                    next(); // 跳过}
+
+                    if (has_part) tokens_.emplace_back(TokenType::Comma, ",", expr_lno, expr_col);
+                    emit_template_expr(expr_str.to_string(), expr_lno, expr_col);
+                    has_part = true;
+                    part_lno = lineno_;
+                    part_col = col_;
+                    continue;
+                }
+
+                if (c == CHAR_RBRACE) {
+                    err::error_reporter(file_path_, {lineno_, lineno_, col_, col_},
+                                      "SyntaxError", "Single '}' is not allowed in template string, use '}}'");
+                }
+
+                raw_str += c;
+                next();
+            }
+
+            flush_literal();
+
+            if (unclosed) {
+                err::error_reporter(file_path_, {start_lno, lineno_, start_col, col_},
+                                  "SyntaxError", R"(Unclosed template string literal (f"): missing closing '"')");
+            }
+
+            tokens_.emplace_back(TokenType::TemplateEnd, "\"", lineno_, col_ - 1);
+            curr_state_ = LexState::Start;
+            break;
+        }
+
         // ======================================
         // 标识符/关键字状态
         // ======================================
@@ -410,6 +558,16 @@ std::vector<Token> Lexer::tokenize(const std::string& src, size_t lineno_start)
                 }
             }
 
+            // 后缀f: IEEE-754浮点数字面量(如 1.5f), token文本不含后缀
+            if (cp_pos_ < total_cp_ && src_[cp_pos_] == CHAR_f &&
+                (cp_pos_ + 1 >= total_cp_ || !is_ident_continue(peek()))) {
+                const size_t num_end = cp_pos_;
+                next();
+                emit_token(TokenType::Float, start_cp, num_end, start_lno, start_col, lineno_, col_ - 1);
+                curr_state_ = LexState::Start;
+                break;
+            }
+
             // 判定类型
             TokenType type = (has_sci || has_dot) ? TokenType::Decimal : TokenType::Number;
             emit_token(type, start_cp, cp_pos_, start_lno, start_col, lineno_, col_ - 1);
@@ -16,6 +16,7 @@
 // 常用字符常量
 static const dep::UTF8Char CHAR_M('M');
 static const dep::UTF8Char CHAR_m('m');
+static const dep::UTF8Char CHAR_f('f');
 static const dep::UTF8Char CHAR_QUOTE('"');
 static const dep::UTF8Char CHAR_SQUOTE('\'');
 static const dep::UTF8Char CHAR_HASH('#');
@@ -59,7 +60,9 @@ enum class TokenType {
     // 赋值运算符
     Assign,
     // 字面量
-    Number, Decimal, String,
+    Number, Decimal, Float, String,
+    // 模板字符串 f"...{expr}..." 的边界, 中间为以逗号分隔的各片段
+    TemplateBegin, TemplateEnd,
     // 分隔符
     LParen, RParen, LBrace, RBrace, LBracket, RBracket,
     Comma, Dot, TripleDot, Semicolon,
@@ -109,6 +112,7 @@ enum class LexState {
     Operator,       // 双字符运算符（=>/->/==/!=等）
     String,         // 普通字符串（""/''）
     MultilineString,// 跨行字符串（M"/m"）
+    TemplateString, // 模板字符串（f"）
     SingleComment,  // 单行注释（#）
     BlockComment    // 块注释（/* */）
 };
@@ -162,6 +166,9 @@ class Lexer {
     /// 处理字符串转义（普通/跨行通用）
     static std::string handle_escape(const std::string& raw);
 
+    /// 词法分析模板字符串中的 {expr}，把其Token追加到tokens_
+    void emit_template_expr(const std::string& expr_src, size_t lno, size_t col);
+
     /// 预读下一个码点（不移动cp_pos_）
     dep::UTF8Char peek(size_t offset = 1) const {
         if (cp_pos_ + offset >= total_cp_) {
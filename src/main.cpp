@@ -15,6 +15,7 @@
 #endif
 
 #include <iostream>
+#include <vector>
 
 #include "kiz.hpp"
 #include "util/src_manager.hpp"
@@ -81,11 +82,27 @@ void enable_ansi_escape() {
  * @param argv 命令行参数数组（来自main函数）
  * @return void
  */
-void args_parser(const int argc, char* argv[]) {
+void args_parser(int argc, char* argv[]) {
     // 程序名称
     enable_ansi_escape();
     const char* prog_name = argv[0];
 
+    // -u : 关闭print输出缓冲, 每次输出后立即刷新
+    // 只在脚本路径之前(可在run之后)作为解释器选项, 路径之后的参数原样保留
+    std::vector<char*> rest_args{argv[0]};
+    bool before_path = true;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (before_path and arg == "-u") {
+            kiz::Vm::stdout_unbuffered = true;
+            continue;
+        }
+        if (arg != "run") before_path = false;
+        rest_args.push_back(argv[i]);
+    }
+    argc = static_cast<int>(rest_args.size());
+    argv = rest_args.data();
+
     // 无参数：默认启动REPL
     if (argc == 1) {
         ui::Repl repl;
@@ -148,6 +165,7 @@ void run_file(const std::string& path) {
     auto module = kiz::IRGenerator::gen_mod(path, ir);
     kiz::Vm::set_main_module(module);
     kiz::Vm::exec_curr_code();
+    kiz::Vm::flush_stdout();
 }
 
 void show_help() {
@@ -180,6 +198,10 @@ the kiz cmd help
   ----------------------
   | > kiz demo.kiz    |
   ----------------------
+  add -u to flush the output of print immediately (unbuffered)
+  -----------------------
+  | > kiz -u demo.kiz  |
+  -----------------------
 
 - version
   show the version of kiz
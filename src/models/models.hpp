@@ -7,9 +7,15 @@
 
 #pragma once
 
+#include <algorithm>
 #include <atomic>
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
 #include <functional>
 #include <iomanip>
+#include <type_traits>
 #include <utility>
 
 #include "../kiz.hpp"
@@ -41,6 +47,7 @@ namespace magic_name {
     constexpr auto setitem = "__setitem__";
     constexpr auto contains = "__contains__";
     constexpr auto next_item = "__next__";
+    constexpr auto iter = "__iter__";
     constexpr auto hash = "__hash__";
     constexpr auto owner_module = "__owner_module__";
 }
@@ -69,7 +76,9 @@ public:
     enum class ObjectType {
         OT_Object, OT_Nil, OT_Bool, OT_Int, OT_Rational, OT_String,
         OT_List, OT_Dictionary, OT_CodeObject, OT_Function,
-        OT_CppFunction, OT_Module, OT_Error, OT_Decimal
+        OT_CppFunction, OT_Module, OT_Error, OT_Decimal,
+        OT_StrBuilder, OT_Iterator, OT_Slice, OT_Set, OT_Tuple, OT_DictView,
+        OT_Float
     };
 
     // 获取实际类型的虚函数
@@ -96,6 +105,11 @@ public:
         return "<Object at " + ptr_to_string(this) + ">";
     }
 
+    // 把调试字符串追加到out, 容器类型重写以避免逐层构造临时字符串
+    virtual void write_debug_string(std::string& out) const {
+        out += debug_string();
+    }
+
     Object () {
         make_ref();
     }
@@ -119,7 +133,14 @@ inline auto based_str = new Object();
 inline auto based_native_function = new Object();
 inline auto based_error = new Object();
 inline auto based_decimal = new Object();
+inline auto based_float = new Object();
 inline auto based_module = new Object();
+inline auto based_str_builder = new Object();
+inline auto based_iterator = new Object();
+inline auto based_slice = new Object();
+inline auto based_set = new Object();
+inline auto based_tuple = new Object();
+inline auto based_dict_view = new Object();
 
 class List;
 
@@ -233,30 +254,116 @@ public:
 
 class List : public Object {
 public:
+    // 存储策略: 元素同类时以拆箱数组保存, 首次插入异类元素时退化为Generic
+    enum class Strategy : uint8_t {
+        Generic,   // Object* 数组(val)
+        Empty,     // 空列表, 由第一个元素决定策略
+        Int,       // int64 数组
+        Decimal,   // dep::Decimal 数组
+        Str        // std::string 数组
+    };
+
+    // Generic策略下的元素; 其他策略下为空, 通过size/get/set/append访问
     std::vector<Object*> val;
 
     static constexpr ObjectType TYPE = ObjectType::OT_List;
     [[nodiscard]] ObjectType get_type() const override { return TYPE; }
 
+    // 参数列表等内部列表使用Generic策略, 可直接读写val
     explicit List(std::vector<Object*> val) : val(std::move(val)) {
         attrs.insert("__parent__", based_list);
         attrs.insert("__current_index__", new Int(0));
     }
+
+    // 可特化的空列表
+    static List* create_empty() {
+        auto list = new List(std::vector<Object*>{});
+        list->strategy_ = Strategy::Empty;
+        return list;
+    }
+
+    // 直接以int64数组构造(range等)
+    static List* from_ints(std::vector<int64_t> ints) {
+        auto list = new List(std::vector<Object*>{});
+        list->strategy_ = Strategy::Int;
+        list->ints_ = std::move(ints);
+        return list;
+    }
+
+    // 直接以字符串数组构造(split等)
+    static List* from_strs(std::vector<std::string> strs) {
+        auto list = new List(std::vector<Object*>{});
+        list->strategy_ = Strategy::Str;
+        list->strs_ = std::move(strs);
+        return list;
+    }
+
+    [[nodiscard]] Strategy strategy() const { return strategy_; }
+    [[nodiscard]] const std::vector<int64_t>& ints() const { return ints_; }
+    [[nodiscard]] const std::vector<dep::Decimal>& decimals() const { return decimals_; }
+    [[nodiscard]] const std::vector<std::string>& strs() const { return strs_; }
+    // 原地重排用(如排序), 调用方不得改变长度
+    std::vector<int64_t>& ints() { return ints_; }
+    std::vector<dep::Decimal>& decimals() { return decimals_; }
+    std::vector<std::string>& strs() { return strs_; }
+
+    [[nodiscard]] size_t size() const;
+    [[nodiscard]] bool empty() const { return size() == 0; }
+
+    // 取第i个元素: Generic下返回原对象, 否则装箱出新对象
+    [[nodiscard]] Object* get(size_t i) const;
+    void set(size_t i, Object* elem);
+    void append(Object* elem);
+    void extend(const List& other);
+    // 按当前策略预留容量(空列表策略未定时不处理)
+    void reserve(size_t n);
+    void pop_back();
+    void reverse();
+    // 按下标序列重排: 第k个元素变为原来的第order[k]个
+    void permute(const std::vector<size_t>& order);
+
+    // 把全部元素装箱, 切换为Generic
+    void generalize();
+    // 新建的Generic列表若元素同类则转为拆箱存储
+    void specialize();
+    // 复制为同策略的新列表(拆箱元素是不可变值, 无需逐个复制对象)
+    [[nodiscard]] List* clone_unboxed() const;
+    // 取从start开始、步长step的count个元素组成新列表, 保持当前策略(Generic下共享元素对象)
+    [[nodiscard]] List* slice(size_t start, int64_t step, size_t count) const;
+    // 不装箱地写出第i个元素(仅用于非Generic策略)
+    void write_unboxed(size_t i, std::string& out, bool debug) const;
+
     [[nodiscard]] std::string debug_string() const override {
-        std::string result = "[";
-        for (size_t i = 0; i < val.size(); ++i) {
-            if (val[i] != nullptr) {
-                result += val[i]->debug_string();  // 递归调用元素的 to_string
+        std::string result;
+        write_debug_string(result);
+        return result;
+    }
+    void write_debug_string(std::string& out) const override {
+        out += '[';
+        const size_t n = size();
+        for (size_t i = 0; i < n; ++i) {
+            if (i != 0) out += ", ";
+            if (strategy_ != Strategy::Generic) {
+                write_unboxed(i, out, true);
+            } else if (val[i] != nullptr) {
+                val[i]->write_debug_string(out);
             } else {
-                result += "Nil";
-            }
-            if (i != val.size() - 1) {
-                result += ", ";
+                out += "Nil";
             }
         }
-        result += "]";
-        return result;
+        out += ']';
     }
+
+private:
+    Strategy strategy_ = Strategy::Generic;
+    std::vector<int64_t> ints_;
+    std::vector<dep::Decimal> decimals_;
+    std::vector<std::string> strs_;
+
+    // 单个元素可用的拆箱策略, 无法拆箱时为Generic
+    static Strategy strategy_of(const Object* elem);
+    // 按当前策略存入elem, 类型不符时返回false
+    bool store_unboxed(Object* elem);
 };
 
 class Decimal : public Object {
@@ -272,49 +379,597 @@ public:
     }
 };
 
+// IEEE-754双精度浮点数, 与任意精度的Decimal并存
+class Float : public Object {
+public:
+    double val;
+    static constexpr ObjectType TYPE = ObjectType::OT_Float;
+    [[nodiscard]] ObjectType get_type() const override { return TYPE; }
+    explicit Float(const double val) : val(val) {
+        attrs.insert("__parent__", based_float);
+    }
+    [[nodiscard]] std::string debug_string() const override {
+        return to_string(val);
+    }
+    // 最短可往返的表示, 整数值补".0"以区别于Int
+    static std::string to_string(const double v) {
+        if (std::isnan(v)) return "nan";
+        if (std::isinf(v)) return v > 0 ? "inf" : "-inf";
+        char buf[32];
+        const auto end = std::to_chars(buf, buf + sizeof(buf), v).ptr;
+        std::string res(buf, end);
+        if (res.find_first_of(".e") == std::string::npos) res += ".0";
+        return res;
+    }
+};
+
 class String : public Object {
+    // 惰性拼接(rope): rope_left_ 非空时 val_ 尚未生成, 首次读取时展平
+    mutable std::string val_;
+    mutable String* rope_left_ = nullptr;
+    mutable String* rope_right_ = nullptr;
+    // 切片视图: view_root_ 非空时内容为 view_root_->val_[view_offset_, view_offset_+byte_size_)
+    mutable String* view_root_ = nullptr;
+    size_t view_offset_ = 0;
+    size_t byte_size_ = 0;
+    // 字符串不可变, 哈希值与字符数首次计算后缓存
+    mutable size_t hash_ = 0;
+    mutable bool hash_cached_ = false;
+    mutable size_t char_size_ = std::string::npos;
+
+    // 按中序把rope的所有叶子写入val_ (迭代实现, 避免长链递归爆栈)
+    void flatten() const {
+        std::string buf;
+        buf.reserve(byte_size_);
+        std::vector<const String*> pending {rope_right_, rope_left_};
+        while (!pending.empty()) {
+            auto node = pending.back();
+            pending.pop_back();
+            if (node->rope_left_ != nullptr) {
+                pending.push_back(node->rope_right_);
+                pending.push_back(node->rope_left_);
+            } else {
+                buf += node->view();
+            }
+        }
+        val_ = std::move(buf);
+        release_rope(rope_left_, rope_right_);
+        rope_left_ = rope_right_ = nullptr;
+    }
+
+    // 切片视图要求根字符串的val_已生成
+    void flatten_if_rope() const {
+        if (rope_left_ != nullptr) flatten();
+    }
+
+    // 释放子节点, 同样迭代处理以免析构链递归
+    static void release_rope(String* left, String* right) {
+        std::vector<String*> pending {left, right};
+        while (!pending.empty()) {
+            auto node = pending.back();
+            pending.pop_back();
+            if (node->get_refc_() == 1 and node->rope_left_ != nullptr) {
+                pending.push_back(node->rope_left_);
+                pending.push_back(node->rope_right_);
+                node->rope_left_ = node->rope_right_ = nullptr;
+            }
+            node->del_ref();
+        }
+    }
+
+    // 视图以根字符串的展平内容为底, 不复制字节
+    String(String* root, const size_t offset, const size_t size)
+        : view_root_(root), view_offset_(offset), byte_size_(size) {
+        root->make_ref();
+        attrs.insert("__parent__", based_str);
+        attrs.insert("__current_index__", new Int(0));
+    }
+
 public:
-    std::string val;
+    // 拼接结果小于该长度时直接复制, 不建rope节点
+    static constexpr size_t rope_threshold = 256;
+    // 切片小于该长度, 或根字符串超过切片的view_pin_ratio倍时直接复制, 避免小切片钉住大缓冲区
+    static constexpr size_t view_threshold = 64;
+    static constexpr size_t view_pin_ratio = 8;
 
     static constexpr ObjectType TYPE = ObjectType::OT_String;
     [[nodiscard]] ObjectType get_type() const override { return TYPE; }
 
-    explicit String(std::string val) : val(std::move(val)) {
+    explicit String(std::string val) : val_(std::move(val)) {
+        byte_size_ = val_.size();
+        attrs.insert("__parent__", based_str);
+        attrs.insert("__current_index__", new Int(0));
+    }
+
+    // 惰性拼接 left + right, 不复制内容
+    String(String* left, String* right) : rope_left_(left), rope_right_(right) {
+        byte_size_ = left->byte_size_ + right->byte_size_;
+        left->make_ref();
+        right->make_ref();
         attrs.insert("__parent__", based_str);
         attrs.insert("__current_index__", new Int(0));
     }
+
+    ~String() override {
+        if (rope_left_ != nullptr) release_rope(rope_left_, rope_right_);
+        if (view_root_ != nullptr) view_root_->del_ref();
+    }
+
+    // 取字节区间[begin, end)的子串: 足够大时共享根字符串的缓冲区, 否则复制
+    static String* slice(String* src, const size_t begin, const size_t end) {
+        const size_t size = end - begin;
+        String* root = src;
+        size_t offset = begin;
+        if (src->view_root_ != nullptr) {
+            root = src->view_root_;
+            offset += src->view_offset_;
+        }
+        if (size < view_threshold or root->byte_size_ / view_pin_ratio > size) {
+            return new String(std::string(src->view().substr(begin, size)));
+        }
+        root->flatten_if_rope();
+        return new String(root, offset, size);
+    }
+
+    // 字符串内容(必要时先展平; 视图在此复制出独立内容并释放根字符串)
+    [[nodiscard]] const std::string& val() const {
+        flatten_if_rope();
+        if (view_root_ != nullptr) {
+            val_.assign(view());
+            view_root_->del_ref();
+            view_root_ = nullptr;
+        }
+        return val_;
+    }
+
+    // 只读访问内容, 视图不会被复制
+    [[nodiscard]] std::string_view view() const {
+        if (view_root_ != nullptr) {
+            return std::string_view(view_root_->val_).substr(view_offset_, byte_size_);
+        }
+        return val();
+    }
+
+    // 字节长度, 不触发展平
+    [[nodiscard]] size_t byte_size() const {
+        return byte_size_;
+    }
+
+    // UTF-8字符数; 与byte_size相等说明是纯ASCII, 字符下标即字节偏移
+    [[nodiscard]] size_t char_size() const {
+        if (char_size_ == std::string::npos) {
+            size_t count = 0;
+            for (const unsigned char c : view()) count += (c & 0xC0) != 0x80;
+            char_size_ = count;
+        }
+        return char_size_;
+    }
+
+    [[nodiscard]] size_t hash() const {
+        if (!hash_cached_) {
+            hash_ = dep::hash_string(view());
+            hash_cached_ = true;
+        }
+        return hash_;
+    }
+
+    // 内容相等: 先比长度, 双方哈希都已缓存时再比哈希, 最后逐字节比较
+    [[nodiscard]] bool equals(const String& other) const {
+        if (this == &other) return true;
+        if (byte_size_ != other.byte_size_) return false;
+        if (hash_cached_ and other.hash_cached_ and hash_ != other.hash_) return false;
+        return view() == other.view();
+    }
+
+    [[nodiscard]] std::string debug_string() const override {
+        std::string result;
+        result.reserve(byte_size_ + 2);
+        result += '"';
+        result += view();
+        result += '"';
+        return result;
+    }
+};
+
+// 字符串构建器: 片段追加均摊O(1), 生成结果时一次性分配
+class StrBuilder : public Object {
+public:
+    std::vector<std::string> parts;
+    size_t byte_size = 0;
+
+    static constexpr ObjectType TYPE = ObjectType::OT_StrBuilder;
+    [[nodiscard]] ObjectType get_type() const override { return TYPE; }
+
+    StrBuilder() {
+        attrs.insert("__parent__", based_str_builder);
+    }
+
+    void append(std::string part) {
+        byte_size += part.size();
+        parts.emplace_back(std::move(part));
+    }
+
+    // 以sep连接所有片段
+    [[nodiscard]] std::string join(const std::string& sep) const {
+        std::string result;
+        if (parts.empty()) return result;
+        result.reserve(byte_size + sep.size() * (parts.size() - 1));
+        for (size_t i = 0; i < parts.size(); ++i) {
+            if (i != 0) result += sep;
+            result += parts[i];
+        }
+        return result;
+    }
+
+    [[nodiscard]] std::string debug_string() const override {
+        return "<StrBuilder at " + ptr_to_string(this) + ">";
+    }
+};
+
+// 惰性迭代器: 适配器只记录上游与回调, 由消费端(collect/for等)逐个拉取, 整条链一次遍历完成
+class Iterator : public Object {
+public:
+    enum class Kind : uint8_t {
+        ListSource,   // 按下标读取source(List), 不复制列表
+        SetSource,    // 按插入顺序读取source(Set)的条目
+        TupleSource,  // 按下标读取source(Tuple)
+        DictKeys, DictValues, DictItems,  // 原地遍历source(Dictionary)的哈希表
+        ObjectSource, // 调用source的__next__
+        Map, Filter, Take, Zip, Enumerate, Chain
+    };
+
+    Kind kind;
+    Object* source;            // 源对象或上游迭代器
+    Object* other = nullptr;   // zip/chain的第二个上游
+    Object* func = nullptr;    // map/filter的回调
+    List* arg_slot = nullptr;  // 回调的参数列表, 每次调用只替换其中的元素
+    size_t index = 0;          // 源下标/字典游标/enumerate计数/take已产出个数/chain当前上游
+    size_t limit = 0;          // take上限/字典游标的桶内位置
+    size_t version = 0;        // 字典迭代开始时的修改计数
+    bool exhausted = false;
+
+    static constexpr ObjectType TYPE = ObjectType::OT_Iterator;
+    [[nodiscard]] ObjectType get_type() const override { return TYPE; }
+
+    Iterator(const Kind kind, Object* source, Object* other = nullptr, Object* func = nullptr)
+        : kind(kind), source(source), other(other), func(func) {
+        attrs.insert("__parent__", based_iterator);
+        source->make_ref();
+        if (other) other->make_ref();
+        if (func) {
+            func->make_ref();
+            arg_slot = new List(std::vector<Object*>{nullptr});
+        }
+    }
+
+    ~Iterator() override {
+        source->del_ref();
+        if (other) other->del_ref();
+        if (func) func->del_ref();
+    }
+
     [[nodiscard]] std::string debug_string() const override {
-        return '"'+val+'"';
+        return "<Iterator at " + ptr_to_string(this) + ">";
     }
 };
 
+// 切片 start:stop:step, 省略的部分为Nil; 三个部分同时作为属性暴露给自定义__getitem__
+class Slice : public Object {
+public:
+    Object* start;
+    Object* stop;
+    Object* step;
+
+    static constexpr ObjectType TYPE = ObjectType::OT_Slice;
+    [[nodiscard]] ObjectType get_type() const override { return TYPE; }
+
+    Slice(Object* start, Object* stop, Object* step) : start(start), stop(stop), step(step) {
+        attrs.insert("__parent__", based_slice);
+        // 引用由attrs持有, 析构时随attrs一并释放
+        start->make_ref();
+        stop->make_ref();
+        step->make_ref();
+        attrs.insert("start", start);
+        attrs.insert("stop", stop);
+        attrs.insert("step", step);
+    }
+
+    [[nodiscard]] std::string debug_string() const override {
+        return "Slice(" + start->debug_string() + ", " + stop->debug_string() + ", " + step->debug_string() + ")";
+    }
+};
+
+// 不可变元组: 对象头与元素数组在同一次分配中, 结构哈希首次计算后缓存
+class Tuple : public Object {
+    struct ElemCount { size_t n; };
+
+    size_t size_;
+    mutable size_t hash_ = 0;
+    mutable bool hash_cached_ = false;
+
+    explicit Tuple(const size_t size) : size_(size) {
+        attrs.insert("__parent__", based_tuple);
+        std::fill_n(data(), size, nullptr);
+    }
+
+    // 元素数组紧跟在对象之后
+    static void* operator new(const size_t base, const ElemCount count) {
+        return ::operator new(base + count.n * sizeof(Object*));
+    }
+    static void operator delete(void* p, ElemCount) {
+        ::operator delete(p);
+    }
+
+    Object** data() { return reinterpret_cast<Object**>(this + 1); }
+    [[nodiscard]] Object* const* data() const { return reinterpret_cast<Object* const*>(this + 1); }
+
+public:
+    static void operator delete(void* p) {
+        ::operator delete(p);
+    }
+
+    static constexpr ObjectType TYPE = ObjectType::OT_Tuple;
+    [[nodiscard]] ObjectType get_type() const override { return TYPE; }
+
+    // 以elems构造, 元素各持有一次引用
+    static Tuple* create(const std::vector<Object*>& elems) {
+        const auto tuple = new (ElemCount{elems.size()}) Tuple(elems.size());
+        for (size_t i = 0; i < elems.size(); ++i) {
+            elems[i]->make_ref();
+            tuple->data()[i] = elems[i];
+        }
+        return tuple;
+    }
+
+    ~Tuple() override {
+        for (size_t i = 0; i < size_; ++i) data()[i]->del_ref();
+    }
+
+    [[nodiscard]] size_t size() const { return size_; }
+    [[nodiscard]] Object* get(const size_t i) const { return data()[i]; }
+    [[nodiscard]] Object* const* begin() const { return data(); }
+    [[nodiscard]] Object* const* end() const { return data() + size_; }
+
+    // 由各元素的哈希组合而成(元素须可哈希)
+    [[nodiscard]] size_t hash() const;
+
+    [[nodiscard]] std::string debug_string() const override {
+        std::string result;
+        write_debug_string(result);
+        return result;
+    }
+    void write_debug_string(std::string& out) const override {
+        out += '(';
+        for (size_t i = 0; i < size_; ++i) {
+            if (i != 0) out += ", ";
+            data()[i]->write_debug_string(out);
+        }
+        if (size_ == 1) out += ',';
+        out += ')';
+    }
+};
+
+// 集合: 紧凑哈希表, entries_按插入顺序存放元素, index_为开放寻址(线性探测)的下标表
+// int64范围内的Int与Str直接存值, 使用原生哈希; 其他对象持有引用, 哈希与相等经过__hash__/__eq__
+class Set : public Object {
+public:
+    enum class Kind : uint8_t { Deleted, Int, Str, Object };
+
+    struct Entry {
+        size_t hash = 0;
+        Kind kind = Kind::Deleted;
+        int64_t int_val = 0;
+        std::string str_val;
+        Object* obj = nullptr;
+    };
+
+    // 查找用的键, 不复制字符串内容
+    struct Key {
+        size_t hash = 0;
+        Kind kind = Kind::Object;
+        int64_t int_val = 0;
+        std::string_view str_val;
+        Object* obj = nullptr;
+    };
+
+    static constexpr ObjectType TYPE = ObjectType::OT_Set;
+    [[nodiscard]] ObjectType get_type() const override { return TYPE; }
+
+    Set() {
+        attrs.insert("__parent__", based_set);
+    }
+
+    ~Set() override {
+        for (const auto& e : entries_) {
+            if (e.kind == Kind::Object) e.obj->del_ref();
+        }
+    }
+
+    // 整数哈希(splitmix64的混合步骤), 使相邻整数分散到不同槽位
+    static size_t hash_int(const int64_t v) {
+        auto x = static_cast<uint64_t>(v);
+        x ^= x >> 30; x *= 0xbf58476d1ce4e5b9ULL;
+        x ^= x >> 27; x *= 0x94d049bb133111ebULL;
+        x ^= x >> 31;
+        return x;
+    }
+    static Key int_key(const int64_t v) {
+        return Key{hash_int(v), Kind::Int, v, {}, nullptr};
+    }
+    static Key str_key(const std::string_view v, const size_t hash) {
+        return Key{hash, Kind::Str, 0, v, nullptr};
+    }
+    static Key entry_key(const Entry& e) {
+        return Key{e.hash, e.kind, e.int_val, e.str_val, e.obj};
+    }
+    // 任意对象的键(Object类会调用__hash__)
+    static Key key_of(Object* elem);
+
+    [[nodiscard]] size_t size() const { return count_; }
+    [[nodiscard]] bool empty() const { return count_ == 0; }
+    // 按插入顺序存放, 已删除的位置kind为Deleted
+    [[nodiscard]] const std::vector<Entry>& entries() const { return entries_; }
+
+    [[nodiscard]] bool contains(const Key& key) const { return find(key) >= 0; }
+    // 返回是否新插入
+    bool add(const Key& key);
+    // 返回是否确实删除了元素
+    bool remove(const Key& key);
+    void clear();
+    // 条目装箱为对象(Int/Str新建, 其他返回原对象)
+    [[nodiscard]] static Object* box(const Entry& e);
+    [[nodiscard]] Set* clone() const;
+
+    [[nodiscard]] std::string debug_string() const override {
+        std::string result;
+        write_debug_string(result);
+        return result;
+    }
+    void write_debug_string(std::string& out) const override;
+
+private:
+    static constexpr int32_t empty_slot = -1;
+    static constexpr int32_t deleted_slot = -2;
+
+    std::vector<Entry> entries_;
+    std::vector<int32_t> index_;
+    size_t count_ = 0;
+
+    static bool key_equals(const Entry& e, const Key& key);
+    // 返回key在entries_中的下标, 不存在时返回-1
+    [[nodiscard]] int64_t find(const Key& key) const;
+    // 丢弃已删除条目并按容量重建下标表
+    void rebuild(size_t capacity);
+};
+
+// 键全部为Str时使用专门的开放寻址表(按插入顺序存放, 直接比较字节, 不经过VM);
+// 出现第一个非Str键时整体转为以__hash__结果为键的通用表示
 class Dictionary : public Object {
 public:
-    dep::Dict<std::pair<Object*, Object*>> val;
+    using Pair = std::pair<Object*, Object*>;
+
     static constexpr ObjectType TYPE = ObjectType::OT_Dictionary;
     [[nodiscard]] ObjectType get_type() const override { return TYPE; }
 
-    explicit Dictionary(dep::Dict<std::pair<Object*, Object*>> val_) : val(std::move(val_)) {
-        attrs.insert("__parent__", based_dict);
-    }
     explicit Dictionary() {
         attrs.insert("__parent__", based_dict);
     }
 
-    [[nodiscard]] std::string debug_string() const override {
-        std::string result = "{";
-        auto kv_list = val.to_vector();
-        size_t i = 0;
-        for (auto& [_, kv_pair] : kv_list) {
-            result += kv_pair.first->debug_string() + ": " + kv_pair.second->debug_string();
-            if (i != kv_list.size() - 1) {
-                result += ", ";
+    [[nodiscard]] size_t size() const { return str_mode_ ? str_count_ : generic_.size(); }
+    [[nodiscard]] bool str_keys() const { return str_mode_; }
+    // 结构修改计数(增删键/扩容/转换表示), 供迭代器检测并发修改
+    [[nodiscard]] size_t version() const { return version_; }
+
+    // 查找键, 不存在时返回nullptr
+    [[nodiscard]] Pair* find(Object* key);
+    // 插入或更新; 键已存在时保留原键对象只替换值
+    void insert(Object* key, Object* value);
+    bool erase(Object* key);
+    // 保证再插入n个键前不扩容
+    void reserve(size_t n);
+    // 原地游标: 返回当前键值对并前移, 结束时返回nullptr; 顺序与for_each一致
+    const Pair* cursor_next(size_t& index, size_t& pos) const;
+
+    template <typename F>
+    void for_each(F&& f) const {
+        if (str_mode_) {
+            for (const auto& e : str_entries_) {
+                if (e.kv.first != nullptr) f(e.kv);
+            }
+        } else {
+            generic_.for_each([&](const dep::BigInt&, const Pair& kv) { f(kv); });
+        }
+    }
+
+    // 复制结构(键增加引用), 值经copy_value处理; 通用表示不重新计算哈希
+    template <typename F>
+    Dictionary* clone(F&& copy_value) const {
+        const auto copied = new Dictionary();
+        copied->str_mode_ = str_mode_;
+        if (str_mode_) {
+            copied->str_entries_.reserve(str_count_);
+            for (const auto& e : str_entries_) {
+                if (e.kv.first == nullptr) continue;
+                e.kv.first->make_ref();
+                copied->str_entries_.push_back(StrEntry{e.hash, Pair{e.kv.first, copy_value(e.kv.second)}});
             }
-            ++i;
+            copied->str_count_ = str_count_;
+            copied->str_rebuild(str_count_);
+        } else {
+            copied->generic_.reserve(generic_.size());
+            generic_.for_each([&](const dep::BigInt& hash, const Pair& kv) {
+                kv.first->make_ref();
+                copied->generic_.insert(hash, Pair{kv.first, copy_value(kv.second)});
+            });
         }
-        result += "}";
+        return copied;
+    }
+
+    [[nodiscard]] std::string debug_string() const override {
+        std::string result;
+        write_debug_string(result);
         return result;
     }
+    void write_debug_string(std::string& out) const override {
+        bool first = true;
+        out += '{';
+        for_each([&](const Pair& kv_pair) {
+            if (!first) out += ", ";
+            first = false;
+            kv_pair.first->write_debug_string(out);
+            out += ": ";
+            kv_pair.second->write_debug_string(out);
+        });
+        out += '}';
+    }
+
+private:
+    // kv.first为nullptr表示已删除
+    struct StrEntry {
+        size_t hash;
+        Pair kv;
+    };
+    static constexpr int32_t empty_slot = -1;
+    static constexpr int32_t deleted_slot = -2;
+
+    bool str_mode_ = true;
+    std::vector<StrEntry> str_entries_;
+    std::vector<int32_t> str_index_;
+    size_t str_count_ = 0;
+    dep::Dict<Pair> generic_;
+    size_t version_ = 0;
+
+    // 返回键在str_entries_中的下标, 不存在时返回-1
+    [[nodiscard]] int64_t str_find(std::string_view key, size_t hash) const;
+    // 压缩已删除的条目并按容量重建下标表
+    void str_rebuild(size_t capacity);
+    // 把Str表中的键值对转入通用表示
+    void generalize();
+};
+
+// Dict.keys()/values()/items()返回的视图, 不复制内容, 始终反映字典的当前状态
+class DictView : public Object {
+public:
+    enum class Kind : uint8_t { Keys, Values, Items };
+
+    Dictionary* dict;
+    Kind kind;
+
+    static constexpr ObjectType TYPE = ObjectType::OT_DictView;
+    [[nodiscard]] ObjectType get_type() const override { return TYPE; }
+
+    DictView(Dictionary* dict, const Kind kind) : dict(dict), kind(kind) {
+        attrs.insert("__parent__", based_dict_view);
+        dict->make_ref();
+    }
+
+    ~DictView() override {
+        dict->del_ref();
+    }
+
+    [[nodiscard]] std::string debug_string() const override {
+        return "<DictView at " + ptr_to_string(this) + ">";
+    }
 };
 
 class Bool : public Object {
@@ -366,9 +1021,234 @@ public:
     }
 };
 
+inline List::Strategy List::strategy_of(const Object* elem) {
+    switch (elem->get_type()) {
+    case ObjectType::OT_Int: {
+        int64_t v;
+        return dynamic_cast<const model::Int*>(elem)->val.to_int64(v) ? Strategy::Int : Strategy::Generic;
+    }
+    case ObjectType::OT_Decimal: return Strategy::Decimal;
+    case ObjectType::OT_String: return Strategy::Str;
+    default: return Strategy::Generic;
+    }
+}
+
+inline bool List::store_unboxed(Object* elem) {
+    if (strategy_of(elem) != strategy_) return false;
+    switch (strategy_) {
+    case Strategy::Int: {
+        // strategy_of已确认可转为int64
+        int64_t v = 0;
+        static_cast<void>(dynamic_cast<model::Int*>(elem)->val.to_int64(v));
+        ints_.push_back(v);
+        return true;
+    }
+    case Strategy::Decimal:
+        decimals_.push_back(dynamic_cast<model::Decimal*>(elem)->val);
+        return true;
+    case Strategy::Str:
+        strs_.push_back(dynamic_cast<String*>(elem)->val());
+        return true;
+    default:
+        return false;
+    }
+}
+
+inline size_t List::size() const {
+    switch (strategy_) {
+    case Strategy::Int: return ints_.size();
+    case Strategy::Decimal: return decimals_.size();
+    case Strategy::Str: return strs_.size();
+    default: return val.size();
+    }
+}
+
+inline Object* List::get(const size_t i) const {
+    switch (strategy_) {
+    case Strategy::Int: return new model::Int(dep::BigInt::from_int64(ints_[i]));
+    case Strategy::Decimal: return new model::Decimal(decimals_[i]);
+    case Strategy::Str: return new String(strs_[i]);
+    default: return val[i];
+    }
+}
+
+inline void List::set(const size_t i, Object* elem) {
+    if (strategy_ != Strategy::Generic and strategy_of(elem) == strategy_) {
+        // Int策略下strategy_of已确认可转为int64
+        switch (strategy_) {
+        case Strategy::Int: static_cast<void>(dynamic_cast<model::Int*>(elem)->val.to_int64(ints_[i])); return;
+        case Strategy::Decimal: decimals_[i] = dynamic_cast<model::Decimal*>(elem)->val; return;
+        case Strategy::Str: strs_[i] = dynamic_cast<String*>(elem)->val(); return;
+        default: break;
+        }
+    }
+    generalize();
+    elem->make_ref();
+    val[i] = elem;
+}
+
+inline void List::append(Object* elem) {
+    if (strategy_ == Strategy::Empty) strategy_ = strategy_of(elem);
+    if (strategy_ != Strategy::Generic and store_unboxed(elem)) return;
+    generalize();
+    elem->make_ref();
+    val.push_back(elem);
+}
+
+inline void List::extend(const List& other) {
+    if (strategy_ == Strategy::Empty and other.strategy_ != Strategy::Generic) {
+        strategy_ = other.strategy_;
+    }
+    if (strategy_ == other.strategy_ and strategy_ != Strategy::Generic) {
+        // 先reserve再按下标追加, other与自身相同时也安全
+        auto append_all = [](auto& dst, const auto& src) {
+            const size_t n = src.size();
+            dst.reserve(dst.size() + n);
+            for (size_t k = 0; k < n; ++k) dst.push_back(src[k]);
+        };
+        append_all(ints_, other.ints_);
+        append_all(decimals_, other.decimals_);
+        append_all(strs_, other.strs_);
+        return;
+    }
+    const size_t n = other.size();
+    for (size_t k = 0; k < n; ++k) {
+        append(other.get(k));
+    }
+}
+
+inline void List::reserve(const size_t n) {
+    switch (strategy_) {
+    case Strategy::Int: ints_.reserve(n); break;
+    case Strategy::Decimal: decimals_.reserve(n); break;
+    case Strategy::Str: strs_.reserve(n); break;
+    case Strategy::Generic: val.reserve(n); break;
+    default: break;
+    }
+}
+
+inline void List::pop_back() {
+    switch (strategy_) {
+    case Strategy::Int: ints_.pop_back(); break;
+    case Strategy::Decimal: decimals_.pop_back(); break;
+    case Strategy::Str: strs_.pop_back(); break;
+    default: val.pop_back(); break;
+    }
+}
+
+inline void List::reverse() {
+    std::ranges::reverse(ints_);
+    std::ranges::reverse(decimals_);
+    std::ranges::reverse(strs_);
+    std::ranges::reverse(val);
+}
+
+inline void List::permute(const std::vector<size_t>& order) {
+    auto apply = [&order](auto& arr) {
+        if (arr.empty()) return;
+        std::remove_reference_t<decltype(arr)> result;
+        result.reserve(order.size());
+        for (const size_t k : order) result.push_back(std::move(arr[k]));
+        arr = std::move(result);
+    };
+    apply(ints_);
+    apply(decimals_);
+    apply(strs_);
+    apply(val);
+}
+
+inline void List::generalize() {
+    if (strategy_ == Strategy::Generic) return;
+    const size_t n = size();
+    val.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+        val.push_back(get(i));
+    }
+    ints_ = {};
+    decimals_ = {};
+    strs_ = {};
+    strategy_ = Strategy::Generic;
+}
+
+inline void List::specialize() {
+    if (strategy_ != Strategy::Generic) return;
+    if (val.empty()) {
+        strategy_ = Strategy::Empty;
+        return;
+    }
+    const Strategy target = strategy_of(val[0]);
+    if (target == Strategy::Generic) return;
+    for (const auto elem : val) {
+        if (elem == nullptr or strategy_of(elem) != target) return;
+    }
+    strategy_ = target;
+    for (const auto elem : val) {
+        store_unboxed(elem);
+        elem->del_ref();
+    }
+    val = {};
+}
+
+inline List* List::clone_unboxed() const {
+    auto list = create_empty();
+    list->strategy_ = strategy_;
+    list->ints_ = ints_;
+    list->decimals_ = decimals_;
+    list->strs_ = strs_;
+    return list;
+}
+
+inline List* List::slice(const size_t start, const int64_t step, const size_t count) const {
+    // 按步长逐个取出, step为1时即连续区间复制
+    auto pick = [&](const auto& src) {
+        std::remove_cvref_t<decltype(src)> out;
+        out.reserve(count);
+        auto idx = static_cast<int64_t>(start);
+        for (size_t k = 0; k < count; ++k, idx += step) out.push_back(src[static_cast<size_t>(idx)]);
+        return out;
+    };
+    if (strategy_ == Strategy::Generic) {
+        auto elems = pick(val);
+        for (const auto e : elems) if (e) e->make_ref();
+        const auto list = new List(std::move(elems));
+        list->specialize();
+        return list;
+    }
+    auto list = create_empty();
+    if (count == 0) return list;
+    list->strategy_ = strategy_;
+    switch (strategy_) {
+    case Strategy::Int: list->ints_ = pick(ints_); break;
+    case Strategy::Decimal: list->decimals_ = pick(decimals_); break;
+    case Strategy::Str: list->strs_ = pick(strs_); break;
+    default: break;
+    }
+    return list;
+}
+
+inline void List::write_unboxed(const size_t i, std::string& out, const bool debug) const {
+    switch (strategy_) {
+    case Strategy::Int:
+        out += std::to_string(ints_[i]);
+        break;
+    case Strategy::Decimal:
+        out += decimals_[i].to_string();
+        break;
+    case Strategy::Str:
+        if (debug) out += '"';
+        out += strs_[i];
+        if (debug) out += '"';
+        break;
+    default:
+        assert(false && "List::write_unboxed: Generic策略应直接访问val");
+    }
+}
+
 inline auto unique_nil = new Nil();
 inline auto unique_false = new Bool(false);
 inline auto unique_true = new Bool(true);
+// 迭代结束标记: __next__返回它表示没有更多元素(内置名StopIter)
+inline auto unique_stop_iter = new Object();
 
 inline auto load_nil() {
     unique_nil->make_ref();
@@ -384,7 +1264,12 @@ inline auto load_true() {
 }
 
 inline auto load_bool(bool b) {
-    return b ? load_false() : load_true();
+    return b ? load_true() : load_false();
+}
+
+inline auto load_stop_iter() {
+    unique_stop_iter->make_ref();
+    return unique_stop_iter;
 }
 
 inline auto create_int(dep::BigInt n) {
@@ -397,11 +1282,129 @@ inline auto create_str(std::string n) {
     return o;
 }
 
+// 拼接两个字符串: 较长时返回rope节点, 否则直接复制
+inline auto concat_str(String* left, String* right) {
+    if (left->byte_size() + right->byte_size() < String::rope_threshold) {
+        std::string joined;
+        joined.reserve(left->byte_size() + right->byte_size());
+        joined += left->view();
+        joined += right->view();
+        return new String(std::move(joined));
+    }
+    return new String(left, right);
+}
+
 inline auto create_decimal(dep::Decimal n) {
     auto o = new Decimal(std::move(n));
     return o;
 }
 
+inline auto create_float(const double n) {
+    auto o = new Float(n);
+    return o;
+}
+
+inline double decimal_to_double(const dep::Decimal& d) {
+    const std::string text = d.mantissa().to_string() + "e" + std::to_string(d.exponent());
+    return std::strtod(text.c_str(), nullptr);
+}
+
+// Int按双精度取值(就近舍入)
+inline double int_to_double(const dep::BigInt& n) {
+    if (int64_t small; n.to_int64(small) and small > -(int64_t{1} << 53) and small < (int64_t{1} << 53)) {
+        return static_cast<double>(small);
+    }
+    return std::strtod(n.to_string().c_str(), nullptr);
+}
+
+// Int/Decimal/Float按双精度取值(就近舍入), 其他类型返回false
+inline bool as_double(const Object* obj, double& out) {
+    switch (obj->get_type()) {
+    case Object::ObjectType::OT_Float:
+        out = static_cast<const Float*>(obj)->val;
+        return true;
+    case Object::ObjectType::OT_Int:
+        out = int_to_double(static_cast<const Int*>(obj)->val);
+        return true;
+    case Object::ObjectType::OT_Decimal:
+        out = decimal_to_double(static_cast<const Decimal*>(obj)->val);
+        return true;
+    default:
+        return false;
+    }
+}
+
+// 有限双精度数的精确十进制值(二进制小数总有有限位的十进制展开), nan/inf返回false
+inline bool exact_decimal(const double v, dep::Decimal& out) {
+    if (!std::isfinite(v)) return false;
+    int exp2;
+    // v = mant * 2^exp2, |mant| < 2^53
+    auto mant = static_cast<int64_t>(std::ldexp(std::frexp(v, &exp2), 53));
+    exp2 -= 53;
+    if (mant == 0) {
+        out = dep::Decimal();
+        return true;
+    }
+    while (mant % 2 == 0) {
+        mant /= 2;
+        ++exp2;
+    }
+    if (exp2 >= 0) {
+        out = dep::Decimal::from_parts(
+            dep::BigInt::from_int64(mant) * dep::BigInt::fast_pow_unsigned(dep::BigInt(2), dep::BigInt(exp2)), 0
+        );
+    } else {
+        // mant * 2^-k = mant * 5^k * 10^-k
+        out = dep::Decimal::from_parts(
+            dep::BigInt::from_int64(mant) * dep::BigInt::fast_pow_unsigned(dep::BigInt(5), dep::BigInt(-exp2)), exp2
+        );
+    }
+    return true;
+}
+
+// Float与数值比较相等: Int/Decimal按精确值比较, 不先舍入为双精度(0.1f != 0.1); 非数值返回false
+inline bool float_equals(const double x, const Object* other) {
+    switch (other->get_type()) {
+    case Object::ObjectType::OT_Float:
+        return x == static_cast<const Float*>(other)->val;
+    case Object::ObjectType::OT_Int: {
+        // 绝对值小于2^53的整数可精确转为双精度
+        const auto& n = static_cast<const Int*>(other)->val;
+        if (int64_t small; n.to_int64(small) and small > -(int64_t{1} << 53) and small < (int64_t{1} << 53)) {
+            return x == static_cast<double>(small);
+        }
+        dep::Decimal exact;
+        return exact_decimal(x, exact) and exact == dep::Decimal(n);
+    }
+    case Object::ObjectType::OT_Decimal: {
+        dep::Decimal exact;
+        return exact_decimal(x, exact) and exact == static_cast<const Decimal*>(other)->val;
+    }
+    default:
+        return false;
+    }
+}
+
+// Int/Decimal/Float共用的数值哈希: 整数值与对应Int的哈希相同, 其余取精确十进制值(已归一化)的哈希
+inline dep::BigInt decimal_value_hash(const dep::Decimal& d) {
+    return d.exponent() >= 0 ? d.integer_part() : d.hash();
+}
+
+// 任一操作数为Float且另一个为Int/Decimal/Float时取出两者的双精度值, 混合运算的结果为Float
+inline bool float_operands(const Object* a, const Object* b, double& x, double& y) {
+    if (a->get_type() != Object::ObjectType::OT_Float and b->get_type() != Object::ObjectType::OT_Float) {
+        return false;
+    }
+    return as_double(a, x) and as_double(b, y);
+}
+
+// 浮点取模: 结果与除数同号(与Int.__mod__一致), 除数为0时为nan
+inline double floor_fmod(const double a, const double b) {
+    double r = std::fmod(a, b);
+    if (r != 0 and (r < 0) != (b < 0)) r += b;
+    return r;
+}
+
 inline auto create_list(std::vector<Object*> n) {
     auto o = new List(n);
     o->make_ref();
@@ -436,27 +1439,30 @@ inline auto copy_or_ref(Object* obj) -> Object* {
     switch (obj->get_type()) {
 
     case Object::ObjectType::OT_List: {
+        const auto list_obj = cast_to_list(obj);
+        if (list_obj->strategy() != List::Strategy::Generic) {
+            const auto copied = list_obj->clone_unboxed();
+            copied->make_ref();
+            return copied;
+        }
         std::vector<Object*> new_val;
-        for (auto val : cast_to_list(obj)->val) {
+        for (auto val : list_obj->val) {
             new_val.push_back(copy_or_ref(val));
         }
         return create_list(std::move(new_val));
     }
 
+    case Object::ObjectType::OT_Set: {
+        const auto copied = dynamic_cast<Set*>(obj)->clone();
+        copied->make_ref();
+        return copied;
+    }
+
     case Object::ObjectType::OT_Dictionary: {
-        std::vector<std::pair<
-            dep::BigInt, std::pair< Object*, Object* >
-        >> elem_list;
         auto dict_obj = dynamic_cast<Dictionary*>(obj);
         assert(dict_obj != nullptr);
-        for (auto& [_, kv_pair] : dict_obj->val.to_vector()) {
-            // key是hashable value, 也就是不可变对象, 可以引用传递, 应该没有神人为可变对象重载__hash__方法的
-            kv_pair.first->make_ref();
-            elem_list.emplace_back(_, std::pair{
-                kv_pair.first, copy_or_ref(kv_pair.second)
-            });
-        }
-        return new Dictionary(dep::Dict(elem_list));
+        // key是hashable value, 也就是不可变对象, 可以引用传递, 应该没有神人为可变对象重载__hash__方法的
+        return dict_obj->clone([](Object* value) { return copy_or_ref(value); });
     }
 
     default: {
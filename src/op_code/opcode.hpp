@@ -25,8 +25,8 @@ enum class Opcode : uint8_t {
     LOAD_VAR, LOAD_CONST,
     SET_GLOBAL, SET_LOCAL, SET_NONLOCAL,
 
-    JUMP, JUMP_IF_FALSE, THROW, 
-    MAKE_LIST, MAKE_DICT,
+    JUMP, JUMP_IF_FALSE, GET_ITER, FOR_ITER, THROW, 
+    MAKE_LIST, LIST_APPEND, MAKE_SLICE, MAKE_SET, MAKE_TUPLE, UNPACK_SEQUENCE, MAKE_DICT, BUILD_STRING,
     IMPORT,
     ENTER_TRY, MARK_HANDLE_ERROR,
     JUMP_IF_FINISH_HANDLE_ERROR, LOAD_ERROR,
@@ -81,11 +81,19 @@ inline std::string opcode_to_string(Opcode opc) {
         // 流程控制
         case Opcode::JUMP:        return "JUMP";
         case Opcode::JUMP_IF_FALSE: return "JUMP_IF_FALSE";
+        case Opcode::GET_ITER:    return "GET_ITER";
+        case Opcode::FOR_ITER:    return "FOR_ITER";
         case Opcode::THROW:       return "THROW";
 
         // 容器创建
         case Opcode::MAKE_LIST:   return "MAKE_LIST";
+        case Opcode::LIST_APPEND: return "LIST_APPEND";
+        case Opcode::MAKE_SLICE:  return "MAKE_SLICE";
+        case Opcode::MAKE_SET:    return "MAKE_SET";
+        case Opcode::MAKE_TUPLE:  return "MAKE_TUPLE";
+        case Opcode::UNPACK_SEQUENCE: return "UNPACK_SEQUENCE";
         case Opcode::MAKE_DICT:   return "MAKE_DICT";
+        case Opcode::BUILD_STRING: return "BUILD_STRING";
 
         // 其他
         case Opcode::IMPORT:      return "IMPORT";
@@ -18,14 +18,14 @@ namespace kiz {
 enum class AstType {
     // 表达式类型（对应 Expr 子类）
     NilExpr, BoolExpr,
-    StringExpr, NumberExpr, DecimalExpr, ListExpr, IdentifierExpr,
+    StringExpr, NumberExpr, DecimalExpr, FloatExpr, ListExpr, ListCompExpr, SetExpr, TupleExpr, IdentifierExpr,
     BinaryExpr, UnaryExpr,
     CallExpr,
-    GetMemberExpr, GetItemExpr,
-    FuncDeclExpr, DictExpr,
+    GetMemberExpr, GetItemExpr, SliceExpr,
+    FuncDeclExpr, DictExpr, TemplateExpr,
 
     // 语句类型（对应 Stmt 子类）
-    AssignStmt, NonlocalAssignStmt, GlobalAssignStmt,
+    AssignStmt, UnpackAssignStmt, NonlocalAssignStmt, GlobalAssignStmt,
     SetMemberStmt, SetItemStmt,
     BlockStmt, IfStmt, WhileStmt,
     ReturnStmt, ImportStmt, ForStmt, TryStmt, CatchStmt,
@@ -57,6 +57,16 @@ struct StringExpr final :  Expr {
     }
 };
 
+// 模板字符串 f"...{expr}..."：字面量片段为StringExpr, 其余为内嵌表达式
+struct TemplateExpr final :  Expr {
+    std::vector<std::unique_ptr<Expr>> parts;
+    explicit TemplateExpr(const err::PositionInfo& pos, std::vector<std::unique_ptr<Expr>> p)
+        : parts(std::move(p)) {
+        this->pos = pos;
+        this->ast_type = AstType::TemplateExpr;
+    }
+};
+
 // 数字字面量
 struct NumberExpr final :  Expr {
     std::string value;
@@ -76,6 +86,16 @@ struct DecimalExpr final :  Expr {
     }
 };
 
+// 浮点数字面量, value不含后缀f
+struct FloatExpr final :  Expr {
+    std::string value;
+    explicit FloatExpr(const err::PositionInfo& pos, std::string v)
+        : value(std::move(v)) {
+        this->pos = pos;
+        this->ast_type = AstType::FloatExpr;
+    }
+};
+
 // 空值字面量
 struct NilExpr final : Expr {
     explicit NilExpr(const err::PositionInfo& pos) {
@@ -103,6 +123,43 @@ struct ListExpr final :  Expr {
     }
 };
 
+// 集合字面量 {a, b, ...}
+struct SetExpr final :  Expr {
+    std::vector<std::unique_ptr<Expr>> elements;
+    explicit SetExpr(const err::PositionInfo& pos, std::vector<std::unique_ptr<Expr>> elems)
+        : elements(std::move(elems)) {
+        this->pos = pos;
+        this->ast_type = AstType::SetExpr;
+    }
+};
+
+// 元组字面量 (a, b, ...), 单元素写作 (a,)
+struct TupleExpr final :  Expr {
+    std::vector<std::unique_ptr<Expr>> elements;
+    explicit TupleExpr(const err::PositionInfo& pos, std::vector<std::unique_ptr<Expr>> elems)
+        : elements(std::move(elems)) {
+        this->pos = pos;
+        this->ast_type = AstType::TupleExpr;
+    }
+};
+
+// 列表推导式 [elem for item_var_name in iter if cond]
+struct ListCompExpr final :  Expr {
+    std::unique_ptr<Expr> elem;
+    std::string item_var_name;
+    std::unique_ptr<Expr> iter;
+    std::unique_ptr<Expr> cond; // 可为空
+    ListCompExpr(const err::PositionInfo& pos,
+        std::unique_ptr<Expr> e,
+        std::string iv,
+        std::unique_ptr<Expr> i,
+        std::unique_ptr<Expr> c
+    ) : elem(std::move(e)), item_var_name(std::move(iv)), iter(std::move(i)), cond(std::move(c)) {
+        this->pos = pos;
+        this->ast_type = AstType::ListCompExpr;
+    }
+};
+
 // 字典字面量
 struct DictExpr final :  Expr {
     std::vector<std::pair<std::unique_ptr<Expr>, std::unique_ptr<Expr>>> elements;
@@ -157,6 +214,17 @@ struct AssignStmt final :  Stmt {
     }
 };
 
+// 解包赋值 a, b = expr
+struct UnpackAssignStmt final :  Stmt {
+    std::vector<std::string> names;
+    std::unique_ptr<Expr> expr;
+    UnpackAssignStmt(const err::PositionInfo& pos, std::vector<std::string> n, std::unique_ptr<Expr> e)
+        : names(std::move(n)), expr(std::move(e)) {
+        this->pos = pos;
+        this->ast_type = AstType::UnpackAssignStmt;
+    }
+};
+
 // nonlocal赋值
 struct NonlocalAssignStmt final :  Stmt {
     std::string name;
@@ -225,6 +293,8 @@ struct ThrowStmt final :  Stmt{
 // for语句
 struct ForStmt final :  Stmt {
     std::string item_var_name;
+    // for a, b in xs: 每个元素解包到这些变量(为空时直接存入item_var_name)
+    std::vector<std::string> unpack_names;
     std::unique_ptr<Expr> iter;
     std::unique_ptr<BlockStmt> body;
     explicit ForStmt(const err::PositionInfo& pos,
@@ -311,6 +381,21 @@ struct GetMemberExpr final :  Expr {
     }
 };
 
+// 切片 start:stop:step, 仅出现在下标中, 省略的部分为空
+struct SliceExpr final :  Expr {
+    std::unique_ptr<Expr> start;
+    std::unique_ptr<Expr> stop;
+    std::unique_ptr<Expr> step;
+    SliceExpr(const err::PositionInfo& pos,
+        std::unique_ptr<Expr> start,
+        std::unique_ptr<Expr> stop,
+        std::unique_ptr<Expr> step
+    ) : start(std::move(start)), stop(std::move(stop)), step(std::move(step)) {
+        this->pos = pos;
+        this->ast_type = AstType::SliceExpr;
+    }
+};
+
 // 获取项
 struct GetItemExpr final :  Expr {
     std::unique_ptr<Expr> father;
@@ -141,7 +141,20 @@ std::unique_ptr<Expr> Parser::parse_factor() {
             auto tok = curr_token();
 
             skip_token("[");
-            auto param = parse_args(TokenType::RBracket);
+            std::vector<std::unique_ptr<Expr>> param;
+            if (curr_token().type == TokenType::Colon) {
+                param.emplace_back(parse_slice(tok.pos, nullptr));
+            } else if (curr_token().type != TokenType::RBracket) {
+                auto first = parse_expression();
+                if (curr_token().type == TokenType::Colon) {
+                    param.emplace_back(parse_slice(tok.pos, std::move(first)));
+                } else {
+                    param.emplace_back(std::move(first));
+                    if (curr_token().type == TokenType::Comma) skip_token(",");
+                    auto rest = parse_args(TokenType::RBracket);
+                    for (auto& e : rest) param.emplace_back(std::move(e));
+                }
+            }
             skip_token("]");
             node = std::make_unique<GetItemExpr>(tok.pos, std::move(node),std::move(param));
         }
@@ -157,6 +170,21 @@ std::unique_ptr<Expr> Parser::parse_factor() {
     return node;
 }
 
+// 解析下标中的切片, 当前token为start之后的':'
+std::unique_ptr<Expr> Parser::parse_slice(const err::PositionInfo& pos, std::unique_ptr<Expr> start) {
+    skip_token(":");
+    std::unique_ptr<Expr> stop = nullptr;
+    std::unique_ptr<Expr> step = nullptr;
+    if (curr_token().type != TokenType::Colon and curr_token().type != TokenType::RBracket) {
+        stop = parse_expression();
+    }
+    if (curr_token().type == TokenType::Colon) {
+        skip_token(":");
+        if (curr_token().type != TokenType::RBracket) step = parse_expression();
+    }
+    return std::make_unique<SliceExpr>(pos, std::move(start), std::move(stop), std::move(step));
+}
+
 std::unique_ptr<Expr> Parser::parse_primary() {
     DEBUG_OUTPUT("parsing primary...");
     const auto tok = skip_token();
@@ -166,9 +194,17 @@ std::unique_ptr<Expr> Parser::parse_primary() {
     if (tok.type == TokenType::Decimal) {
         return std::make_unique<DecimalExpr>(tok.pos, tok.text);
     }
+    if (tok.type == TokenType::Float) {
+        return std::make_unique<FloatExpr>(tok.pos, tok.text);
+    }
     if (tok.type == TokenType::String) {
         return std::make_unique<StringExpr>(tok.pos, tok.text);
     }
+    if (tok.type == TokenType::TemplateBegin) {
+        auto parts = parse_args(TokenType::TemplateEnd);
+        skip_token("\"");
+        return std::make_unique<TemplateExpr>(tok.pos, std::move(parts));
+    }
     if (tok.type == TokenType::Nil) {
         return std::make_unique<NilExpr>(tok.pos);
     }
@@ -227,6 +263,16 @@ std::unique_ptr<Expr> Parser::parse_primary() {
         while (curr_token().type != TokenType::RBrace) {
             DEBUG_OUTPUT("parse dict item");
             auto key = parse_expression();
+            // 首项后为','或'}'时为集合字面量({}仍是空字典), 其他情况由skip_token(":")报语法错误
+            if (init_vec.empty() and (curr_token().type == TokenType::Comma or curr_token().type == TokenType::RBrace)) {
+                std::vector<std::unique_ptr<Expr>> elems;
+                elems.emplace_back(std::move(key));
+                if (curr_token().type == TokenType::Comma) skip_token(",");
+                auto rest = parse_args(TokenType::RBrace);
+                for (auto& e : rest) elems.emplace_back(std::move(e));
+                skip_token("}");
+                return std::make_unique<SetExpr>(tok.pos, std::move(elems));
+            }
             skip_token(":");
             auto val = parse_expression();
 
@@ -245,12 +291,49 @@ std::unique_ptr<Expr> Parser::parse_primary() {
         return std::make_unique<DictExpr>(curr_token().pos, std::move(init_vec));
     }
     if (tok.type == TokenType::LBracket) {
-        auto param = parse_args(TokenType::RBracket);
+        std::vector<std::unique_ptr<Expr>> param;
+        if (curr_token().type != TokenType::RBracket) {
+            auto first = parse_expression();
+            // 列表推导式: [elem for name in iter if cond]
+            if (curr_token().type == TokenType::For) {
+                skip_token("for");
+                const std::string name = skip_token().text;
+                skip_token("in");
+                auto iter = parse_expression();
+                std::unique_ptr<Expr> cond = nullptr;
+                if (curr_token().type == TokenType::If) {
+                    skip_token("if");
+                    cond = parse_expression();
+                }
+                skip_token("]");
+                return std::make_unique<ListCompExpr>(
+                    tok.pos, std::move(first), name, std::move(iter), std::move(cond)
+                );
+            }
+            param.emplace_back(std::move(first));
+            if (curr_token().type == TokenType::Comma) skip_token(",");
+            auto rest = parse_args(TokenType::RBracket);
+            for (auto& e : rest) param.emplace_back(std::move(e));
+        }
         skip_token("]");
         return std::make_unique<ListExpr>(curr_token().pos, std::move(param));
     }
     if (tok.type == TokenType::LParen) {
+        if (curr_token().type == TokenType::RParen) {
+            skip_token(")");
+            return std::make_unique<TupleExpr>(tok.pos, std::vector<std::unique_ptr<Expr>>{});
+        }
         auto expr = parse_expression();
+        // 括号内出现逗号即为元组
+        if (curr_token().type == TokenType::Comma) {
+            skip_token(",");
+            std::vector<std::unique_ptr<Expr>> elems;
+            elems.emplace_back(std::move(expr));
+            auto rest = parse_args(TokenType::RParen);
+            for (auto& e : rest) elems.emplace_back(std::move(e));
+            skip_token(")");
+            return std::make_unique<TupleExpr>(tok.pos, std::move(elems));
+        }
         skip_token(")");
         return expr;
     }
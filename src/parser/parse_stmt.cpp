@@ -253,13 +253,23 @@ std::unique_ptr<Stmt> Parser::parse_stmt() {
         DEBUG_OUTPUT("parsing for");
         auto tok = skip_token("for");
         const std::string name = skip_token().text;
+        std::vector<std::string> unpack_names;
+        if (curr_token().type == TokenType::Comma) {
+            unpack_names.push_back(name);
+            while (curr_token().type == TokenType::Comma) {
+                skip_token(",");
+                unpack_names.push_back(skip_token().text);
+            }
+        }
         skip_token("in");
         std::unique_ptr<Expr> expr = parse_expression();
 
         skip_start_of_block();
         auto for_block = parse_block();
         skip_token("end");
-        return std::make_unique<ForStmt>(tok.pos, name, std::move(expr), std::move(for_block));
+        auto for_stmt = std::make_unique<ForStmt>(tok.pos, name, std::move(expr), std::move(for_block));
+        for_stmt->unpack_names = std::move(unpack_names);
+        return for_stmt;
     }
     
     // 解析try语句
@@ -319,6 +329,45 @@ std::unique_ptr<Stmt> Parser::parse_stmt() {
         );
     }
 
+    // 解析解包赋值语句（a, b = expr;）
+    if (curr_tok.type == TokenType::Identifier
+        and curr_tok_idx_ + 1 < tokens_.size()
+        and tokens_[curr_tok_idx_ + 1].type == TokenType::Comma
+    ) {
+        // 确认形如 name (, name)+ = , 否则按表达式语句处理
+        size_t idx = curr_tok_idx_;
+        while (idx + 1 < tokens_.size()
+            and tokens_[idx].type == TokenType::Identifier
+            and tokens_[idx + 1].type == TokenType::Comma) {
+            idx += 2;
+        }
+        if (idx + 1 < tokens_.size()
+            and tokens_[idx].type == TokenType::Identifier
+            and tokens_[idx + 1].type == TokenType::Assign) {
+            DEBUG_OUTPUT("parsing unpack assign");
+            std::vector<std::string> names;
+            while (curr_tok_idx_ < idx) {
+                names.push_back(skip_token().text);
+                skip_token(",");
+            }
+            names.push_back(skip_token().text);
+            skip_token("=");
+            auto expr = parse_expression();
+            // 右侧可省略括号: a, b = b, a
+            if (curr_token().type == TokenType::Comma) {
+                std::vector<std::unique_ptr<Expr>> elems;
+                elems.emplace_back(std::move(expr));
+                while (curr_token().type == TokenType::Comma) {
+                    skip_token(",");
+                    elems.emplace_back(parse_expression());
+                }
+                expr = std::make_unique<TupleExpr>(curr_tok.pos, std::move(elems));
+            }
+            skip_end_of_ln();
+            return std::make_unique<UnpackAssignStmt>(curr_tok.pos, std::move(names), std::move(expr));
+        }
+    }
+
     // 解析赋值语句（x = expr;）
     if (curr_tok.type == TokenType::Identifier
         and curr_tok_idx_ + 1 < tokens_.size()
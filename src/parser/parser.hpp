@@ -47,6 +47,7 @@ private:
     std::unique_ptr<Expr> parse_factor();
 
     // parse factor
+    std::unique_ptr<Expr> parse_slice(const err::PositionInfo& pos, std::unique_ptr<Expr> start);
     std::unique_ptr<Expr> parse_primary();
     std::vector<std::unique_ptr<Expr>> parse_args(TokenType endswith);
 };
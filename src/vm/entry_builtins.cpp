@@ -9,6 +9,8 @@ namespace kiz {
 
 void Vm::entry_builtins() {
     builtins.insert("print", new model::NativeFunction(builtin::print));
+    builtins.insert("write", new model::NativeFunction(builtin::write));
+    builtins.insert("flush", new model::NativeFunction(builtin::flush));
     builtins.insert("input", new model::NativeFunction(builtin::input));
     builtins.insert("ischild", new model::NativeFunction(builtin::ischild));
     builtins.insert("create", new model::NativeFunction(builtin::create));
@@ -22,6 +24,12 @@ void Vm::entry_builtins() {
     builtins.insert("getattr", new model::NativeFunction(builtin::getattr));
     builtins.insert("hasattr", new model::NativeFunction(builtin::hasattr));
     builtins.insert("range", new model::NativeFunction(builtin::range));
+    builtins.insert("sorted", new model::NativeFunction(builtin::sorted));
+    builtins.insert("sum", new model::NativeFunction(builtin::sum));
+    builtins.insert("min", new model::NativeFunction(builtin::min));
+    builtins.insert("max", new model::NativeFunction(builtin::max));
+    builtins.insert("any", new model::NativeFunction(builtin::any));
+    builtins.insert("all", new model::NativeFunction(builtin::all));
     builtins.insert("type_of", new model::NativeFunction(builtin::type_of_obj));
 
 
@@ -33,12 +41,20 @@ void Vm::entry_builtins() {
     model::based_nil->attrs.insert("__parent__", model::based_obj);
     model::based_function->attrs.insert("__parent__", model::based_obj);
     model::based_decimal->attrs.insert("__parent__", model::based_obj);
+    model::based_float->attrs.insert("__parent__", model::based_obj);
     model::based_module->attrs.insert("__parent__", model::based_obj);
     model::based_dict->attrs.insert("__parent__", model::based_obj);
     model::based_list->attrs.insert("__parent__", model::based_obj);
     model::based_native_function->attrs.insert("__parent__", model::based_obj);
     model::based_error->attrs.insert("__parent__", model::based_obj);
     model::based_str->attrs.insert("__parent__", model::based_obj);
+    model::based_str_builder->attrs.insert("__parent__", model::based_obj);
+    model::based_iterator->attrs.insert("__parent__", model::based_obj);
+    model::based_slice->attrs.insert("__parent__", model::based_obj);
+    model::based_set->attrs.insert("__parent__", model::based_obj);
+    model::based_tuple->attrs.insert("__parent__", model::based_obj);
+    model::based_dict_view->attrs.insert("__parent__", model::based_obj);
+    model::unique_stop_iter->attrs.insert("__parent__", model::based_obj);
 
     DEBUG_OUTPUT("registering magic methods...");
 
@@ -56,7 +72,7 @@ void Vm::entry_builtins() {
         auto attr = builtin::get_one_arg(args);
         auto attr_str = dynamic_cast<model::String*>(attr);
         assert(attr_str != nullptr);
-        return get_attr(self, attr_str->val);
+        return get_attr(self, attr_str->val());
     }));
 
     model::based_obj->attrs.insert("__setitem__", new model::NativeFunction([](model::Object* self, model::List* args) -> model::Object* {
@@ -64,7 +80,7 @@ void Vm::entry_builtins() {
         auto attr = args->val[0];
         auto attr_str = dynamic_cast<model::String*>(attr);
         assert(attr_str != nullptr);
-        self->attrs.insert(attr_str->val, args->val[1]);
+        self->attrs.insert(attr_str->val(), args->val[1]);
         return self;
     }));
 
@@ -111,6 +127,22 @@ void Vm::entry_builtins() {
     model::based_decimal->attrs.insert("__str__", new model::NativeFunction(model::decimal_str));
     model::based_decimal->attrs.insert("safe_div", new model::NativeFunction(model::decimal_safe_div));
 
+    // Float类型魔术方法
+    model::based_float->attrs.insert("__add__", new model::NativeFunction(model::float_add));
+    model::based_float->attrs.insert("__sub__", new model::NativeFunction(model::float_sub));
+    model::based_float->attrs.insert("__mul__", new model::NativeFunction(model::float_mul));
+    model::based_float->attrs.insert("__div__", new model::NativeFunction(model::float_div));
+    model::based_float->attrs.insert("__mod__", new model::NativeFunction(model::float_mod));
+    model::based_float->attrs.insert("__pow__", new model::NativeFunction(model::float_pow));
+    model::based_float->attrs.insert("__neg__", new model::NativeFunction(model::float_neg));
+    model::based_float->attrs.insert("__eq__", new model::NativeFunction(model::float_eq));
+    model::based_float->attrs.insert("__lt__", new model::NativeFunction(model::float_lt));
+    model::based_float->attrs.insert("__gt__", new model::NativeFunction(model::float_gt));
+    model::based_float->attrs.insert("__bool__", new model::NativeFunction(model::float_bool));
+    model::based_float->attrs.insert("__call__", new model::NativeFunction(model::float_call));
+    model::based_float->attrs.insert("__hash__", new model::NativeFunction(model::float_hash));
+    model::based_float->attrs.insert("__str__", new model::NativeFunction(model::float_str));
+
     // Dictionary 类型魔法方法
     model::based_dict->attrs.insert("__add__", new model::NativeFunction(model::dict_add));
     model::based_dict->attrs.insert("__contains__", new model::NativeFunction(model::dict_contains));
@@ -118,6 +150,21 @@ void Vm::entry_builtins() {
     model::based_dict->attrs.insert("__str__", new model::NativeFunction(model::dict_str));
     model::based_dict->attrs.insert("__dstr__", new model::NativeFunction(model::dict_dstr));
     model::based_dict->attrs.insert("__setitem__", new model::NativeFunction(model::dict_setitem));
+    model::based_dict->attrs.insert("contains", new model::NativeFunction(model::dict_contains));
+    model::based_dict->attrs.insert("len", new model::NativeFunction(model::dict_len));
+    model::based_dict->attrs.insert("get", new model::NativeFunction(model::dict_get));
+    model::based_dict->attrs.insert("pop", new model::NativeFunction(model::dict_pop));
+    model::based_dict->attrs.insert("keys", new model::NativeFunction(model::dict_keys));
+    model::based_dict->attrs.insert("values", new model::NativeFunction(model::dict_values));
+    model::based_dict->attrs.insert("items", new model::NativeFunction(model::dict_items));
+    model::based_dict->attrs.insert("iter", new model::NativeFunction(model::dict_iter));
+
+    // DictView 类型方法
+    model::based_dict_view->attrs.insert("__str__", new model::NativeFunction(model::dict_view_str));
+    model::based_dict_view->attrs.insert("__dstr__", new model::NativeFunction(model::dict_view_dstr));
+    model::based_dict_view->attrs.insert("len", new model::NativeFunction(model::dict_view_len));
+    model::based_dict_view->attrs.insert("contains", new model::NativeFunction(model::dict_view_contains));
+    model::based_dict_view->attrs.insert("iter", new model::NativeFunction(model::dict_view_iter));
 
     // List 类型魔法方法
     model::based_list->attrs.insert("__add__", new model::NativeFunction(model::list_add));
@@ -143,6 +190,8 @@ void Vm::entry_builtins() {
     model::based_list->attrs.insert("count", new model::NativeFunction(model::list_count));
     model::based_list->attrs.insert("filter", new model::NativeFunction(model::list_filter));
     model::based_list->attrs.insert("len", new model::NativeFunction(model::list_len));
+    model::based_list->attrs.insert("sort", new model::NativeFunction(model::list_sort));
+    model::based_list->attrs.insert("iter", new model::NativeFunction(model::list_iter));
 
     // String 类型魔法方法
     model::based_str->attrs.insert("__add__", new model::NativeFunction(model::str_add));
@@ -167,7 +216,63 @@ void Vm::entry_builtins() {
     model::based_str->attrs.insert("is_digit", new model::NativeFunction(model::str_is_digit));
     model::based_str->attrs.insert("to_lower", new model::NativeFunction(model::str_to_lower));
     model::based_str->attrs.insert("to_upper", new model::NativeFunction(model::str_to_upper));
+    model::based_str->attrs.insert("find", new model::NativeFunction(model::str_find));
+    model::based_str->attrs.insert("split", new model::NativeFunction(model::str_split));
+    model::based_str->attrs.insert("replace", new model::NativeFunction(model::str_replace));
+    model::based_str->attrs.insert("join", new model::NativeFunction(model::str_join));
+    model::based_str->attrs.insert("strip", new model::NativeFunction(model::str_strip));
+
+
+    // StrBuilder 类型方法
+    model::based_str_builder->attrs.insert("__call__", new model::NativeFunction(model::str_builder_call));
+    model::based_str_builder->attrs.insert("__str__", new model::NativeFunction(model::str_builder_str));
+    model::based_str_builder->attrs.insert("append", new model::NativeFunction(model::str_builder_append));
+    model::based_str_builder->attrs.insert("join", new model::NativeFunction(model::str_builder_join));
+    model::based_str_builder->attrs.insert("len", new model::NativeFunction(model::str_builder_len));
+    model::based_str_builder->attrs.insert("clear", new model::NativeFunction(model::str_builder_clear));
+
+    // Iterator 类型方法
+    model::based_iterator->attrs.insert("__next__", new model::NativeFunction(model::iterator_next));
+    model::based_iterator->attrs.insert("iter", new model::NativeFunction(model::iterator_iter));
+    model::based_iterator->attrs.insert("map", new model::NativeFunction(model::iterator_map));
+    model::based_iterator->attrs.insert("filter", new model::NativeFunction(model::iterator_filter));
+    model::based_iterator->attrs.insert("take", new model::NativeFunction(model::iterator_take));
+    model::based_iterator->attrs.insert("zip", new model::NativeFunction(model::iterator_zip));
+    model::based_iterator->attrs.insert("enumerate", new model::NativeFunction(model::iterator_enumerate));
+    model::based_iterator->attrs.insert("chain", new model::NativeFunction(model::iterator_chain));
+    model::based_iterator->attrs.insert("collect", new model::NativeFunction(model::iterator_collect));
+
+    // Set 类型方法
+    model::based_set->attrs.insert("__call__", new model::NativeFunction(model::set_call));
+    model::based_set->attrs.insert("__bool__", new model::NativeFunction(model::set_bool));
+    model::based_set->attrs.insert("__eq__", new model::NativeFunction(model::set_eq));
+    model::based_set->attrs.insert("__str__", new model::NativeFunction(model::set_str));
+    model::based_set->attrs.insert("__dstr__", new model::NativeFunction(model::set_dstr));
+    model::based_set->attrs.insert("add", new model::NativeFunction(model::set_add));
+    model::based_set->attrs.insert("remove", new model::NativeFunction(model::set_remove));
+    model::based_set->attrs.insert("discard", new model::NativeFunction(model::set_discard));
+    model::based_set->attrs.insert("contains", new model::NativeFunction(model::set_contains));
+    model::based_set->attrs.insert("len", new model::NativeFunction(model::set_len));
+    model::based_set->attrs.insert("clear", new model::NativeFunction(model::set_clear));
+    model::based_set->attrs.insert("union", new model::NativeFunction(model::set_union));
+    model::based_set->attrs.insert("intersection", new model::NativeFunction(model::set_intersection));
+    model::based_set->attrs.insert("difference", new model::NativeFunction(model::set_difference));
+    model::based_set->attrs.insert("iter", new model::NativeFunction(model::set_iter));
+
+    // Tuple 类型方法
+    model::based_tuple->attrs.insert("__call__", new model::NativeFunction(model::tuple_call));
+    model::based_tuple->attrs.insert("__getitem__", new model::NativeFunction(model::tuple_getitem));
+    model::based_tuple->attrs.insert("__eq__", new model::NativeFunction(model::tuple_eq));
+    model::based_tuple->attrs.insert("__hash__", new model::NativeFunction(model::tuple_hash));
+    model::based_tuple->attrs.insert("__bool__", new model::NativeFunction(model::tuple_bool));
+    model::based_tuple->attrs.insert("__str__", new model::NativeFunction(model::tuple_str));
+    model::based_tuple->attrs.insert("__dstr__", new model::NativeFunction(model::tuple_dstr));
+    model::based_tuple->attrs.insert("len", new model::NativeFunction(model::tuple_len));
+    model::based_tuple->attrs.insert("contains", new model::NativeFunction(model::tuple_contains));
+    model::based_tuple->attrs.insert("iter", new model::NativeFunction(model::tuple_iter));
 
+    // Slice 类型方法
+    model::based_slice->attrs.insert("indices", new model::NativeFunction(model::slice_indices));
 
     model::based_error->attrs.insert("__call__", new model::NativeFunction([](model::Object* self, model::List* args) {
         assert( args->val.size() == 2);
@@ -215,9 +320,16 @@ void Vm::entry_builtins() {
     builtins.insert("Int", model::based_int);
     builtins.insert("Bool", model::based_bool);
     builtins.insert("Decimal", model::based_decimal);
+    builtins.insert("Float", model::based_float);
     builtins.insert("List", model::based_list);
     builtins.insert("Dict", model::based_dict);
     builtins.insert("Str", model::based_str);
+    builtins.insert("StrBuilder", model::based_str_builder);
+    builtins.insert("Iterator", model::based_iterator);
+    builtins.insert("StopIter", model::unique_stop_iter);
+    builtins.insert("Set", model::based_set);
+    builtins.insert("Tuple", model::based_tuple);
+    builtins.insert("Slice", model::based_slice);
     builtins.insert("Func", model::based_function);
     builtins.insert("NFunc", model::based_native_function);
     builtins.insert("__Nil", model::based_nil);
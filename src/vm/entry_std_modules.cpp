@@ -1,5 +1,13 @@
 #include "../models/models.hpp"
 #include "../libs/io/include/io_lib.hpp"
+#include "../libs/collections/include/collections_lib.hpp"
+#include "../libs/json/include/json_lib.hpp"
+#include "../libs/csv/include/csv_lib.hpp"
+#include "../libs/re/include/re_lib.hpp"
+#include "../libs/math/include/math_lib.hpp"
+#include "../libs/array/include/array_lib.hpp"
+#include "../libs/matrix/include/matrix_lib.hpp"
+#include "../libs/random/include/random_lib.hpp"
 
 namespace kiz {
 
@@ -7,6 +15,30 @@ void Vm::entry_std_modules() {
     std_modules.insert("io", new model::NativeFunction(
         io_lib::init_module
     ));
+    std_modules.insert("collections", new model::NativeFunction(
+        collections_lib::init_module
+    ));
+    std_modules.insert("json", new model::NativeFunction(
+        json_lib::init_module
+    ));
+    std_modules.insert("csv", new model::NativeFunction(
+        csv_lib::init_module
+    ));
+    std_modules.insert("re", new model::NativeFunction(
+        re_lib::init_module
+    ));
+    std_modules.insert("math", new model::NativeFunction(
+        math_lib::init_module
+    ));
+    std_modules.insert("array", new model::NativeFunction(
+        array_lib::init_module
+    ));
+    std_modules.insert("matrix", new model::NativeFunction(
+        matrix_lib::init_module
+    ));
+    std_modules.insert("random", new model::NativeFunction(
+        random_lib::init_module
+    ));
 }
 
 } // namespace model
\ No newline at end of file
@@ -1,3 +1,4 @@
+#include <cmath>
 #include <tuple>
 
 #include "../models/models.hpp"
@@ -21,11 +22,17 @@ auto Vm::fetch_two_from_stack_top(
 }
 
 // -------------------------- 算术指令 --------------------------
+// 含Float的数值运算直接按双精度计算并压栈, 不再查找__op__并经handle_call构造参数列表
 void Vm::exec_ADD(const Instruction& instruction) {
     DEBUG_OUTPUT("exec add...");
     auto [a, b] = fetch_two_from_stack_top("add");
     DEBUG_OUTPUT("a is " + a->debug_string() + ", b is " + b->debug_string());
 
+    if (double x, y; model::float_operands(a, b, x, y)) {
+        op_stack.push(model::create_float(x + y));
+        return;
+    }
+
     handle_call(get_attr(a, "__add__"), new model::List({b}), a);
     DEBUG_OUTPUT("success to call function");
 }
@@ -33,6 +40,10 @@ void Vm::exec_ADD(const Instruction& instruction) {
 void Vm::exec_SUB(const Instruction& instruction) {
     DEBUG_OUTPUT("exec sub...");
     auto [a, b] = fetch_two_from_stack_top("sub");
+    if (double x, y; model::float_operands(a, b, x, y)) {
+        op_stack.push(model::create_float(x - y));
+        return;
+    }
 
     handle_call(get_attr(a, "__sub__"), new model::List({b}), a);
 }
@@ -40,6 +51,10 @@ void Vm::exec_SUB(const Instruction& instruction) {
 void Vm::exec_MUL(const Instruction& instruction) {
     DEBUG_OUTPUT("exec mul...");
     auto [a, b] = fetch_two_from_stack_top("mul");
+    if (double x, y; model::float_operands(a, b, x, y)) {
+        op_stack.push(model::create_float(x * y));
+        return;
+    }
 
     handle_call(get_attr(a, "__mul__"), new model::List({b}), a);
 }
@@ -47,6 +62,10 @@ void Vm::exec_MUL(const Instruction& instruction) {
 void Vm::exec_DIV(const Instruction& instruction) {
     DEBUG_OUTPUT("exec div...");
     auto [a, b] = fetch_two_from_stack_top("div");
+    if (double x, y; model::float_operands(a, b, x, y)) {
+        op_stack.push(model::create_float(x / y));
+        return;
+    }
 
     handle_call(get_attr(a, "__div__"), new model::List({b}), a);
 }
@@ -54,6 +73,10 @@ void Vm::exec_DIV(const Instruction& instruction) {
 void Vm::exec_MOD(const Instruction& instruction) {
     DEBUG_OUTPUT("exec mod...");
     auto [a, b] = fetch_two_from_stack_top("mod");
+    if (double x, y; model::float_operands(a, b, x, y)) {
+        op_stack.push(model::create_float(model::floor_fmod(x, y)));
+        return;
+    }
 
     handle_call(get_attr(a, "__mod__"), new model::List({b}), a);
 
@@ -62,6 +85,10 @@ void Vm::exec_MOD(const Instruction& instruction) {
 void Vm::exec_POW(const Instruction& instruction) {
     DEBUG_OUTPUT("exec pow...");
     auto [a, b] = fetch_two_from_stack_top("pow");
+    if (double x, y; model::float_operands(a, b, x, y)) {
+        op_stack.push(model::create_float(std::pow(x, y)));
+        return;
+    }
 
     handle_call(get_attr(a, "__pow__"), new model::List({b}), a);
 }
@@ -72,20 +99,125 @@ void Vm::exec_NEG(const Instruction& instruction) {
     DEBUG_OUTPUT("exec neg...");
     auto a = op_stack.top();
     op_stack.pop();
+    if (const auto a_float = dynamic_cast<model::Float*>(a)) {
+        op_stack.push(model::create_float(-a_float->val));
+        return;
+    }
     handle_call(get_attr(a, "__neg__"), new model::List({}), a);
 }
 
+// -------------------------- 相等协议 --------------------------
+// 内置值类型(相等语义固定, 不经过__eq__查找)
+static bool has_native_eq(const model::Object* obj) {
+    switch (obj->get_type()) {
+    case model::Object::ObjectType::OT_Int:
+    case model::Object::ObjectType::OT_Decimal:
+    case model::Object::ObjectType::OT_Float:
+    case model::Object::ObjectType::OT_String:
+    case model::Object::ObjectType::OT_Bool:
+    case model::Object::ObjectType::OT_Nil:
+    case model::Object::ObjectType::OT_List:
+    case model::Object::ObjectType::OT_Tuple:
+        return true;
+    default:
+        return false;
+    }
+}
+
+static bool list_equal(const model::List* a, const model::List* b) {
+    const size_t n = a->size();
+    if (n != b->size()) return false;
+    if (a->strategy() == b->strategy()) {
+        switch (a->strategy()) {
+        case model::List::Strategy::Int: return a->ints() == b->ints();
+        case model::List::Strategy::Decimal: return a->decimals() == b->decimals();
+        case model::List::Strategy::Str: return a->strs() == b->strs();
+        case model::List::Strategy::Empty: return true;
+        default: break;
+        }
+    }
+    for (size_t i = 0; i < n; ++i) {
+        if (!Vm::is_equal(a->get(i), b->get(i))) return false;
+    }
+    return true;
+}
+
+bool Vm::is_equal(model::Object* a, model::Object* b) {
+    if (a == b) return true;
+    if (!has_native_eq(a)) {
+        call_function(get_attr(a, "__eq__"), new model::List({b}), a);
+        return is_true(fetch_one_from_stack_top());
+    }
+    // 左侧为内置值而右侧不是时交给右侧的__eq__, 使 1 == obj 与 obj == 1 一致
+    if (!has_native_eq(b)) {
+        call_function(get_attr(b, "__eq__"), new model::List({a}), b);
+        return is_true(fetch_one_from_stack_top());
+    }
+
+    using OT = model::Object::ObjectType;
+    const auto ta = a->get_type();
+    const auto tb = b->get_type();
+    if (ta == OT::OT_Int and tb == OT::OT_Int) {
+        return dynamic_cast<model::Int*>(a)->val == dynamic_cast<model::Int*>(b)->val;
+    }
+    // 含Float时按精确值比较(nan与任何值都不相等)
+    if (ta == OT::OT_Float) return model::float_equals(dynamic_cast<model::Float*>(a)->val, b);
+    if (tb == OT::OT_Float) return model::float_equals(dynamic_cast<model::Float*>(b)->val, a);
+    if ((ta == OT::OT_Int or ta == OT::OT_Decimal) and (tb == OT::OT_Int or tb == OT::OT_Decimal)) {
+        auto to_decimal = [](model::Object* o) {
+            if (const auto o_int = dynamic_cast<model::Int*>(o)) return dep::Decimal(o_int->val);
+            return dynamic_cast<model::Decimal*>(o)->val;
+        };
+        return to_decimal(a) == to_decimal(b);
+    }
+    if (ta != tb) return false;
+    switch (ta) {
+    case OT::OT_String:
+        return dynamic_cast<model::String*>(a)->equals(*dynamic_cast<model::String*>(b));
+    case OT::OT_Bool:
+        return dynamic_cast<model::Bool*>(a)->val == dynamic_cast<model::Bool*>(b)->val;
+    case OT::OT_Nil:
+        return true;
+    case OT::OT_List:
+        return list_equal(dynamic_cast<model::List*>(a), dynamic_cast<model::List*>(b));
+    case OT::OT_Tuple: {
+        const auto ta_tuple = dynamic_cast<model::Tuple*>(a);
+        const auto tb_tuple = dynamic_cast<model::Tuple*>(b);
+        if (ta_tuple->size() != tb_tuple->size()) return false;
+        for (size_t i = 0; i < ta_tuple->size(); ++i) {
+            if (!is_equal(ta_tuple->get(i), tb_tuple->get(i))) return false;
+        }
+        return true;
+    }
+    default:
+        return false;
+    }
+}
+
 // -------------------------- 比较指令 --------------------------
 void Vm::exec_EQ(const Instruction& instruction) {
     DEBUG_OUTPUT("exec eq...");
     auto [a, b] = fetch_two_from_stack_top("eq");
 
-    handle_call(get_attr(a, "__eq__"), new model::List({b}), a);
+    if (!has_native_eq(a)) {
+        handle_call(get_attr(a, "__eq__"), new model::List({b}), a);
+        return;
+    }
+    // 右侧的__eq__的结果原样返回(如 1 == arr 与 arr == 1 同为逐元素比较)
+    if (!has_native_eq(b)) {
+        handle_call(get_attr(b, "__eq__"), new model::List({a}), b);
+        return;
+    }
+    op_stack.push(new model::Bool(is_equal(a, b)));
 }
 
 void Vm::exec_GT(const Instruction& instruction) {
     DEBUG_OUTPUT("exec gt...");
     auto [a, b] = fetch_two_from_stack_top("gt");
+    if (double x, y; model::float_operands(a, b, x, y)) {
+        op_stack.push(new model::Bool(x > y));
+        return;
+    }
 
     handle_call(get_attr(a, "__gt__"), new model::List({b}), a);
 }
@@ -93,6 +225,10 @@ void Vm::exec_GT(const Instruction& instruction) {
 void Vm::exec_LT(const Instruction& instruction) {
     DEBUG_OUTPUT("exec lt...");
     auto [a, b] = fetch_two_from_stack_top("lt");
+    if (double x, y; model::float_operands(a, b, x, y)) {
+        op_stack.push(new model::Bool(x < y));
+        return;
+    }
 
     handle_call(get_attr(a, "__lt__"), new model::List({b}), a);
 }
@@ -156,6 +292,10 @@ void Vm::exec_IS(const Instruction& instruction) {
 
 void Vm::exec_GE(const Instruction& instruction) {
     auto [a, b] = fetch_two_from_stack_top("ge");
+    if (double x, y; model::float_operands(a, b, x, y)) {
+        op_stack.push(new model::Bool(x >= y));
+        return;
+    }
     call_function(get_attr(a, "__eq__"), new model::List({b}), a);
     call_function(get_attr(a, "__gt__"), new model::List({b}), a);
     auto [gt_result, eq_result] = fetch_two_from_stack_top("ge");
@@ -171,6 +311,10 @@ void Vm::exec_GE(const Instruction& instruction) {
 
 void Vm::exec_LE(const Instruction& instruction) {
     auto [a, b] = fetch_two_from_stack_top("le");
+    if (double x, y; model::float_operands(a, b, x, y)) {
+        op_stack.push(new model::Bool(x <= y));
+        return;
+    }
     call_function(get_attr(a, "__eq__"), new model::List({b}), a);
     call_function(get_attr(a, "__lt__"), new model::List({b}), a);
     auto [lt_result, eq_result] = fetch_two_from_stack_top("le");
@@ -186,6 +330,10 @@ void Vm::exec_LE(const Instruction& instruction) {
 
 void Vm::exec_NE(const Instruction& instruction) {
     auto [a, b] = fetch_two_from_stack_top("ne");
+    if (has_native_eq(a)) {
+        op_stack.push(new model::Bool(!is_equal(a, b)));
+        return;
+    }
     call_function(get_attr(a, "__eq__"), new model::List({b}), a);
     if (is_true(op_stack.top())) {
         op_stack.pop();
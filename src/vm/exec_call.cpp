@@ -164,7 +164,7 @@ void Vm::call_function(model::Object* func_obj, model::Object* args_obj, model::
         }
 
         if (curr_inst.opc != Opcode::JUMP && curr_inst.opc != Opcode::JUMP_IF_FALSE &&
-            curr_inst.opc != Opcode::RET && curr_inst.opc != Opcode::JUMP_IF_FINISH_HANDLE_ERROR
+            curr_inst.opc != Opcode::FOR_ITER && curr_inst.opc != Opcode::RET && curr_inst.opc != Opcode::JUMP_IF_FINISH_HANDLE_ERROR
             && curr_inst.opc != Opcode::THROW) {
             curr_frame.pc++;
             }
@@ -245,7 +245,7 @@ void Vm::exec_IMPORT(const Instruction& instruction) {
         if (name == "__name__") {
             auto module_name_str = dynamic_cast<model::String*>(local_object);
             assert(module_name_str != nullptr);
-            module_name = module_name_str->val;
+            module_name = module_name_str->val();
         }
         local_object->attrs.insert("__owner_module__", module_obj);
         local_object->make_ref();
@@ -3,6 +3,7 @@
 #include "../models/models.hpp"
 #include "vm.hpp"
 #include "builtins/include/builtin_functions.hpp"
+#include "builtins/include/builtin_methods.hpp"
 #include "ir_gen/ir_gen.hpp"
 #include "lexer/lexer.hpp"
 #include "util/src_manager.hpp"
@@ -45,14 +46,126 @@ void Vm::exec_MAKE_LIST(const Instruction& instruction) {
     // 反转元素顺序（恢复原参数顺序：arg1 → arg2 → ... → argN）
     std::reverse(elem_list.begin(), elem_list.end());
 
-    // 创建 List 对象，压入栈
+    // 创建 List 对象，压入栈; 列表字面量元素同类时转为拆箱存储(参数列表保持Generic)
     auto* list_obj = new model::List(elem_list);
+    if (instruction.opn_list.size() > 1 and instruction.opn_list[1] == 1) {
+        list_obj->specialize();
+    }
     list_obj->make_ref();  // List 自身引用计std::to_string
     op_stack.push(list_obj);
 
     DEBUG_OUTPUT("make_list: 打包 " + std::to_string(elem_count) + " 个元素为 List，压栈成功");
 }
 
+void Vm::exec_LIST_APPEND(const Instruction& instruction) {
+    DEBUG_OUTPUT("exec list_append...");
+    // 栈顶为待追加元素, 其下为构造中的列表(列表推导式)
+    if (op_stack.size() < 2) assert(false && "LIST_APPEND: 操作数栈元素不足");
+    if (instruction.opn_list.empty()) assert(false && "LIST_APPEND: 无迭代器槽位");
+
+    model::Object* elem = op_stack.top();
+    op_stack.pop();
+    auto* list_obj = dynamic_cast<model::List*>(op_stack.top());
+    assert(list_obj != nullptr && "LIST_APPEND: 栈顶-1元素非List类型");
+
+    const bool first = list_obj->empty();
+    list_obj->append(elem);
+
+    // 首个元素确定存储策略后, 按迭代器剩余长度一次预分配
+    if (first) {
+        const auto& slots = call_stack.back()->iter_slots;
+        if (const size_t slot = instruction.opn_list[0]; slot < slots.size() and slots[slot] != nullptr) {
+            list_obj->reserve(1 + model::iterator_size_hint(slots[slot]));
+        }
+    }
+}
+
+void Vm::exec_MAKE_SLICE(const Instruction& instruction) {
+    DEBUG_OUTPUT("exec make_slice...");
+    // 栈顶依次为 step, stop, start
+    if (op_stack.size() < 3) assert(false && "MAKE_SLICE: 操作数栈元素不足");
+
+    model::Object* parts[3];
+    for (int i = 2; i >= 0; --i) {
+        parts[i] = op_stack.top();
+        op_stack.pop();
+    }
+    auto* slice_obj = new model::Slice(parts[0], parts[1], parts[2]);
+    slice_obj->make_ref();
+    op_stack.push(slice_obj);
+}
+
+void Vm::exec_MAKE_SET(const Instruction& instruction) {
+    DEBUG_OUTPUT("exec make_set...");
+    if (instruction.opn_list.empty()) assert(false && "MAKE_SET: 无元素个数参数");
+    const size_t elem_count = instruction.opn_list[0];
+    if (op_stack.size() < elem_count) assert(false && "MAKE_SET: 操作数栈元素不足");
+
+    // 按字面量顺序插入, 重复元素保留首次出现的位置
+    std::vector<model::Object*> elem_list(elem_count);
+    for (size_t i = elem_count; i > 0; --i) {
+        elem_list[i - 1] = op_stack.top();
+        op_stack.pop();
+    }
+    auto* set_obj = new model::Set();
+    for (const auto elem : elem_list) {
+        set_obj->add(model::Set::key_of(elem));
+    }
+    set_obj->make_ref();
+    op_stack.push(set_obj);
+}
+
+void Vm::exec_MAKE_TUPLE(const Instruction& instruction) {
+    DEBUG_OUTPUT("exec make_tuple...");
+    if (instruction.opn_list.empty()) assert(false && "MAKE_TUPLE: 无元素个数参数");
+    const size_t elem_count = instruction.opn_list[0];
+    if (op_stack.size() < elem_count) assert(false && "MAKE_TUPLE: 操作数栈元素不足");
+
+    std::vector<model::Object*> elem_list(elem_count);
+    for (size_t i = elem_count; i > 0; --i) {
+        elem_list[i - 1] = op_stack.top();
+        op_stack.pop();
+    }
+    auto* tuple_obj = model::Tuple::create(elem_list);
+    tuple_obj->make_ref();
+    op_stack.push(tuple_obj);
+}
+
+void Vm::exec_UNPACK_SEQUENCE(const Instruction& instruction) {
+    DEBUG_OUTPUT("exec unpack_sequence...");
+    if (instruction.opn_list.empty()) assert(false && "UNPACK_SEQUENCE: 无变量个数参数");
+    const size_t want = instruction.opn_list[0];
+    model::Object* src = fetch_one_from_stack_top();
+
+    // Tuple/List直接按下标取, 其他对象按迭代协议取出
+    std::vector<model::Object*> elems;
+    bool truncated = false;
+    if (const auto src_tuple = dynamic_cast<model::Tuple*>(src)) {
+        elems.assign(src_tuple->begin(), src_tuple->end());
+    } else if (const auto src_list = dynamic_cast<model::List*>(src)) {
+        for (size_t i = 0; i < src_list->size(); ++i) elems.push_back(src_list->get(i));
+    } else {
+        const auto it = model::make_iterator(src);
+        while (const auto elem = model::iterator_step(it)) {
+            elems.push_back(elem);
+            if (elems.size() > want) {
+                truncated = true;
+                break;
+            }
+        }
+    }
+    if (elems.size() != want) {
+        instruction_throw("ValueError", "expected " + std::to_string(want) + " values to unpack, got "
+            + (truncated ? "more" : std::to_string(elems.size())));
+    }
+
+    // 逆序压栈, 使第一个变量先取到第一个元素
+    for (size_t i = want; i > 0; --i) {
+        elems[i - 1]->make_ref();
+        op_stack.push(elems[i - 1]);
+    }
+}
+
 void Vm::exec_MAKE_DICT(const Instruction& instruction) {
     DEBUG_OUTPUT("exec make_dict...");
 
@@ -65,10 +178,7 @@ void Vm::exec_MAKE_DICT(const Instruction& instruction) {
     }
 
     // 栈中顺序是 [key1, val1, key2, val2,...]（栈底→栈顶）
-    std::vector<std::pair<
-        dep::BigInt, std::pair< model::Object*, model::Object* >
-    >> elem_list;
-    elem_list.reserve(elem_count);
+    std::vector<model::Dictionary::Pair> elem_list(elem_count);
 
     for (size_t i = 0; i < elem_count; ++i) {
         // 弹出 value（栈顶第一个是 value）
@@ -84,26 +194,79 @@ void Vm::exec_MAKE_DICT(const Instruction& instruction) {
 
         key->make_ref(); // 增加引用计数
 
-        // 调用 __hash__ 方法获取哈希值
-        call_function(get_attr(key, "__hash__"), new model::List({}), key);
-        model::Object* hash_obj = fetch_one_from_stack_top();
-
-        // 检查哈希值类型
-        auto* hashed_int = dynamic_cast<model::Int*>(hash_obj);
-        if (!hashed_int) {
-            instruction_throw("TypeError", "__hash__ must return an integer");
-        }
-        assert(hashed_int != nullptr);
-
-        elem_list.emplace_back(hashed_int->val, std::pair{key, value});
+        elem_list[elem_count - 1 - i] = {key, value};
     }
 
-    // 创建字典对象
-    auto* dict_obj = new model::Dictionary(dep::Dict(elem_list));
+    // 创建字典对象: 按源码顺序插入(重复键后者覆盖前者), 全为Str键时不经过__hash__
+    auto* dict_obj = new model::Dictionary();
+    dict_obj->reserve(elem_count);
+    for (const auto& [key, value] : elem_list) {
+        dict_obj->insert(key, value);
+    }
     dict_obj->make_ref();
     op_stack.push(dict_obj);
 }
 
+// -------------------------- 模板字符串拼接 --------------------------
+void Vm::exec_BUILD_STRING(const Instruction& instruction) {
+    DEBUG_OUTPUT("exec build_string...");
+
+    const size_t part_count = instruction.opn_list[0];
+    if (op_stack.size() < part_count) {
+        assert(false && "BUILD_STRING: 栈元素不足");
+    }
+
+    std::vector<model::Object*> parts(part_count);
+    for (size_t i = part_count; i > 0; --i) {
+        parts[i - 1] = op_stack.top();
+        op_stack.pop();
+    }
+
+    // 内置类型直接取文本, 其余对象调用__str__; 预留容量保证string_view不失效
+    std::vector<std::string> converted;
+    converted.reserve(part_count);
+    std::vector<std::string_view> pieces;
+    pieces.reserve(part_count);
+    size_t total = 0;
+    for (const auto part : parts) {
+        switch (part->get_type()) {
+        case model::Object::ObjectType::OT_String:
+            pieces.emplace_back(dynamic_cast<model::String*>(part)->val());
+            break;
+        case model::Object::ObjectType::OT_Int:
+            converted.push_back(dynamic_cast<model::Int*>(part)->val.to_string());
+            pieces.emplace_back(converted.back());
+            break;
+        case model::Object::ObjectType::OT_Decimal:
+            converted.push_back(dynamic_cast<model::Decimal*>(part)->val.to_string());
+            pieces.emplace_back(converted.back());
+            break;
+        case model::Object::ObjectType::OT_Float:
+            converted.push_back(part->debug_string());
+            pieces.emplace_back(converted.back());
+            break;
+        case model::Object::ObjectType::OT_Bool:
+            pieces.emplace_back(dynamic_cast<model::Bool*>(part)->val ? "True" : "False");
+            break;
+        case model::Object::ObjectType::OT_Nil:
+            pieces.emplace_back("Nil");
+            break;
+        default:
+            converted.push_back(obj_to_str(part));
+            pieces.emplace_back(converted.back());
+            break;
+        }
+        total += pieces.back().size();
+    }
+
+    std::string result;
+    result.reserve(total);
+    for (const auto piece : pieces) {
+        result.append(piece);
+    }
+    op_stack.push(model::create_str(std::move(result)));
+}
+
 // -------------------------- 跳转指令 --------------------------
 void Vm::exec_JUMP(const Instruction& instruction) {
     DEBUG_OUTPUT("exec jump...");
@@ -145,6 +308,51 @@ void Vm::exec_JUMP_IF_FALSE(const Instruction& instruction) {
     }
 }
 
+// -------------------------- 迭代指令 --------------------------
+void Vm::exec_GET_ITER(const Instruction& instruction) {
+    DEBUG_OUTPUT("exec get_iter...");
+    // opn_list: [迭代器槽位]
+    if (op_stack.empty()) assert(false && "GET_ITER: 操作数栈空");
+    if (instruction.opn_list.size() != 1) assert(false && "GET_ITER: 操作数数量错误");
+
+    // 列表不复制, 由迭代器按下标读取
+    model::Object* iterable = op_stack.top();
+    op_stack.pop();
+    auto& slots = call_stack.back()->iter_slots;
+    const size_t slot = instruction.opn_list[0];
+    if (slots.size() <= slot) slots.resize(slot + 1, nullptr);
+    slots[slot] = model::make_iterator(iterable);
+}
+
+void Vm::exec_FOR_ITER(const Instruction& instruction) {
+    DEBUG_OUTPUT("exec for_iter...");
+    // opn_list: [迭代器槽位, 循环变量名索引, 循环结束位置]
+    // 只有[迭代器槽位, 循环结束位置]时元素压入操作数栈(供解包赋值)
+    const size_t opn_count = instruction.opn_list.size();
+    if (opn_count != 2 and opn_count != 3) assert(false && "FOR_ITER: 操作数数量错误");
+
+    CallFrame* curr_frame = call_stack.back().get();
+    const size_t slot = instruction.opn_list[0];
+    assert(slot < curr_frame->iter_slots.size() && curr_frame->iter_slots[slot] != nullptr
+        && "FOR_ITER: 迭代器槽位为空");
+    const auto iter = curr_frame->iter_slots[slot];
+
+    model::Object* item = model::iterator_step(iter);
+    if (item == nullptr) {
+        DEBUG_OUTPUT("FOR_ITER: 迭代结束, 跳转至 PC=" + std::to_string(instruction.opn_list.back()));
+        curr_frame->pc = instruction.opn_list.back();
+        return;
+    }
+
+    if (opn_count == 2) {
+        op_stack.push(item);
+    } else {
+        // 与SET_LOCAL相同的赋值语义
+        curr_frame->locals.insert(curr_frame->code_object->names[instruction.opn_list[1]], model::copy_or_ref(item));
+    }
+    curr_frame->pc++;
+}
+
 
 void Vm::exec_CREATE_OBJECT(const Instruction& instruction) {
     auto obj = new model::Object();
@@ -50,8 +50,20 @@ void execute_unit(const Instruction& instruction) {
 
     case Opcode::MAKE_LIST:
 
+    case Opcode::LIST_APPEND:
+
+    case Opcode::MAKE_SLICE:
+
+    case Opcode::MAKE_SET:
+
+    case Opcode::MAKE_TUPLE:
+
+    case Opcode::UNPACK_SEQUENCE:
+
     case Opcode::MAKE_DICT:
 
+    case Opcode::BUILD_STRING:
+
 
     case Opcode::CALL:
 
@@ -93,6 +105,10 @@ void execute_unit(const Instruction& instruction) {
 
     case Opcode::JUMP_IF_FALSE:
 
+    case Opcode::GET_ITER:
+
+    case Opcode::FOR_ITER:
+
     case Opcode::IS_CHILD:
 
     case Opcode::CREATE_OBJECT:
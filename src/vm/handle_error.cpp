@@ -158,6 +158,7 @@ void Vm::handle_throw() {
     }
 
     auto [error_name, error_msg] = get_err_name_and_msg(curr_error);
+    flush_stdout();
 
     // 报错
     if (auto err_obj = dynamic_cast<model::Error*>(curr_error)) {
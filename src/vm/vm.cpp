@@ -13,6 +13,14 @@
 
 #include <algorithm>
 #include <cassert>
+#include <cstdio>
+#include <cstdlib>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
 
 #include "../kiz.hpp"
 
@@ -30,10 +38,26 @@ bool Vm::running = false;
 std::string Vm::file_path;
 model::Object* Vm::curr_error {};
 dep::HashMap<model::Object*> Vm::std_modules {};
+std::string Vm::stdout_buffer {};
+bool Vm::stdout_is_tty = false;
+bool Vm::stdout_unbuffered = false;
 
 
 Vm::Vm(const std::string& file_path_) {
     file_path = file_path_;
+
+#ifdef _WIN32
+    stdout_is_tty = _isatty(_fileno(stdout));
+#else
+    stdout_is_tty = isatty(STDOUT_FILENO);
+#endif
+    static bool flush_at_exit_registered = false;
+    if (!flush_at_exit_registered) {
+        std::atexit(flush_stdout);
+        flush_at_exit_registered = true;
+    }
+    stdout_buffer.reserve(stdout_buffer_capacity);
+
     DEBUG_OUTPUT("entry builtin functions...");
     entry_builtins();
     entry_std_modules();
@@ -97,7 +121,7 @@ void Vm::exec_curr_code() {
         DEBUG_OUTPUT("current stack top : " + (op_stack.empty() ? "[Nothing]" : op_stack.top()->debug_string()));
 
         if (curr_inst.opc != Opcode::JUMP && curr_inst.opc != Opcode::JUMP_IF_FALSE &&
-            curr_inst.opc != Opcode::RET && curr_inst.opc != Opcode::JUMP_IF_FINISH_HANDLE_ERROR) {
+            curr_inst.opc != Opcode::FOR_ITER && curr_inst.opc != Opcode::RET && curr_inst.opc != Opcode::JUMP_IF_FINISH_HANDLE_ERROR) {
             curr_frame.pc++;
         }
     }
@@ -166,7 +190,13 @@ void Vm::execute_instruction(const Instruction& instruction) {
         case Opcode::OP_IS:           exec_IS(instruction);           break;
         case Opcode::OP_IN:           exec_IN(instruction);           break;
         case Opcode::MAKE_LIST:       exec_MAKE_LIST(instruction);    break;
+        case Opcode::LIST_APPEND:     exec_LIST_APPEND(instruction);  break;
+        case Opcode::MAKE_SLICE:      exec_MAKE_SLICE(instruction);   break;
+        case Opcode::MAKE_SET:        exec_MAKE_SET(instruction);     break;
+        case Opcode::MAKE_TUPLE:      exec_MAKE_TUPLE(instruction);   break;
+        case Opcode::UNPACK_SEQUENCE: exec_UNPACK_SEQUENCE(instruction); break;
         case Opcode::MAKE_DICT:       exec_MAKE_DICT(instruction);    break;
+        case Opcode::BUILD_STRING:    exec_BUILD_STRING(instruction); break;
 
         case Opcode::CALL:            exec_CALL(instruction);          break;
         case Opcode::RET:             exec_RET(instruction);           break;
@@ -189,6 +219,8 @@ void Vm::execute_instruction(const Instruction& instruction) {
         case Opcode::SET_NONLOCAL:    exec_SET_NONLOCAL(instruction);  break;
         case Opcode::JUMP:            exec_JUMP(instruction);          break;
         case Opcode::JUMP_IF_FALSE:   exec_JUMP_IF_FALSE(instruction); break;
+        case Opcode::GET_ITER:        exec_GET_ITER(instruction);      break;
+        case Opcode::FOR_ITER:        exec_FOR_ITER(instruction);      break;
         case Opcode::THROW:           exec_THROW(instruction);         break;
         case Opcode::IS_CHILD:        exec_IS_CHILD(instruction);      break;
         case Opcode::CREATE_OBJECT:   exec_CREATE_OBJECT(instruction); break;
@@ -197,42 +229,129 @@ void Vm::execute_instruction(const Instruction& instruction) {
     }
 }
 
-std::string Vm::obj_to_str(model::Object* for_cast_obj) {
-    DEBUG_OUTPUT("obj to str");
-    model::Object* method;
-    try {
-        method = get_attr(for_cast_obj, "__str__");
-    } catch (NativeFuncError& e) {
-        try {
-            method = get_attr(for_cast_obj, "__dstr__");
-        } catch (NativeFuncError& e2) {
-            method = get_attr(model::based_obj, "__str__");
-        }
+// 沿原型链查找属性, 找不到返回nullptr(不抛异常)
+static model::Object* find_attr(const model::Object* obj, const std::string& attr_name) {
+    while (obj != nullptr) {
+        if (const auto attr_it = obj->attrs.find(attr_name)) return attr_it->value;
+        const auto parent_it = obj->attrs.find("__parent__");
+        obj = parent_it ? parent_it->value : nullptr;
     }
+    return nullptr;
+}
+
+// 格式化到out: 若转换方法仍是内置的原生实现, 直接按类型写出(容器逐元素递归);
+// 否则(用户重载)通过VM调用该方法
+static void write_obj(model::Object* obj, std::string& out, const bool debug) {
+    model::Object* method = find_attr(obj, debug ? "__dstr__" : "__str__");
+    if (method == nullptr) method = find_attr(obj, debug ? "__str__" : "__dstr__");
+    if (method == nullptr) method = find_attr(model::based_obj, "__str__");
     assert(method != nullptr);
-    call_function(method, model::create_list({}), for_cast_obj);
-    auto res = fetch_one_from_stack_top();
-    std::string val = model::cast_to_str(res)->val;
-    return val;
+
+    if (dynamic_cast<model::NativeFunction*>(method) != nullptr) {
+        switch (obj->get_type()) {
+        case model::Object::ObjectType::OT_String: {
+            const auto val = dynamic_cast<model::String*>(obj)->view();
+            if (debug) {
+                out += '"';
+                out += val;
+                out += '"';
+            } else {
+                out += val;
+            }
+            return;
+        }
+        case model::Object::ObjectType::OT_Int:
+            out += dynamic_cast<model::Int*>(obj)->val.to_string();
+            return;
+        case model::Object::ObjectType::OT_Decimal:
+            out += dynamic_cast<model::Decimal*>(obj)->val.to_string();
+            return;
+        case model::Object::ObjectType::OT_Float:
+            out += obj->debug_string();
+            return;
+        case model::Object::ObjectType::OT_Bool:
+            out += dynamic_cast<model::Bool*>(obj)->val ? "True" : "False";
+            return;
+        case model::Object::ObjectType::OT_Nil:
+            out += "Nil";
+            return;
+        case model::Object::ObjectType::OT_List: {
+            const auto list = dynamic_cast<model::List*>(obj);
+            const auto& elems = list->val;
+            const bool unboxed = list->strategy() != model::List::Strategy::Generic;
+            out += '[';
+            for (size_t i = 0; i < list->size(); ++i) {
+                if (i != 0) out += ", ";
+                if (unboxed) list->write_unboxed(i, out, debug);
+                else if (elems[i] != nullptr) write_obj(elems[i], out, debug);
+                else out += "Nil";
+            }
+            out += ']';
+            return;
+        }
+        case model::Object::ObjectType::OT_Dictionary: {
+            bool first = true;
+            out += '{';
+            dynamic_cast<model::Dictionary*>(obj)->for_each([&](const model::Dictionary::Pair& kv_pair) {
+                if (!first) out += ", ";
+                first = false;
+                write_obj(kv_pair.first, out, debug);
+                out += ": ";
+                write_obj(kv_pair.second, out, debug);
+            });
+            out += '}';
+            return;
+        }
+        default:
+            break;
+        }
+    }
+
+    Vm::call_function(method, model::create_list({}), obj);
+    const auto res = Vm::fetch_one_from_stack_top();
+    out += model::cast_to_str(res)->view();
+}
+
+void Vm::write_str(model::Object* obj, std::string& out) {
+    write_obj(obj, out, false);
+}
+
+void Vm::write_debug_str(model::Object* obj, std::string& out) {
+    write_obj(obj, out, true);
+}
+
+void Vm::write_stdout(const std::string_view text) {
+    if (stdout_unbuffered) {
+        std::cout << text;
+        std::cout.flush();
+        return;
+    }
+    stdout_buffer.append(text);
+    if (stdout_buffer.size() >= stdout_buffer_capacity
+        or (stdout_is_tty and text.find('\n') != std::string_view::npos)) {
+        flush_stdout();
+    }
+}
+
+void Vm::flush_stdout() {
+    if (!stdout_buffer.empty()) {
+        std::cout.write(stdout_buffer.data(), static_cast<std::streamsize>(stdout_buffer.size()));
+        stdout_buffer.clear();
+    }
+    std::cout.flush();
 }
 
+std::string Vm::obj_to_str(model::Object* for_cast_obj) {
+    DEBUG_OUTPUT("obj to str");
+    std::string val;
+    write_str(for_cast_obj, val);
+    return val;
+}
 
 std::string Vm::obj_to_debug_str(model::Object* for_cast_obj) {
     DEBUG_OUTPUT("obj to debug str");
-    model::Object* method;
-    try {
-        method = get_attr(for_cast_obj, "__dstr__");
-    } catch (NativeFuncError& e) {
-        try {
-            method = get_attr(for_cast_obj, "__str__");
-        } catch (NativeFuncError& e2) {
-            method = get_attr(model::based_obj, "__str__"); // 兜底
-        }
-    }
-    assert(method != nullptr);
-    call_function(method, model::create_list({}), for_cast_obj);
-    auto res = fetch_one_from_stack_top();
-    std::string val = model::cast_to_str(res)->val;
+    std::string val;
+    write_debug_str(for_cast_obj, val);
     return val;
 }
 
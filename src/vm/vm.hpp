@@ -12,6 +12,7 @@
 #include "../../deps/hashmap.hpp"
 
 #include <stack>
+#include <string_view>
 #include <tuple>
 #include <utility>
 
@@ -26,6 +27,7 @@ namespace model {
 class Module;
 class CodeObject;
 class Object;
+class Iterator;
 }
 
 namespace kiz {
@@ -56,6 +58,8 @@ struct CallFrame {
     model::CodeObject* code_object;
     
     std::vector<TryFrame> try_blocks;
+    // for循环与列表推导式的迭代器, 按循环嵌套深度存放, 不占用变量名
+    std::vector<model::Iterator*> iter_slots;
 };
 
 class Vm {
@@ -75,6 +79,12 @@ public:
 
     static dep::HashMap<model::Object*> std_modules;
 
+    // 标准输出缓冲: 满64KiB、stdout为终端时遇换行、读输入/执行命令前及退出时刷新
+    static constexpr size_t stdout_buffer_capacity = 64 * 1024;
+    static std::string stdout_buffer;
+    static bool stdout_is_tty;
+    static bool stdout_unbuffered; // 命令行 -u: 每次输出后立即刷新(旧行为)
+
     explicit Vm(const std::string& file_path_);
 
     static void entry_builtins();
@@ -87,6 +97,12 @@ public:
     static void execute_instruction(const Instruction& instruction);
     static std::string obj_to_str(model::Object* for_cast_obj);
     static std::string obj_to_debug_str(model::Object* for_cast_obj);
+    /// 把对象的 __str__ / __dstr__ 结果直接追加到out; 内置类型不经过VM调用
+    static void write_str(model::Object* obj, std::string& out);
+    static void write_debug_str(model::Object* obj, std::string& out);
+
+    static void write_stdout(std::string_view text);
+    static void flush_stdout();
 
     static CallFrame* fetch_curr_call_frame();
     static model::Object* fetch_one_from_stack_top();
@@ -95,6 +111,8 @@ public:
 
     static model::Object* get_attr(const model::Object* obj, const std::string& attr);
     static bool is_true(model::Object* obj);
+    /// 相等协议: 同一对象/内置值类型在C++中直接比较, 其余经VM调用__eq__
+    static bool is_equal(model::Object* a, model::Object* b);
 
     static void instruction_throw(const std::string& name, const std::string& content);
     static auto gen_pos_info()
@@ -128,7 +146,13 @@ private:
     static void exec_IN(const Instruction& instruction);
 
     static void exec_MAKE_LIST(const Instruction& instruction);
+    static void exec_LIST_APPEND(const Instruction& instruction);
+    static void exec_MAKE_SLICE(const Instruction& instruction);
+    static void exec_MAKE_SET(const Instruction& instruction);
+    static void exec_MAKE_TUPLE(const Instruction& instruction);
+    static void exec_UNPACK_SEQUENCE(const Instruction& instruction);
     static void exec_MAKE_DICT(const Instruction& instruction);
+    static void exec_BUILD_STRING(const Instruction& instruction);
     static void exec_CALL(const Instruction& instruction);
     static void exec_RET(const Instruction& instruction);
     static void exec_GET_ATTR(const Instruction& instruction);
@@ -151,6 +175,8 @@ private:
 
     static void exec_JUMP(const Instruction& instruction);
     static void exec_JUMP_IF_FALSE(const Instruction& instruction);
+    static void exec_GET_ITER(const Instruction& instruction);
+    static void exec_FOR_ITER(const Instruction& instruction);
     static void exec_IS_CHILD(const Instruction& instruction);
     static void exec_CREATE_OBJECT(const Instruction& instruction);
     static void exec_STOP(const Instruction& instruction);